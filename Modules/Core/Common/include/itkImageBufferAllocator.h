@@ -0,0 +1,129 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageBufferAllocator_h
+#define itkImageBufferAllocator_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkIntTypes.h"
+
+namespace itk
+{
+
+struct ImageBufferAllocatorGlobals;
+
+/** \class ImageBufferAllocator
+ * \brief Allocates the raw memory of image pixel buffers.
+ *
+ * An ImageBufferAllocator provides the memory used by ImportImageContainer
+ * (and hence by Image and VectorImage) for its pixel buffer. It may be set
+ * on an individual container with ImportImageContainer::SetAllocator(), or
+ * process wide with SetGlobalDefaultAllocator(). When no allocator is set,
+ * which is the default, pixel buffers are allocated with new[].
+ *
+ * This allocator returns blocks aligned on Alignment bytes (64 by default,
+ * the size of a cache line and of an AVX-512 register). With UseHugePages
+ * enabled, large blocks are aligned on 2 MiB boundaries and, on Linux,
+ * transparent huge pages are requested for them, which reduces TLB misses
+ * and page faults when the buffer is first touched. Physical pages are
+ * placed on the NUMA node of the thread that first writes them.
+ *
+ * Subclasses may override Allocate() and Deallocate(), e.g. to recycle
+ * buffers (see PooledImageBufferAllocator). Both methods may be called
+ * concurrently from several threads.
+ *
+ * \sa PooledImageBufferAllocator
+ * \sa ImportImageContainer
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ImageBufferAllocator : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = ImageBufferAllocator;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageBufferAllocator, Object);
+
+  /** Allocate a block of numberOfBytes bytes. The content of the block is
+   * uninitialized. Throws a MemoryAllocationError on failure. */
+  virtual void *
+  Allocate(SizeValueType numberOfBytes);
+
+  /** Release a block previously returned by Allocate(), numberOfBytes being
+   * the size that was requested. */
+  virtual void
+  Deallocate(void * buffer, SizeValueType numberOfBytes);
+
+  /** Set/Get the alignment, in bytes, of the allocated blocks. It must be a
+   * power of two, and is at least the alignment of any fundamental type.
+   * Default is 64. */
+  void
+  SetAlignment(SizeValueType alignment);
+  itkGetConstMacro(Alignment, SizeValueType);
+
+  /** Set/Get whether huge pages are requested for blocks of at least
+   * 2 MiB. This is a hint, honored on Linux with transparent huge pages
+   * enabled, and ignored elsewhere. Default is off. */
+  itkSetMacro(UseHugePages, bool);
+  itkGetConstMacro(UseHugePages, bool);
+  itkBooleanMacro(UseHugePages);
+
+  /** Set/Get the allocator used by all the pixel containers that do not
+   * have their own allocator. A null pointer, the default, restores
+   * allocation with new[]. */
+  static void
+  SetGlobalDefaultAllocator(ImageBufferAllocator * allocator);
+  static Pointer
+  GetGlobalDefaultAllocator();
+
+protected:
+  ImageBufferAllocator() = default;
+  ~ImageBufferAllocator() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Allocate and release aligned memory from the operating system, as
+   * configured by Alignment and UseHugePages. These are the building blocks
+   * of Allocate() and Deallocate() for subclasses. */
+  void *
+  AllocateAligned(SizeValueType numberOfBytes) const;
+  static void
+  DeallocateAligned(void * buffer);
+
+private:
+  itkGetGlobalDeclarationMacro(ImageBufferAllocatorGlobals, PimplGlobals);
+
+  SizeValueType m_Alignment{ 64 };
+  bool          m_UseHugePages{ false };
+
+  static ImageBufferAllocatorGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
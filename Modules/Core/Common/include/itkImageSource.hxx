@@ -31,6 +31,7 @@
 #include "itkOutputDataObjectIterator.h"
 #include "itkImageRegionSplitterBase.h"
 #include "itkMultiThreaderBase.h"
+#include "itkProcessObjectProfiler.h"
 
 #include "itkMath.h"
 
@@ -288,7 +289,17 @@ ImageSource<TOutputImage>::ThreaderCallback(void * arg)
 
   if (workUnitID < total)
   {
-    str->Filter->ThreadedGenerateData(splitRegion, workUnitID);
+    ProcessObjectProfiler * profiler = str->Filter->GetActiveProfiler();
+    if (profiler)
+    {
+      const ProcessObjectProfiler::TimeType start = profiler->GetTime();
+      str->Filter->ThreadedGenerateData(splitRegion, workUnitID);
+      profiler->RecordWorkUnit(str->Filter, start, splitRegion.GetNumberOfPixels());
+    }
+    else
+    {
+      str->Filter->ThreadedGenerateData(splitRegion, workUnitID);
+    }
 #if defined(ITKV4_COMPATIBILITY)
     if (str->Filter->GetAbortGenerateData())
     {
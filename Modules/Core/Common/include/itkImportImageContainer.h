@@ -20,6 +20,8 @@
 
 #include "itkObject.h"
 #include "itkObjectFactory.h"
+#include "itkImageBufferAllocator.h"
+#include <functional>
 #include <utility>
 
 namespace itk
@@ -79,6 +81,18 @@ public:
   void
   SetImportPointer(TElement * ptr, TElementIdentifier num, bool LetContainerManageMemory = false);
 
+  /** Function object used to release a buffer that was not allocated by
+   * the container itself, e.g. a memory mapped file. */
+  using DeleterType = std::function<void(TElement *)>;
+
+  /** Set the pointer from which the image data is imported, and let the
+   * container manage its memory through the given deleter instead of
+   * delete[]. The deleter is invoked exactly once, when the container
+   * releases the buffer (on destruction, Initialize(), or when the buffer is
+   * replaced). "num" is the number of elements in the block of memory. */
+  void
+  SetImportPointer(TElement * ptr, TElementIdentifier num, DeleterType deleter);
+
   /** Index operator. This version can be an lvalue. */
   TElement & operator[](const ElementIdentifier id) { return m_ImportPointer[id]; }
 
@@ -151,6 +165,16 @@ public:
   itkGetConstMacro(ContainerManageMemory, bool);
   itkBooleanMacro(ContainerManageMemory);
 
+  /** Set/Get the allocator providing the memory of the buffers allocated
+   * by this container (by Reserve() and Squeeze()). When it is null, the
+   * default, the global default allocator is used if there is one (see
+   * ImageBufferAllocator::SetGlobalDefaultAllocator()), and otherwise the
+   * buffer is allocated by AllocateElements(). Changing the allocator does
+   * not affect the current buffer, which is released by the allocator it
+   * was obtained from. */
+  itkSetObjectMacro(Allocator, ImageBufferAllocator);
+  itkGetModifiableObjectMacro(Allocator, ImageBufferAllocator);
+
 protected:
   ImportImageContainer();
   ~ImportImageContainer() override;
@@ -188,6 +212,12 @@ protected:
    * DeallocateManagedMemory. */
   itkSetMacro(Capacity, TElementIdentifier);
 
+  /** Allocates elements of the array through the allocator of the container
+   * or the global default allocator, and returns the deleter releasing them.
+   * Returns a null pointer when there is no such allocator. */
+  TElement *
+  AllocateElementsWithAllocator(ElementIdentifier size, bool UseDefaultConstructor, DeleterType & deleter) const;
+
   /* Set the m_ImportPointer member. Use this function with great care
    * since it only changes the m_ImportPointer member but not the m_Size
    * and m_Capacity members. It should typically be used only to override
@@ -203,6 +233,9 @@ private:
   TElementIdentifier m_Size;
   TElementIdentifier m_Capacity;
   bool               m_ContainerManageMemory;
+  DeleterType        m_Deleter;
+
+  ImageBufferAllocator::Pointer m_Allocator;
 };
 } // end namespace itk
 
@@ -29,6 +29,7 @@
 #define itkImportImageContainer_hxx
 
 #include <algorithm> // For copy_n.
+#include <new>       // For placement new.
 
 namespace itk
 {
@@ -62,13 +63,19 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   {
     if (size > m_Capacity)
     {
-      TElement * temp = this->AllocateElements(size, UseDefaultConstructor);
+      DeleterType deleter;
+      TElement *  temp = this->AllocateElementsWithAllocator(size, UseDefaultConstructor, deleter);
+      if (!temp)
+      {
+        temp = this->AllocateElements(size, UseDefaultConstructor);
+      }
       // only copy the portion of the data used in the old buffer
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_Deleter = std::move(deleter);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -82,7 +89,11 @@ ImportImageContainer<TElementIdentifier, TElement>::Reserve(ElementIdentifier si
   }
   else
   {
-    m_ImportPointer = this->AllocateElements(size, UseDefaultConstructor);
+    m_ImportPointer = this->AllocateElementsWithAllocator(size, UseDefaultConstructor, m_Deleter);
+    if (!m_ImportPointer)
+    {
+      m_ImportPointer = this->AllocateElements(size, UseDefaultConstructor);
+    }
     m_Capacity = size;
     m_Size = size;
     m_ContainerManageMemory = true;
@@ -103,12 +114,18 @@ ImportImageContainer<TElementIdentifier, TElement>::Squeeze()
     if (m_Size < m_Capacity)
     {
       const TElementIdentifier size = m_Size;
-      TElement *               temp = this->AllocateElements(size, false);
+      DeleterType              deleter;
+      TElement *               temp = this->AllocateElementsWithAllocator(size, false, deleter);
+      if (!temp)
+      {
+        temp = this->AllocateElements(size, false);
+      }
       std::copy_n(m_ImportPointer, m_Size, temp);
 
       DeallocateManagedMemory();
 
       m_ImportPointer = temp;
+      m_Deleter = std::move(deleter);
       m_ContainerManageMemory = true;
       m_Capacity = size;
       m_Size = size;
@@ -159,6 +176,22 @@ ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *
   this->Modified();
 }
 
+template <typename TElementIdentifier, typename TElement>
+void
+ImportImageContainer<TElementIdentifier, TElement>::SetImportPointer(TElement *         ptr,
+                                                                     TElementIdentifier num,
+                                                                     DeleterType        deleter)
+{
+  DeallocateManagedMemory();
+  m_ImportPointer = ptr;
+  m_ContainerManageMemory = true;
+  m_Deleter = std::move(deleter);
+  m_Capacity = num;
+  m_Size = num;
+
+  this->Modified();
+}
+
 template <typename TElementIdentifier, typename TElement>
 TElement *
 ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIdentifier size,
@@ -193,6 +226,47 @@ ImportImageContainer<TElementIdentifier, TElement>::AllocateElements(ElementIden
   return data;
 }
 
+template <typename TElementIdentifier, typename TElement>
+TElement *
+ImportImageContainer<TElementIdentifier, TElement>::AllocateElementsWithAllocator(ElementIdentifier size,
+                                                                                  bool UseDefaultConstructor,
+                                                                                  DeleterType & deleter) const
+{
+  ImageBufferAllocator::Pointer allocator = m_Allocator;
+  if (allocator.IsNull())
+  {
+    allocator = ImageBufferAllocator::GetGlobalDefaultAllocator();
+    if (allocator.IsNull())
+    {
+      return nullptr;
+    }
+  }
+
+  const SizeValueType numberOfBytes = static_cast<SizeValueType>(size) * sizeof(TElement);
+  auto *              data = static_cast<TElement *>(allocator->Allocate(numberOfBytes));
+  for (ElementIdentifier i = 0; i < size; ++i)
+  {
+    if (UseDefaultConstructor)
+    {
+      new (data + i) TElement(); // POD types initialized to 0, others use default constructor.
+    }
+    else
+    {
+      new (data + i) TElement; // Faster but uninitialized
+    }
+  }
+
+  // The deleter keeps the allocator alive for as long as the buffer exists
+  deleter = [allocator, size, numberOfBytes](TElement * buffer) {
+    for (ElementIdentifier i = 0; i < size; ++i)
+    {
+      buffer[i].~TElement();
+    }
+    allocator->Deallocate(buffer, numberOfBytes);
+  };
+  return data;
+}
+
 template <typename TElementIdentifier, typename TElement>
 void
 ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
@@ -200,8 +274,16 @@ ImportImageContainer<TElementIdentifier, TElement>::DeallocateManagedMemory()
   // Encapsulate all image memory deallocation here
   if (m_ContainerManageMemory)
   {
-    delete[] m_ImportPointer;
+    if (m_Deleter)
+    {
+      m_Deleter(m_ImportPointer);
+    }
+    else
+    {
+      delete[] m_ImportPointer;
+    }
   }
+  m_Deleter = nullptr;
   m_ImportPointer = nullptr;
   m_Capacity = 0;
   m_Size = 0;
@@ -215,6 +297,8 @@ ImportImageContainer<TElementIdentifier, TElement>::PrintSelf(std::ostream & os,
 
   os << indent << "Pointer: " << static_cast<void *>(m_ImportPointer) << std::endl;
   os << indent << "Container manages memory: " << (m_ContainerManageMemory ? "true" : "false") << std::endl;
+  os << indent << "Custom deleter: " << (m_Deleter ? "true" : "false") << std::endl;
+  itkPrintSelfObjectMacro(Allocator);
   os << indent << "Size: " << m_Size << std::endl;
   os << indent << "Capacity: " << m_Capacity << std::endl;
 }
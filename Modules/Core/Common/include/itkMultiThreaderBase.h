@@ -63,7 +63,8 @@ public:
     First = Platform,
     Pool,
     TBB,
-    Last = TBB,
+    WorkStealing,
+    Last = WorkStealing,
     Unknown = -1
   };
 
@@ -163,6 +164,7 @@ public:
   static constexpr ThreaderEnum First = ThreaderEnum::First;
   static constexpr ThreaderEnum Pool = ThreaderEnum::Pool;
   static constexpr ThreaderEnum TBB = ThreaderEnum::TBB;
+  static constexpr ThreaderEnum WorkStealing = ThreaderEnum::WorkStealing;
   static constexpr ThreaderEnum Last = ThreaderEnum::Last;
   static constexpr ThreaderEnum Unknown = ThreaderEnum::Unknown;
 #endif
@@ -186,6 +188,9 @@ public:
       case ThreaderEnum::TBB:
         return "TBB";
         break;
+      case ThreaderEnum::WorkStealing:
+        return "WorkStealing";
+        break;
       case ThreaderEnum::Unknown:
       default:
         return "Unknown";
@@ -340,15 +345,18 @@ ITK_GCC_PRAGMA_DIAG_POP()
       VDimension,
       requestedRegion.GetIndex().m_InternalArray,
       requestedRegion.GetSize().m_InternalArray,
-      [funcP](const IndexValueType index[], const SizeValueType size[]) {
-        ImageRegion<VDimension> region;
-        for (unsigned int d = 0; d < VDimension; ++d)
-        {
-          region.SetIndex(d, index[d]);
-          region.SetSize(d, size[d]);
-        }
-        funcP(region);
-      },
+      ProfileWorkUnits(
+        [funcP](const IndexValueType index[], const SizeValueType size[]) {
+          ImageRegion<VDimension> region;
+          for (unsigned int d = 0; d < VDimension; ++d)
+          {
+            region.SetIndex(d, index[d]);
+            region.SetSize(d, size[d]);
+          }
+          funcP(region);
+        },
+        VDimension,
+        filter),
       filter);
   }
 
@@ -389,22 +397,26 @@ ITK_GCC_PRAGMA_DIAG_POP()
         SplitDimension,
         splitRegion.GetIndex().m_InternalArray,
         splitRegion.GetSize().m_InternalArray,
-        [&](const IndexValueType index[], const SizeValueType size[]) {
-          ImageRegion<VDimension> restrictedRequestedRegion;
-          restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
-          restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
-          for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
-          {
-            if (dimension == restrictedDirection)
+        ProfileWorkUnits(
+          [&](const IndexValueType index[], const SizeValueType size[]) {
+            ImageRegion<VDimension> restrictedRequestedRegion;
+            restrictedRequestedRegion.SetIndex(restrictedDirection, requestedRegion.GetIndex(restrictedDirection));
+            restrictedRequestedRegion.SetSize(restrictedDirection, requestedRegion.GetSize(restrictedDirection));
+            for (unsigned int splitDimension = 0, dimension = 0; dimension < VDimension; ++dimension)
             {
-              continue;
+              if (dimension == restrictedDirection)
+              {
+                continue;
+              }
+              restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
+              restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
+              ++splitDimension;
             }
-            restrictedRequestedRegion.SetIndex(dimension, index[splitDimension]);
-            restrictedRequestedRegion.SetSize(dimension, size[splitDimension]);
-            ++splitDimension;
-          }
-          funcP(restrictedRequestedRegion);
-        },
+            funcP(restrictedRequestedRegion);
+          },
+          SplitDimension,
+          filter,
+          requestedRegion.GetSize(restrictedDirection)),
         filter);
     }
   }
@@ -447,6 +459,15 @@ protected:
   static ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
   ParallelizeImageRegionHelper(void * arg);
 
+  /** Return funcP, wrapped so that each call is recorded as a work unit
+   * when the execution of filter is profiled (see ProcessObjectProfiler).
+   * Each index of the chunks stands for numberOfPixelsPerIndex pixels. */
+  static ThreadingFunctorType
+  ProfileWorkUnits(ThreadingFunctorType funcP,
+                   unsigned int         dimension,
+                   ProcessObject *      filter,
+                   SizeValueType        numberOfPixelsPerIndex = 1);
+
   /** The number of work units to create. */
   ThreadIdType m_NumberOfWorkUnits;
 
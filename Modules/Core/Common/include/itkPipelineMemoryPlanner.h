@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPipelineMemoryPlanner_h
+#define itkPipelineMemoryPlanner_h
+
+#include "itkDataObject.h"
+#include "itkObjectFactory.h"
+
+#include <map>
+#include <set>
+#include <vector>
+
+namespace itk
+{
+
+class ProcessObject;
+
+/** \class PipelineMemoryPlanner
+ * \brief Updates a pipeline, releasing its intermediate data objects as
+ * soon as they are no longer needed and recycling their buffers.
+ *
+ * Update() analyzes the graph of the process objects which generate the
+ * Output, and counts the consumers of each intermediate data object, i.e.
+ * the process objects of the graph which take it as input. During the
+ * update of the Output, an intermediate data object is released (see
+ * DataObject::ReleaseData()) when the last of its consumers has finished
+ * its execution, instead of being held until the end of the update or
+ * forever. Consumers which do not contribute to the Output are ignored.
+ *
+ * With ReuseBuffers, the default, a PooledImageBufferAllocator is the
+ * global default allocator during the update (see
+ * ImageBufferAllocator::SetGlobalDefaultAllocator()), so that the buffers
+ * of the released data objects are recycled by the compatible outputs
+ * generated downstream, i.e. the outputs of the same size in bytes. The
+ * pool is emptied at the end of the update.
+ *
+ * The planner measures the peak of the memory allocated for image buffers
+ * during the update, and the total of the buffers allocated, which is the
+ * peak of a pipeline holding all its intermediate data objects. Report()
+ * summarizes both.
+ *
+ * The released data objects are generated again by the next update of
+ * the pipeline, even if their process objects were not modified. The
+ * allocator of the pixel containers which do not have their own allocator
+ * is changed in all the threads during the update.
+ *
+ * \sa ProcessObject::SetReleaseDataFlag(), PooledImageBufferAllocator
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PipelineMemoryPlanner : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PipelineMemoryPlanner);
+
+  /** Standard class type aliases. */
+  using Self = PipelineMemoryPlanner;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PipelineMemoryPlanner, Object);
+
+  /** Set/Get the data object updated by the planner, typically the output
+   * of the last filter of the pipeline. It is never released. */
+  itkSetObjectMacro(Output, DataObject);
+  itkGetModifiableObjectMacro(Output, DataObject);
+
+  /** Set/Get whether the buffers of the released data objects are recycled.
+   * Default is true. */
+  itkSetMacro(ReuseBuffers, bool);
+  itkGetConstMacro(ReuseBuffers, bool);
+  itkBooleanMacro(ReuseBuffers);
+
+  /** Analyze the graph of the process objects which generate the Output.
+   * Called by Update(). */
+  void
+  Plan();
+
+  /** Update the Output, releasing the intermediate data objects as planned. */
+  void
+  Update();
+
+  /** Number of process objects of the graph which take dataObject as
+   * input, as found by the last Plan(). Zero for the data objects which are
+   * never released. */
+  SizeValueType
+  GetNumberOfConsumers(const DataObject * dataObject) const;
+
+  /** Number of process objects in the graph, as found by the last Plan(). */
+  SizeValueType
+  GetNumberOfProcessObjects() const
+  {
+    return static_cast<SizeValueType>(m_ProcessObjects.size());
+  }
+
+  /** Peak of the memory allocated for image buffers during the last
+   * Update(), including the recycled buffers waiting in the pool. */
+  itkGetConstMacro(PeakMemoryInBytes, SizeValueType);
+
+  /** Total of the image buffers allocated during the last Update(), which
+   * is the peak memory when no data object is released. */
+  itkGetConstMacro(UnplannedPeakMemoryInBytes, SizeValueType);
+
+  /** Number of data objects released, and of buffers recycled, during the
+   * last Update(). */
+  itkGetConstMacro(NumberOfReleasedDataObjects, SizeValueType);
+  itkGetConstMacro(NumberOfReusedBuffers, SizeValueType);
+
+  /** Summary of the plan and of the memory measured by the last Update(). */
+  void
+  Report(std::ostream & os = std::cout) const;
+
+protected:
+  PipelineMemoryPlanner() = default;
+  ~PipelineMemoryPlanner() override = default;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** The consumers of an intermediate data object, and those of them which
+   * finished since it was last generated. */
+  struct DataObjectUsage
+  {
+    std::set<const ProcessObject *> Consumers;
+    std::set<const ProcessObject *> FinishedConsumers;
+  };
+
+  /** Observer of the EndEvent of the process objects of the graph. */
+  void
+  ProcessObjectFinished(Object * caller, const EventObject & event);
+
+  DataObject::Pointer m_Output;
+  bool                m_ReuseBuffers{ true };
+
+  std::vector<ProcessObject *>                 m_ProcessObjects;
+  std::map<const DataObject *, DataObjectUsage> m_Usages;
+
+  SizeValueType m_PeakMemoryInBytes{ 0 };
+  SizeValueType m_UnplannedPeakMemoryInBytes{ 0 };
+  SizeValueType m_NumberOfReleasedDataObjects{ 0 };
+  SizeValueType m_NumberOfReusedBuffers{ 0 };
+};
+} // end namespace itk
+
+#endif
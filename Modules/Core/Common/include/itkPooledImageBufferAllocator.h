@@ -0,0 +1,115 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkPooledImageBufferAllocator_h
+#define itkPooledImageBufferAllocator_h
+
+#include "itkImageBufferAllocator.h"
+#include "itkNumericTraits.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+/** \class PooledImageBufferAllocator
+ * \brief Image buffer allocator recycling released blocks.
+ *
+ * Blocks released by Deallocate() are kept in a pool, keyed by their size
+ * in bytes, instead of being returned to the operating system. A later
+ * Allocate() of the same size reuses a pooled block. When a pipeline is
+ * updated repeatedly on images of the same size (e.g. the frames of a
+ * video, or the levels of a registration), the buffers of every filter
+ * output are then recycled instead of being allocated and page faulted on
+ * each Update().
+ *
+ * The total size of the pooled blocks is bounded by
+ * MaximumPoolSizeInBytes; blocks which would exceed it are freed. The pool
+ * is emptied by ReleasePool(), and when the allocator is destroyed.
+ *
+ * The allocator is thread safe.
+ *
+ * \sa ImageBufferAllocator
+ *
+ * \ingroup ImageObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT PooledImageBufferAllocator : public ImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PooledImageBufferAllocator);
+
+  /** Standard class type aliases. */
+  using Self = PooledImageBufferAllocator;
+  using Superclass = ImageBufferAllocator;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PooledImageBufferAllocator, ImageBufferAllocator);
+
+  /** Return a pooled block of numberOfBytes bytes if there is one, or
+   * allocate a new one. */
+  void *
+  Allocate(SizeValueType numberOfBytes) override;
+
+  /** Return the block to the pool, or free it if the pool is full. */
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override;
+
+  /** Free all the pooled blocks. */
+  void
+  ReleasePool();
+
+  /** Set/Get the maximum total size of the pooled blocks. Default is
+   * unbounded. */
+  itkSetMacro(MaximumPoolSizeInBytes, SizeValueType);
+  itkGetConstMacro(MaximumPoolSizeInBytes, SizeValueType);
+
+  /** Total size of the blocks currently in the pool. */
+  SizeValueType
+  GetPoolSizeInBytes() const;
+
+  /** Number of calls to Allocate() served by a pooled block, and by a new
+   * block. */
+  SizeValueType
+  GetNumberOfReusedBlocks() const;
+  SizeValueType
+  GetNumberOfAllocatedBlocks() const;
+
+protected:
+  PooledImageBufferAllocator() = default;
+  ~PooledImageBufferAllocator() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  SizeValueType m_MaximumPoolSizeInBytes{ NumericTraits<SizeValueType>::max() };
+
+  mutable std::mutex                             m_Mutex;
+  std::map<SizeValueType, std::vector<void *>> m_Pool;
+  SizeValueType                                  m_PoolSizeInBytes{ 0 };
+  SizeValueType                                  m_NumberOfReusedBlocks{ 0 };
+  SizeValueType                                  m_NumberOfAllocatedBlocks{ 0 };
+};
+} // end namespace itk
+
+#endif
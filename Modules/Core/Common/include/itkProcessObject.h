@@ -42,6 +42,7 @@ namespace itk
 {
 
 class MultiThreaderBase;
+class ProcessObjectProfiler;
 
 /** \class ProcessObject
  * \brief The base class for all process objects (source,
@@ -510,6 +511,26 @@ public:
   void
   SetMultiThreader(MultiThreaderType * threader);
 
+  /** Set/Get the profiler recording the execution of this process object.
+   * When it is not set, the global profiler of ProcessObjectProfiler is
+   * used, if any. \sa ProcessObjectProfiler */
+  void
+  SetProfiler(ProcessObjectProfiler * profiler);
+  ProcessObjectProfiler *
+  GetProfiler() const
+  {
+    return m_Profiler.GetPointer();
+  }
+
+  /** Return the profiler recording the current execution of GenerateData(),
+   * or nullptr when the execution is not profiled. Used by the
+   * multithreaders to record the work units. */
+  ProcessObjectProfiler *
+  GetActiveProfiler() const
+  {
+    return m_ActiveProfiler.GetPointer();
+  }
+
   /** An opportunity to deallocate a ProcessObject's bulk data
    *  storage. Some filters may wish to reuse existing bulk data
    *  storage to avoid unnecessary deallocation/allocation
@@ -977,6 +998,10 @@ private:
 
   bool m_ThreaderUpdateProgress{ true };
 
+  /** Profiling support */
+  itk::SmartPointer<ProcessObjectProfiler> m_Profiler;
+  itk::SmartPointer<ProcessObjectProfiler> m_ActiveProfiler;
+
   /** Memory management ivars */
   bool m_ReleaseDataBeforeUpdateFlag;
 
@@ -0,0 +1,197 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkProcessObjectProfiler_h
+#define itkProcessObjectProfiler_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace itk
+{
+
+class ProcessObject;
+class TimeProbesCollectorBase;
+class MemoryProbesCollectorBase;
+struct ProcessObjectProfilerGlobals;
+
+/** \class ProcessObjectProfiler
+ * \brief Records the execution of the process objects of a pipeline.
+ *
+ * When a profiler is set on a ProcessObject, or process wide with
+ * SetGlobalProfiler(), each update of the process object records:
+ * - the wall time spent in GenerateOutputInformation() and GenerateData(),
+ * - the change of the memory used by the process during GenerateData(),
+ *   which includes the allocation of the outputs,
+ * - the number of executions of GenerateData(), i.e. the number of pieces
+ *   of a streamed update,
+ * - the wall time of each work unit executed through
+ *   MultiThreaderBase::ParallelizeImageRegion() or
+ *   ImageSource::ThreadedGenerateData(), to expose load imbalance.
+ *
+ * Report() summarizes these measures per process object, using
+ * TimeProbesCollectorBase and MemoryProbesCollectorBase, and
+ * WriteChromeTrace() exports all the recorded events in the Chrome trace
+ * event format, which can be opened by chrome://tracing or Perfetto.
+ *
+ * Profiling is disabled by default. Without a profiler, the overhead is a
+ * pointer check per update and per parallelized region.
+ *
+ * Process objects are identified by their object name when it is set
+ * (see Object::SetObjectName()), and otherwise by their class name and
+ * address.
+ *
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT ProcessObjectProfiler : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ProcessObjectProfiler);
+
+  /** Standard class type aliases. */
+  using Self = ProcessObjectProfiler;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ProcessObjectProfiler, Object);
+
+  /** Time in microseconds, since the creation of the profiler. */
+  using TimeType = double;
+
+  /** A recorded event. Category is "GenerateOutputInformation",
+   * "GenerateData" or "WorkUnit". */
+  struct Event
+  {
+    std::string     Name;
+    std::string     Category;
+    TimeType        Start;
+    TimeType        Duration;
+    unsigned int    Thread;
+    SizeValueType   Execution;
+    SizeValueType   NumberOfPixels;
+    OffsetValueType MemoryChange;
+  };
+  using EventContainerType = std::vector<Event>;
+
+  /** Set/Get the profiler used by all the process objects which do not
+   * have their own profiler. A null pointer, the default, disables
+   * profiling. */
+  static void
+  SetGlobalProfiler(ProcessObjectProfiler * profiler);
+  static Pointer
+  GetGlobalProfiler();
+
+  /** Elapsed time since the creation of the profiler. */
+  TimeType
+  GetTime() const
+  {
+    return std::chrono::duration<TimeType, std::micro>(std::chrono::steady_clock::now() - m_Origin).count();
+  }
+
+  /** Called by ProcessObject around GenerateOutputInformation() and
+   * GenerateData(). */
+  void
+  BeginGenerateOutputInformation(const ProcessObject * processObject);
+  void
+  EndGenerateOutputInformation(const ProcessObject * processObject);
+  void
+  BeginGenerateData(const ProcessObject * processObject);
+  void
+  EndGenerateData(const ProcessObject * processObject);
+
+  /** Record a work unit of processObject, started at startTime and which
+   * processed numberOfPixels pixels. Called from the threads executing the
+   * work units. */
+  void
+  RecordWorkUnit(const ProcessObject * processObject, TimeType startTime, SizeValueType numberOfPixels);
+
+  /** Copy of the events recorded so far. */
+  EventContainerType
+  GetEvents() const;
+
+  /** Summary of the recorded measures, per process object. */
+  void
+  Report(std::ostream & os = std::cout);
+
+  /** Write the recorded events in the Chrome trace event format. */
+  void
+  WriteChromeTrace(std::ostream & os) const;
+  void
+  WriteChromeTrace(const std::string & fileName) const;
+
+  /** Discard the recorded measures. */
+  void
+  Clear();
+
+protected:
+  ProcessObjectProfiler();
+  ~ProcessObjectProfiler() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  itkGetGlobalDeclarationMacro(ProcessObjectProfilerGlobals, PimplGlobals);
+
+  /** Summary statistics of the work units of a process object. */
+  struct WorkUnitStatistics
+  {
+    SizeValueType Count{ 0 };
+    TimeType      Total{ 0 };
+    TimeType      Minimum{ 0 };
+    TimeType      Maximum{ 0 };
+  };
+
+  static std::string
+  GetProcessObjectLabel(const ProcessObject * processObject);
+
+  unsigned int
+  GetThreadNumber(); // m_Mutex must be held
+
+  const std::chrono::steady_clock::time_point m_Origin;
+
+  mutable std::mutex m_Mutex;
+
+  EventContainerType                        m_Events;
+  std::map<std::thread::id, unsigned int>   m_ThreadNumbers;
+  std::map<std::string, WorkUnitStatistics> m_WorkUnitStatistics;
+
+  /** Start time of the calls being executed */
+  std::map<const ProcessObject *, TimeType> m_GenerateOutputInformationStarts;
+  std::map<const ProcessObject *, TimeType> m_GenerateDataStarts;
+
+  const std::unique_ptr<TimeProbesCollectorBase>   m_GenerateOutputInformationTimes;
+  const std::unique_ptr<TimeProbesCollectorBase>   m_GenerateDataTimes;
+  const std::unique_ptr<MemoryProbesCollectorBase> m_GenerateDataMemory;
+
+  static ProcessObjectProfilerGlobals * m_PimplGlobals;
+};
+} // end namespace itk
+
+#endif
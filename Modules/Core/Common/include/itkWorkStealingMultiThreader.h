@@ -0,0 +1,120 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkStealingMultiThreader_h
+#define itkWorkStealingMultiThreader_h
+
+#include "itkMultiThreaderBase.h"
+#include "itkWorkStealingThreadPool.h"
+
+namespace itk
+{
+/** \class WorkStealingMultiThreader
+ * \brief A class for performing multithreaded execution with a work
+ * stealing thread pool back end.
+ *
+ * Image regions and index ranges are split recursively in halves, the
+ * halves being handed over to the WorkStealingThreadPool, until the pieces
+ * reach the size of the whole divided by the number of work units. Idle
+ * threads steal the largest pending pieces, which balances the load when
+ * the cost per pixel is not uniform, without needing a central queue.
+ *
+ * Calls made from within a parallelized function (nested parallelism)
+ * are scheduled on the same threads, and the calling thread executes
+ * pending work while waiting, so the number of running threads never
+ * exceeds the size of the pool.
+ *
+ * Unlike TBBMultiThreader, it does not depend on any external library.
+ *
+ * \ingroup OSSystemObjects
+ *
+ * \ingroup ITKCommon
+ */
+
+class ITKCommon_EXPORT WorkStealingMultiThreader : public MultiThreaderBase
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WorkStealingMultiThreader);
+
+  /** Standard class type aliases. */
+  using Self = WorkStealingMultiThreader;
+  using Superclass = MultiThreaderBase;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WorkStealingMultiThreader, MultiThreaderBase);
+
+  /** Get/Set the number of work units to create. WorkStealingMultiThreader
+   * does not limit the number of work units. It is the number of work units
+   * of SetSingleMethod/SingleMethodExecute, and the number of pieces which
+   * ParallelizeArray and ParallelizeImageRegion split their range into. */
+  void
+  SetNumberOfWorkUnits(ThreadIdType numberOfWorkUnits) override;
+
+  /** Execute the SingleMethod (as define by SetSingleMethod) using
+   * m_NumberOfWorkUnits work units. */
+  void
+  SingleMethodExecute() override;
+
+  /** Set the SingleMethod to f() and the UserData field of the
+   * WorkUnitInfo that is passed to it will be data.
+   * This method must be of type itkThreadFunctionType and
+   * must take a single argument of type void. */
+  void
+  SetSingleMethod(ThreadFunctionType, void * data) override;
+
+  /** Parallelize an operation over an array. If filter argument is not nullptr,
+   * this function will update its progress as each index is completed. */
+  void
+  ParallelizeArray(SizeValueType             firstIndex,
+                   SizeValueType             lastIndexPlus1,
+                   ArrayThreadingFunctorType aFunc,
+                   ProcessObject *           filter) override;
+
+  /** Break up region into smaller chunks, and call the function with chunks as parameters. */
+  void
+  ParallelizeImageRegion(unsigned int         dimension,
+                         const IndexValueType index[],
+                         const SizeValueType  size[],
+                         ThreadingFunctorType funcP,
+                         ProcessObject *      filter) override;
+
+  /** Set the number of threads to use. WorkStealingMultiThreader
+   * can only INCREASE its number of threads. */
+  void
+  SetMaximumNumberOfThreads(ThreadIdType numberOfThreads) override;
+
+protected:
+  WorkStealingMultiThreader();
+  ~WorkStealingMultiThreader() override;
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  // Thread pool instance
+  WorkStealingThreadPool::Pointer m_ThreadPool;
+
+  /** ProcessObject is a friend so that it can call PrintSelf() on its Multithreader. */
+  friend class ProcessObject;
+};
+
+} // end namespace itk
+#endif
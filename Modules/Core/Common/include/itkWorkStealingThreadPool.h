@@ -0,0 +1,213 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkWorkStealingThreadPool_h
+#define itkWorkStealingThreadPool_h
+
+#include "itkConfigure.h"
+#include "itkIntTypes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkSingletonMacro.h"
+
+
+namespace itk
+{
+
+struct WorkStealingThreadPoolGlobals;
+
+/**
+ * \class WorkStealingThreadPool
+ * \brief Thread pool scheduling tasks by work stealing.
+ *
+ * Each worker thread owns a double-ended task queue, guarded by its own
+ * mutex. A task added from a worker is pushed to the back of that worker's
+ * queue, and the worker pops its tasks from the back (most recent first),
+ * which keeps the data of recursively split tasks hot in its caches. An
+ * idle worker steals the oldest task, which is also the largest one for
+ * recursively split work, from the front of another queue. Tasks added by
+ * threads which are not workers go to a shared queue.
+ *
+ * Tasks are added to a TaskGroup, and Wait() returns once all the tasks of
+ * the group are done. Instead of blocking, the waiting thread executes
+ * queued tasks in the meantime. Tasks may therefore add tasks and wait for
+ * them (nested parallelism) without creating additional threads and
+ * without deadlocking, even when all the workers are waiting.
+ *
+ * As the thread calling Wait() also executes tasks, the pool starts one
+ * worker less than GlobalDefaultNumberOfThreads.
+ *
+ * \sa WorkStealingMultiThreader
+ * \sa ThreadPool
+ *
+ * \ingroup OSSystemObjects
+ * \ingroup ITKCommon
+ */
+class ITKCommon_EXPORT WorkStealingThreadPool : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(WorkStealingThreadPool);
+
+  /** Standard class type aliases. */
+  using Self = WorkStealingThreadPool;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(WorkStealingThreadPool, Object);
+
+  /** Returns the global instance */
+  static Pointer
+  New();
+
+  /** Returns the global singleton instance of the WorkStealingThreadPool */
+  static Pointer
+  GetInstance();
+
+  using TaskFunctionType = std::function<void()>;
+
+  /** \class TaskGroup
+   * \brief A set of tasks which are waited for together.
+   *
+   * A TaskGroup must be waited for, using WorkStealingThreadPool::Wait(),
+   * before it is destroyed.
+   *
+   * \ingroup ITKCommon
+   */
+  class ITKCommon_EXPORT TaskGroup
+  {
+  public:
+    ITK_DISALLOW_COPY_AND_MOVE(TaskGroup);
+    TaskGroup() = default;
+    ~TaskGroup() = default;
+
+  private:
+    friend class WorkStealingThreadPool;
+
+    std::atomic<SizeValueType> m_NumberOfPendingTasks{ 0 };
+
+    std::mutex         m_ExceptionMutex;
+    std::exception_ptr m_FirstCaughtException;
+  };
+
+  /** Add a task to the group. The task may be executed by any thread of the
+   * pool, or by a thread waiting for a task group. */
+  void
+  AddTask(TaskGroup & group, TaskFunctionType task);
+
+  /** Wait until all the tasks of the group are done, executing queued tasks
+   * in the meantime. If some of the tasks have thrown an exception, the
+   * first one caught is rethrown. */
+  void
+  Wait(TaskGroup & group);
+
+  /** Can call this method if we want to add extra threads to the pool.
+   * The number of threads is bounded by ITK_MAX_THREADS. */
+  void
+  AddThreads(ThreadIdType count);
+
+  /** The number of threads executing tasks: the workers, plus the thread
+   * waiting for the tasks. */
+  ThreadIdType
+  GetMaximumNumberOfThreads() const;
+
+  /** Whether the calling thread is one of the workers of the pool. */
+  static bool
+  IsWorkerThread();
+
+protected:
+  WorkStealingThreadPool();
+
+  /** Stop the pool and release threads. To be called by the destructor and atfork. */
+  void
+  CleanUp();
+
+  ~WorkStealingThreadPool() override { this->CleanUp(); }
+
+  static void
+  PrepareForFork();
+  static void
+  ResumeFromFork();
+
+private:
+  /** Only used to synchronize the global variable across static libraries.*/
+  itkGetGlobalDeclarationMacro(WorkStealingThreadPoolGlobals, PimplGlobals);
+
+  struct Task
+  {
+    TaskGroup *      m_Group;
+    TaskFunctionType m_Function;
+  };
+
+  struct TaskQueue
+  {
+    std::mutex       m_Mutex;
+    std::deque<Task> m_Tasks;
+  };
+
+  /** Pop a task from the back of the queue of the calling thread, or steal
+   * one from the front of another queue, and execute it. Returns false when
+   * no task was found. */
+  bool
+  ExecuteQueuedTask();
+
+  void
+  ExecuteTask(Task & task);
+
+  /** The continuously running thread function */
+  void
+  ThreadExecute(ThreadIdType queueIndex);
+
+  /** One queue per worker, queue 0 being shared by the threads which are
+   * not workers. Allocated once for ITK_MAX_THREADS threads, so that workers
+   * may be added while other threads steal tasks. */
+  std::unique_ptr<TaskQueue[]> m_Queues;
+  std::atomic<ThreadIdType>    m_NumberOfQueues{ 1 };
+
+  /** Number of tasks in all the queues, used by idle threads to decide
+   * whether to sleep. */
+  std::atomic<SizeValueType> m_NumberOfQueuedTasks{ 0 };
+
+  /** Idle threads wait on m_Condition. It is signaled when a task is added,
+   * or when the last task of a group is done, but only if some threads are
+   * sleeping, so that busy threads do not contend on m_Mutex. */
+  std::atomic<ThreadIdType> m_NumberOfSleepingThreads{ 0 };
+  std::mutex              m_Mutex;
+  std::condition_variable m_Condition;
+
+  std::vector<std::thread> m_Threads; // guarded by m_Mutex
+
+  /* Has destruction started? */
+  bool m_Stopping{ false }; // guarded by m_Mutex
+
+  static WorkStealingThreadPoolGlobals * m_PimplGlobals;
+};
+
+} // namespace itk
+#endif
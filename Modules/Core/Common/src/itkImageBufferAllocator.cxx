@@ -0,0 +1,145 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkImageBufferAllocator.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <mutex>
+
+#if defined(_WIN32)
+#  include <malloc.h>
+#elif defined(__linux__)
+#  include <sys/mman.h>
+#endif
+
+namespace itk
+{
+
+namespace
+{
+// Size and alignment of the transparent huge pages on the common platforms
+constexpr SizeValueType HugePageSize = 2 * 1024 * 1024;
+} // namespace
+
+struct ImageBufferAllocatorGlobals
+{
+  std::mutex                    m_Mutex;
+  ImageBufferAllocator::Pointer m_GlobalDefaultAllocator{ nullptr };
+};
+
+itkGetGlobalSimpleMacro(ImageBufferAllocator, ImageBufferAllocatorGlobals, PimplGlobals);
+
+ImageBufferAllocatorGlobals * ImageBufferAllocator::m_PimplGlobals;
+
+void
+ImageBufferAllocator::SetGlobalDefaultAllocator(ImageBufferAllocator * allocator)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_GlobalDefaultAllocator = allocator;
+}
+
+ImageBufferAllocator::Pointer
+ImageBufferAllocator::GetGlobalDefaultAllocator()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_GlobalDefaultAllocator;
+}
+
+void
+ImageBufferAllocator::SetAlignment(SizeValueType alignment)
+{
+  if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+  {
+    itkExceptionMacro("Alignment must be a power of two, got " << alignment);
+  }
+  alignment = std::max(alignment, static_cast<SizeValueType>(alignof(std::max_align_t)));
+  if (m_Alignment != alignment)
+  {
+    m_Alignment = alignment;
+    this->Modified();
+  }
+}
+
+void *
+ImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  return this->AllocateAligned(numberOfBytes);
+}
+
+void
+ImageBufferAllocator::Deallocate(void * buffer, SizeValueType itkNotUsed(numberOfBytes))
+{
+  DeallocateAligned(buffer);
+}
+
+void *
+ImageBufferAllocator::AllocateAligned(SizeValueType numberOfBytes) const
+{
+  const bool useHugePages = m_UseHugePages && numberOfBytes >= HugePageSize;
+  const auto alignment = static_cast<size_t>(useHugePages ? std::max(m_Alignment, HugePageSize) : m_Alignment);
+  // Allocating zero bytes must still return a unique pointer
+  const auto size = static_cast<size_t>(std::max(numberOfBytes, SizeValueType{ 1 }));
+
+  void * buffer = nullptr;
+#if defined(_WIN32)
+  buffer = _aligned_malloc(size, alignment);
+#else
+  if (posix_memalign(&buffer, alignment, size) != 0)
+  {
+    buffer = nullptr;
+  }
+#endif
+  if (buffer == nullptr)
+  {
+    // We cannot construct an error string here because we may be out
+    // of memory.  Do not use the exception macro.
+    throw MemoryAllocationError(__FILE__, __LINE__, "Failed to allocate memory for image.", ITK_LOCATION);
+  }
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (useHugePages)
+  {
+    // Only a hint: failure leaves the block backed by regular pages
+    madvise(buffer, size, MADV_HUGEPAGE);
+  }
+#endif
+  return buffer;
+}
+
+void
+ImageBufferAllocator::DeallocateAligned(void * buffer)
+{
+#if defined(_WIN32)
+  _aligned_free(buffer);
+#else
+  free(buffer);
+#endif
+}
+
+void
+ImageBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Alignment: " << m_Alignment << std::endl;
+  os << indent << "UseHugePages: " << (m_UseHugePages ? "On" : "Off") << std::endl;
+}
+} // end namespace itk
@@ -30,6 +30,7 @@
 
 #if defined(ITK_USE_POOL_MULTI_THREADER)
 #  include "itkPoolMultiThreader.h"
+#  include "itkWorkStealingMultiThreader.h"
 #endif
 #include "itkNumericTraits.h"
 #include <mutex>
@@ -39,6 +40,7 @@
 #include "itkImageSourceCommon.h"
 #include "itkSingleton.h"
 #include "itkProcessObject.h"
+#include "itkProcessObjectProfiler.h"
 #include <iostream>
 #include <string>
 #include <algorithm>
@@ -203,6 +205,10 @@ MultiThreaderBase::ThreaderTypeFromString(std::string threaderString)
   {
     return ThreaderEnum::TBB;
   }
+  else if (threaderString == "WORKSTEALING")
+  {
+    return ThreaderEnum::WorkStealing;
+  }
   else
   {
     return ThreaderEnum::Unknown;
@@ -425,6 +431,12 @@ MultiThreaderBase::New()
         return TBBMultiThreader::New();
 #else
         itkGenericExceptionMacro("ITK has been built without TBB support!");
+#endif
+      case ThreaderEnum::WorkStealing:
+#if defined(ITK_USE_POOL_MULTI_THREADER)
+        return WorkStealingMultiThreader::New();
+#else
+        itkGenericExceptionMacro("ITK has been built without WorkStealingMultiThreader support!");
 #endif
       default:
         itkGenericExceptionMacro("MultiThreaderBase::GetGlobalDefaultThreader returned Unknown!");
@@ -561,6 +573,31 @@ MultiThreaderBase::ParallelizeImageRegion(unsigned int
   this->SingleMethodExecute();
 }
 
+MultiThreaderBase::ThreadingFunctorType
+MultiThreaderBase::ProfileWorkUnits(ThreadingFunctorType funcP,
+                                    unsigned int         dimension,
+                                    ProcessObject *      filter,
+                                    SizeValueType        numberOfPixelsPerIndex)
+{
+  if (filter == nullptr || filter->GetActiveProfiler() == nullptr)
+  {
+    return funcP;
+  }
+  ProcessObjectProfiler::Pointer profiler = filter->GetActiveProfiler();
+  return [funcP, dimension, filter, numberOfPixelsPerIndex, profiler](const IndexValueType index[],
+                                                                       const SizeValueType  size[]) {
+    const ProcessObjectProfiler::TimeType start = profiler->GetTime();
+    funcP(index, size);
+
+    SizeValueType numberOfPixels = numberOfPixelsPerIndex;
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      numberOfPixels *= size[d];
+    }
+    profiler->RecordWorkUnit(filter, start, numberOfPixels);
+  };
+}
+
 ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
 MultiThreaderBase::ParallelizeImageRegionHelper(void * arg)
 {
@@ -622,6 +659,8 @@ operator<<(std::ostream & out, const MultiThreaderBaseEnums::Threader value)
         return "itk::MultiThreaderBaseEnums::Threader::Pool";
       case MultiThreaderBaseEnums::Threader::TBB:
         return "itk::MultiThreaderBaseEnums::Threader::TBB";
+      case MultiThreaderBaseEnums::Threader::WorkStealing:
+        return "itk::MultiThreaderBaseEnums::Threader::WorkStealing";
         //      TODO    case MultiThreaderBaseEnums::Threader::Last:
         //                    return "itk::MultiThreaderBaseEnums::Threader::Last";
       case MultiThreaderBaseEnums::Threader::Unknown:
@@ -0,0 +1,258 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPipelineMemoryPlanner.h"
+#include "itkCommand.h"
+#include "itkPooledImageBufferAllocator.h"
+#include "itkProcessObject.h"
+
+#include <algorithm>
+#include <mutex>
+
+namespace itk
+{
+
+namespace
+{
+// Pooled allocator measuring the memory held for the image buffers
+class MeasuringImageBufferAllocator : public PooledImageBufferAllocator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(MeasuringImageBufferAllocator);
+
+  using Self = MeasuringImageBufferAllocator;
+  using Superclass = PooledImageBufferAllocator;
+  using Pointer = SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(MeasuringImageBufferAllocator, PooledImageBufferAllocator);
+
+  void *
+  Allocate(SizeValueType numberOfBytes) override
+  {
+    void * buffer = Superclass::Allocate(numberOfBytes);
+
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_NumberOfBytesInUse += numberOfBytes;
+    m_NumberOfBytesAllocated += numberOfBytes;
+    // the pooled blocks are still held
+    m_PeakNumberOfBytes = std::max(m_PeakNumberOfBytes, m_NumberOfBytesInUse + this->GetPoolSizeInBytes());
+    return buffer;
+  }
+
+  void
+  Deallocate(void * buffer, SizeValueType numberOfBytes) override
+  {
+    Superclass::Deallocate(buffer, numberOfBytes);
+
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_NumberOfBytesInUse -= numberOfBytes;
+  }
+
+  SizeValueType
+  GetPeakNumberOfBytes() const
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_PeakNumberOfBytes;
+  }
+
+  SizeValueType
+  GetNumberOfBytesAllocated() const
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_NumberOfBytesAllocated;
+  }
+
+protected:
+  MeasuringImageBufferAllocator() = default;
+  ~MeasuringImageBufferAllocator() override = default;
+
+private:
+  mutable std::mutex m_Mutex;
+  SizeValueType      m_NumberOfBytesInUse{ 0 };
+  SizeValueType      m_NumberOfBytesAllocated{ 0 };
+  SizeValueType      m_PeakNumberOfBytes{ 0 };
+};
+} // namespace
+
+void
+PipelineMemoryPlanner::Plan()
+{
+  m_ProcessObjects.clear();
+  m_Usages.clear();
+  if (m_Output == nullptr)
+  {
+    return;
+  }
+
+  // Walk the graph upstream from the output, depth first
+  std::set<const ProcessObject *> visited;
+  std::vector<DataObject *>       dataObjects{ m_Output.GetPointer() };
+  while (!dataObjects.empty())
+  {
+    DataObject * const dataObject = dataObjects.back();
+    dataObjects.pop_back();
+
+    ProcessObject * const source = dataObject->GetSource().GetPointer();
+    if (source == nullptr || !visited.insert(source).second)
+    {
+      continue;
+    }
+    m_ProcessObjects.push_back(source);
+
+    for (const auto & input : source->GetInputs())
+    {
+      if (input == nullptr)
+      {
+        continue;
+      }
+      // the data objects without source cannot be generated again
+      if (input != m_Output && input->GetSource() != nullptr)
+      {
+        m_Usages[input.GetPointer()].Consumers.insert(source);
+      }
+      dataObjects.push_back(input.GetPointer());
+    }
+  }
+}
+
+void
+PipelineMemoryPlanner::Update()
+{
+  if (m_Output == nullptr)
+  {
+    itkExceptionMacro("Output is not set");
+  }
+
+  this->Plan();
+
+  const ImageBufferAllocator::Pointer previousAllocator = ImageBufferAllocator::GetGlobalDefaultAllocator();
+  const auto                          allocator = MeasuringImageBufferAllocator::New();
+  if (previousAllocator != nullptr)
+  {
+    allocator->SetAlignment(previousAllocator->GetAlignment());
+    allocator->SetUseHugePages(previousAllocator->GetUseHugePages());
+  }
+  if (!m_ReuseBuffers)
+  {
+    allocator->SetMaximumPoolSizeInBytes(0);
+  }
+
+  const auto command = MemberCommand<Self>::New();
+  command->SetCallbackFunction(this, &Self::ProcessObjectFinished);
+  std::vector<unsigned long> tags;
+  tags.reserve(m_ProcessObjects.size());
+  for (ProcessObject * const processObject : m_ProcessObjects)
+  {
+    tags.push_back(processObject->AddObserver(EndEvent(), command));
+  }
+
+  const auto restore = [&]() {
+    for (size_t i = 0; i < tags.size(); ++i)
+    {
+      m_ProcessObjects[i]->RemoveObserver(tags[i]);
+    }
+    ImageBufferAllocator::SetGlobalDefaultAllocator(previousAllocator);
+
+    // The buffers which are still in use are freed when released
+    allocator->SetMaximumPoolSizeInBytes(0);
+    allocator->ReleasePool();
+  };
+
+  m_NumberOfReleasedDataObjects = 0;
+  ImageBufferAllocator::SetGlobalDefaultAllocator(allocator);
+  try
+  {
+    m_Output->Update();
+  }
+  catch (...)
+  {
+    restore();
+    throw;
+  }
+  restore();
+
+  m_PeakMemoryInBytes = allocator->GetPeakNumberOfBytes();
+  m_UnplannedPeakMemoryInBytes = allocator->GetNumberOfBytesAllocated();
+  m_NumberOfReusedBuffers = allocator->GetNumberOfReusedBlocks();
+}
+
+void
+PipelineMemoryPlanner::ProcessObjectFinished(Object * caller, const EventObject &)
+{
+  auto * const processObject = static_cast<ProcessObject *>(caller);
+
+  // The outputs were just generated, for all their consumers
+  for (const auto & output : processObject->GetOutputs())
+  {
+    const auto it = m_Usages.find(output.GetPointer());
+    if (it != m_Usages.end())
+    {
+      it->second.FinishedConsumers.clear();
+    }
+  }
+
+  for (const auto & input : processObject->GetInputs())
+  {
+    const auto it = m_Usages.find(input.GetPointer());
+    if (it == m_Usages.end())
+    {
+      continue;
+    }
+    DataObjectUsage & usage = it->second;
+    usage.FinishedConsumers.insert(processObject);
+    if (usage.FinishedConsumers.size() == usage.Consumers.size())
+    {
+      input->ReleaseData();
+      usage.FinishedConsumers.clear();
+      ++m_NumberOfReleasedDataObjects;
+    }
+  }
+}
+
+SizeValueType
+PipelineMemoryPlanner::GetNumberOfConsumers(const DataObject * dataObject) const
+{
+  const auto it = m_Usages.find(dataObject);
+  return it != m_Usages.end() ? static_cast<SizeValueType>(it->second.Consumers.size()) : 0;
+}
+
+void
+PipelineMemoryPlanner::Report(std::ostream & os) const
+{
+  os << "Process objects: " << m_ProcessObjects.size() << std::endl;
+  os << "Intermediate data objects: " << m_Usages.size() << std::endl;
+  os << "Released data objects: " << m_NumberOfReleasedDataObjects << std::endl;
+  os << "Reused buffers: " << m_NumberOfReusedBuffers << std::endl;
+  os << "Peak memory without planning (bytes): " << m_UnplannedPeakMemoryInBytes << std::endl;
+  os << "Peak memory with planning (bytes): " << m_PeakMemoryInBytes << std::endl;
+}
+
+void
+PipelineMemoryPlanner::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(Output);
+  os << indent << "ReuseBuffers: " << (m_ReuseBuffers ? "On" : "Off") << std::endl;
+  os << indent << "NumberOfProcessObjects: " << m_ProcessObjects.size() << std::endl;
+  os << indent << "PeakMemoryInBytes: " << m_PeakMemoryInBytes << std::endl;
+  os << indent << "UnplannedPeakMemoryInBytes: " << m_UnplannedPeakMemoryInBytes << std::endl;
+  os << indent << "NumberOfReleasedDataObjects: " << m_NumberOfReleasedDataObjects << std::endl;
+  os << indent << "NumberOfReusedBuffers: " << m_NumberOfReusedBuffers << std::endl;
+}
+} // end namespace itk
@@ -0,0 +1,113 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkPooledImageBufferAllocator.h"
+
+namespace itk
+{
+
+PooledImageBufferAllocator::~PooledImageBufferAllocator()
+{
+  this->ReleasePool();
+}
+
+void *
+PooledImageBufferAllocator::Allocate(SizeValueType numberOfBytes)
+{
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    auto                              it = m_Pool.find(numberOfBytes);
+    if (it != m_Pool.end() && !it->second.empty())
+    {
+      void * buffer = it->second.back();
+      it->second.pop_back();
+      m_PoolSizeInBytes -= numberOfBytes;
+      ++m_NumberOfReusedBlocks;
+      return buffer;
+    }
+    ++m_NumberOfAllocatedBlocks;
+  }
+  return this->AllocateAligned(numberOfBytes);
+}
+
+void
+PooledImageBufferAllocator::Deallocate(void * buffer, SizeValueType numberOfBytes)
+{
+  if (buffer == nullptr)
+  {
+    return;
+  }
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    if (numberOfBytes <= m_MaximumPoolSizeInBytes - m_PoolSizeInBytes)
+    {
+      m_Pool[numberOfBytes].push_back(buffer);
+      m_PoolSizeInBytes += numberOfBytes;
+      return;
+    }
+  }
+  DeallocateAligned(buffer);
+}
+
+void
+PooledImageBufferAllocator::ReleasePool()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto & sizeAndBlocks : m_Pool)
+  {
+    for (void * buffer : sizeAndBlocks.second)
+    {
+      DeallocateAligned(buffer);
+    }
+  }
+  m_Pool.clear();
+  m_PoolSizeInBytes = 0;
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetPoolSizeInBytes() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_PoolSizeInBytes;
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetNumberOfReusedBlocks() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfReusedBlocks;
+}
+
+SizeValueType
+PooledImageBufferAllocator::GetNumberOfAllocatedBlocks() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfAllocatedBlocks;
+}
+
+void
+PooledImageBufferAllocator::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  os << indent << "MaximumPoolSizeInBytes: " << m_MaximumPoolSizeInBytes << std::endl;
+  os << indent << "PoolSizeInBytes: " << m_PoolSizeInBytes << std::endl;
+  os << indent << "NumberOfReusedBlocks: " << m_NumberOfReusedBlocks << std::endl;
+  os << indent << "NumberOfAllocatedBlocks: " << m_NumberOfAllocatedBlocks << std::endl;
+}
+} // end namespace itk
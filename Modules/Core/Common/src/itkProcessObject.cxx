@@ -32,6 +32,7 @@
 #include <sstream>
 #include <algorithm>
 #include "itkMultiThreaderBase.h"
+#include "itkProcessObjectProfiler.h"
 
 namespace itk
 {
@@ -1275,6 +1276,7 @@ ProcessObject::PrintSelf(std::ostream & os, Indent indent) const
   os << indent << "Progress: " << progressFixedToFloat(m_Progress) << std::endl;
   os << indent << "Multithreader: " << std::endl;
   m_MultiThreader->PrintSelf(os, indent.GetNextIndent());
+  itkPrintSelfObjectMacro(Profiler);
 }
 
 
@@ -1475,7 +1477,17 @@ ProcessObject::UpdateOutputInformation()
     /**
      * Finally, generate the output information.
      */
+    const ProcessObjectProfiler::Pointer profiler =
+      m_Profiler ? m_Profiler : ProcessObjectProfiler::GetGlobalProfiler();
+    if (profiler)
+    {
+      profiler->BeginGenerateOutputInformation(this);
+    }
     this->GenerateOutputInformation();
+    if (profiler)
+    {
+      profiler->EndGenerateOutputInformation(this);
+    }
 
     /**
      * Keep track of the last time GenerateOutputInformation() was called
@@ -1604,6 +1616,17 @@ ProcessObject::SetMultiThreader(MultiThreaderType * threader)
 }
 
 
+void
+ProcessObject::SetProfiler(ProcessObjectProfiler * profiler)
+{
+  if (this->m_Profiler != profiler)
+  {
+    this->m_Profiler = profiler;
+    this->Modified();
+  }
+}
+
+
 void
 ProcessObject::PrepareOutputs()
 {
@@ -1703,12 +1726,22 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
   m_AbortGenerateData = false;
   m_Progress = 0u;
 
+  /**
+   * Profile this execution, if requested.
+   */
+  m_ActiveProfiler = m_Profiler ? m_Profiler : ProcessObjectProfiler::GetGlobalProfiler();
+  if (m_ActiveProfiler)
+  {
+    m_ActiveProfiler->BeginGenerateData(this);
+  }
+
   try
   {
     this->GenerateData();
   }
   catch (ProcessAborted &)
   {
+    m_ActiveProfiler = nullptr;
     this->InvokeEvent(AbortEvent());
     this->ResetPipeline();
     this->RestoreInputReleaseDataFlags();
@@ -1716,11 +1749,18 @@ ProcessObject::UpdateOutputData(DataObject * itkNotUsed(output))
   }
   catch (...)
   {
+    m_ActiveProfiler = nullptr;
     this->ResetPipeline();
     this->RestoreInputReleaseDataFlags();
     throw;
   }
 
+  if (m_ActiveProfiler)
+  {
+    m_ActiveProfiler->EndGenerateData(this);
+    m_ActiveProfiler = nullptr;
+  }
+
   /**
    * If we ended due to aborting, push the progress up to 1.0 (since
    * it probably didn't end there)
@@ -0,0 +1,309 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkProcessObjectProfiler.h"
+#include "itkProcessObject.h"
+#include "itkSingleton.h"
+#include "itkTimeProbesCollectorBase.h"
+#include "itkMemoryProbesCollectorBase.h"
+
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+
+namespace itk
+{
+
+namespace
+{
+// Write a string as a JSON string literal
+void
+WriteJSONString(std::ostream & os, const std::string & value)
+{
+  os << '"';
+  for (const char c : value)
+  {
+    switch (c)
+    {
+      case '"':
+        os << "\\\"";
+        break;
+      case '\\':
+        os << "\\\\";
+        break;
+      case '\n':
+        os << "\\n";
+        break;
+      case '\t':
+        os << "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20)
+        {
+          os << ' ';
+        }
+        else
+        {
+          os << c;
+        }
+    }
+  }
+  os << '"';
+}
+} // namespace
+
+struct ProcessObjectProfilerGlobals
+{
+  std::mutex                     m_Mutex;
+  ProcessObjectProfiler::Pointer m_GlobalProfiler{ nullptr };
+};
+
+itkGetGlobalSimpleMacro(ProcessObjectProfiler, ProcessObjectProfilerGlobals, PimplGlobals);
+
+ProcessObjectProfilerGlobals * ProcessObjectProfiler::m_PimplGlobals;
+
+void
+ProcessObjectProfiler::SetGlobalProfiler(ProcessObjectProfiler * profiler)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  m_PimplGlobals->m_GlobalProfiler = profiler;
+}
+
+ProcessObjectProfiler::Pointer
+ProcessObjectProfiler::GetGlobalProfiler()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  const std::lock_guard<std::mutex> lock(m_PimplGlobals->m_Mutex);
+  return m_PimplGlobals->m_GlobalProfiler;
+}
+
+ProcessObjectProfiler::ProcessObjectProfiler()
+  : m_Origin(std::chrono::steady_clock::now())
+  , m_GenerateOutputInformationTimes(new TimeProbesCollectorBase)
+  , m_GenerateDataTimes(new TimeProbesCollectorBase)
+  , m_GenerateDataMemory(new MemoryProbesCollectorBase)
+{}
+
+ProcessObjectProfiler::~ProcessObjectProfiler() = default;
+
+std::string
+ProcessObjectProfiler::GetProcessObjectLabel(const ProcessObject * processObject)
+{
+  if (!processObject->GetObjectName().empty())
+  {
+    return processObject->GetObjectName();
+  }
+  std::ostringstream label;
+  label << processObject->GetNameOfClass() << " (" << static_cast<const void *>(processObject) << ')';
+  return label.str();
+}
+
+unsigned int
+ProcessObjectProfiler::GetThreadNumber()
+{
+  const auto inserted =
+    m_ThreadNumbers.insert(std::make_pair(std::this_thread::get_id(), static_cast<unsigned int>(m_ThreadNumbers.size())));
+  return inserted.first->second;
+}
+
+void
+ProcessObjectProfiler::BeginGenerateOutputInformation(const ProcessObject * processObject)
+{
+  const std::string                 label = GetProcessObjectLabel(processObject);
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_GenerateOutputInformationTimes->Start(label.c_str());
+  m_GenerateOutputInformationStarts[processObject] = this->GetTime();
+}
+
+void
+ProcessObjectProfiler::EndGenerateOutputInformation(const ProcessObject * processObject)
+{
+  const TimeType                    end = this->GetTime();
+  const std::string                 label = GetProcessObjectLabel(processObject);
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  const auto                        it = m_GenerateOutputInformationStarts.find(processObject);
+  if (it == m_GenerateOutputInformationStarts.end())
+  {
+    return;
+  }
+  m_GenerateOutputInformationTimes->Stop(label.c_str());
+
+  const TimeType start = it->second;
+  m_GenerateOutputInformationStarts.erase(it);
+  m_Events.push_back(Event{ label, "GenerateOutputInformation", start, end - start, this->GetThreadNumber(), 0, 0, 0 });
+}
+
+void
+ProcessObjectProfiler::BeginGenerateData(const ProcessObject * processObject)
+{
+  const std::string                 label = GetProcessObjectLabel(processObject);
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_GenerateDataTimes->Start(label.c_str());
+  m_GenerateDataMemory->Start(label.c_str());
+  m_GenerateDataStarts[processObject] = this->GetTime();
+}
+
+void
+ProcessObjectProfiler::EndGenerateData(const ProcessObject * processObject)
+{
+  const TimeType                    end = this->GetTime();
+  const std::string                 label = GetProcessObjectLabel(processObject);
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  const auto                        it = m_GenerateDataStarts.find(processObject);
+  if (it == m_GenerateDataStarts.end())
+  {
+    return;
+  }
+  m_GenerateDataTimes->Stop(label.c_str());
+
+  // The memory probe accumulates the change of each execution
+  const MemoryProbe &   memoryProbe = m_GenerateDataMemory->GetProbe(label.c_str());
+  const OffsetValueType memoryBefore = memoryProbe.GetTotal();
+  m_GenerateDataMemory->Stop(label.c_str());
+  const OffsetValueType memoryChange = memoryProbe.GetTotal() - memoryBefore;
+
+  const TimeType      start = it->second;
+  const SizeValueType execution = m_GenerateDataTimes->GetProbe(label.c_str()).GetNumberOfStops();
+  m_GenerateDataStarts.erase(it);
+  m_Events.push_back(
+    Event{ label, "GenerateData", start, end - start, this->GetThreadNumber(), execution, 0, memoryChange });
+}
+
+void
+ProcessObjectProfiler::RecordWorkUnit(const ProcessObject * processObject,
+                                      TimeType              startTime,
+                                      SizeValueType         numberOfPixels)
+{
+  const TimeType                    end = this->GetTime();
+  const TimeType                    duration = end - startTime;
+  const std::string                 label = GetProcessObjectLabel(processObject);
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  WorkUnitStatistics & statistics = m_WorkUnitStatistics[label];
+  statistics.Minimum = (statistics.Count == 0) ? duration : std::min(statistics.Minimum, duration);
+  statistics.Maximum = std::max(statistics.Maximum, duration);
+  statistics.Total += duration;
+  ++statistics.Count;
+
+  // Work units belong to the current execution of GenerateData
+  const SizeValueType execution = (m_GenerateDataStarts.count(processObject) > 0)
+                                    ? m_GenerateDataTimes->GetProbe(label.c_str()).GetNumberOfStarts()
+                                    : 0;
+  m_Events.push_back(
+    Event{ label, "WorkUnit", startTime, duration, this->GetThreadNumber(), execution, numberOfPixels, 0 });
+}
+
+ProcessObjectProfiler::EventContainerType
+ProcessObjectProfiler::GetEvents() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Events;
+}
+
+void
+ProcessObjectProfiler::Report(std::ostream & os)
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  os << "GenerateOutputInformation" << std::endl;
+  m_GenerateOutputInformationTimes->Report(os, true, true);
+  os << std::endl << "GenerateData (the number of iterations is the number of streamed pieces)" << std::endl;
+  m_GenerateDataTimes->Report(os, false, true);
+  os << std::endl << "GenerateData memory change" << std::endl;
+  m_GenerateDataMemory->Report(os, false, true);
+
+  if (!m_WorkUnitStatistics.empty())
+  {
+    // The ratio of the longest to the mean work unit measures the imbalance
+    os << std::endl << "Work units (us)" << std::endl;
+    os << "Name\tCount\tTotal\tMinimum\tMean\tMaximum\tMaximum/Mean" << std::endl;
+    for (const auto & labelAndStatistics : m_WorkUnitStatistics)
+    {
+      const WorkUnitStatistics & statistics = labelAndStatistics.second;
+      const TimeType             mean = statistics.Total / statistics.Count;
+      os << labelAndStatistics.first << '\t' << statistics.Count << '\t' << statistics.Total << '\t'
+         << statistics.Minimum << '\t' << mean << '\t' << statistics.Maximum << '\t'
+         << (mean > 0 ? statistics.Maximum / mean : 1.0) << std::endl;
+    }
+  }
+}
+
+void
+ProcessObjectProfiler::WriteChromeTrace(std::ostream & os) const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+
+  os << "{\"traceEvents\":[";
+  bool first = true;
+  for (const Event & event : m_Events)
+  {
+    os << (first ? "\n" : ",\n") << "{\"name\":";
+    WriteJSONString(os, event.Name);
+    os << ",\"cat\":";
+    WriteJSONString(os, event.Category);
+    os << ",\"ph\":\"X\",\"ts\":" << event.Start << ",\"dur\":" << event.Duration << ",\"pid\":0,\"tid\":" << event.Thread
+       << ",\"args\":{\"execution\":" << event.Execution;
+    if (event.Category == "WorkUnit")
+    {
+      os << ",\"pixels\":" << event.NumberOfPixels;
+    }
+    else if (event.Category == "GenerateData")
+    {
+      os << ",\"memory_kB\":" << event.MemoryChange;
+    }
+    os << "}}";
+    first = false;
+  }
+  os << "\n],\"displayTimeUnit\":\"ms\"}" << std::endl;
+}
+
+void
+ProcessObjectProfiler::WriteChromeTrace(const std::string & fileName) const
+{
+  std::ofstream file(fileName.c_str());
+  if (!file)
+  {
+    itkExceptionMacro("Cannot open " << fileName << " for writing");
+  }
+  this->WriteChromeTrace(file);
+}
+
+void
+ProcessObjectProfiler::Clear()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Events.clear();
+  m_ThreadNumbers.clear();
+  m_WorkUnitStatistics.clear();
+  m_GenerateOutputInformationStarts.clear();
+  m_GenerateDataStarts.clear();
+  m_GenerateOutputInformationTimes->Clear();
+  m_GenerateDataTimes->Clear();
+  m_GenerateDataMemory->Clear();
+}
+
+void
+ProcessObjectProfiler::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  os << indent << "NumberOfEvents: " << m_Events.size() << std::endl;
+  os << indent << "NumberOfThreads: " << m_ThreadNumbers.size() << std::endl;
+}
+} // end namespace itk
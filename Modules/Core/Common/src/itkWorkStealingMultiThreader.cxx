@@ -0,0 +1,288 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkStealingMultiThreader.h"
+#include "itkImageIORegion.h"
+#include "itkProcessObject.h"
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
+#include <exception>
+
+namespace itk
+{
+namespace
+{
+using TaskGroup = WorkStealingThreadPool::TaskGroup;
+
+// Call function, then wait for the tasks it added to the group. The tasks
+// refer to the stack of the caller, so they are waited for even if function
+// throws. The first exception caught is rethrown.
+template <typename TFunction>
+void
+ExecuteAndWait(WorkStealingThreadPool * pool, TaskGroup & group, const TFunction & function)
+{
+  std::exception_ptr exception;
+  try
+  {
+    function();
+  }
+  catch (...)
+  {
+    exception = std::current_exception();
+  }
+  try
+  {
+    pool->Wait(group);
+  }
+  catch (...)
+  {
+    if (exception == nullptr)
+    {
+      exception = std::current_exception();
+    }
+  }
+  if (exception != nullptr)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+// Hand over the upper half of [first, last) to the pool until it is no
+// longer than grainSize, then call function on what remains.
+template <typename TFunction>
+void
+ProcessRange(WorkStealingThreadPool * pool,
+             TaskGroup &              group,
+             SizeValueType            first,
+             SizeValueType            last,
+             SizeValueType            grainSize,
+             const TFunction &        function)
+{
+  while (last - first > grainSize)
+  {
+    const SizeValueType middle = first + (last - first) / 2;
+    pool->AddTask(group,
+                  [pool, &group, middle, last, grainSize, &function] {
+                    ProcessRange(pool, group, middle, last, grainSize, function);
+                  });
+    last = middle;
+  }
+  function(first, last);
+}
+
+// Split the region in halves along its highest dimension of size larger
+// than one, region keeping the lower half. Returns false for a single pixel.
+bool
+SplitInHalves(ImageIORegion & region, ImageIORegion & upperHalf)
+{
+  for (int d = int(region.GetImageDimension()) - 1; d >= 0; d--) // prefer to split along highest dimension
+  {
+    const SizeValueType size = region.GetSize(d);
+    if (size > 1)
+    {
+      upperHalf = region;
+      region.SetSize(d, size / 2);
+      upperHalf.SetSize(d, size - size / 2);
+      upperHalf.SetIndex(d, region.GetIndex(d) + static_cast<IndexValueType>(size / 2));
+      return true;
+    }
+  }
+  return false;
+}
+
+// Same as ProcessRange, for image regions
+template <typename TFunction>
+void
+ProcessImageRegion(WorkStealingThreadPool * pool,
+                   TaskGroup &              group,
+                   ImageIORegion            region,
+                   SizeValueType            grainSize,
+                   const TFunction &        function)
+{
+  ImageIORegion upperHalf;
+  while (region.GetNumberOfPixels() > grainSize && SplitInHalves(region, upperHalf))
+  {
+    pool->AddTask(group, [pool, &group, upperHalf, grainSize, &function] {
+      ProcessImageRegion(pool, group, upperHalf, grainSize, function);
+    });
+  }
+  function(region);
+}
+} // namespace
+
+
+WorkStealingMultiThreader::WorkStealingMultiThreader()
+  : m_ThreadPool(WorkStealingThreadPool::GetInstance())
+{
+  ThreadIdType defaultThreads = std::max(1u, GetGlobalDefaultNumberOfThreads());
+#if defined(ITKV4_COMPATIBILITY)
+  m_NumberOfWorkUnits = defaultThreads;
+#else
+  if (defaultThreads > 1) // one work unit for only one thread
+  {
+    // Enough pieces for idle threads to steal from busy ones
+    m_NumberOfWorkUnits = 16 * defaultThreads;
+  }
+#endif
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+WorkStealingMultiThreader::~WorkStealingMultiThreader() = default;
+
+void
+WorkStealingMultiThreader::SetSingleMethod(ThreadFunctionType f, void * data)
+{
+  m_SingleMethod = f;
+  m_SingleData = data;
+}
+
+void
+WorkStealingMultiThreader::SetMaximumNumberOfThreads(ThreadIdType numberOfThreads)
+{
+  Superclass::SetMaximumNumberOfThreads(numberOfThreads);
+  ThreadIdType threadCount = m_ThreadPool->GetMaximumNumberOfThreads();
+  if (threadCount < m_MaximumNumberOfThreads)
+  {
+    m_ThreadPool->AddThreads(m_MaximumNumberOfThreads - threadCount);
+  }
+  m_MaximumNumberOfThreads = m_ThreadPool->GetMaximumNumberOfThreads();
+}
+
+void
+WorkStealingMultiThreader::SetNumberOfWorkUnits(ThreadIdType numberOfWorkUnits)
+{
+  m_NumberOfWorkUnits = std::max(1u, numberOfWorkUnits);
+}
+
+void
+WorkStealingMultiThreader::SingleMethodExecute()
+{
+  if (!m_SingleMethod)
+  {
+    itkExceptionMacro(<< "No single method set!");
+  }
+
+  const auto workUnitFunction = [this](SizeValueType firstWorkUnit, SizeValueType lastWorkUnitPlus1) {
+    for (SizeValueType workUnit = firstWorkUnit; workUnit < lastWorkUnitPlus1; ++workUnit)
+    {
+      WorkUnitInfo ti;
+      ti.WorkUnitID = static_cast<ThreadIdType>(workUnit);
+      ti.UserData = m_SingleData;
+      ti.NumberOfWorkUnits = m_NumberOfWorkUnits;
+      m_SingleMethod(&ti);
+    }
+  };
+
+  // The calling thread executes work unit 0
+  TaskGroup group;
+  ExecuteAndWait(m_ThreadPool, group, [this, &group, &workUnitFunction] {
+    ProcessRange(m_ThreadPool.GetPointer(), group, 0, m_NumberOfWorkUnits, 1, workUnitFunction);
+  });
+}
+
+void
+WorkStealingMultiThreader::ParallelizeArray(SizeValueType             firstIndex,
+                                            SizeValueType             lastIndexPlus1,
+                                            ArrayThreadingFunctorType aFunc,
+                                            ProcessObject *           filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  ProgressReporter progressStartEnd(filter, 0, 1);
+
+  if (firstIndex + 1 < lastIndexPlus1)
+  {
+    const SizeValueType count = lastIndexPlus1 - firstIndex;
+    const SizeValueType grainSize = (count + m_NumberOfWorkUnits - 1) / m_NumberOfWorkUnits;
+
+    const auto rangeFunction = [&aFunc, filter, count](SizeValueType first, SizeValueType last) {
+      TotalProgressReporter progress(filter, count, 100);
+      progress.CheckAbortGenerateData();
+
+      for (SizeValueType ii = first; ii < last; ++ii)
+      {
+        aFunc(ii); // invoke the function
+      }
+
+      progress.Completed(last - first);
+    };
+
+    TaskGroup group;
+    ExecuteAndWait(m_ThreadPool, group, [this, &group, firstIndex, lastIndexPlus1, grainSize, &rangeFunction] {
+      ProcessRange(m_ThreadPool.GetPointer(), group, firstIndex, lastIndexPlus1, grainSize, rangeFunction);
+    });
+  }
+  else if (firstIndex + 1 == lastIndexPlus1)
+  {
+    aFunc(firstIndex);
+  }
+  // else nothing needs to be executed
+}
+
+void
+WorkStealingMultiThreader::ParallelizeImageRegion(unsigned int         dimension,
+                                                  const IndexValueType index[],
+                                                  const SizeValueType  size[],
+                                                  ThreadingFunctorType funcP,
+                                                  ProcessObject *      filter)
+{
+  if (!this->GetUpdateProgress())
+  {
+    filter = nullptr;
+  }
+  ProgressReporter progressStartEnd(filter, 0, 1);
+
+  if (m_NumberOfWorkUnits == 1) // no multi-threading wanted
+  {
+    funcP(index, size); // process whole region
+  }
+  else
+  {
+    ImageIORegion region(dimension);
+    for (unsigned d = 0; d < dimension; ++d)
+    {
+      region.SetIndex(d, index[d]);
+      region.SetSize(d, size[d]);
+    }
+    const SizeValueType totalCount = region.GetNumberOfPixels();
+    const SizeValueType grainSize = (totalCount + m_NumberOfWorkUnits - 1) / m_NumberOfWorkUnits;
+
+    const auto regionFunction = [&funcP, filter, totalCount](const ImageIORegion & regionToProcess) {
+      TotalProgressReporter progress(filter, totalCount, 100);
+      progress.CheckAbortGenerateData();
+
+      funcP(&regionToProcess.GetIndex()[0], &regionToProcess.GetSize()[0]);
+
+      progress.Completed(regionToProcess.GetNumberOfPixels());
+    };
+
+    TaskGroup group;
+    ExecuteAndWait(m_ThreadPool, group, [this, &group, &region, grainSize, &regionFunction] {
+      ProcessImageRegion(m_ThreadPool.GetPointer(), group, region, grainSize, regionFunction);
+    });
+  }
+}
+
+void
+WorkStealingMultiThreader::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+}
+
+} // namespace itk
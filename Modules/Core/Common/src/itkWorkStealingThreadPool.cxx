@@ -0,0 +1,326 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkWorkStealingThreadPool.h"
+#include "itkThreadPool.h"
+#include "itkThreadSupport.h"
+#include "itkMultiThreaderBase.h"
+#include "itkSingleton.h"
+
+#include <algorithm>
+#include <cassert>
+
+
+namespace itk
+{
+
+namespace
+{
+// Index of the queue of the calling thread: its own queue for a worker,
+// and the shared queue 0 for any other thread.
+ITK_THREAD_LOCAL ThreadIdType t_QueueIndex = 0;
+
+// Victims of the steal attempts of the calling thread are visited from a
+// varying starting point, to spread the thieves over the queues.
+ITK_THREAD_LOCAL ThreadIdType t_StealSeed = 0;
+} // namespace
+
+struct WorkStealingThreadPoolGlobals
+{
+  WorkStealingThreadPoolGlobals() = default;
+
+  // To allow singleton creation of WorkStealingThreadPool.
+  std::once_flag m_ThreadPoolOnceFlag;
+
+  // The singleton instance of WorkStealingThreadPool.
+  WorkStealingThreadPool::Pointer m_ThreadPoolInstance;
+};
+
+itkGetGlobalSimpleMacro(WorkStealingThreadPool, WorkStealingThreadPoolGlobals, PimplGlobals);
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::New()
+{
+  return Self::GetInstance();
+}
+
+
+WorkStealingThreadPool::Pointer
+WorkStealingThreadPool::GetInstance()
+{
+  // This is called once, on-demand to ensure that m_PimplGlobals is
+  // initialized.
+  itkInitGlobalsMacro(PimplGlobals);
+
+  // Create a singleton WorkStealingThreadPool.
+  std::call_once(m_PimplGlobals->m_ThreadPoolOnceFlag, []() {
+    m_PimplGlobals->m_ThreadPoolInstance = ObjectFactory<Self>::Create();
+    if (m_PimplGlobals->m_ThreadPoolInstance.IsNull())
+    {
+      new WorkStealingThreadPool(); // constructor sets m_PimplGlobals->m_ThreadPoolInstance
+    }
+#if defined(ITK_USE_PTHREADS)
+    pthread_atfork(WorkStealingThreadPool::PrepareForFork,
+                   WorkStealingThreadPool::ResumeFromFork,
+                   WorkStealingThreadPool::ResumeFromFork);
+#endif
+  });
+
+  return m_PimplGlobals->m_ThreadPoolInstance;
+}
+
+WorkStealingThreadPool::WorkStealingThreadPool()
+  : m_Queues(new TaskQueue[ITK_MAX_THREADS])
+{
+  m_PimplGlobals->m_ThreadPoolInstance = this;        // threads need this
+  m_PimplGlobals->m_ThreadPoolInstance->UnRegister(); // Remove extra reference
+
+  // The thread waiting for a task group is the last one
+  const ThreadIdType threadCount = MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  this->AddThreads(std::max<ThreadIdType>(threadCount, 1) - 1);
+}
+
+void
+WorkStealingThreadPool::AddThreads(ThreadIdType count)
+{
+  std::unique_lock<std::mutex> mutexHolder(m_Mutex);
+  ThreadIdType                 queueIndex = m_NumberOfQueues;
+  count = std::min<ThreadIdType>(count, ITK_MAX_THREADS - queueIndex);
+  m_Threads.reserve(m_Threads.size() + count);
+  for (ThreadIdType i = 0; i < count; ++i, ++queueIndex)
+  {
+    m_Threads.emplace_back(&WorkStealingThreadPool::ThreadExecute, this, queueIndex);
+  }
+  // Publish the new queues once their workers exist
+  m_NumberOfQueues = queueIndex;
+}
+
+ThreadIdType
+WorkStealingThreadPool::GetMaximumNumberOfThreads() const
+{
+  return m_NumberOfQueues;
+}
+
+bool
+WorkStealingThreadPool::IsWorkerThread()
+{
+  return t_QueueIndex != 0;
+}
+
+void
+WorkStealingThreadPool::AddTask(TaskGroup & group, TaskFunctionType task)
+{
+  ++group.m_NumberOfPendingTasks;
+  ++m_NumberOfQueuedTasks;
+  {
+    TaskQueue &                       queue = m_Queues[t_QueueIndex];
+    const std::lock_guard<std::mutex> lock(queue.m_Mutex);
+    queue.m_Tasks.push_back(Task{ &group, std::move(task) });
+  }
+  if (m_NumberOfSleepingThreads > 0)
+  {
+    // Acquiring the mutex ensures that a thread about to sleep either sees
+    // the new task, or already waits for the notification.
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+    }
+    m_Condition.notify_one();
+  }
+}
+
+void
+WorkStealingThreadPool::Wait(TaskGroup & group)
+{
+  while (group.m_NumberOfPendingTasks > 0)
+  {
+    if (this->ExecuteQueuedTask())
+    {
+      continue;
+    }
+
+    // All the remaining tasks of the group are being executed by other
+    // threads: sleep until one of them is done, or new work is available.
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    ++m_NumberOfSleepingThreads;
+    m_Condition.wait(lock, [this, &group] { return group.m_NumberOfPendingTasks == 0 || m_NumberOfQueuedTasks > 0; });
+    --m_NumberOfSleepingThreads;
+  }
+
+  std::exception_ptr exception;
+  {
+    const std::lock_guard<std::mutex> lock(group.m_ExceptionMutex);
+    std::swap(exception, group.m_FirstCaughtException);
+  }
+  if (exception != nullptr)
+  {
+    std::rethrow_exception(exception);
+  }
+}
+
+bool
+WorkStealingThreadPool::ExecuteQueuedTask()
+{
+  if (m_NumberOfQueuedTasks == 0)
+  {
+    return false;
+  }
+
+  Task task;
+  bool found = false;
+
+  // First the most recent task of our own queue
+  {
+    TaskQueue &                       queue = m_Queues[t_QueueIndex];
+    const std::lock_guard<std::mutex> lock(queue.m_Mutex);
+    if (!queue.m_Tasks.empty())
+    {
+      task = std::move(queue.m_Tasks.back());
+      queue.m_Tasks.pop_back();
+      found = true;
+    }
+  }
+
+  // Then the oldest task of another queue
+  const ThreadIdType numberOfQueues = m_NumberOfQueues;
+  const ThreadIdType start = t_StealSeed++;
+  for (ThreadIdType i = 0; !found && i < numberOfQueues; ++i)
+  {
+    const ThreadIdType victim = (start + i) % numberOfQueues;
+    if (victim == t_QueueIndex)
+    {
+      continue;
+    }
+    TaskQueue &                       queue = m_Queues[victim];
+    const std::lock_guard<std::mutex> lock(queue.m_Mutex);
+    if (!queue.m_Tasks.empty())
+    {
+      task = std::move(queue.m_Tasks.front());
+      queue.m_Tasks.pop_front();
+      found = true;
+    }
+  }
+
+  if (found)
+  {
+    --m_NumberOfQueuedTasks;
+    this->ExecuteTask(task);
+  }
+  return found;
+}
+
+void
+WorkStealingThreadPool::ExecuteTask(Task & task)
+{
+  TaskGroup & group = *task.m_Group;
+  try
+  {
+    task.m_Function();
+  }
+  catch (...)
+  {
+    const std::lock_guard<std::mutex> lock(group.m_ExceptionMutex);
+    if (group.m_FirstCaughtException == nullptr)
+    {
+      group.m_FirstCaughtException = std::current_exception();
+    }
+  }
+  // Release the resources of the task before the group is reported done
+  task.m_Function = nullptr;
+
+  // The group may be destroyed by its waiting thread as soon as its last
+  // task is reported done, so it must not be accessed afterwards.
+  if (--group.m_NumberOfPendingTasks == 0 && m_NumberOfSleepingThreads > 0)
+  {
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+    }
+    m_Condition.notify_all();
+  }
+}
+
+void
+WorkStealingThreadPool::ThreadExecute(ThreadIdType queueIndex)
+{
+  t_QueueIndex = queueIndex;
+  t_StealSeed = queueIndex;
+
+  while (true)
+  {
+    if (this->ExecuteQueuedTask())
+    {
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(m_Mutex);
+    ++m_NumberOfSleepingThreads;
+    m_Condition.wait(lock, [this] { return m_Stopping || m_NumberOfQueuedTasks > 0; });
+    --m_NumberOfSleepingThreads;
+    if (m_Stopping && m_NumberOfQueuedTasks == 0)
+    {
+      return;
+    }
+  }
+}
+
+void
+WorkStealingThreadPool::CleanUp()
+{
+  bool shouldNotify;
+  {
+    std::unique_lock<std::mutex> mutexHolder(m_Mutex);
+
+    this->m_Stopping = true;
+
+    // Same constraints on waiting for the threads as for ThreadPool
+    shouldNotify = !ThreadPool::GetDoNotWaitForThreads() && !m_Threads.empty();
+  }
+
+  if (shouldNotify)
+  {
+    m_Condition.notify_all();
+  }
+
+  // Even if the threads have already been terminated,
+  // we should join() the std::thread variables.
+  // Otherwise some sanity check in debug mode complains.
+  for (auto & thread : m_Threads)
+  {
+    assert(thread.joinable());
+    thread.join();
+  }
+}
+
+void
+WorkStealingThreadPool::PrepareForFork()
+{
+  m_PimplGlobals->m_ThreadPoolInstance->CleanUp();
+}
+
+void
+WorkStealingThreadPool::ResumeFromFork()
+{
+  WorkStealingThreadPool * instance = m_PimplGlobals->m_ThreadPoolInstance.GetPointer();
+  const auto               threadCount = static_cast<ThreadIdType>(instance->m_Threads.size());
+  instance->m_Threads.clear();
+  instance->m_NumberOfQueues = 1;
+  instance->m_Stopping = false;
+  instance->AddThreads(threadCount);
+}
+
+WorkStealingThreadPoolGlobals * WorkStealingThreadPool::m_PimplGlobals;
+
+} // namespace itk
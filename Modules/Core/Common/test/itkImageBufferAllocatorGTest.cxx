@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header files to be tested:
+#include "itkImageBufferAllocator.h"
+#include "itkPooledImageBufferAllocator.h"
+
+#include "itkImage.h"
+#include "itkVectorImage.h"
+#include <gtest/gtest.h>
+#include <cstdint>
+
+
+namespace
+{
+bool
+IsAligned(const void * buffer, itk::SizeValueType alignment)
+{
+  return reinterpret_cast<std::uintptr_t>(buffer) % alignment == 0;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(itk::SizeValueType sizeValue, itk::ImageBufferAllocator * allocator)
+{
+  auto image = TImage::New();
+  image->SetRegions(TImage::SizeType::Filled(sizeValue));
+  image->GetPixelContainer()->SetAllocator(allocator);
+  image->Allocate(true);
+  return image;
+}
+} // namespace
+
+
+TEST(ImageBufferAllocator, AllocatesAlignedBlocks)
+{
+  const auto allocator = itk::ImageBufferAllocator::New();
+  EXPECT_EQ(allocator->GetAlignment(), 64u);
+
+  for (const itk::SizeValueType alignment : { 64u, 128u, 4096u })
+  {
+    allocator->SetAlignment(alignment);
+    for (const itk::SizeValueType numberOfBytes : { 0u, 1u, 1000u, 1u << 20 })
+    {
+      void * const buffer = allocator->Allocate(numberOfBytes);
+      ASSERT_NE(buffer, nullptr);
+      EXPECT_TRUE(IsAligned(buffer, alignment));
+      allocator->Deallocate(buffer, numberOfBytes);
+    }
+  }
+  EXPECT_THROW(allocator->SetAlignment(48), itk::ExceptionObject);
+
+  allocator->UseHugePagesOn();
+  constexpr itk::SizeValueType numberOfBytes = 8u << 20;
+  void * const                 buffer = allocator->Allocate(numberOfBytes);
+  EXPECT_TRUE(IsAligned(buffer, 2u << 20));
+  allocator->Deallocate(buffer, numberOfBytes);
+}
+
+
+TEST(ImageBufferAllocator, ImageUsesContainerAllocator)
+{
+  const auto allocator = itk::ImageBufferAllocator::New();
+  allocator->SetAlignment(256);
+
+  const auto image = MakeImage<itk::Image<float, 3>>(17, allocator);
+  EXPECT_TRUE(IsAligned(image->GetBufferPointer(), 256));
+  EXPECT_EQ(image->GetPixel({ { 3, 4, 5 } }), 0.0f);
+
+  // Growing the buffer keeps the allocator, and the existing values
+  image->SetPixel({ { 1, 2, 3 } }, 42.0f);
+  image->GetPixelContainer()->Reserve(image->GetPixelContainer()->Size() * 2);
+  EXPECT_TRUE(IsAligned(image->GetBufferPointer(), 256));
+  EXPECT_EQ(image->GetPixel({ { 1, 2, 3 } }), 42.0f);
+
+  const auto vectorImage = itk::VectorImage<double, 2>::New();
+  vectorImage->SetRegions(itk::Size<2>::Filled(9));
+  vectorImage->SetVectorLength(3);
+  vectorImage->GetPixelContainer()->SetAllocator(allocator);
+  vectorImage->Allocate(true);
+  EXPECT_TRUE(IsAligned(vectorImage->GetBufferPointer(), 256));
+  EXPECT_EQ(vectorImage->GetPixelContainer()->Size(), 9u * 9u * 3u);
+}
+
+
+TEST(ImageBufferAllocator, GlobalDefaultAllocator)
+{
+  EXPECT_TRUE(itk::ImageBufferAllocator::GetGlobalDefaultAllocator().IsNull());
+
+  const auto allocator = itk::PooledImageBufferAllocator::New();
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(allocator);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAllocator().GetPointer(),
+            static_cast<itk::ImageBufferAllocator *>(allocator.GetPointer()));
+
+  MakeImage<itk::Image<short, 2>>(32, nullptr);
+  EXPECT_EQ(allocator->GetNumberOfAllocatedBlocks(), 1u);
+  EXPECT_EQ(allocator->GetPoolSizeInBytes(), 32u * 32u * sizeof(short));
+
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(nullptr);
+  EXPECT_TRUE(itk::ImageBufferAllocator::GetGlobalDefaultAllocator().IsNull());
+  MakeImage<itk::Image<short, 2>>(32, nullptr);
+  EXPECT_EQ(allocator->GetNumberOfAllocatedBlocks(), 1u);
+}
+
+
+TEST(PooledImageBufferAllocator, ReusesReleasedBlocks)
+{
+  const auto allocator = itk::PooledImageBufferAllocator::New();
+
+  void * const first = MakeImage<itk::Image<float, 2>>(64, allocator)->GetBufferPointer();
+  EXPECT_EQ(allocator->GetNumberOfAllocatedBlocks(), 1u);
+  EXPECT_EQ(allocator->GetPoolSizeInBytes(), 64u * 64u * sizeof(float));
+
+  // A buffer of the same size in bytes is recycled, and initialized again
+  const auto image = MakeImage<itk::Image<int, 2>>(64, allocator);
+  EXPECT_EQ(image->GetBufferPointer(), static_cast<int *>(first));
+  EXPECT_EQ(image->GetPixel({ { 10, 10 } }), 0);
+  EXPECT_EQ(allocator->GetNumberOfReusedBlocks(), 1u);
+  EXPECT_EQ(allocator->GetPoolSizeInBytes(), 0u);
+
+  // A buffer of another size is not
+  MakeImage<itk::Image<float, 2>>(32, allocator);
+  EXPECT_EQ(allocator->GetNumberOfAllocatedBlocks(), 2u);
+  EXPECT_EQ(allocator->GetPoolSizeInBytes(), 32u * 32u * sizeof(float));
+
+  allocator->ReleasePool();
+  EXPECT_EQ(allocator->GetPoolSizeInBytes(), 0u);
+
+  // Blocks exceeding the maximum pool size are freed
+  allocator->SetMaximumPoolSizeInBytes(1024);
+  MakeImage<itk::Image<float, 2>>(32, allocator);
+  EXPECT_EQ(allocator->GetPoolSizeInBytes(), 0u);
+  MakeImage<itk::Image<float, 2>>(16, allocator);
+  EXPECT_EQ(allocator->GetPoolSizeInBytes(), 1024u);
+}
+
+
+TEST(PooledImageBufferAllocator, OutlivedByItsBuffers)
+{
+  itk::Image<double, 2>::Pointer image;
+  {
+    const auto allocator = itk::PooledImageBufferAllocator::New();
+    image = MakeImage<itk::Image<double, 2>>(8, allocator);
+  }
+  // The image keeps the allocator alive until its buffer is released
+  image->FillBuffer(1.0);
+  image = nullptr;
+}
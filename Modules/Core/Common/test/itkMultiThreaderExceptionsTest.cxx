@@ -83,7 +83,7 @@ itkMultiThreaderExceptionsTest(int, char *[])
 
   using OutputImageType = itk::Image<OutputPixelType, Dimension>;
 
-  std::set<ThreaderEnum> threadersToTest = { ThreaderEnum::Platform, ThreaderEnum::Pool };
+  std::set<ThreaderEnum> threadersToTest = { ThreaderEnum::Platform, ThreaderEnum::Pool, ThreaderEnum::WorkStealing };
 #ifdef ITK_USE_TBB
   threadersToTest.insert(ThreaderEnum::TBB);
 #endif // ITK_USE_TBB
@@ -0,0 +1,224 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkPipelineMemoryPlanner.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageToImageFilter.h"
+#include "itkPooledImageBufferAllocator.h"
+
+#include <gtest/gtest.h>
+#include <cstdint>
+#include <sstream>
+
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+
+constexpr itk::SizeValueType bufferSizeInBytes = 64 * 32 * sizeof(float);
+
+// Fills its output with one
+class OnesSource : public itk::ImageSource<ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(OnesSource);
+
+  using Self = OnesSource;
+  using Superclass = itk::ImageSource<ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(OnesSource, ImageSource);
+
+protected:
+  OnesSource() = default;
+
+  void
+  GenerateOutputInformation() override
+  {
+    ImageType::RegionType region;
+    region.SetSize({ { 64, 32 } });
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & region) override
+  {
+    for (itk::ImageRegionIterator<ImageType> it(this->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(1.0f);
+    }
+  }
+};
+
+// Adds one to the sum of its inputs
+class SumPlusOneFilter : public itk::ImageToImageFilter<ImageType, ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(SumPlusOneFilter);
+
+  using Self = SumPlusOneFilter;
+  using Superclass = itk::ImageToImageFilter<ImageType, ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(SumPlusOneFilter, ImageToImageFilter);
+
+  using Superclass::SetInput;
+
+protected:
+  SumPlusOneFilter() = default;
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & region) override
+  {
+    for (itk::ImageRegionIterator<ImageType> it(this->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      float sum = 1.0f;
+      for (unsigned int i = 0; i < this->GetNumberOfIndexedInputs(); ++i)
+      {
+        sum += this->GetInput(i)->GetPixel(it.GetIndex());
+      }
+      it.Set(sum);
+    }
+  }
+};
+
+bool
+HasValue(const ImageType * image, float value)
+{
+  for (itk::ImageRegionConstIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != value)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+
+TEST(PipelineMemoryPlanner, ReleasesAndRecyclesTheIntermediatesOfAChain)
+{
+  const auto source = OnesSource::New();
+  std::vector<SumPlusOneFilter::Pointer> filters;
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    filters.push_back(SumPlusOneFilter::New());
+    filters.back()->SetInput(i == 0 ? source->GetOutput() : filters[i - 1]->GetOutput());
+  }
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  EXPECT_TRUE(planner->GetReuseBuffers());
+  planner->SetOutput(filters.back()->GetOutput());
+  planner->Plan();
+  EXPECT_EQ(planner->GetNumberOfProcessObjects(), 5u);
+  EXPECT_EQ(planner->GetNumberOfConsumers(source->GetOutput()), 1u);
+  EXPECT_EQ(planner->GetNumberOfConsumers(filters.back()->GetOutput()), 0u);
+
+  planner->Update();
+  EXPECT_TRUE(HasValue(filters.back()->GetOutput(), 5.0f));
+
+  // Two buffers at most are held: the input and the output of a filter
+  EXPECT_EQ(planner->GetNumberOfReleasedDataObjects(), 4u);
+  EXPECT_EQ(planner->GetNumberOfReusedBuffers(), 3u);
+  EXPECT_EQ(planner->GetUnplannedPeakMemoryInBytes(), 5 * bufferSizeInBytes);
+  EXPECT_EQ(planner->GetPeakMemoryInBytes(), 2 * bufferSizeInBytes);
+  EXPECT_TRUE(source->GetOutput()->GetDataReleased());
+  EXPECT_TRUE(filters[2]->GetOutput()->GetDataReleased());
+  EXPECT_FALSE(filters.back()->GetOutput()->GetDataReleased());
+
+  std::ostringstream report;
+  planner->Report(report);
+  EXPECT_NE(report.str().find("Peak memory with planning"), std::string::npos);
+
+  // The released data objects are generated again
+  filters[1]->Modified();
+  planner->Update();
+  EXPECT_TRUE(HasValue(filters.back()->GetOutput(), 5.0f));
+  EXPECT_EQ(planner->GetNumberOfReleasedDataObjects(), 4u);
+}
+
+
+TEST(PipelineMemoryPlanner, WaitsForAllTheConsumers)
+{
+  // source -> a -> (b, c) -> d
+  const auto source = OnesSource::New();
+  const auto a = SumPlusOneFilter::New();
+  a->SetInput(source->GetOutput());
+  const auto b = SumPlusOneFilter::New();
+  b->SetInput(a->GetOutput());
+  const auto c = SumPlusOneFilter::New();
+  c->SetInput(a->GetOutput());
+  const auto d = SumPlusOneFilter::New();
+  d->SetInput(0, b->GetOutput());
+  d->SetInput(1, c->GetOutput());
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetOutput(d->GetOutput());
+  planner->Update();
+  EXPECT_EQ(planner->GetNumberOfProcessObjects(), 5u);
+  EXPECT_EQ(planner->GetNumberOfConsumers(a->GetOutput()), 2u);
+
+  // a is not generated again for c
+  EXPECT_TRUE(HasValue(d->GetOutput(), 7.0f));
+  EXPECT_EQ(planner->GetNumberOfReleasedDataObjects(), 4u);
+  EXPECT_TRUE(a->GetOutput()->GetDataReleased());
+  EXPECT_LT(planner->GetPeakMemoryInBytes(), planner->GetUnplannedPeakMemoryInBytes());
+  EXPECT_EQ(planner->GetUnplannedPeakMemoryInBytes(), 5 * bufferSizeInBytes);
+}
+
+
+TEST(PipelineMemoryPlanner, ReleasesWithoutRecycling)
+{
+  const auto source = OnesSource::New();
+  const auto a = SumPlusOneFilter::New();
+  a->SetInput(source->GetOutput());
+  const auto b = SumPlusOneFilter::New();
+  b->SetInput(a->GetOutput());
+
+  // The global allocator is used for the alignment, and restored
+  const auto globalAllocator = itk::PooledImageBufferAllocator::New();
+  globalAllocator->SetAlignment(128);
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(globalAllocator);
+
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  planner->SetOutput(b->GetOutput());
+  planner->ReuseBuffersOff();
+  planner->Update();
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAllocator(), globalAllocator);
+  itk::ImageBufferAllocator::SetGlobalDefaultAllocator(nullptr);
+
+  EXPECT_TRUE(HasValue(b->GetOutput(), 3.0f));
+  EXPECT_EQ(reinterpret_cast<std::uintptr_t>(b->GetOutput()->GetBufferPointer()) % 128, 0u);
+  EXPECT_EQ(planner->GetNumberOfReusedBuffers(), 0u);
+  EXPECT_EQ(planner->GetPeakMemoryInBytes(), 2 * bufferSizeInBytes);
+  EXPECT_EQ(planner->GetUnplannedPeakMemoryInBytes(), 3 * bufferSizeInBytes);
+}
+
+
+TEST(PipelineMemoryPlanner, RequiresAnOutput)
+{
+  const auto planner = itk::PipelineMemoryPlanner::New();
+  EXPECT_THROW(planner->Update(), itk::ExceptionObject);
+  EXPECT_EQ(itk::ImageBufferAllocator::GetGlobalDefaultAllocator(), nullptr);
+}
@@ -0,0 +1,179 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkProcessObjectProfiler.h"
+
+#include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageSource.h"
+
+#include <gtest/gtest.h>
+#include <sstream>
+
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+
+// Fills its output with a constant, using either threading model
+class ConstantSource : public itk::ImageSource<ImageType>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ConstantSource);
+
+  using Self = ConstantSource;
+  using Superclass = itk::ImageSource<ImageType>;
+  using Pointer = itk::SmartPointer<Self>;
+
+  itkNewMacro(Self);
+  itkTypeMacro(ConstantSource, ImageSource);
+
+  using Superclass::SetDynamicMultiThreading;
+
+protected:
+  ConstantSource() = default;
+
+  void
+  GenerateOutputInformation() override
+  {
+    ImageType::RegionType region;
+    region.SetSize({ { 64, 32 } });
+    this->GetOutput()->SetLargestPossibleRegion(region);
+  }
+
+  void
+  ThreadedGenerateData(const ImageType::RegionType & region, itk::ThreadIdType) override
+  {
+    this->DynamicThreadedGenerateData(region);
+  }
+
+  void
+  DynamicThreadedGenerateData(const ImageType::RegionType & region) override
+  {
+    for (itk::ImageRegionIterator<ImageType> it(this->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(1.0f);
+    }
+  }
+};
+
+itk::SizeValueType
+CountEvents(const itk::ProcessObjectProfiler::EventContainerType & events,
+            const std::string &                                    category,
+            itk::SizeValueType *                                   numberOfPixels = nullptr)
+{
+  itk::SizeValueType count = 0;
+  for (const auto & event : events)
+  {
+    if (event.Category == category)
+    {
+      ++count;
+      if (numberOfPixels)
+      {
+        *numberOfPixels += event.NumberOfPixels;
+      }
+    }
+  }
+  return count;
+}
+} // namespace
+
+
+TEST(ProcessObjectProfiler, RecordsFilterExecution)
+{
+  for (const bool dynamicMultiThreading : { true, false })
+  {
+    const auto profiler = itk::ProcessObjectProfiler::New();
+    const auto source = ConstantSource::New();
+    source->SetObjectName("constant");
+    source->SetDynamicMultiThreading(dynamicMultiThreading);
+    source->SetNumberOfWorkUnits(4);
+    source->SetProfiler(profiler);
+    EXPECT_EQ(source->GetProfiler(), profiler.GetPointer());
+    source->Update();
+    EXPECT_EQ(source->GetActiveProfiler(), nullptr);
+
+    const auto events = profiler->GetEvents();
+    EXPECT_EQ(CountEvents(events, "GenerateOutputInformation"), 1u);
+    EXPECT_EQ(CountEvents(events, "GenerateData"), 1u);
+
+    itk::SizeValueType numberOfPixels = 0;
+    EXPECT_GE(CountEvents(events, "WorkUnit", &numberOfPixels), 1u);
+    EXPECT_EQ(numberOfPixels, 64u * 32u);
+    for (const auto & event : events)
+    {
+      EXPECT_EQ(event.Name, "constant");
+      EXPECT_GE(event.Duration, 0.0);
+    }
+
+    // Up to date: no new event
+    source->Update();
+    EXPECT_EQ(profiler->GetEvents().size(), events.size());
+
+    // A new execution is counted
+    source->Modified();
+    source->Update();
+    EXPECT_EQ(CountEvents(profiler->GetEvents(), "GenerateData"), 2u);
+    EXPECT_EQ(profiler->GetEvents().back().Execution, 2u);
+
+    std::ostringstream report;
+    profiler->Report(report);
+    EXPECT_NE(report.str().find("constant"), std::string::npos);
+
+    profiler->Clear();
+    EXPECT_TRUE(profiler->GetEvents().empty());
+  }
+}
+
+
+TEST(ProcessObjectProfiler, GlobalProfiler)
+{
+  EXPECT_EQ(itk::ProcessObjectProfiler::GetGlobalProfiler(), nullptr);
+
+  const auto profiler = itk::ProcessObjectProfiler::New();
+  itk::ProcessObjectProfiler::SetGlobalProfiler(profiler);
+  EXPECT_EQ(itk::ProcessObjectProfiler::GetGlobalProfiler(), profiler);
+
+  ConstantSource::New()->Update();
+  EXPECT_EQ(CountEvents(profiler->GetEvents(), "GenerateData"), 1u);
+
+  itk::ProcessObjectProfiler::SetGlobalProfiler(nullptr);
+  ConstantSource::New()->Update();
+  EXPECT_EQ(CountEvents(profiler->GetEvents(), "GenerateData"), 1u);
+}
+
+
+TEST(ProcessObjectProfiler, WritesChromeTrace)
+{
+  const auto profiler = itk::ProcessObjectProfiler::New();
+  const auto source = ConstantSource::New();
+  source->SetObjectName("a \"quoted\" name");
+  source->SetProfiler(profiler);
+  source->Update();
+
+  std::ostringstream trace;
+  profiler->WriteChromeTrace(trace);
+  const std::string json = trace.str();
+  EXPECT_EQ(json.find("{\"traceEvents\":["), 0u);
+  EXPECT_NE(json.find("\"name\":\"a \\\"quoted\\\" name\""), std::string::npos);
+  EXPECT_NE(json.find("\"cat\":\"GenerateData\""), std::string::npos);
+  EXPECT_NE(json.find("\"ph\":\"X\""), std::string::npos);
+
+  EXPECT_THROW(profiler->WriteChromeTrace(std::string("/nonexistent/directory/trace.json")), itk::ExceptionObject);
+}
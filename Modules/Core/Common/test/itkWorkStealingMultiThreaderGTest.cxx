@@ -0,0 +1,163 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkWorkStealingMultiThreader.h"
+
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <set>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+namespace
+{
+itk::WorkStealingMultiThreader::Pointer
+MakeThreader(itk::ThreadIdType numberOfWorkUnits)
+{
+  auto threader = itk::WorkStealingMultiThreader::New();
+  // Have a few workers, even on a single core machine
+  threader->SetMaximumNumberOfThreads(4);
+  threader->SetNumberOfWorkUnits(numberOfWorkUnits);
+  return threader;
+}
+
+ITK_THREAD_RETURN_FUNCTION_CALL_CONVENTION
+CountWorkUnit(void * arg)
+{
+  const auto * info = static_cast<itk::MultiThreaderBase::WorkUnitInfo *>(arg);
+  auto &       counts = *static_cast<std::vector<std::atomic<int>> *>(info->UserData);
+  ++counts[info->WorkUnitID];
+  return ITK_THREAD_RETURN_DEFAULT_VALUE;
+}
+} // namespace
+
+
+TEST(WorkStealingMultiThreader, SingleMethodExecutesEachWorkUnitOnce)
+{
+  const auto threader = MakeThreader(37);
+  EXPECT_EQ(threader->GetNumberOfWorkUnits(), 37u);
+
+  std::vector<std::atomic<int>> counts(37);
+  threader->SetSingleMethod(CountWorkUnit, &counts);
+  threader->SingleMethodExecute();
+  for (const auto & count : counts)
+  {
+    EXPECT_EQ(count, 1);
+  }
+}
+
+
+TEST(WorkStealingMultiThreader, ParallelizeImageRegionVisitsEachPixelOnce)
+{
+  constexpr unsigned int     dimension = 3;
+  const itk::IndexValueType  index[dimension] = { -2, 5, 1 };
+  const itk::SizeValueType   size[dimension] = { 13, 17, 19 };
+  const itk::SizeValueType   numberOfPixels = size[0] * size[1] * size[2];
+  std::vector<std::atomic<int>> counts(numberOfPixels);
+
+  for (const itk::ThreadIdType numberOfWorkUnits : { 1u, 3u, 64u, 10000u })
+  {
+    for (auto & count : counts)
+    {
+      count = 0;
+    }
+    MakeThreader(numberOfWorkUnits)
+      ->ParallelizeImageRegion(
+        dimension,
+        index,
+        size,
+        [&](const itk::IndexValueType chunkIndex[], const itk::SizeValueType chunkSize[]) {
+          for (itk::SizeValueType z = 0; z < chunkSize[2]; ++z)
+          {
+            for (itk::SizeValueType y = 0; y < chunkSize[1]; ++y)
+            {
+              for (itk::SizeValueType x = 0; x < chunkSize[0]; ++x)
+              {
+                const itk::SizeValueType i = chunkIndex[0] - index[0] + x;
+                const itk::SizeValueType j = chunkIndex[1] - index[1] + y;
+                const itk::SizeValueType k = chunkIndex[2] - index[2] + z;
+                ++counts[(k * size[1] + j) * size[0] + i];
+              }
+            }
+          }
+        },
+        nullptr);
+
+    for (const auto & count : counts)
+    {
+      EXPECT_EQ(count, 1);
+    }
+  }
+}
+
+
+TEST(WorkStealingMultiThreader, NestedParallelismDoesNotOversubscribe)
+{
+  const auto threader = MakeThreader(16);
+
+  std::mutex                  mutex;
+  std::set<std::thread::id>   threadIds;
+  std::atomic<itk::SizeValueType> sum{ 0 };
+
+  threader->ParallelizeArray(
+    0,
+    8,
+    [&](itk::SizeValueType outer) {
+      // Nested calls are scheduled on the same pool
+      MakeThreader(16)->ParallelizeArray(
+        0,
+        1000,
+        [&](itk::SizeValueType inner) {
+          sum += outer * 1000 + inner;
+          const std::lock_guard<std::mutex> lock(mutex);
+          threadIds.insert(std::this_thread::get_id());
+        },
+        nullptr);
+    },
+    nullptr);
+
+  EXPECT_EQ(sum, 7999u * 8000u / 2u);
+  EXPECT_LE(threadIds.size(), itk::WorkStealingThreadPool::GetInstance()->GetMaximumNumberOfThreads());
+}
+
+
+TEST(WorkStealingMultiThreader, RethrowsExceptionOfAnyPiece)
+{
+  const auto threader = MakeThreader(100);
+
+  std::atomic<int> count{ 0 };
+  const auto       throwingFunction = [&count](itk::SizeValueType i) {
+    ++count;
+    if (i == 77)
+    {
+      throw std::runtime_error("Exception at index 77");
+    }
+  };
+  EXPECT_THROW(threader->ParallelizeArray(0, 100, throwingFunction, nullptr), std::runtime_error);
+  // Other pieces are not interrupted
+  EXPECT_EQ(count, 100);
+
+  // The pool is still usable afterwards
+  count = 0;
+  threader->ParallelizeArray(0, 100, [&count](itk::SizeValueType) { ++count; }, nullptr);
+  EXPECT_EQ(count, 100);
+}
@@ -177,6 +177,15 @@ public:
     return this->EvaluateAtContinuousIndexInternal(x, m_ThreadedEvaluateIndex[threadId], m_ThreadedWeights[threadId]);
   }
 
+  /** Interpolate the image at the continuous indices of a scanline. The
+   * working space is allocated once for all the indices, and the methods
+   * of this class are called without virtual dispatch. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              bool *                      insideBuffer,
+                              SizeValueType               numberOfIndices) const override;
+
   CovariantVectorType
   EvaluateDerivative(const PointType & point) const
   {
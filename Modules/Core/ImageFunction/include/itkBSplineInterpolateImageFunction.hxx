@@ -486,6 +486,33 @@ BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::Evalua
   return (interpolated);
 }
 
+template <typename TImageType, typename TCoordRep, typename TCoefficientType>
+void
+BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::EvaluateAtContinuousIndices(
+  const ContinuousIndexType * indices,
+  OutputType *                values,
+  bool *                      insideBuffer,
+  SizeValueType               numberOfIndices) const
+{
+  // The subclasses may override the evaluation
+  if (typeid(*this) != typeid(Self))
+  {
+    Superclass::EvaluateAtContinuousIndices(indices, values, insideBuffer, numberOfIndices);
+    return;
+  }
+
+  vnl_matrix<long>   evaluateIndex(ImageDimension, (m_SplineOrder + 1));
+  vnl_matrix<double> weights(ImageDimension, (m_SplineOrder + 1));
+  for (SizeValueType i = 0; i < numberOfIndices; ++i)
+  {
+    insideBuffer[i] = this->Self::IsInsideBuffer(indices[i]);
+    if (insideBuffer[i])
+    {
+      values[i] = this->Self::EvaluateAtContinuousIndexInternal(indices[i], evaluateIndex, weights);
+    }
+  }
+}
+
 template <typename TImageType, typename TCoordRep, typename TCoefficientType>
 void
 BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::
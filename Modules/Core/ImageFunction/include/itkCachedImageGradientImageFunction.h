@@ -0,0 +1,205 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCachedImageGradientImageFunction_h
+#define itkCachedImageGradientImageFunction_h
+
+#include "itkCentralDifferenceImageFunction.h"
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+
+namespace itk
+{
+/**
+ * \class CachedImageGradientImageFunction
+ * \brief Evaluate the gradient of an image from gradients cached at the pixels.
+ *
+ * The gradients at the pixels are computed by a gradient calculator, a
+ * CentralDifferenceImageFunction by default, and stored with TCachedValueType
+ * components, in blocks of BlockSize pixels along each dimension. A block is
+ * computed the first time one of its pixels is needed, by the thread that
+ * needs it, so that only the blocks of the image that are used are computed
+ * and stored.
+ *
+ * Only the pixels of the cached region are cached. The gradients of the other
+ * pixels of the image are computed by the gradient calculator each time they
+ * are needed. The cached region is the buffered region of the input image by
+ * default.
+ *
+ * The gradient at a non-integer index is linearly interpolated from the
+ * gradients at the neighboring pixels, like the gradient image of a gradient
+ * filter would be by a LinearInterpolateImageFunction.
+ *
+ * The cache is cleared when the input image, the gradient calculator or the
+ * cached region are set. The methods of this class may be called concurrently,
+ * except the ones that clear the cache.
+ *
+ * This class is templated over the input image type, the coordinate
+ * representation type, the output type of the gradient calculator and the
+ * type of the cached components.
+ *
+ * \ingroup ImageFunctions
+ * \ingroup ITKImageFunction
+ */
+template <typename TInputImage,
+          typename TCoordRep = float,
+          typename TOutputType = CovariantVector<double, TInputImage::ImageDimension>,
+          typename TCachedValueType = float>
+class ITK_TEMPLATE_EXPORT CachedImageGradientImageFunction : public ImageFunction<TInputImage, TOutputType, TCoordRep>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(CachedImageGradientImageFunction);
+
+  /** Dimension underlying input image. */
+  static constexpr unsigned int ImageDimension = TInputImage::ImageDimension;
+
+  /** Standard class type aliases. */
+  using Self = CachedImageGradientImageFunction;
+  using Superclass = ImageFunction<TInputImage, TOutputType, TCoordRep>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(CachedImageGradientImageFunction, ImageFunction);
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** InputImageType type alias support */
+  using InputImageType = TInputImage;
+  using RegionType = typename InputImageType::RegionType;
+
+  /** OutputType typdef support. */
+  using typename Superclass::OutputType;
+
+  /** Output convert type alias support */
+  using OutputConvertType = DefaultConvertPixelTraits<OutputType>;
+
+  /** Output value type alias support */
+  using OutputValueType = typename OutputConvertType::ComponentType;
+
+  /** Type of the cached components of the gradients. */
+  using CachedValueType = TCachedValueType;
+
+  /** Index type alias support */
+  using typename Superclass::IndexType;
+
+  /** ContinuousIndex type alias support */
+  using typename Superclass::ContinuousIndexType;
+
+  /** Point type alias support */
+  using typename Superclass::PointType;
+
+  /** Gradient calculator type alias support */
+  using GradientCalculatorType = ImageFunction<TInputImage, TOutputType, TCoordRep>;
+  using GradientCalculatorPointer = typename GradientCalculatorType::Pointer;
+
+  /** Number of pixels of the blocks along each dimension. */
+  static constexpr unsigned int BlockSize = 16;
+
+  /** Set the input image. This must be set by the user. */
+  void
+  SetInputImage(const TInputImage * inputData) override;
+
+  /** Set the gradient calculator. Its EvaluateAtIndex method computes the
+   * gradients at the pixels. The input image of the gradient calculator is
+   * set by SetInputImage. */
+  virtual void
+  SetGradientCalculator(GradientCalculatorType * gradientCalculator);
+
+  /** Get the gradient calculator. */
+  itkGetModifiableObjectMacro(GradientCalculator, GradientCalculatorType);
+
+  /** Set the region of the input image whose gradients are cached. It is
+   * cropped by the buffered region of the input image. */
+  virtual void
+  SetCachedRegion(const RegionType & region);
+
+  /** Get the region of the input image whose gradients are cached. */
+  itkGetConstReferenceMacro(CachedRegion, RegionType);
+
+  /** Clear the cache. */
+  void
+  ClearCache();
+
+  /** Get the number of blocks that are currently cached. */
+  SizeValueType
+  GetNumberOfCachedBlocks() const;
+
+  /** Evaluate the gradient at the specified index, from the cache when the
+   * index is in the cached region. The index is assumed to lie within the
+   * buffered region of the image. */
+  OutputType
+  EvaluateAtIndex(const IndexType & index) const override;
+
+  /** Evaluate the gradient at a point, by linear interpolation of the
+   * gradients at the neighboring pixels. */
+  OutputType
+  Evaluate(const PointType & point) const override;
+
+  /** Evaluate the gradient at a non-integer index, by linear interpolation
+   * of the gradients at the neighboring pixels. The neighbors outside the
+   * buffered region are replaced by the nearest pixel of the buffered
+   * region. */
+  OutputType
+  EvaluateAtContinuousIndex(const ContinuousIndexType & cindex) const override;
+
+protected:
+  CachedImageGradientImageFunction();
+  ~CachedImageGradientImageFunction() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** The gradients of the pixels of a block, computed once. */
+  struct Block
+  {
+    std::once_flag                     Flag;
+    std::unique_ptr<CachedValueType[]> Values;
+  };
+
+  /** Returns the cached gradient components of the pixel at the specified
+   * index of the cached region, computing its block if needed. */
+  const CachedValueType *
+  GetCachedGradient(const IndexType & index) const;
+
+  /** Computes the gradients of the pixels of a block. */
+  void
+  ComputeBlock(SizeValueType blockNumber, Block & block) const;
+
+  GradientCalculatorPointer m_GradientCalculator;
+
+  /** The cached region set by the user, and the one that is cached. */
+  RegionType m_UserCachedRegion;
+  bool       m_UserHasSetCachedRegion{ false };
+  RegionType m_CachedRegion;
+
+  /** Number of blocks of the cached region along each dimension. */
+  Size<ImageDimension>               m_NumberOfBlocks;
+  std::unique_ptr<Block[]>           m_Blocks;
+  mutable std::atomic<SizeValueType> m_NumberOfCachedBlocks{ 0 };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkCachedImageGradientImageFunction.hxx"
+#endif
+
+#endif
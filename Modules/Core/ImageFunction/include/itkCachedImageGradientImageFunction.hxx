@@ -0,0 +1,279 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkCachedImageGradientImageFunction_hxx
+#define itkCachedImageGradientImageFunction_hxx
+
+#include "itkIndexRange.h"
+#include "itkMath.h"
+
+#include <algorithm>
+
+namespace itk
+{
+/**
+ * Constructor
+ */
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::
+  CachedImageGradientImageFunction()
+{
+  /* Gradient calculator. Default to central differences. */
+  using CentralDifferenceType = CentralDifferenceImageFunction<TInputImage, TCoordRep, TOutputType>;
+  this->m_GradientCalculator = CentralDifferenceType::New();
+  this->m_NumberOfBlocks.Fill(0);
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+void
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::SetInputImage(
+  const TInputImage * inputData)
+{
+  Superclass::SetInputImage(inputData);
+  this->m_GradientCalculator->SetInputImage(inputData);
+  this->ClearCache();
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+void
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::SetGradientCalculator(
+  GradientCalculatorType * gradientCalculator)
+{
+  if (gradientCalculator == nullptr)
+  {
+    itkExceptionMacro("The gradient calculator must not be null");
+  }
+  this->m_GradientCalculator = gradientCalculator;
+  this->m_GradientCalculator->SetInputImage(this->m_Image);
+  this->ClearCache();
+  this->Modified();
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+void
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::SetCachedRegion(
+  const RegionType & region)
+{
+  this->m_UserCachedRegion = region;
+  this->m_UserHasSetCachedRegion = true;
+  this->ClearCache();
+  this->Modified();
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+void
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::ClearCache()
+{
+  this->m_CachedRegion = RegionType();
+  if (this->m_Image)
+  {
+    const RegionType & bufferedRegion = this->m_Image->GetBufferedRegion();
+    this->m_CachedRegion = this->m_UserHasSetCachedRegion ? this->m_UserCachedRegion : bufferedRegion;
+    if (!this->m_CachedRegion.Crop(bufferedRegion))
+    {
+      this->m_CachedRegion = RegionType();
+    }
+  }
+
+  SizeValueType numberOfBlocks = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    this->m_NumberOfBlocks[d] = (this->m_CachedRegion.GetSize(d) + BlockSize - 1) / BlockSize;
+    numberOfBlocks *= this->m_NumberOfBlocks[d];
+  }
+  this->m_Blocks.reset(numberOfBlocks > 0 ? new Block[numberOfBlocks] : nullptr);
+  this->m_NumberOfCachedBlocks = 0;
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+SizeValueType
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::GetNumberOfCachedBlocks()
+  const
+{
+  return this->m_NumberOfCachedBlocks;
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+auto
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::GetCachedGradient(
+  const IndexType & index) const -> const CachedValueType *
+{
+  SizeValueType blockNumber = 0;
+  SizeValueType blockStride = 1;
+  SizeValueType pixelNumber = 0;
+  SizeValueType pixelStride = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const auto          position = static_cast<SizeValueType>(index[d] - this->m_CachedRegion.GetIndex(d));
+    const SizeValueType blockIndex = position / BlockSize;
+    blockNumber += blockIndex * blockStride;
+    blockStride *= this->m_NumberOfBlocks[d];
+    pixelNumber += (position - blockIndex * BlockSize) * pixelStride;
+    pixelStride *= std::min<SizeValueType>(BlockSize, this->m_CachedRegion.GetSize(d) - blockIndex * BlockSize);
+  }
+
+  Block & block = this->m_Blocks[blockNumber];
+  std::call_once(block.Flag, [this, blockNumber, &block]() { this->ComputeBlock(blockNumber, block); });
+  return block.Values.get() + pixelNumber * OutputConvertType::GetNumberOfComponents();
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+void
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::ComputeBlock(
+  SizeValueType blockNumber,
+  Block &       block) const
+{
+  RegionType blockRegion;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const SizeValueType blockIndex = blockNumber % this->m_NumberOfBlocks[d];
+    blockNumber /= this->m_NumberOfBlocks[d];
+    blockRegion.SetIndex(d, this->m_CachedRegion.GetIndex(d) + static_cast<IndexValueType>(blockIndex * BlockSize));
+    blockRegion.SetSize(d,
+                        std::min<SizeValueType>(BlockSize, this->m_CachedRegion.GetSize(d) - blockIndex * BlockSize));
+  }
+
+  const unsigned int numberOfComponents = OutputConvertType::GetNumberOfComponents();
+  block.Values = std::make_unique<CachedValueType[]>(blockRegion.GetNumberOfPixels() * numberOfComponents);
+
+  CachedValueType * values = block.Values.get();
+  for (const auto & index : ImageRegionIndexRange<ImageDimension>(blockRegion))
+  {
+    const OutputType gradient = this->m_GradientCalculator->EvaluateAtIndex(index);
+    for (unsigned int c = 0; c < numberOfComponents; ++c)
+    {
+      *(values++) = static_cast<CachedValueType>(OutputConvertType::GetNthComponent(c, gradient));
+    }
+  }
+  ++this->m_NumberOfCachedBlocks;
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+auto
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::EvaluateAtIndex(
+  const IndexType & index) const -> OutputType
+{
+  if (!this->m_CachedRegion.IsInside(index))
+  {
+    return this->m_GradientCalculator->EvaluateAtIndex(index);
+  }
+
+  const CachedValueType * cachedGradient = this->GetCachedGradient(index);
+
+  OutputType gradient;
+  for (unsigned int c = 0; c < OutputConvertType::GetNumberOfComponents(); ++c)
+  {
+    OutputConvertType::SetNthComponent(c, gradient, static_cast<OutputValueType>(cachedGradient[c]));
+  }
+  return gradient;
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+auto
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::Evaluate(
+  const PointType & point) const -> OutputType
+{
+  ContinuousIndexType cindex;
+  this->ConvertPointToContinuousIndex(point, cindex);
+  return this->EvaluateAtContinuousIndex(cindex);
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+auto
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::EvaluateAtContinuousIndex(
+  const ContinuousIndexType & cindex) const -> OutputType
+{
+  const unsigned int numberOfComponents = OutputConvertType::GetNumberOfComponents();
+
+  IndexType baseIndex;
+  double    distance[ImageDimension];
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    baseIndex[d] = Math::Floor<IndexValueType>(cindex[d]);
+    distance[d] = cindex[d] - static_cast<double>(baseIndex[d]);
+  }
+
+  OutputType gradient;
+  for (unsigned int c = 0; c < numberOfComponents; ++c)
+  {
+    OutputConvertType::SetNthComponent(c, gradient, NumericTraits<OutputValueType>::ZeroValue());
+  }
+
+  // Linear interpolation of the gradients at the 2^ImageDimension neighbors.
+  for (unsigned int counter = 0; counter < (1U << ImageDimension); ++counter)
+  {
+    double    overlap = 1.0;
+    IndexType neighIndex = baseIndex;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (counter & (1U << d))
+      {
+        ++neighIndex[d];
+        overlap *= distance[d];
+      }
+      else
+      {
+        overlap *= 1.0 - distance[d];
+      }
+      neighIndex[d] = std::max(this->m_StartIndex[d], std::min(neighIndex[d], this->m_EndIndex[d]));
+    }
+    if (overlap == 0.0)
+    {
+      continue;
+    }
+
+    if (this->m_CachedRegion.IsInside(neighIndex))
+    {
+      const CachedValueType * cachedGradient = this->GetCachedGradient(neighIndex);
+      for (unsigned int c = 0; c < numberOfComponents; ++c)
+      {
+        OutputConvertType::SetNthComponent(
+          c,
+          gradient,
+          OutputConvertType::GetNthComponent(c, gradient) + static_cast<OutputValueType>(overlap * cachedGradient[c]));
+      }
+    }
+    else
+    {
+      const OutputType neighGradient = this->m_GradientCalculator->EvaluateAtIndex(neighIndex);
+      for (unsigned int c = 0; c < numberOfComponents; ++c)
+      {
+        OutputConvertType::SetNthComponent(c,
+                                           gradient,
+                                           OutputConvertType::GetNthComponent(c, gradient) +
+                                             static_cast<OutputValueType>(
+                                               overlap * OutputConvertType::GetNthComponent(c, neighGradient)));
+      }
+    }
+  }
+  return gradient;
+}
+
+template <typename TInputImage, typename TCoordRep, typename TOutputType, typename TCachedValueType>
+void
+CachedImageGradientImageFunction<TInputImage, TCoordRep, TOutputType, TCachedValueType>::PrintSelf(std::ostream & os,
+                                                                                                    Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  itkPrintSelfObjectMacro(GradientCalculator);
+  os << indent << "CachedRegion: " << this->m_CachedRegion << std::endl;
+  os << indent << "NumberOfCachedBlocks: " << this->GetNumberOfCachedBlocks() << std::endl;
+}
+} // end namespace itk
+
+#endif
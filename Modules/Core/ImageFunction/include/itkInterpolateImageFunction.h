@@ -20,6 +20,8 @@
 
 #include "itkImageFunction.h"
 
+#include <typeinfo>
+
 namespace itk
 {
 /**
@@ -127,6 +129,33 @@ public:
     return (static_cast<RealType>(this->GetInputImage()->GetPixel(index)));
   }
 
+  /** Interpolate the image at the continuous indices of a scanline
+   *
+   * For each of the numberOfIndices indices, stores in insideBuffer[i]
+   * whether indices[i] is inside the image buffer (see
+   * ImageFunction::IsInsideBuffer()) and, if it is, the interpolated
+   * image intensity in values[i]. The values at the indices outside of
+   * the buffer are left unchanged.
+   *
+   * This implementation calls IsInsideBuffer() and
+   * EvaluateAtContinuousIndex() for each index. The interpolators
+   * override it to evaluate all the indices without virtual calls. */
+  virtual void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              bool *                      insideBuffer,
+                              SizeValueType               numberOfIndices) const
+  {
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      insideBuffer[i] = this->IsInsideBuffer(indices[i]);
+      if (insideBuffer[i])
+      {
+        values[i] = this->EvaluateAtContinuousIndex(indices[i]);
+      }
+    }
+  }
+
 /** Get the radius required for interpolation.
  *
  * This defines the number of surrounding pixels required to interpolate at
@@ -158,6 +187,34 @@ protected:
   {
     Superclass::PrintSelf(os, indent);
   }
+
+  /** Implementation of EvaluateAtContinuousIndices() for the interpolator
+   * TInterpolator, which calls its IsInsideBuffer() and
+   * EvaluateAtContinuousIndex() without virtual dispatch, so that they can
+   * be inlined. The subclasses of TInterpolator, which may override these
+   * methods, are evaluated with virtual calls. */
+  template <typename TInterpolator>
+  void
+  EvaluateAtContinuousIndicesWithoutVirtualCalls(const ContinuousIndexType * indices,
+                                                 OutputType *                values,
+                                                 bool *                      insideBuffer,
+                                                 SizeValueType               numberOfIndices) const
+  {
+    if (typeid(*this) != typeid(TInterpolator))
+    {
+      Self::EvaluateAtContinuousIndices(indices, values, insideBuffer, numberOfIndices);
+      return;
+    }
+    const auto * const interpolator = static_cast<const TInterpolator *>(this);
+    for (SizeValueType i = 0; i < numberOfIndices; ++i)
+    {
+      insideBuffer[i] = interpolator->TInterpolator::IsInsideBuffer(indices[i]);
+      if (insideBuffer[i])
+      {
+        values[i] = interpolator->TInterpolator::EvaluateAtContinuousIndex(indices[i]);
+      }
+    }
+  }
 };
 } // end namespace itk
 
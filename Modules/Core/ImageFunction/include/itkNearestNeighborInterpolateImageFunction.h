@@ -89,6 +89,17 @@ public:
     return static_cast<OutputType>(this->GetInputImage()->GetPixel(nindex));
   }
 
+  /** Interpolate the image at the continuous indices of a scanline,
+   * without virtual calls. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              bool *                      insideBuffer,
+                              SizeValueType               numberOfIndices) const override
+  {
+    this->template EvaluateAtContinuousIndicesWithoutVirtualCalls<Self>(indices, values, insideBuffer, numberOfIndices);
+  }
+
   SizeType
   GetRadius() const override
   {
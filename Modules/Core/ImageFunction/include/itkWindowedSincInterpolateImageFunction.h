@@ -317,6 +317,17 @@ public:
   OutputType
   EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override;
 
+  /** Interpolate the image at the continuous indices of a scanline,
+   * without virtual calls. */
+  void
+  EvaluateAtContinuousIndices(const ContinuousIndexType * indices,
+                              OutputType *                values,
+                              bool *                      insideBuffer,
+                              SizeValueType               numberOfIndices) const override
+  {
+    this->template EvaluateAtContinuousIndicesWithoutVirtualCalls<Self>(indices, values, insideBuffer, numberOfIndices);
+  }
+
   SizeType
   GetRadius() const override
   {
@@ -0,0 +1,153 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkCachedImageGradientImageFunction.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTestingMacros.h"
+
+int
+itkCachedImageGradientImageFunctionTest(int, char *[])
+{
+  constexpr unsigned int ImageDimension = 3;
+  using ImageType = itk::Image<double, ImageDimension>;
+  using FunctionType = itk::CachedImageGradientImageFunction<ImageType, double>;
+  using OutputType = FunctionType::OutputType;
+  using GradientImageType = itk::Image<OutputType, ImageDimension>;
+
+  // Make a test image with an oblique direction
+  auto                image = ImageType::New();
+  ImageType::SizeType size = { { 40, 30, 20 } };
+  image->SetRegions(size);
+  ImageType::SpacingType spacing;
+  spacing[0] = 0.5;
+  spacing[1] = 1.0;
+  spacing[2] = 2.0;
+  image->SetSpacing(spacing);
+  ImageType::DirectionType direction;
+  direction.SetIdentity();
+  direction[0][0] = direction[1][1] = std::cos(0.3);
+  direction[0][1] = -std::sin(0.3);
+  direction[1][0] = std::sin(0.3);
+  image->SetDirection(direction);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(0.1 * index[0] * index[0] + 0.5 * index[0] * index[1] - 2.0 * index[2] + std::sin(0.4 * index[1]));
+  }
+
+  auto function = FunctionType::New();
+
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(function, CachedImageGradientImageFunction, ImageFunction);
+
+  ITK_TRY_EXPECT_EXCEPTION(function->SetGradientCalculator(nullptr));
+
+  function->SetInputImage(image);
+  ITK_TEST_EXPECT_EQUAL(function->GetCachedRegion(), image->GetBufferedRegion());
+
+  ImageType::RegionType cachedRegion;
+  cachedRegion.SetIndex({ { 4, 4, 4 } });
+  cachedRegion.SetSize({ { 20, 20, 30 } });
+  function->SetCachedRegion(cachedRegion);
+
+  // The cached region is cropped by the buffered region
+  cachedRegion.SetSize(2, 16);
+  ITK_TEST_EXPECT_EQUAL(function->GetCachedRegion(), cachedRegion);
+  ITK_TEST_EXPECT_EQUAL(function->GetNumberOfCachedBlocks(), 0);
+
+  // The gradients at the pixels are the ones of the gradient calculator
+  // stored as float
+  auto gradientImage = GradientImageType::New();
+  gradientImage->CopyInformation(image);
+  gradientImage->SetRegions(image->GetBufferedRegion());
+  gradientImage->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<GradientImageType> gradientIt(gradientImage, gradientImage->GetBufferedRegion());
+  for (gradientIt.GoToBegin(); !gradientIt.IsAtEnd(); ++gradientIt)
+  {
+    const ImageType::IndexType & index = gradientIt.GetIndex();
+    const OutputType             expected = function->GetGradientCalculator()->EvaluateAtIndex(index);
+    const OutputType             gradient = function->EvaluateAtIndex(index);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const double tolerance = cachedRegion.IsInside(index) ? 1e-6 * (1.0 + std::abs(expected[d])) : 0.0;
+      if (std::abs(gradient[d] - expected[d]) > tolerance)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in EvaluateAtIndex at " << index << ": expected " << expected << ", got " << gradient
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+    gradientIt.Set(expected);
+  }
+
+  // Only the blocks of the cached region are stored
+  ITK_TEST_EXPECT_EQUAL(function->GetNumberOfCachedBlocks(), 4);
+  function->ClearCache();
+  ITK_TEST_EXPECT_EQUAL(function->GetNumberOfCachedBlocks(), 0);
+
+  // The gradients at points are linearly interpolated, from any thread
+  using GradientInterpolatorType = itk::LinearInterpolateImageFunction<GradientImageType, double>;
+  auto gradientInterpolator = GradientInterpolatorType::New();
+  gradientInterpolator->SetInputImage(gradientImage);
+
+  // A low discrepancy sequence of points covering the image
+  constexpr unsigned int            numberOfPoints = 5000;
+  const double                      alpha[ImageDimension] = { 0.8191725134, 0.6710436067, 0.5497004779 };
+  std::vector<ImageType::PointType> points(numberOfPoints);
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    FunctionType::ContinuousIndexType cindex;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      cindex[d] = std::fmod(0.5 + alpha[d] * (i + 1), 1.0) * (size[d] - 1);
+    }
+    image->TransformContinuousIndexToPhysicalPoint(cindex, points[i]);
+  }
+
+  std::vector<OutputType> gradients(numberOfPoints);
+  itk::MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfPoints,
+    [&function, &points, &gradients](itk::SizeValueType i) { gradients[i] = function->Evaluate(points[i]); },
+    nullptr);
+
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    const OutputType expected = gradientInterpolator->Evaluate(points[i]);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (std::abs(gradients[i][d] - expected[d]) > 1e-5 * (1.0 + std::abs(expected[d])))
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in Evaluate at " << points[i] << ": expected " << expected << ", got " << gradients[i]
+                  << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  ITK_TEST_EXPECT_EQUAL(function->GetNumberOfCachedBlocks(), 4);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -20,6 +20,8 @@
 
 #include "itkMacro.h"
 
+#include <vector>
+
 namespace itk
 {
 /**
@@ -85,14 +87,23 @@ TransformMeshFilter<TInputMesh, TOutputMesh, TTransform>::GenerateData()
   outPoints->Squeeze(); // in case the previous mesh had
                         // allocated a larger memory
 
-  typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin();
-  typename OutputPointsContainer::Iterator     outputPoint = outPoints->Begin();
-
-  while (inputPoint != inPoints->End())
+  // Transform all the points with a single call, which the transforms
+  // that override TransformPoints process without a virtual call per point.
+  std::vector<typename TransformType::InputPointType>  inputPoints;
+  std::vector<typename TransformType::OutputPointType> outputPoints(inPoints->Size());
+  inputPoints.reserve(inPoints->Size());
+  for (typename InputPointsContainer::ConstIterator inputPoint = inPoints->Begin(); inputPoint != inPoints->End();
+       ++inputPoint)
   {
-    outputPoint.Value() = m_Transform->TransformPoint(inputPoint.Value());
+    inputPoints.push_back(inputPoint.Value());
+  }
 
-    ++inputPoint;
+  m_Transform->TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+
+  typename OutputPointsContainer::Iterator outputPoint = outPoints->Begin();
+  for (const auto & point : outputPoints)
+  {
+    outputPoint.Value() = point;
     ++outputPoint;
   }
 
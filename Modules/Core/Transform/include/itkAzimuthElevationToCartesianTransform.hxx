@@ -84,6 +84,19 @@ AzimuthElevationToCartesianTransform<TParametersValueType, NDimensions>::Transfo
   return result;
 }
 
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+AzimuthElevationToCartesianTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    outputPoints[p] = this->TransformPoint(inputPoints[p]);
+  }
+}
+
 /** Transform a point, from azimuth-elevation to cartesian */
 template <typename TParametersValueType, unsigned int NDimensions>
 typename AzimuthElevationToCartesianTransform<TParametersValueType, NDimensions>::OutputPointType
@@ -292,6 +292,23 @@ public:
                                                          WeightsType &,
                                                          ParameterIndexArrayType &) const;
 
+  /**
+   * Compute the sparse Jacobian with respect to the parameters at a point.
+   * Only the parameters of the coefficients in the support region of the
+   * point have a non-zero derivative: on return, weights contains the
+   * interpolation weights of these coefficients and indices contains the
+   * indices of their x (zeroth) dimension parameters. The derivative of the
+   * i-th dimension of the output point with respect to the parameter
+   * indices[k] + i * GetNumberOfParametersPerDimension() is weights[k], and
+   * is zero for all the other parameters.
+   * Returns false, with zero weights, if the support region of the point
+   * does not lie totally within the grid.
+   */
+  bool
+  ComputeSparseJacobianWithRespectToParameters(const InputPointType &    point,
+                                               WeightsType &             weights,
+                                               ParameterIndexArrayType & indices) const;
+
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override = 0;
 
@@ -248,42 +248,50 @@ BSplineBaseTransform<TParametersValueType, NDimensions, VSplineOrder>::
                                                          WeightsType &             weights,
                                                          ParameterIndexArrayType & indexes) const
 {
+  this->ComputeSparseJacobianWithRespectToParameters(point, weights, indexes);
+}
+
+template <typename TParametersValueType, unsigned int NDimensions, unsigned int VSplineOrder>
+bool
+BSplineBaseTransform<TParametersValueType, NDimensions, VSplineOrder>::ComputeSparseJacobianWithRespectToParameters(
+  const InputPointType &    point,
+  WeightsType &             weights,
+  ParameterIndexArrayType & indices) const
+{
+  const ImageType * coefficientImage = this->m_CoefficientImages[0];
+
   ContinuousIndexType index =
-    this->m_CoefficientImages[0]->template TransformPhysicalPointToContinuousIndex<TParametersValueType>(point);
+    coefficientImage->template TransformPhysicalPointToContinuousIndex<typename ContinuousIndexType::ValueType>(point);
 
   // NOTE: if the support region does not lie totally within the grid
-  // we assume zero displacement and return the input point
+  // we assume zero displacement, so that all the derivatives are zero
   if (!this->InsideValidRegion(index))
   {
     weights.Fill(0.0);
-    indexes.Fill(0);
-    return;
+    indices.Fill(0);
+    return false;
   }
 
   // Compute interpolation weights
   IndexType supportIndex;
   this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
 
-  // For each dimension, copy the weight to the support region
-  RegionType supportRegion;
-  SizeType   supportSize;
-  supportSize.Fill(SplineOrder + 1);
-  supportRegion.SetSize(supportSize);
-  supportRegion.SetIndex(supportIndex);
-  unsigned long counter = 0;
-
-  using IteratorType = ImageRegionIterator<ImageType>;
-
-  IteratorType                coeffIterator = IteratorType(this->m_CoefficientImages[0], supportRegion);
-  const ParametersValueType * basePointer = this->m_CoefficientImages[0]->GetBufferPointer();
-  while (!coeffIterator.IsAtEnd())
+  // The weights are ordered like the coefficients of the support region in
+  // the buffer, the first dimension varying fastest
+  const OffsetValueType * offsetTable = coefficientImage->GetOffsetTable();
+  const OffsetValueType   supportOffset = coefficientImage->ComputeOffset(supportIndex);
+  for (unsigned int k = 0; k < NumberOfWeights; ++k)
   {
-    indexes[counter] = &(coeffIterator.Value()) - basePointer;
-
-    // go to next coefficient in the support region
-    ++counter;
-    ++coeffIterator;
+    OffsetValueType offset = supportOffset;
+    unsigned int    position = k;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      offset += static_cast<OffsetValueType>(position % (SplineOrder + 1)) * offsetTable[d];
+      position /= SplineOrder + 1;
+    }
+    indices[k] = static_cast<unsigned long>(offset);
   }
+  return true;
 }
 
 template <typename TParametersValueType, unsigned int NDimensions, unsigned int VSplineOrder>
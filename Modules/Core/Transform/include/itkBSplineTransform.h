@@ -239,6 +239,13 @@ public:
                  ParameterIndexArrayType & indices,
                  bool &                    inside) const override;
 
+  /** Transform the points, with the offsets of the coefficients of the
+   * support region computed once for all the points. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /** Compute the Jacobian in one position. */
   void
   ComputeJacobianWithRespectToParameters(const InputPointType &, JacobianType &) const override;
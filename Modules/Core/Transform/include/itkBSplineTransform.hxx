@@ -599,6 +599,77 @@ BSplineTransform<TParametersValueType, NDimensions, VSplineOrder>::TransformPoin
   }
 }
 
+template <typename TParametersValueType, unsigned int NDimensions, unsigned int VSplineOrder>
+void
+BSplineTransform<TParametersValueType, NDimensions, VSplineOrder>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  const ImageType * coefficientImage = this->m_CoefficientImages[0];
+  if (!coefficientImage->GetBufferPointer())
+  {
+    Superclass::TransformPoints(inputPoints, outputPoints, numberOfPoints);
+    return;
+  }
+
+  // Offsets of the coefficients of the support region from its first
+  // coefficient, in the order of the weights, the first dimension varying
+  // fastest
+  const OffsetValueType * offsetTable = coefficientImage->GetOffsetTable();
+  OffsetValueType         supportOffsets[Self::NumberOfWeights];
+  for (unsigned int k = 0; k < Self::NumberOfWeights; ++k)
+  {
+    supportOffsets[k] = 0;
+    unsigned int position = k;
+    for (unsigned int d = 0; d < SpaceDimension; ++d)
+    {
+      supportOffsets[k] += static_cast<OffsetValueType>(position % (SplineOrder + 1)) * offsetTable[d];
+      position /= SplineOrder + 1;
+    }
+  }
+  const ParametersValueType * coefficients[SpaceDimension];
+  for (unsigned int j = 0; j < SpaceDimension; ++j)
+  {
+    coefficients[j] = this->m_CoefficientImages[j]->GetBufferPointer();
+  }
+
+  WeightsType weights;
+  IndexType   supportIndex;
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    // Copy of the input point, as the output may overwrite it.
+    const InputPointType point = inputPoints[p];
+    ContinuousIndexType  index = coefficientImage->template TransformPhysicalPointToContinuousIndex<
+      typename ContinuousIndexType::ValueType>(point);
+
+    // NOTE: if the support region does not lie totally within the grid
+    // we assume zero displacement and return the input point
+    if (!this->InsideValidRegion(index))
+    {
+      outputPoints[p] = point;
+      continue;
+    }
+
+    this->m_WeightsFunction->Evaluate(index, weights, supportIndex);
+    const OffsetValueType supportOffset = coefficientImage->ComputeOffset(supportIndex);
+
+    ScalarType displacement[SpaceDimension] = {};
+    for (unsigned int k = 0; k < Self::NumberOfWeights; ++k)
+    {
+      const OffsetValueType offset = supportOffset + supportOffsets[k];
+      for (unsigned int j = 0; j < SpaceDimension; ++j)
+      {
+        displacement[j] += static_cast<ScalarType>(weights[k] * coefficients[j][offset]);
+      }
+    }
+    for (unsigned int j = 0; j < SpaceDimension; ++j)
+    {
+      outputPoints[p][j] = displacement[j] + point[j];
+    }
+  }
+}
+
 template <typename TParametersValueType, unsigned int NDimensions, unsigned int VSplineOrder>
 void
 BSplineTransform<TParametersValueType, NDimensions, VSplineOrder>::ComputeJacobianWithRespectToParameters(
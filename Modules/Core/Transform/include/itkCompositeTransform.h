@@ -20,6 +20,7 @@
 
 #include "itkMultiTransform.h"
 
+#include <algorithm>
 #include <deque>
 
 namespace itk
@@ -258,6 +259,15 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Transform the points by each transform of the queue in turn, in the
+   * same order as TransformPoint(). Each transform processes all the points
+   * in place with its own TransformPoints(), instead of composing the
+   * transforms point by point. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
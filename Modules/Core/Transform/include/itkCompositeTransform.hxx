@@ -81,6 +81,25 @@ CompositeTransform<TParametersValueType, NDimensions>::TransformPoint(const Inpu
 }
 
 
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+CompositeTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                        OutputPointType *      outputPoints,
+                                                                        SizeValueType          numberOfPoints) const
+{
+  if (outputPoints != inputPoints)
+  {
+    std::copy(inputPoints, inputPoints + numberOfPoints, outputPoints);
+  }
+
+  /* Apply in reverse queue order.  */
+  for (auto it = this->m_TransformQueue.rbegin(); it != this->m_TransformQueue.rend(); ++it)
+  {
+    (*it)->TransformPoints(outputPoints, outputPoints, numberOfPoints);
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int NDimensions>
 auto
 CompositeTransform<TParametersValueType, NDimensions>::TransformVector(const InputVectorType & inputVector) const
@@ -394,6 +394,14 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  /** Transform the points by the matrix and offset, without virtual calls.
+   * Subclasses that override TransformPoint must also override this
+   * method. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   using Superclass::TransformVector;
 
   OutputVectorType
@@ -137,6 +137,43 @@ MatrixOffsetTransformBase<TParametersValueType, NInputDimensions, NOutputDimensi
 }
 
 
+template <typename TParametersValueType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void
+MatrixOffsetTransformBase<TParametersValueType, NInputDimensions, NOutputDimensions>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  // Local copies of the matrix and offset, which the compiler can keep in
+  // registers over the loop.
+  TParametersValueType matrix[NOutputDimensions][NInputDimensions];
+  TParametersValueType offset[NOutputDimensions];
+  for (unsigned int i = 0; i < NOutputDimensions; ++i)
+  {
+    for (unsigned int j = 0; j < NInputDimensions; ++j)
+    {
+      matrix[i][j] = m_Matrix[i][j];
+    }
+    offset[i] = m_Offset[i];
+  }
+
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    // Copy of the input point, as the output may overwrite it.
+    const InputPointType point = inputPoints[p];
+    for (unsigned int i = 0; i < NOutputDimensions; ++i)
+    {
+      TParametersValueType value = NumericTraits<TParametersValueType>::ZeroValue();
+      for (unsigned int j = 0; j < NInputDimensions; ++j)
+      {
+        value += matrix[i][j] * point[j];
+      }
+      outputPoints[p][i] = value + offset[i];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 typename MatrixOffsetTransformBase<TParametersValueType, NInputDimensions, NOutputDimensions>::OutputVectorType
 MatrixOffsetTransformBase<TParametersValueType, NInputDimensions, NOutputDimensions>::TransformVector(
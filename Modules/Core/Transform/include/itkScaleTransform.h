@@ -155,6 +155,12 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & point) const override;
 
+  /** Scale the points, without virtual calls. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   using Superclass::TransformVector;
   OutputVectorType
   TransformVector(const InputVectorType & vect) const override;
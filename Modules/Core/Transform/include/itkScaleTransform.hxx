@@ -117,6 +117,24 @@ ScaleTransform<TParametersValueType, NDimensions>::TransformPoint(const InputPoi
 }
 
 
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+ScaleTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                    OutputPointType *      outputPoints,
+                                                                    SizeValueType          numberOfPoints) const
+{
+  const InputPointType center = this->GetCenter();
+  const ScaleType      scale = m_Scale;
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    for (unsigned int i = 0; i < SpaceDimension; ++i)
+    {
+      outputPoints[p][i] = (inputPoints[p][i] - center[i]) * scale[i] + center[i];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int NDimensions>
 auto
 ScaleTransform<TParametersValueType, NDimensions>::TransformVector(const InputVectorType & vect) const
@@ -180,6 +180,24 @@ public:
   virtual OutputPointType
   TransformPoint(const InputPointType &) const = 0;
 
+  /** Method to transform the numberOfPoints points of inputPoints into
+   * outputPoints. The default implementation calls TransformPoint() for
+   * each point. The transforms that override it transform all the points
+   * without virtual calls; a subclass that overrides TransformPoint() must
+   * then also override this method. When the input and output point types
+   * are the same, inputPoints and outputPoints may be the same array.
+   * \warning This method must be thread-safe. */
+  virtual void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const
+  {
+    for (SizeValueType i = 0; i < numberOfPoints; ++i)
+    {
+      outputPoints[i] = this->TransformPoint(inputPoints[i]);
+    }
+  }
+
   /**  Method to transform a vector. */
   virtual OutputVectorType
   TransformVector(const InputVectorType &) const
@@ -126,6 +126,23 @@ TranslationTransform<TParametersValueType, NDimensions>::TransformPoint(const In
 }
 
 
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+TranslationTransform<TParametersValueType, NDimensions>::TransformPoints(const InputPointType * inputPoints,
+                                                                          OutputPointType *      outputPoints,
+                                                                          SizeValueType          numberOfPoints) const
+{
+  const OutputVectorType offset = m_Offset;
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    for (unsigned int i = 0; i < NDimensions; ++i)
+    {
+      outputPoints[p][i] = inputPoints[p][i] + offset[i];
+    }
+  }
+}
+
+
 template <typename TParametersValueType, unsigned int NDimensions>
 auto
 TranslationTransform<TParametersValueType, NDimensions>::TransformVector(const InputVectorType & vect) const
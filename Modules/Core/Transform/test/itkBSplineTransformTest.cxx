@@ -316,6 +316,35 @@ itkBSplineTransformTest1()
     std::cout << std::endl;
   }
 
+  /**
+   * The sparse Jacobian must hold the non-zero entries of the Jacobian
+   */
+  for (const double value : { 7.5, 4.25, 11.0, -10.0 })
+  {
+    inputPoint.Fill(value);
+    JacobianType jacobian;
+    transform->ComputeJacobianWithRespectToParameters(inputPoint, jacobian);
+
+    TransformType::WeightsType             weights;
+    TransformType::ParameterIndexArrayType indices;
+    const bool inside = transform->ComputeSparseJacobianWithRespectToParameters(inputPoint, weights, indices);
+
+    JacobianType sparseJacobian(SpaceDimension, transform->GetNumberOfParameters());
+    sparseJacobian.Fill(0.0);
+    for (unsigned int k = 0; k < TransformType::NumberOfWeights; ++k)
+    {
+      for (j = 0; j < SpaceDimension; ++j)
+      {
+        sparseJacobian(j, indices[k] + j * transform->GetNumberOfParametersPerDimension()) += weights[k];
+      }
+    }
+    if (sparseJacobian != jacobian || inside != (value > 0.0))
+    {
+      std::cout << "Error in ComputeSparseJacobianWithRespectToParameters() at " << inputPoint << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   /**
    * TODO: add test to check the numerical accuarcy of the jacobian output
    */
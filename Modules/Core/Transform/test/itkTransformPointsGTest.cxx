@@ -0,0 +1,157 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header files to be tested:
+#include "itkAffineTransform.h"
+#include "itkBSplineTransform.h"
+#include "itkCompositeTransform.h"
+#include "itkScaleTransform.h"
+#include "itkTranslationTransform.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+
+namespace
+{
+constexpr unsigned int Dimension = 3;
+
+using PointType = itk::Point<double, Dimension>;
+
+
+// Returns random points in [minimum, maximum) along each dimension.
+std::vector<PointType>
+GenerateRandomPoints(const size_t numberOfPoints, const double minimum, const double maximum)
+{
+  std::mt19937                           randomNumberEngine;
+  std::uniform_real_distribution<double> distribution(minimum, maximum);
+
+  std::vector<PointType> points(numberOfPoints);
+  for (auto & point : points)
+  {
+    for (auto & coordinate : point)
+    {
+      coordinate = distribution(randomNumberEngine);
+    }
+  }
+  return points;
+}
+
+
+// Expects that TransformPoints gives exactly the same points as TransformPoint, both into a separate array and in
+// place.
+template <typename TTransform>
+void
+Expect_TransformPoints_equals_TransformPoint(const TTransform & transform, const std::vector<PointType> & points)
+{
+  std::vector<PointType> outputPoints(points.size());
+  transform.TransformPoints(points.data(), outputPoints.data(), points.size());
+
+  std::vector<PointType> inPlacePoints(points);
+  transform.TransformPoints(inPlacePoints.data(), inPlacePoints.data(), inPlacePoints.size());
+
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const PointType expectedPoint = transform.TransformPoint(points[i]);
+    EXPECT_EQ(outputPoints[i], expectedPoint) << " point " << i << ": " << points[i];
+    EXPECT_EQ(inPlacePoints[i], expectedPoint) << " point " << i << " (in place): " << points[i];
+  }
+}
+
+
+itk::AffineTransform<double, Dimension>::Pointer
+CreateAffineTransform()
+{
+  auto transform = itk::AffineTransform<double, Dimension>::New();
+  transform->Rotate3D(itk::Vector<double, Dimension>(1.0), 0.3);
+  transform->Scale(itk::Vector<double, Dimension>(1.1));
+  transform->Translate(itk::Vector<double, Dimension>(0.5));
+  transform->SetCenter(PointType(2.0));
+  return transform;
+}
+
+
+itk::BSplineTransform<double, Dimension>::Pointer
+CreateBSplineTransform()
+{
+  using TransformType = itk::BSplineTransform<double, Dimension>;
+
+  auto transform = TransformType::New();
+  transform->SetTransformDomainOrigin(PointType(0.0));
+  transform->SetTransformDomainPhysicalDimensions(TransformType::PhysicalDimensionsType(10.0));
+  transform->SetTransformDomainMeshSize(TransformType::MeshSizeType::Filled(4));
+
+  std::mt19937                           randomNumberEngine;
+  std::uniform_real_distribution<double> distribution(-1.0, 1.0);
+
+  TransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (unsigned int i = 0; i < parameters.size(); ++i)
+  {
+    parameters[i] = distribution(randomNumberEngine);
+  }
+  transform->SetParametersByValue(parameters);
+  return transform;
+}
+
+} // namespace
+
+
+TEST(TransformPoints, AffineTransformEqualsTransformPoint)
+{
+  Expect_TransformPoints_equals_TransformPoint(*CreateAffineTransform(), GenerateRandomPoints(100, -20.0, 20.0));
+}
+
+
+TEST(TransformPoints, TranslationTransformEqualsTransformPoint)
+{
+  auto transform = itk::TranslationTransform<double, Dimension>::New();
+  transform->SetOffset(itk::Vector<double, Dimension>(0.25));
+  Expect_TransformPoints_equals_TransformPoint(*transform, GenerateRandomPoints(100, -20.0, 20.0));
+}
+
+
+TEST(TransformPoints, ScaleTransformEqualsTransformPoint)
+{
+  auto transform = itk::ScaleTransform<double, Dimension>::New();
+  transform->SetScale(itk::FixedArray<double, Dimension>(1.5));
+  transform->SetCenter(PointType(3.0));
+  Expect_TransformPoints_equals_TransformPoint(*transform, GenerateRandomPoints(100, -20.0, 20.0));
+}
+
+
+// Tests points both inside and outside of the support of the BSpline.
+TEST(TransformPoints, BSplineTransformEqualsTransformPoint)
+{
+  Expect_TransformPoints_equals_TransformPoint(*CreateBSplineTransform(), GenerateRandomPoints(1000, -2.0, 12.0));
+}
+
+
+TEST(TransformPoints, CompositeTransformEqualsTransformPoint)
+{
+  auto transform = itk::CompositeTransform<double, Dimension>::New();
+  transform->AddTransform(CreateAffineTransform());
+  transform->AddTransform(CreateBSplineTransform());
+
+  auto translation = itk::TranslationTransform<double, Dimension>::New();
+  translation->SetOffset(itk::Vector<double, Dimension>(-0.5));
+  transform->AddTransform(translation);
+
+  Expect_TransformPoints_equals_TransformPoint(*transform, GenerateRandomPoints(1000, -2.0, 12.0));
+}
@@ -41,6 +41,13 @@ namespace itk
  * of the kernel image and treats them as identical to those in the
  * input image.
  *
+ * By default, the whole padded input is transformed at once. When a
+ * BlockSize is set, the output requested region is instead computed
+ * block by block with the overlap-save method, and only the region of
+ * the input needed by the output requested region is requested, so that
+ * large images can be convolved in bounded memory, for example with a
+ * StreamingImageFilter.
+ *
  * This code was adapted from the Insight Journal contribution:
  *
  * "FFT Based Convolution"
@@ -107,6 +114,18 @@ public:
   itkSetMacro(SizeGreatestPrimeFactor, SizeValueType);
   itkGetMacro(SizeGreatestPrimeFactor, SizeValueType);
 
+  /** Set/Get the size of the blocks of the output computed by each Fourier
+   * transform. When a component is non-zero, the output requested region is
+   * split in blocks computed with the overlap-save method: each block is
+   * computed from the block of the input it depends on, padded by the kernel
+   * size, and the transform of the kernel is computed once for all the
+   * blocks. A zero component makes the blocks span the output requested
+   * region in that dimension. The blocks are enlarged to use the padding
+   * needed to get a size suitable for the FFT. The default, all zeros,
+   * transforms the whole padded input at once. */
+  itkSetMacro(BlockSize, InputSizeType);
+  itkGetConstReferenceMacro(BlockSize, InputSizeType);
+
 protected:
   FFTConvolutionImageFilter();
   ~FFTConvolutionImageFilter() override = default;
@@ -130,6 +149,22 @@ protected:
   void
   GenerateData() override;
 
+  /** Whether the output is computed block by block, as set by the
+   * BlockSize. */
+  bool
+  GetUseBlocks() const;
+
+  /** Compute the output requested region block by block, with the
+   * overlap-save method. */
+  void
+  BlockGenerateData();
+
+  /** Get the transform of the kernel, normalized if requested, and zero
+   * padded to fftSize. The transform is kept between the executions of the
+   * filter, as long as the kernel and the size do not change. */
+  InternalComplexImageType *
+  GetBlockKernelTransform(const KernelImageType * kernel, const InputSizeType & fftSize);
+
   /** Prepare the input images for operations in the Fourier
    * domain. This includes resizing the input and kernel images,
    * normalizing the kernel if requested, shifting the kernel, and
@@ -203,6 +238,11 @@ protected:
 
 private:
   SizeValueType m_SizeGreatestPrimeFactor;
+  InputSizeType m_BlockSize;
+
+  InternalComplexImagePointerType m_BlockKernelTransform;
+  InputSizeType                   m_BlockKernelTransformSize;
+  TimeStamp                       m_BlockKernelTransformTime;
 };
 } // namespace itk
 
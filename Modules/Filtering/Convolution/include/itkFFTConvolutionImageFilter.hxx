@@ -26,9 +26,12 @@
 #include "itkCyclicShiftImageFilter.h"
 #include "itkExtractImageFilter.h"
 #include "itkImageBase.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkMultiplyImageFilter.h"
 #include "itkNormalizeToConstantImageFilter.h"
 #include "itkMath.h"
+#include "itkProgressReporter.h"
 
 namespace itk
 {
@@ -37,14 +40,37 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::FFTConvolutionImageFilter()
 {
   m_SizeGreatestPrimeFactor = FFTFilterType::New()->GetSizeGreatestPrimeFactor();
+  m_BlockSize.Fill(0);
+  m_BlockKernelTransformSize.Fill(0);
 }
 
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateInputRequestedRegion()
 {
+  if (this->GetUseBlocks() && this->GetInput() && this->GetKernelImage())
+  {
+    // Request the region of the input covered by the kernel when it is
+    // centered on the pixels of the output requested region.
+    typename InputImageType::Pointer imagePtr = const_cast<InputImageType *>(this->GetInput());
+    const KernelSizeType kernelSize = this->GetKernelImage()->GetLargestPossibleRegion().GetSize();
+
+    InputRegionType requestedRegion = this->GetOutput()->GetRequestedRegion();
+    InputIndexType  requestedIndex = requestedRegion.GetIndex();
+    InputSizeType   requestedSize = requestedRegion.GetSize();
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      requestedIndex[i] -= static_cast<IndexValueType>(kernelSize[i] - 1 - kernelSize[i] / 2);
+      requestedSize[i] += kernelSize[i] - 1;
+    }
+    requestedRegion.SetIndex(requestedIndex);
+    requestedRegion.SetSize(requestedSize);
+
+    imagePtr->SetRequestedRegion(
+      this->GetBoundaryCondition()->GetInputRequestedRegion(imagePtr->GetLargestPossibleRegion(), requestedRegion));
+  }
   // Request the largest possible region for both input images.
-  if (this->GetInput())
+  else if (this->GetInput())
   {
     typename InputImageType::Pointer imagePtr = const_cast<InputImageType *>(this->GetInput());
     imagePtr->SetRequestedRegionToLargestPossibleRegion();
@@ -63,6 +89,12 @@ template <typename TInputImage, typename TKernelImage, typename TOutputImage, ty
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GenerateData()
 {
+  if (this->GetUseBlocks())
+  {
+    this->BlockGenerateData();
+    return;
+  }
+
   // Create a process accumulator for tracking the progress of this minipipeline
   auto progress = ProgressAccumulator::New();
   progress->SetMiniPipelineFilter(this);
@@ -91,6 +123,222 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
   this->ProduceOutput(multiplyFilter->GetOutput(), progress, 0.2);
 }
 
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+bool
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetUseBlocks() const
+{
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    if (m_BlockSize[i] > 0)
+    {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+void
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::BlockGenerateData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType *  input = this->GetInput();
+  const KernelImageType * kernel = this->GetKernelImage();
+  OutputImageType *       output = this->GetOutput();
+  BoundaryConditionType * boundaryCondition = this->GetBoundaryCondition();
+
+  const InputRegionType outputRegion = output->GetRequestedRegion();
+  if (outputRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+  const InputIndexType & outputIndex = outputRegion.GetIndex();
+  const InputSizeType &  outputSize = outputRegion.GetSize();
+  const KernelSizeType   kernelSize = kernel->GetLargestPossibleRegion().GetSize();
+
+  // Each block of the output is the valid part of the circular
+  // convolution of the kernel with the block of the input it depends on.
+  // The block is enlarged so that this padded block has a size suitable
+  // for the FFT.
+  InputSizeType  blockSize;
+  InputSizeType  fftSize;
+  InputSizeType  numberOfBlocks;
+  InputIndexType lowerMargin;
+  SizeValueType  totalNumberOfBlocks = 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    blockSize[i] = m_BlockSize[i] > 0 ? std::min(m_BlockSize[i], outputSize[i]) : outputSize[i];
+    fftSize[i] = blockSize[i] + kernelSize[i] - 1;
+    if (m_SizeGreatestPrimeFactor > 1)
+    {
+      while (Math::GreatestPrimeFactor(fftSize[i]) > m_SizeGreatestPrimeFactor)
+      {
+        fftSize[i]++;
+      }
+    }
+    blockSize[i] = std::min(fftSize[i] - kernelSize[i] + 1, outputSize[i]);
+    numberOfBlocks[i] = (outputSize[i] + blockSize[i] - 1) / blockSize[i];
+    totalNumberOfBlocks *= numberOfBlocks[i];
+    lowerMargin[i] = static_cast<IndexValueType>(kernelSize[i] - 1 - kernelSize[i] / 2);
+  }
+
+  const InternalComplexImageType * kernelTransform = this->GetBlockKernelTransform(kernel, fftSize);
+
+  ProgressReporter progress(this, 0, totalNumberOfBlocks);
+
+  const InputRegionType & inputRegion = input->GetLargestPossibleRegion();
+  InputIndexType          fftIndex;
+  fftIndex.Fill(0);
+  const InputRegionType fftRegion(fftIndex, fftSize);
+
+  for (SizeValueType block = 0; block < totalNumberOfBlocks; ++block)
+  {
+    // Locate the block of the output and the block of the input it
+    // depends on.
+    InputIndexType blockIndex;
+    InputSizeType  currentBlockSize;
+    InputIndexType sourceIndex;
+    InputSizeType  sourceSize;
+    InputIndexType validIndex;
+    SizeValueType  remainder = block;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      const SizeValueType position = (remainder % numberOfBlocks[i]) * blockSize[i];
+      remainder /= numberOfBlocks[i];
+      blockIndex[i] = outputIndex[i] + static_cast<IndexValueType>(position);
+      currentBlockSize[i] = std::min(blockSize[i], outputSize[i] - position);
+      sourceIndex[i] = blockIndex[i] - lowerMargin[i];
+      sourceSize[i] = currentBlockSize[i] + kernelSize[i] - 1;
+      validIndex[i] = static_cast<IndexValueType>(kernelSize[i] - 1);
+    }
+    const InputRegionType sourceRegion(sourceIndex, sourceSize);
+    const InputRegionType paddedSourceRegion(fftIndex, sourceSize);
+
+    // Copy the block of the input, extended with the boundary condition,
+    // into a zero padded image.
+    auto paddedBlock = InternalImageType::New();
+    paddedBlock->SetRegions(fftRegion);
+    paddedBlock->Allocate(true);
+    if (inputRegion.IsInside(sourceRegion))
+    {
+      ImageRegionConstIterator<InputImageType> inputIt(input, sourceRegion);
+      ImageRegionIterator<InternalImageType>   paddedIt(paddedBlock, paddedSourceRegion);
+      for (; !inputIt.IsAtEnd(); ++inputIt, ++paddedIt)
+      {
+        paddedIt.Set(static_cast<TInternalPrecision>(inputIt.Get()));
+      }
+    }
+    else
+    {
+      ImageRegionIteratorWithIndex<InternalImageType> paddedIt(paddedBlock, paddedSourceRegion);
+      for (; !paddedIt.IsAtEnd(); ++paddedIt)
+      {
+        const InputIndexType index = sourceIndex + (paddedIt.GetIndex() - fftIndex);
+        if (inputRegion.IsInside(index))
+        {
+          paddedIt.Set(static_cast<TInternalPrecision>(input->GetPixel(index)));
+        }
+        else
+        {
+          paddedIt.Set(static_cast<TInternalPrecision>(boundaryCondition->GetPixel(index, input)));
+        }
+      }
+    }
+
+    auto fftFilter = FFTFilterType::New();
+    fftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    fftFilter->SetInput(paddedBlock);
+    fftFilter->Update();
+    InternalComplexImagePointerType transformedBlock = fftFilter->GetOutput();
+    transformedBlock->DisconnectPipeline();
+    fftFilter = nullptr;
+    paddedBlock = nullptr;
+
+    // Multiply by the transform of the kernel in place.
+    using ComplexType = typename InternalComplexImageType::PixelType;
+    ComplexType *       blockBuffer = transformedBlock->GetBufferPointer();
+    const ComplexType * kernelBuffer = kernelTransform->GetBufferPointer();
+    const SizeValueType numberOfPixels = transformedBlock->GetBufferedRegion().GetNumberOfPixels();
+    for (SizeValueType p = 0; p < numberOfPixels; ++p)
+    {
+      blockBuffer[p] *= kernelBuffer[p];
+    }
+
+    auto ifftFilter = IFFTFilterType::New();
+    ifftFilter->SetActualXDimensionIsOdd(fftSize[0] % 2 != 0);
+    ifftFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+    ifftFilter->SetInput(transformedBlock);
+    ifftFilter->Update();
+
+    // The first kernelSize - 1 pixels of the circular convolution are
+    // aliased, the next ones are the convolution of the output block.
+    const InputRegionType                        validRegion(validIndex, currentBlockSize);
+    ImageRegionConstIterator<InternalImageType> convolvedIt(ifftFilter->GetOutput(), validRegion);
+    ImageRegionIterator<OutputImageType>        outputIt(output, InputRegionType(blockIndex, currentBlockSize));
+    for (; !convolvedIt.IsAtEnd(); ++convolvedIt, ++outputIt)
+    {
+      outputIt.Set(static_cast<OutputPixelType>(convolvedIt.Get()));
+    }
+
+    progress.CompletedPixel();
+  }
+}
+
+template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
+auto
+FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::GetBlockKernelTransform(
+  const KernelImageType * kernel,
+  const InputSizeType &   fftSize) -> InternalComplexImageType *
+{
+  if (m_BlockKernelTransform && m_BlockKernelTransformSize == fftSize &&
+      m_BlockKernelTransformTime.GetMTime() > kernel->GetMTime() &&
+      m_BlockKernelTransformTime.GetMTime() > this->GetMTime())
+  {
+    return m_BlockKernelTransform;
+  }
+
+  // Zero pad the kernel, without shifting it: the shift is accounted for
+  // by the position of the input blocks.
+  const KernelRegionType & kernelRegion = kernel->GetLargestPossibleRegion();
+  InputIndexType           fftIndex;
+  fftIndex.Fill(0);
+
+  auto paddedKernel = InternalImageType::New();
+  paddedKernel->SetRegions(InputRegionType(fftIndex, fftSize));
+  paddedKernel->Allocate(true);
+
+  ImageRegionConstIterator<KernelImageType> kernelIt(kernel, kernelRegion);
+  ImageRegionIterator<InternalImageType>    paddedIt(paddedKernel, InputRegionType(fftIndex, kernelRegion.GetSize()));
+  TInternalPrecision                        sum = NumericTraits<TInternalPrecision>::ZeroValue();
+  for (; !kernelIt.IsAtEnd(); ++kernelIt, ++paddedIt)
+  {
+    const auto value = static_cast<TInternalPrecision>(kernelIt.Get());
+    paddedIt.Set(value);
+    sum += value;
+  }
+
+  if (this->GetNormalize())
+  {
+    for (paddedIt.GoToBegin(); !paddedIt.IsAtEnd(); ++paddedIt)
+    {
+      paddedIt.Set(paddedIt.Get() / sum);
+    }
+  }
+
+  auto kernelFFTFilter = FFTFilterType::New();
+  kernelFFTFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  kernelFFTFilter->SetInput(paddedKernel);
+  kernelFFTFilter->Update();
+
+  m_BlockKernelTransform = kernelFFTFilter->GetOutput();
+  m_BlockKernelTransform->DisconnectPipeline();
+  m_BlockKernelTransformSize = fftSize;
+  m_BlockKernelTransformTime.Modified();
+
+  return m_BlockKernelTransform;
+}
+
 template <typename TInputImage, typename TKernelImage, typename TOutputImage, typename TInternalPrecision>
 void
 FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrecision>::PrepareInputs(
@@ -415,6 +663,7 @@ FFTConvolutionImageFilter<TInputImage, TKernelImage, TOutputImage, TInternalPrec
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "SizeGreatestPrimeFactor: " << m_SizeGreatestPrimeFactor << std::endl;
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
 }
 
 } // namespace itk
@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFFTDiscreteGaussianImageFilter_h
+#define itkFFTDiscreteGaussianImageFilter_h
+
+#include "itkDiscreteGaussianImageFilter.h"
+#include "ITKConvolutionExport.h"
+
+#include <type_traits>
+
+namespace itk
+{
+/**\class FFTDiscreteGaussianImageFilterEnums
+ * \brief Contains all enum classes used by FFTDiscreteGaussianImageFilter class.
+ * \ingroup ITKConvolution
+ */
+class FFTDiscreteGaussianImageFilterEnums
+{
+public:
+  /**\class Algorithm
+   * \ingroup ITKConvolution
+   * Algorithm used to convolve the image by the Gaussian kernel. */
+  enum class Algorithm : uint8_t
+  {
+    /** FFT if the kernel is large enough for the image size, otherwise Separable. */
+    Automatic = 0,
+    /** Separable convolution by the 1D kernels, as by DiscreteGaussianImageFilter. */
+    Separable = 1,
+    /** Multiplication by the whole kernel in the Fourier domain, for scalar pixel types. */
+    FFT = 2
+  };
+};
+// Define how to print enumeration
+extern ITKConvolution_EXPORT std::ostream &
+                             operator<<(std::ostream & out, const FFTDiscreteGaussianImageFilterEnums::Algorithm value);
+
+/**
+ *\class FFTDiscreteGaussianImageFilter
+ * \brief Blurs an image by convolution with a discrete gaussian kernel,
+ * choosing between a separable and an FFT based convolution.
+ *
+ * This filter computes the same Gaussian kernel as its superclass,
+ * DiscreteGaussianImageFilter. The separable convolution costs O(w) per
+ * pixel and dimension, for a kernel of width w, while the convolution in
+ * the Fourier domain costs O(log N) per pixel, for an image of N pixels,
+ * whatever the width of the kernel. By default, the filter estimates both
+ * costs from the kernel radius and the size of the requested region, and
+ * uses the cheapest one. SetAlgorithm() allows to choose one of them
+ * explicitly.
+ *
+ * The FFT based convolution is performed by FFTConvolutionImageFilter on
+ * the buffered region of the input, using the input boundary condition.
+ * Its output only differs from the separable convolution by rounding
+ * errors, except for integer output pixel types, for which the separable
+ * convolution rounds the intermediate image of each dimension.
+ *
+ * \sa DiscreteGaussianImageFilter
+ * \sa FFTConvolutionImageFilter
+ *
+ * \ingroup ImageEnhancement
+ * \ingroup ImageFeatureExtraction
+ * \ingroup ITKConvolution
+ */
+template <typename TInputImage, typename TOutputImage = TInputImage>
+class ITK_TEMPLATE_EXPORT FFTDiscreteGaussianImageFilter : public DiscreteGaussianImageFilter<TInputImage, TOutputImage>
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(FFTDiscreteGaussianImageFilter);
+
+  /** Standard class type aliases. */
+  using Self = FFTDiscreteGaussianImageFilter;
+  using Superclass = DiscreteGaussianImageFilter<TInputImage, TOutputImage>;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(FFTDiscreteGaussianImageFilter, DiscreteGaussianImageFilter);
+
+  /** Image type information. */
+  using typename Superclass::InputImageType;
+  using typename Superclass::OutputImageType;
+  using typename Superclass::InputPixelType;
+  using typename Superclass::OutputPixelType;
+  using typename Superclass::RealOutputPixelValueType;
+  using typename Superclass::KernelType;
+  using typename Superclass::RadiusType;
+
+  /** Extract some information from the image types.  Dimensionality
+   * of the two images is assumed to be the same. */
+  static constexpr unsigned int ImageDimension = TOutputImage::ImageDimension;
+
+  /** Image of the Gaussian kernel, convolved in the Fourier domain. */
+  using KernelImageType = Image<RealOutputPixelValueType, ImageDimension>;
+
+  using AlgorithmEnum = FFTDiscreteGaussianImageFilterEnums::Algorithm;
+
+  /** Set/Get the algorithm used to convolve the image. Defaults to
+   * Automatic. */
+  itkSetEnumMacro(Algorithm, AlgorithmEnum);
+  itkGetEnumMacro(Algorithm, AlgorithmEnum);
+
+  /** Returns whether the filter convolves in the Fourier domain, with its
+   * current algorithm, pixel types, kernel and output requested region. */
+  bool
+  GetUseFFT() const;
+
+  /** Returns the image of the Gaussian kernel, the outer product of the
+   * 1D kernels along the dimensions to smooth. */
+  typename KernelImageType::Pointer
+  GenerateKernelImage() const;
+
+protected:
+  FFTDiscreteGaussianImageFilter() = default;
+  ~FFTDiscreteGaussianImageFilter() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  void
+  VerifyPreconditions() ITKv5_CONST override;
+
+  /** Convolves in the Fourier domain when GetUseFFT() is true, otherwise
+   * calls DiscreteGaussianImageFilter::GenerateData(). */
+  void
+  GenerateData() override;
+
+private:
+  /** Whether FFTConvolutionImageFilter supports the pixel types. */
+  using SupportsFFT = std::integral_constant<bool,
+                                             std::is_arithmetic<InputPixelType>::value &&
+                                               std::is_arithmetic<OutputPixelType>::value>;
+
+  /** Convolves the input by FFTConvolutionImageFilter. */
+  void
+  FFTGenerateData(std::true_type);
+  void
+  FFTGenerateData(std::false_type)
+  {}
+
+  AlgorithmEnum m_Algorithm{ AlgorithmEnum::Automatic };
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkFFTDiscreteGaussianImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkFFTDiscreteGaussianImageFilter_hxx
+#define itkFFTDiscreteGaussianImageFilter_hxx
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMath.h"
+#include "itkProgressAccumulator.h"
+
+#include <cmath>
+
+namespace itk
+{
+template <typename TInputImage, typename TOutputImage>
+bool
+FFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GetUseFFT() const
+{
+  switch (m_Algorithm)
+  {
+    case AlgorithmEnum::Separable:
+      return false;
+    case AlgorithmEnum::FFT:
+      return true;
+    default:
+      break;
+  }
+  if (!SupportsFFT::value || this->GetInput() == nullptr || this->GetValidFilterDimensionality() == 0)
+  {
+    return false;
+  }
+
+  // The separable convolution costs a multiply-add per pixel and kernel
+  // coefficient. The FFT based convolution costs the forward transforms of
+  // the padded input and kernel and the inverse transform of their product,
+  // in O(P log P) for P padded pixels. The cost factor is measured by
+  // itkFFTDiscreteGaussianImageFilterTest.
+  constexpr double fftCostFactor = 2.0;
+
+  const RadiusType radius = this->GetKernelRadius();
+  const auto       region = this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() > 0
+                              ? this->GetOutput()->GetRequestedRegion()
+                              : this->GetInput()->GetLargestPossibleRegion();
+
+  double numberOfPixels = 1.0;
+  double numberOfPaddedPixels = 1.0;
+  double kernelWidthSum = 0.0;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    const double kernelWidth = 2.0 * radius[i] + 1.0;
+    numberOfPixels *= region.GetSize(i);
+    numberOfPaddedPixels *= region.GetSize(i) + 2.0 * kernelWidth;
+    if (i < this->GetValidFilterDimensionality())
+    {
+      kernelWidthSum += kernelWidth;
+    }
+  }
+  const double separableCost = numberOfPixels * kernelWidthSum;
+  const double fftCost = fftCostFactor * numberOfPaddedPixels * std::log2(numberOfPaddedPixels);
+
+  return fftCost < separableCost;
+}
+
+template <typename TInputImage, typename TOutputImage>
+auto
+FFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateKernelImage() const ->
+  typename KernelImageType::Pointer
+{
+  const RadiusType radius = this->GetKernelRadius();
+
+  typename KernelImageType::SizeType kernelSize;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    kernelSize[i] = 2 * radius[i] + 1;
+  }
+
+  std::vector<KernelType> kernels(this->GetValidFilterDimensionality());
+  for (unsigned int i = 0; i < kernels.size(); ++i)
+  {
+    this->GenerateKernel(i, kernels[i]);
+  }
+
+  auto kernelImage = KernelImageType::New();
+  kernelImage->SetRegions(kernelSize);
+  kernelImage->Allocate();
+
+  // The kernel is the outer product of the 1D kernels, whose coefficients are
+  // stored along their own direction.
+  for (ImageRegionIteratorWithIndex<KernelImageType> it(kernelImage, kernelImage->GetLargestPossibleRegion());
+       !it.IsAtEnd();
+       ++it)
+  {
+    const auto               index = it.GetIndex();
+    RealOutputPixelValueType value = NumericTraits<RealOutputPixelValueType>::OneValue();
+    for (unsigned int i = 0; i < kernels.size(); ++i)
+    {
+      value *= kernels[i][static_cast<SizeValueType>(index[i])];
+    }
+    it.Set(value);
+  }
+  return kernelImage;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+FFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::VerifyPreconditions() ITKv5_CONST
+{
+  Superclass::VerifyPreconditions();
+
+  if (m_Algorithm == AlgorithmEnum::FFT && !SupportsFFT::value)
+  {
+    itkExceptionMacro("The FFT algorithm only supports scalar pixel types.");
+  }
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+FFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  if (this->GetUseFFT())
+  {
+    this->FFTGenerateData(SupportsFFT());
+    return;
+  }
+  Superclass::GenerateData();
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+FFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::FFTGenerateData(std::true_type)
+{
+  // Create a process accumulator for tracking the progress of minipipeline
+  auto progress = ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  // The requested region of the input is padded by the kernel radius, so
+  // the convolution of its buffered region, as if it were the whole image,
+  // provides the output requested region. This preserves streaming.
+  auto localInput = TInputImage::New();
+  localInput->Graft(this->GetInput());
+  localInput->SetLargestPossibleRegion(localInput->GetBufferedRegion());
+
+  using ConvolutionFilterType = FFTConvolutionImageFilter<TInputImage, KernelImageType, TOutputImage>;
+  auto convolutionFilter = ConvolutionFilterType::New();
+  convolutionFilter->SetInput(localInput);
+  convolutionFilter->SetKernelImage(this->GenerateKernelImage());
+  convolutionFilter->SetBoundaryCondition(this->GetInputBoundaryCondition());
+  convolutionFilter->SetNormalize(false);
+  convolutionFilter->SetOutputRegionModeToSame();
+  convolutionFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  convolutionFilter->GetOutput()->SetRequestedRegion(this->GetOutput()->GetRequestedRegion());
+  progress->RegisterInternalFilter(convolutionFilter, 1.0f);
+  convolutionFilter->Update();
+
+  // Only share the buffer of the convolution, whose output information is
+  // the one of the buffered region of the input.
+  OutputImageType * output = this->GetOutput();
+  output->SetBufferedRegion(convolutionFilter->GetOutput()->GetBufferedRegion());
+  output->SetPixelContainer(convolutionFilter->GetOutput()->GetPixelContainer());
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+FFTDiscreteGaussianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Algorithm: " << m_Algorithm << std::endl;
+}
+} // end namespace itk
+
+#endif
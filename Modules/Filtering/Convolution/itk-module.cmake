@@ -7,6 +7,7 @@ itk_module(ITKConvolution
   DEPENDS
     ITKFFT
     ITKImageIntensity
+    ITKSmoothing
     ITKThresholding
   TEST_DEPENDS
     ITKTestKernel
@@ -0,0 +1,40 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkFFTDiscreteGaussianImageFilter.h"
+
+namespace itk
+{
+/** Define how to print enumerations */
+std::ostream &
+operator<<(std::ostream & out, const FFTDiscreteGaussianImageFilterEnums::Algorithm value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case FFTDiscreteGaussianImageFilterEnums::Algorithm::Automatic:
+        return "itk::FFTDiscreteGaussianImageFilterEnums::Algorithm::Automatic";
+      case FFTDiscreteGaussianImageFilterEnums::Algorithm::Separable:
+        return "itk::FFTDiscreteGaussianImageFilterEnums::Algorithm::Separable";
+      case FFTDiscreteGaussianImageFilterEnums::Algorithm::FFT:
+        return "itk::FFTDiscreteGaussianImageFilterEnums::Algorithm::FFT";
+      default:
+        return "INVALID VALUE FOR itk::FFTDiscreteGaussianImageFilterEnums::Algorithm";
+    }
+  }();
+}
+} // namespace itk
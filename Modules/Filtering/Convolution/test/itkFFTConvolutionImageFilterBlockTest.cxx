@@ -0,0 +1,183 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTConvolutionImageFilter.h"
+#include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkPeriodicBoundaryCondition.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+#include "itkObjectFactoryBase.h"
+#include "itkVnlRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkVnlHalfHermitianToRealInverseFFTImageFilter.h"
+#if defined(ITK_USE_FFTWD) || defined(ITK_USE_FFTWF)
+#  include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#  include "itkFFTWHalfHermitianToRealInverseFFTImageFilter.h"
+#endif
+
+namespace
+{
+constexpr unsigned int Dimension = 2;
+using ImageType = itk::Image<float, Dimension>;
+using ConvolutionFilterType = itk::FFTConvolutionImageFilter<ImageType>;
+
+ImageType::Pointer
+MakeImage(const ImageType::IndexType & index, const ImageType::SizeType & size, unsigned int seed)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(index, size));
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & pixelIndex = it.GetIndex();
+    it.Set(static_cast<float>((pixelIndex[0] * 7 + pixelIndex[1] * 13 + seed) % 17) - 8.0f);
+  }
+  return image;
+}
+
+bool
+CompareImages(const ImageType * baseline, const ImageType * test, const std::string & description)
+{
+  if (baseline->GetLargestPossibleRegion() != test->GetLargestPossibleRegion())
+  {
+    std::cerr << description << ": the largest possible regions differ" << std::endl;
+    return false;
+  }
+
+  itk::ImageRegionConstIterator<ImageType> baselineIt(baseline, baseline->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> testIt(test, baseline->GetLargestPossibleRegion());
+  for (; !baselineIt.IsAtEnd(); ++baselineIt, ++testIt)
+  {
+    if (itk::Math::abs(baselineIt.Get() - testIt.Get()) > 1e-3)
+    {
+      std::cerr << description << ": expected " << baselineIt.Get() << " but got " << testIt.Get() << " at index "
+                << baselineIt.GetIndex() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkFFTConvolutionImageFilterBlockTest(int, char *[])
+{
+#ifndef ITK_FFT_FACTORY_REGISTER_MANAGER // Manual factory registration is required for ITK FFT tests
+#  if defined(ITK_USE_FFTWD) || defined(ITK_USE_FFTWF)
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::FFTWRealToHalfHermitianForwardFFTImageFilter>>();
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::FFTWHalfHermitianToRealInverseFFTImageFilter>>();
+#  endif
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::VnlRealToHalfHermitianForwardFFTImageFilter>>();
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::VnlHalfHermitianToRealInverseFFTImageFilter>>();
+#endif
+
+  ImageType::IndexType imageIndex = { { 3, -2 } };
+  ImageType::SizeType  imageSize = { { 61, 47 } };
+  ImageType::Pointer   image = MakeImage(imageIndex, imageSize, 0);
+
+  ImageType::IndexType kernelIndex = { { 0, 0 } };
+  ImageType::SizeType  kernelSizes[] = { { { 5, 3 } }, { { 4, 6 } } };
+
+  itk::ConstantBoundaryCondition<ImageType> constantBoundaryCondition;
+  constantBoundaryCondition.SetConstant(2.0f);
+  itk::PeriodicBoundaryCondition<ImageType> periodicBoundaryCondition;
+
+  const ConvolutionFilterType::BoundaryConditionPointerType boundaryConditions[] = {
+    nullptr, &constantBoundaryCondition, &periodicBoundaryCondition
+  };
+
+  // Blocks split along the first dimension only, along both dimensions,
+  // and larger than the image.
+  ImageType::SizeType blockSizes[] = { { { 16, 0 } }, { { 9, 11 } }, { { 100, 100 } } };
+
+  bool testPassed = true;
+  for (const auto & kernelSize : kernelSizes)
+  {
+    ImageType::Pointer kernel = MakeImage(kernelIndex, kernelSize, 5);
+    for (const auto bc : boundaryConditions)
+    {
+      for (const bool valid : { false, true })
+      {
+        auto reference = ConvolutionFilterType::New();
+        reference->SetInput(image);
+        reference->SetKernelImage(kernel);
+        reference->NormalizeOn();
+        if (bc)
+        {
+          reference->SetBoundaryCondition(bc);
+        }
+        if (valid)
+        {
+          reference->SetOutputRegionModeToValid();
+        }
+        ITK_TRY_EXPECT_NO_EXCEPTION(reference->Update());
+
+        for (const auto & blockSize : blockSizes)
+        {
+          std::ostringstream description;
+          description << "kernel size " << kernelSize << ", boundary condition "
+                      << (bc ? bc->GetNameOfClass() : "default") << ", " << (valid ? "VALID" : "SAME")
+                      << ", block size " << blockSize;
+
+          auto convolver = ConvolutionFilterType::New();
+          convolver->SetInput(image);
+          convolver->SetKernelImage(kernel);
+          convolver->NormalizeOn();
+          if (bc)
+          {
+            convolver->SetBoundaryCondition(bc);
+          }
+          if (valid)
+          {
+            convolver->SetOutputRegionModeToValid();
+          }
+          convolver->SetBlockSize(blockSize);
+          ITK_TEST_SET_GET_VALUE(blockSize, convolver->GetBlockSize());
+          ITK_TRY_EXPECT_NO_EXCEPTION(convolver->Update());
+          testPassed &= CompareImages(reference->GetOutput(), convolver->GetOutput(), description.str());
+
+          // Stream the output: only the part of the input needed by each
+          // piece is requested, and the transform of the kernel is reused.
+          using StreamerType = itk::StreamingImageFilter<ImageType, ImageType>;
+          auto streamer = StreamerType::New();
+          streamer->SetInput(convolver->GetOutput());
+          streamer->SetNumberOfStreamDivisions(5);
+          ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+          testPassed &= CompareImages(reference->GetOutput(), streamer->GetOutput(), description.str() + ", streamed");
+        }
+      }
+    }
+  }
+
+  if (!testPassed)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
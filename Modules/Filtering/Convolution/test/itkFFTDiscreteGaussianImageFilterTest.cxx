@@ -0,0 +1,190 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkFFTDiscreteGaussianImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+
+#include "itkObjectFactoryBase.h"
+#include "itkVnlRealToHalfHermitianForwardFFTImageFilter.h"
+#include "itkVnlHalfHermitianToRealInverseFFTImageFilter.h"
+#if defined(ITK_USE_FFTWD) || defined(ITK_USE_FFTWF)
+#  include "itkFFTWRealToHalfHermitianForwardFFTImageFilter.h"
+#  include "itkFFTWHalfHermitianToRealInverseFFTImageFilter.h"
+#endif
+
+#include <cmath>
+#include <iomanip>
+#include <set>
+
+namespace
+{
+using ImageType = itk::Image<float, 2>;
+using FilterType = itk::FFTDiscreteGaussianImageFilter<ImageType>;
+
+// Smooths the image with the specified algorithm, and returns the specified region of the output.
+ImageType::Pointer
+Smooth(const ImageType *               image,
+       const double                    variance,
+       const FilterType::AlgorithmEnum algorithm,
+       const ImageType::RegionType &   requestedRegion,
+       itk::TimeProbe &                probe)
+{
+  auto filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetVariance(variance);
+  filter->SetMaximumKernelWidth(128);
+  filter->SetAlgorithm(algorithm);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+
+  probe.Start();
+  filter->Update();
+  probe.Stop();
+
+  ImageType::Pointer output = filter->GetOutput();
+  output->DisconnectPipeline();
+  return output;
+}
+
+// Returns the maximum absolute difference between the two images, over the specified region.
+double
+MaximumDifference(const ImageType * image1, const ImageType * image2, const ImageType::RegionType & region)
+{
+  double                                   maximumDifference = 0.0;
+  itk::ImageRegionConstIterator<ImageType> it1(image1, region);
+  itk::ImageRegionConstIterator<ImageType> it2(image2, region);
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    maximumDifference = std::max(maximumDifference, std::abs(static_cast<double>(it1.Get()) - it2.Get()));
+  }
+  return maximumDifference;
+}
+} // namespace
+
+int
+itkFFTDiscreteGaussianImageFilterTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " imageSize" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+#ifndef ITK_FFT_FACTORY_REGISTER_MANAGER // Manual factory registration is required for ITK FFT tests
+#  if defined(ITK_USE_FFTWD) || defined(ITK_USE_FFTWF)
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::FFTWRealToHalfHermitianForwardFFTImageFilter>>();
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::FFTWHalfHermitianToRealInverseFFTImageFilter>>();
+#  endif
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::VnlRealToHalfHermitianForwardFFTImageFilter>>();
+  itk::ObjectFactoryBase::RegisterInternalFactoryOnce<
+    itk::FFTImageFilterFactory<itk::VnlHalfHermitianToRealInverseFFTImageFilter>>();
+#endif
+
+  auto filter = FilterType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(filter, FFTDiscreteGaussianImageFilter, DiscreteGaussianImageFilter);
+
+  ITK_TEST_EXPECT_EQUAL(filter->GetAlgorithm(), FilterType::AlgorithmEnum::Automatic);
+  ITK_TEST_EXPECT_TRUE(!filter->GetUseFFT());
+
+  const auto imageSize = static_cast<itk::SizeValueType>(std::stoi(argv[1]));
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType::Filled(imageSize));
+  image->Allocate();
+
+  auto generator = itk::Statistics::MersenneTwisterRandomVariateGenerator::New();
+  generator->Initialize(12345);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(static_cast<float>(generator->GetUniformVariate(0.0, 255.0)));
+  }
+
+  const ImageType::RegionType largestRegion = image->GetLargestPossibleRegion();
+  ImageType::RegionType       streamedRegion = largestRegion;
+  streamedRegion.ShrinkByRadius(imageSize / 4);
+
+  int testStatus = EXIT_SUCCESS;
+
+  std::cout << std::setw(10) << "Variance" << std::setw(12) << "Radius" << std::setw(16) << "Separable (s)"
+            << std::setw(12) << "FFT (s)" << std::setw(12) << "Automatic" << std::setw(16) << "Difference"
+            << std::endl;
+
+  for (const double variance : { 1.0, 16.0, 64.0, 256.0 })
+  {
+    filter->SetInput(image);
+    filter->SetVariance(variance);
+    filter->SetMaximumKernelWidth(128);
+
+    itk::TimeProbe separableProbe;
+    itk::TimeProbe fftProbe;
+    itk::TimeProbe streamedProbe;
+    const auto     separableOutput =
+      Smooth(image, variance, FilterType::AlgorithmEnum::Separable, largestRegion, separableProbe);
+    const auto fftOutput = Smooth(image, variance, FilterType::AlgorithmEnum::FFT, largestRegion, fftProbe);
+    const auto streamedFFTOutput =
+      Smooth(image, variance, FilterType::AlgorithmEnum::FFT, streamedRegion, streamedProbe);
+
+    const double difference = MaximumDifference(separableOutput, fftOutput, largestRegion);
+    const double streamedDifference = MaximumDifference(separableOutput, streamedFFTOutput, streamedRegion);
+
+    std::cout << std::setw(10) << variance << std::setw(12) << filter->GetKernelRadius()[0] << std::setw(16)
+              << separableProbe.GetTotal() << std::setw(12) << fftProbe.GetTotal() << std::setw(12)
+              << (filter->GetUseFFT() ? "FFT" : "Separable") << std::setw(16) << difference << std::endl;
+
+    // The FFT based convolution only differs by rounding errors, relative to
+    // the pixel values.
+    constexpr double tolerance = 1e-3;
+    if (difference > tolerance || streamedDifference > tolerance)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The FFT based convolution differs from the separable convolution by " << difference
+                << " over the whole image, and by " << streamedDifference << " over a streamed region." << std::endl;
+      testStatus = EXIT_FAILURE;
+    }
+  }
+
+  // Small kernels are convolved separably, large kernels in the Fourier domain.
+  filter->SetVariance(1.0);
+  ITK_TEST_EXPECT_TRUE(!filter->GetUseFFT());
+  filter->SetVariance(256.0);
+  ITK_TEST_EXPECT_TRUE(filter->GetUseFFT());
+  filter->SetAlgorithm(FilterType::AlgorithmEnum::Separable);
+  ITK_TEST_EXPECT_TRUE(!filter->GetUseFFT());
+  filter->SetAlgorithm(FilterType::AlgorithmEnum::FFT);
+  filter->SetVariance(1.0);
+  ITK_TEST_EXPECT_TRUE(filter->GetUseFFT());
+
+  // Test streaming enumeration for FFTDiscreteGaussianImageFilterEnums::Algorithm elements
+  const std::set<itk::FFTDiscreteGaussianImageFilterEnums::Algorithm> allAlgorithm{
+    itk::FFTDiscreteGaussianImageFilterEnums::Algorithm::Automatic,
+    itk::FFTDiscreteGaussianImageFilterEnums::Algorithm::Separable,
+    itk::FFTDiscreteGaussianImageFilterEnums::Algorithm::FFT
+  };
+  for (const auto & ee : allAlgorithm)
+  {
+    std::cout << "STREAMED ENUM VALUE FFTDiscreteGaussianImageFilterEnums::Algorithm: " << ee << std::endl;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
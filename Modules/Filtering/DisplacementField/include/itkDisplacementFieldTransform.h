@@ -209,6 +209,14 @@ public:
   OutputPointType
   TransformPoint(const InputPointType & inputPoint) const override;
 
+  /** Method to transform an array of points. The checks of the
+   * displacement field and of the interpolator are done once, and each
+   * point is mapped to a continuous index of the field only once. */
+  void
+  TransformPoints(const InputPointType * inputPoints,
+                  OutputPointType *      outputPoints,
+                  SizeValueType          numberOfPoints) const override;
+
   /**  Method to transform a vector. */
   using Superclass::TransformVector;
   OutputVectorType
@@ -99,6 +99,47 @@ DisplacementFieldTransform<TParametersValueType, NDimensions>::TransformPoint(co
   return outputPoint;
 }
 
+template <typename TParametersValueType, unsigned int NDimensions>
+void
+DisplacementFieldTransform<TParametersValueType, NDimensions>::TransformPoints(
+  const InputPointType * inputPoints,
+  OutputPointType *      outputPoints,
+  SizeValueType          numberOfPoints) const
+{
+  if (!this->m_DisplacementField)
+  {
+    itkExceptionMacro("No displacement field is specified.");
+  }
+  if (!this->m_Interpolator)
+  {
+    itkExceptionMacro("No interpolator is specified.");
+  }
+
+  using ContinuousIndexType = typename InterpolatorType::ContinuousIndexType;
+
+  for (SizeValueType p = 0; p < numberOfPoints; ++p)
+  {
+    typename InterpolatorType::PointType point;
+    point.CastFrom(inputPoints[p]);
+
+    OutputPointType outputPoint;
+    outputPoint.CastFrom(inputPoints[p]);
+
+    const ContinuousIndexType cidx =
+      this->m_DisplacementField->template TransformPhysicalPointToContinuousIndex<
+        typename ContinuousIndexType::ValueType>(point);
+    if (this->m_Interpolator->IsInsideBuffer(cidx))
+    {
+      const typename InterpolatorType::OutputType displacement = this->m_Interpolator->EvaluateAtContinuousIndex(cidx);
+      for (unsigned int ii = 0; ii < NDimensions; ++ii)
+      {
+        outputPoint[ii] += displacement[ii];
+      }
+    }
+    outputPoints[p] = outputPoint;
+  }
+}
+
 template <typename TParametersValueType, unsigned int NDimensions>
 bool
 DisplacementFieldTransform<TParametersValueType, NDimensions>::GetInverse(Self * inverse) const
@@ -24,6 +24,8 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageScanlineIterator.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -183,10 +185,14 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
   using OutputIteratorType = ImageScanlineIterator<TOutputImage>;
   OutputIteratorType outIt(output, outputRegionForThread);
 
-  // Define a few variables that will be used to translate from an input pixel
-  // to an output pixel
-  PointType outputPoint;       // Coordinates of output pixel
-  PointType transformedPoint;  // Coordinates of transformed pixel
+  // The points of each scanline are transformed with a single call to
+  // TransformPoints, which avoids a virtual call per pixel for the
+  // transforms that override it.
+  const SizeValueType                                  scanlineSize = outputRegionForThread.GetSize(0);
+  std::vector<PointType>                               outputPoints(scanlineSize);
+  std::vector<typename TransformType::InputPointType>  transformInputPoints(scanlineSize);
+  std::vector<typename TransformType::OutputPointType> transformedPoints(scanlineSize);
+
   PointType displacementPoint; // the difference
   PixelType displacementPixel; // the difference, cast to pixel type
 
@@ -197,15 +203,21 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
   outIt.GoToBegin();
   while (!outIt.IsAtEnd())
   {
-    while (!outIt.IsAtEndOfLine())
+    // Determine the coordinates of the output pixels of the scanline
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < scanlineSize; ++i, ++index[0])
     {
-      // Determine the index of the current output pixel
-      output->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
+      output->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+      transformInputPoints[i] = outputPoints[i];
+    }
 
-      // Compute corresponding input pixel position
-      transformedPoint = transform->TransformPoint(outputPoint);
+    // Compute corresponding input pixel positions
+    transform->TransformPoints(transformInputPoints.data(), transformedPoints.data(), scanlineSize);
 
-      displacementPoint = transformedPoint - outputPoint;
+    for (SizeValueType i = 0; i < scanlineSize; ++i)
+    {
+      const PointType transformedPoint(transformedPoints[i]);
+      displacementPoint = transformedPoint - outputPoints[i];
       // Cast PointType -> PixelType
       for (IndexValueType idx = 0; idx < ImageDimension; ++idx)
       {
@@ -215,7 +227,7 @@ TransformToDisplacementFieldFilter<TOutputImage, TParametersValueType>::Nonlinea
       ++outIt;
     }
     outIt.NextLine();
-    progress.Completed(outputRegionForThread.GetSize()[0]);
+    progress.Completed(scanlineSize);
   }
 }
 
@@ -50,6 +50,21 @@ namespace itk
  *  the itk::DanielssonDistanceImageFilter class except it does not return
  *  the Voronoi map.
  *
+ *  Set/GetMaximumDistance limits the computation to a band around the
+ *  boundary of the object: pixels farther than the maximum distance from
+ *  the boundary are set to plus or minus the maximum distance (squared when
+ *  SquaredDistance is on). Partial distances beyond the band are discarded
+ *  after each dimension, so that the remaining dimensions have fewer points
+ *  to process. The distances inside the band are unchanged.
+ *
+ *  \par Performance
+ *  The lines along each dimension are processed in parallel. The lines
+ *  along the dimensions other than the first one are processed in blocks
+ *  of adjacent lines, so that the image is accessed contiguously. The
+ *  squared distances are computed in the output image, without any other
+ *  image-sized buffer: a float output image uses half the memory of a
+ *  double one.
+ *
  *  Reference:
  *  C. R. Maurer, Jr., R. Qi, and V. Raghavan, "A Linear Time Algorithm
  *  for Computing Exact Euclidean Distance Transforms of Binary Images in
@@ -153,6 +168,14 @@ public:
   itkSetMacro(BackgroundValue, InputPixelType);
   itkGetConstReferenceMacro(BackgroundValue, InputPixelType);
 
+  /** Set/Get the maximum distance to compute, in physical units when
+   * UseImageSpacing is on, in pixels otherwise. Pixels farther from the
+   * boundary of the object are set to plus or minus this distance. Defaults
+   * to the maximum value of the output pixel type, which computes all the
+   * distances. */
+  itkSetMacro(MaximumDistance, OutputPixelType);
+  itkGetConstMacro(MaximumDistance, OutputPixelType);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(IntConvertibleToInputCheck, (Concept::Convertible<int, InputPixelType>));
@@ -171,33 +194,38 @@ protected:
   void
   GenerateData() override;
 
-  unsigned int
-  SplitRequestedRegion(unsigned int i, unsigned int num, OutputImageRegionType & splitRegion) override;
-
+  /** Computes the squared distances along the lines of the region in the
+   * specified dimension, from the squared distances along the previous
+   * dimensions. */
   void
-  ThreadedGenerateData(const OutputImageRegionType &, ThreadIdType) override;
+  VoronoiLines(unsigned int d, const OutputImageRegionType & region);
 
+  /** Computes the signed distances of the region from the squared
+   * distances. */
   void
-  DynamicThreadedGenerateData(const OutputImageRegionType &) override
-  {
-    itkExceptionMacro("This class requires threadId so it must use classic multi-threading model");
-  }
+  SignDistances(const OutputImageRegionType & region);
 
 private:
+  /** Computes the squared distances along a line of the specified dimension,
+   * in place. g and h are scratch buffers of the size of the line. */
   void
-       Voronoi(unsigned int, OutputIndexType idx, OutputImageType * output);
-  bool Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType);
+  Voronoi(unsigned int d, OutputPixelType * line, OutputSizeValueType nd, OutputPixelType * g, OutputPixelType * h)
+    const;
+  bool
+  Remove(OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType, OutputPixelType) const;
+
+  /** Number of adjacent lines that are processed together, along the
+   * dimensions other than the first one. */
+  static constexpr SizeValueType LineBlockSize = 16;
 
   InputPixelType   m_BackgroundValue;
   InputSpacingType m_Spacing;
-
-  unsigned int m_CurrentDimension{ 0 };
+  OutputPixelType  m_MaximumDistance;
+  OutputPixelType  m_MaximumSquaredDistance;
 
   bool m_InsideIsPositive{ false };
   bool m_UseImageSpacing{ true };
   bool m_SquaredDistance{ false };
-
-  const InputImageType * m_InputCache;
 };
 } // end namespace itk
 
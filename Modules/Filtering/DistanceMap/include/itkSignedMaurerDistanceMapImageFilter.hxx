@@ -18,15 +18,15 @@
 #ifndef itkSignedMaurerDistanceMapImageFilter_hxx
 #define itkSignedMaurerDistanceMapImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 #include "itkBinaryThresholdImageFilter.h"
 #include "itkBinaryContourImageFilter.h"
-#include "itkProgressReporter.h"
+#include "itkIndexRange.h"
 #include "itkProgressAccumulator.h"
+#include "itkProgressTransformer.h"
 #include "itkMath.h"
-#include "vnl/vnl_vector.h"
-#include "itkMath.h"
+
+#include <vector>
 
 namespace itk
 {
@@ -34,68 +34,9 @@ template <typename TInputImage, typename TOutputImage>
 SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SignedMaurerDistanceMapImageFilter()
   : m_BackgroundValue(NumericTraits<InputPixelType>::ZeroValue())
   , m_Spacing(0.0)
-  , m_InputCache(nullptr)
-{
-  this->DynamicMultiThreadingOff();
-}
-
-template <typename TInputImage, typename TOutputImage>
-unsigned int
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SplitRequestedRegion(unsigned int            i,
-                                                                                    unsigned int            num,
-                                                                                    OutputImageRegionType & splitRegion)
-{
-  // Get the output pointer
-  OutputImageType * outputPtr = this->GetOutput();
-
-  // Initialize the splitRegion to the output requested region
-  splitRegion = outputPtr->GetRequestedRegion();
-
-  const OutputSizeType & requestedRegionSize = splitRegion.GetSize();
-
-  OutputIndexType splitIndex = splitRegion.GetIndex();
-  OutputSizeType  splitSize = splitRegion.GetSize();
-
-  // split on the outermost dimension available
-  // and avoid the current dimension
-  int splitAxis = static_cast<int>(outputPtr->GetImageDimension()) - 1;
-  while ((requestedRegionSize[splitAxis] == 1) || (splitAxis == static_cast<int>(m_CurrentDimension)))
-  {
-    --splitAxis;
-    if (splitAxis < 0)
-    { // cannot split
-      itkDebugMacro("Cannot Split");
-      return 1;
-    }
-  }
-
-  // determine the actual number of pieces that will be generated
-  auto range = static_cast<double>(requestedRegionSize[splitAxis]);
-
-  auto         valuesPerThread = static_cast<unsigned int>(std::ceil(range / static_cast<double>(num)));
-  unsigned int maxThreadIdUsed = static_cast<unsigned int>(std::ceil(range / static_cast<double>(valuesPerThread))) - 1;
-
-  // Split the region
-  if (i < maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    splitSize[splitAxis] = valuesPerThread;
-  }
-  if (i == maxThreadIdUsed)
-  {
-    splitIndex[splitAxis] += i * valuesPerThread;
-    // last thread needs to process the "rest" dimension being split
-    splitSize[splitAxis] = splitSize[splitAxis] - i * valuesPerThread;
-  }
-
-  // set the split region ivars
-  splitRegion.SetIndex(splitIndex);
-  splitRegion.SetSize(splitSize);
-
-  itkDebugMacro("Split Piece: " << splitRegion);
-
-  return maxThreadIdUsed + 1;
-}
+  , m_MaximumDistance(NumericTraits<OutputPixelType>::max())
+  , m_MaximumSquaredDistance(NumericTraits<OutputPixelType>::max())
+{}
 
 template <typename TInputImage, typename TOutputImage>
 void
@@ -105,12 +46,21 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   OutputImageType *      outputPtr = this->GetOutput();
   const InputImageType * inputPtr = this->GetInput();
-  m_InputCache = this->GetInput();
 
   // prepare the data
   this->AllocateOutputs();
   this->m_Spacing = outputPtr->GetSpacing();
 
+  // Squared distances beyond the maximum one are discarded.
+  if (this->m_MaximumDistance < std::sqrt(NumericTraits<OutputPixelType>::max()))
+  {
+    this->m_MaximumSquaredDistance = this->m_MaximumDistance * this->m_MaximumDistance;
+  }
+  else
+  {
+    this->m_MaximumSquaredDistance = NumericTraits<OutputPixelType>::max();
+  }
+
   // store the binary image in an image with a pixel type as small as possible
   // instead of keeping the native input pixel type to avoid using too much
   // memory.
@@ -148,190 +98,161 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   this->GraftOutput(borderFilter->GetOutput());
 
-  // Set up the multithreaded processing
-  typename ImageSource<OutputImageType>::ThreadStruct str;
-  str.Filter = this;
+  const OutputImageRegionType region = this->GetOutput()->GetRequestedRegion();
 
-  this->GetMultiThreader()->SetNumberOfWorkUnits(numberOfWorkUnits);
-  this->GetMultiThreader()->SetSingleMethod(this->ThreaderCallback, &str);
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(numberOfWorkUnits);
 
-  // multithread the execution
+  // Compute the squared distances dimension after dimension, in parallel
+  // over the lines of each dimension.
+  const float progressPerDimension = 0.67f / (static_cast<float>(ImageDimension) + 1);
   for (unsigned int d = 0; d < ImageDimension; ++d)
   {
-    m_CurrentDimension = d;
-    this->GetMultiThreader()->SingleMethodExecute();
+    ProgressTransformer progress(0.33f + static_cast<float>(d) * progressPerDimension,
+                                 0.33f + static_cast<float>(d + 1) * progressPerDimension,
+                                 this);
+    multiThreader->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+      d,
+      region,
+      [this, d](const OutputImageRegionType & lambdaRegion) { this->VoronoiLines(d, lambdaRegion); },
+      progress.GetProcessObject());
   }
+
+  ProgressTransformer progress(0.33f + static_cast<float>(ImageDimension) * progressPerDimension, 1.0f, this);
+  multiThreader->template ParallelizeImageRegion<ImageDimension>(
+    region,
+    [this](const OutputImageRegionType & lambdaRegion) { this->SignDistances(lambdaRegion); },
+    progress.GetProcessObject());
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(
-  const OutputImageRegionType & outputRegionForThread,
-  ThreadIdType                  threadId)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::VoronoiLines(unsigned int                  d,
+                                                                            const OutputImageRegionType & region)
 {
-  OutputImageType * outputImage = this->GetOutput();
+  OutputImageType * const   output = this->GetOutput();
+  const OutputSizeValueType nd = region.GetSize(d);
+  const OffsetValueType     stride = output->GetOffsetTable()[d];
 
-  InputRegionType region = outputRegionForThread;
-  InputSizeType   size = region.GetSize();
-  InputIndexType  startIndex = outputRegionForThread.GetIndex();
+  // Along the dimensions other than the first one, the lines are strided:
+  // blocks of adjacent lines are copied to contiguous buffers, reading and
+  // writing contiguous rows of the image.
+  const SizeValueType maximumNumberOfLanes = (d == 0) ? 1 : LineBlockSize;
+  const SizeValueType totalNumberOfLanes = (d == 0) ? 1 : region.GetSize(0);
 
-  OutputImageType * outputPtr = this->GetOutput();
+  std::vector<OutputPixelType> lines(nd * maximumNumberOfLanes);
+  std::vector<OutputPixelType> g(nd);
+  std::vector<OutputPixelType> h(nd);
 
-  // compute the number of rows first, so we can setup a progress reporter
-  std::vector<InputSizeValueType> NumberOfRows;
-  for (unsigned int i = 0; i < InputImageDimension; ++i)
-  {
-    NumberOfRows.push_back(1);
-    for (unsigned int d = 0; d < InputImageDimension; ++d)
-    {
-      if (d != i)
-      {
-        NumberOfRows[i] *= size[d];
-      }
-    }
-  }
+  OutputImageRegionType blocksRegion = region;
+  blocksRegion.SetSize(d, 1);
+  blocksRegion.SetSize(0, 1);
 
-  // set the progress reporter. Use a pointer to be able to destroy it before
-  // the creation of progress2
-  // so it won't set wrong progress at the end of ThreadedGenerateData()
-  float progressPerDimension = 0.67f / static_cast<float>(ImageDimension);
-  if (!this->m_SquaredDistance)
+  for (const auto & blocksIndex : ImageRegionIndexRange<ImageDimension>(blocksRegion))
   {
-    progressPerDimension = 0.67f / (static_cast<float>(ImageDimension) + 1);
-  }
-  auto progress =
-    std::make_unique<ProgressReporter>(this,
-                                       threadId,
-                                       NumberOfRows[m_CurrentDimension],
-                                       30,
-                                       0.33f + static_cast<float>(m_CurrentDimension * progressPerDimension),
-                                       progressPerDimension);
-
-  // This variable provides the amount by which to divide the dimensionless index in order to get the index for each
-  // dimension.
-  vnl_vector<unsigned int> k(InputImageDimension - 1);
-  unsigned int             count = 0;
-  k[count] = 1;
-  for (unsigned int d = m_CurrentDimension + InputImageDimension - 1; d > m_CurrentDimension + 1; d--)
-  {
-    k[count + 1] = k[count] * size[d % InputImageDimension];
-    count++;
-  }
-  k.flip();
-
-  // The index is defined as the dimensionless index into the pixel.
-  // It must be divided by each dimension size in order to get the index for that dimension.
-  // The result of this division is the offsetIndex, which is the index offset relative to the region of this thread.
-  // The true pixel location (idx) is provided by the sum of the offsetIndex and the startIndex.
-  InputSizeValueType index;
-  OutputIndexType    offsetIndex;
-  offsetIndex.Fill(0);
-  InputSizeValueType tempRow = NumberOfRows[m_CurrentDimension];
-  OutputIndexType    idx;
-  idx.Fill(0);
-
-  for (InputSizeValueType n = 0; n < tempRow; ++n)
-  {
-    index = n;
-    count = 0;
-    for (unsigned int d = m_CurrentDimension + 1; d < m_CurrentDimension + InputImageDimension; ++d)
-    {
-      offsetIndex[d % InputImageDimension] =
-        static_cast<OutputIndexValueType>(static_cast<double>(index) / static_cast<double>(k[count]));
-      idx[d % InputImageDimension] =
-        offsetIndex[d % InputImageDimension] + static_cast<OutputIndexValueType>(startIndex[d % InputImageDimension]);
+    OutputPixelType * const firstLine = output->GetBufferPointer() + output->ComputeOffset(blocksIndex);
 
-      index %= k[count];
-      count++;
+    if (d == 0)
+    {
+      this->Voronoi(d, firstLine, nd, g.data(), h.data());
+      continue;
     }
-    this->Voronoi(m_CurrentDimension, idx, outputImage);
-    progress->CompletedPixel();
-  }
-  progress.reset();
-
-  if (m_CurrentDimension == ImageDimension - 1 && !this->m_SquaredDistance)
-  {
-    using OutputIterator = ImageRegionIterator<OutputImageType>;
-    using InputIterator = ImageRegionConstIterator<InputImageType>;
-
-    typename OutputImageType::RegionType outputRegion = outputRegionForThread;
-
-    OutputIterator Ot(outputPtr, outputRegion);
-    InputIterator  It(m_InputCache, outputRegion);
-
-    Ot.GoToBegin();
-    It.GoToBegin();
 
-    ProgressReporter progress2(this,
-                               threadId,
-                               outputRegionForThread.GetNumberOfPixels(),
-                               30,
-                               0.33f + static_cast<float>(ImageDimension * progressPerDimension),
-                               progressPerDimension);
-
-    using OutputRealType = typename NumericTraits<OutputPixelType>::RealType;
-
-    while (!Ot.IsAtEnd())
+    for (SizeValueType firstLane = 0; firstLane < totalNumberOfLanes; firstLane += maximumNumberOfLanes)
     {
-      // cast to a real type is required on some platforms
-      const auto outputValue =
-        static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(itk::Math::abs(Ot.Get()))));
+      const SizeValueType numberOfLanes = std::min(maximumNumberOfLanes, totalNumberOfLanes - firstLane);
 
-      if (Math::NotExactlyEquals(It.Get(), this->m_BackgroundValue))
+      for (OutputSizeValueType i = 0; i < nd; ++i)
       {
-        if (this->GetInsideIsPositive())
+        const OutputPixelType * const row = firstLine + static_cast<OffsetValueType>(i) * stride + firstLane;
+        for (SizeValueType b = 0; b < numberOfLanes; ++b)
         {
-          Ot.Set(outputValue);
-        }
-        else
-        {
-          Ot.Set(-outputValue);
+          lines[b * nd + i] = row[b];
         }
       }
-      else
+
+      for (SizeValueType b = 0; b < numberOfLanes; ++b)
       {
-        if (this->GetInsideIsPositive())
-        {
-          Ot.Set(-outputValue);
-        }
-        else
+        this->Voronoi(d, &lines[b * nd], nd, g.data(), h.data());
+      }
+
+      for (OutputSizeValueType i = 0; i < nd; ++i)
+      {
+        OutputPixelType * const row = firstLine + static_cast<OffsetValueType>(i) * stride + firstLane;
+        for (SizeValueType b = 0; b < numberOfLanes; ++b)
         {
-          Ot.Set(outputValue);
+          row[b] = lines[b * nd + i];
         }
       }
-
-      ++Ot;
-      ++It;
-      progress2.CompletedPixel();
     }
   }
 }
 
 template <typename TInputImage, typename TOutputImage>
 void
-SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int      d,
-                                                                       OutputIndexType   idx,
-                                                                       OutputImageType * output)
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::SignDistances(const OutputImageRegionType & region)
 {
-  OutputRegionType    oRegion = output->GetRequestedRegion();
-  OutputSizeValueType nd = oRegion.GetSize()[d];
+  using OutputIterator = ImageRegionIterator<OutputImageType>;
+  using InputIterator = ImageRegionConstIterator<InputImageType>;
+  using OutputRealType = typename NumericTraits<OutputPixelType>::RealType;
 
-  vnl_vector<OutputPixelType> g(nd, 0);
-  vnl_vector<OutputPixelType> h(nd, 0);
+  OutputIterator Ot(this->GetOutput(), region);
+  InputIterator  It(this->GetInput(), region);
 
+  while (!Ot.IsAtEnd())
+  {
+    // The pixels farther than the maximum distance, or without any object
+    // pixel, are set to the maximum distance.
+    OutputPixelType outputValue = std::min(itk::Math::abs(Ot.Get()), this->m_MaximumSquaredDistance);
+    if (!this->m_SquaredDistance)
+    {
+      // cast to a real type is required on some platforms
+      outputValue = static_cast<OutputPixelType>(std::sqrt(static_cast<OutputRealType>(outputValue)));
+    }
 
-  InputRegionType iRegion = m_InputCache->GetRequestedRegion();
-  InputIndexType  startIndex = iRegion.GetIndex();
+    if (Math::NotExactlyEquals(It.Get(), this->m_BackgroundValue))
+    {
+      if (this->GetInsideIsPositive())
+      {
+        Ot.Set(outputValue);
+      }
+      else
+      {
+        Ot.Set(-outputValue);
+      }
+    }
+    else
+    {
+      if (this->GetInsideIsPositive())
+      {
+        Ot.Set(-outputValue);
+      }
+      else
+      {
+        Ot.Set(outputValue);
+      }
+    }
+
+    ++Ot;
+    ++It;
+  }
+}
 
+template <typename TInputImage, typename TOutputImage>
+void
+SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned int              d,
+                                                                       OutputPixelType * const   line,
+                                                                       const OutputSizeValueType nd,
+                                                                       OutputPixelType * const   g,
+                                                                       OutputPixelType * const   h) const
+{
   OutputPixelType di;
 
   int l = -1;
 
-  for (unsigned int i = 0; i < nd; ++i)
+  for (OutputSizeValueType i = 0; i < nd; ++i)
   {
-    idx[d] = i + startIndex[d];
-
-    di = output->GetPixel(idx);
+    di = line[i];
 
     OutputPixelType iw;
 
@@ -349,18 +270,18 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
       if (l < 1)
       {
         l++;
-        g(l) = di;
-        h(l) = iw;
+        g[l] = di;
+        h[l] = iw;
       }
       else
       {
-        while ((l >= 1) && this->Remove(g(l - 1), g(l), di, h(l - 1), h(l), iw))
+        while ((l >= 1) && this->Remove(g[l - 1], g[l], di, h[l - 1], h[l], iw))
         {
           l--;
         }
         l++;
-        g(l) = di;
-        h(l) = iw;
+        g[l] = di;
+        h[l] = iw;
       }
     }
   }
@@ -374,7 +295,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
 
   l = 0;
 
-  for (unsigned int i = 0; i < nd; ++i)
+  for (OutputSizeValueType i = 0; i < nd; ++i)
   {
     OutputPixelType iw;
 
@@ -387,12 +308,12 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
       iw = static_cast<OutputPixelType>(i);
     }
 
-    OutputPixelType d1 = itk::Math::abs(g(l)) + (h(l) - iw) * (h(l) - iw);
+    OutputPixelType d1 = itk::Math::abs(g[l]) + (h[l] - iw) * (h[l] - iw);
 
     while (l < ns)
     {
       // be sure to compute d2 *only* if l < ns
-      OutputPixelType d2 = itk::Math::abs(g(l + 1)) + (h(l + 1) - iw) * (h(l + 1) - iw);
+      OutputPixelType d2 = itk::Math::abs(g[l + 1]) + (h[l + 1] - iw) * (h[l + 1] - iw);
       // then compare d1 and d2
       if (d1 <= d2)
       {
@@ -401,29 +322,17 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Voronoi(unsigned
       l++;
       d1 = d2;
     }
-    idx[d] = i + startIndex[d];
 
-    if (Math::NotExactlyEquals(m_InputCache->GetPixel(idx), this->m_BackgroundValue))
+    // The squared distances beyond the maximum one are discarded, so that
+    // they are not processed along the next dimensions. The sign is set by
+    // SignDistances().
+    if (d1 > this->m_MaximumSquaredDistance)
     {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, d1);
-      }
-      else
-      {
-        output->SetPixel(idx, -d1);
-      }
+      line[i] = NumericTraits<OutputPixelType>::max();
     }
     else
     {
-      if (this->m_InsideIsPositive)
-      {
-        output->SetPixel(idx, -d1);
-      }
-      else
-      {
-        output->SetPixel(idx, d1);
-      }
+      line[i] = d1;
     }
   }
 }
@@ -435,7 +344,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::Remove(OutputPixe
                                                                       OutputPixelType df,
                                                                       OutputPixelType x1,
                                                                       OutputPixelType x2,
-                                                                      OutputPixelType xf)
+                                                                      OutputPixelType xf) const
 {
   OutputPixelType a = x2 - x1;
   OutputPixelType b = xf - x2;
@@ -456,6 +365,7 @@ SignedMaurerDistanceMapImageFilter<TInputImage, TOutputImage>::PrintSelf(std::os
   Superclass::PrintSelf(os, indent);
   os << indent << "Background Value: " << this->m_BackgroundValue << std::endl;
   os << indent << "Spacing: " << this->m_Spacing << std::endl;
+  os << indent << "Maximum distance: " << this->m_MaximumDistance << std::endl;
   os << indent << "Inside is positive: " << this->m_InsideIsPositive << std::endl;
   os << indent << "Use image spacing: " << this->m_UseImageSpacing << std::endl;
   os << indent << "Squared distance: " << this->m_SquaredDistance << std::endl;
@@ -19,6 +19,8 @@
 #include "itkShowDistanceMap.h"
 #include "itkSignedMaurerDistanceMapImageFilter.h"
 #include "itkStdStreamStateSave.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkTestingMacros.h"
 
 int
 itkSignedMaurerDistanceMapImageFilterTest11(int, char *[])
@@ -152,5 +154,42 @@ itkSignedMaurerDistanceMapImageFilterTest11(int, char *[])
   std::cout << "Use ImageSpacing Distance Map with squared distance turned off" << std::endl;
   ShowDistanceMap(outputDistance2D2);
 
+  /* Test the maximum distance: the distances beyond it are clamped, the
+   * other ones are unchanged */
+  auto unlimitedDistance2D = myImageType2D2::New();
+  unlimitedDistance2D->Graft(outputDistance2D2);
+  outputDistance2D2->DisconnectPipeline();
+
+  const myImageType2D2::PixelType maximumDistance = 5.5;
+  filter2D->SetMaximumDistance(maximumDistance);
+  ITK_TEST_SET_GET_VALUE(maximumDistance, filter2D->GetMaximumDistance());
+  ITK_TRY_EXPECT_NO_EXCEPTION(filter2D->Update());
+
+  myImageType2D2::Pointer limitedDistance2D = filter2D->GetOutput();
+  std::cout << "Distance Map with a maximum distance of " << maximumDistance << std::endl;
+  ShowDistanceMap(limitedDistance2D);
+
+  itk::ImageRegionConstIterator<myImageType2D2> unlimitedIt(unlimitedDistance2D, region2D);
+  itk::ImageRegionConstIterator<myImageType2D2> limitedIt(limitedDistance2D, region2D);
+  for (; !unlimitedIt.IsAtEnd(); ++unlimitedIt, ++limitedIt)
+  {
+    const myImageType2D2::PixelType unlimitedValue = unlimitedIt.Get();
+    myImageType2D2::PixelType       expectedValue = unlimitedValue;
+    if (unlimitedValue > maximumDistance)
+    {
+      expectedValue = maximumDistance;
+    }
+    else if (unlimitedValue < -maximumDistance)
+    {
+      expectedValue = -maximumDistance;
+    }
+    if (itk::Math::abs(limitedIt.Get() - expectedValue) > epsilon)
+    {
+      std::cerr << "Error with the maximum distance at " << limitedIt.GetIndex() << ": expected " << expectedValue
+                << " but got " << limitedIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
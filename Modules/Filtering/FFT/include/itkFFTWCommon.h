@@ -34,6 +34,7 @@
 #endif
 
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -385,11 +386,122 @@ public:
   }
 
 
+  /** Plan a transform like Plan_dft_r2c(), or return the plan of a
+   * previous call with the same key, from the plan cache of
+   * FFTWGlobalConfiguration. The plan must be executed by Execute_dft_r2c()
+   * and released by ReleasePlan(). */
+  static PlanType
+  CachedPlan_dft_r2c(int           rank,
+                     const int *   n,
+                     PixelType *   in,
+                     ComplexType * out,
+                     unsigned      flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    return CachedPlan(FFTWPlanKey::Kind::RealToComplex,
+                      rank,
+                      n,
+                      in,
+                      reinterpret_cast<PixelType *>(out),
+                      flags,
+                      threads,
+                      [=] { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); });
+#  else
+    return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  /** Plan a transform like Plan_dft_c2r(), or return the cached plan. The
+   * plan must be executed by Execute_dft_c2r() and released by
+   * ReleasePlan(). */
+  static PlanType
+  CachedPlan_dft_c2r(int           rank,
+                     const int *   n,
+                     ComplexType * in,
+                     PixelType *   out,
+                     unsigned      flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    return CachedPlan(FFTWPlanKey::Kind::ComplexToReal,
+                      rank,
+                      n,
+                      reinterpret_cast<PixelType *>(in),
+                      out,
+                      flags,
+                      threads,
+                      [=] { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); });
+#  else
+    return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  /** Plan a transform like Plan_dft(), or return the cached plan. The plan
+   * must be executed by Execute_dft() and released by ReleasePlan(). */
+  static PlanType
+  CachedPlan_dft(int           rank,
+                 const int *   n,
+                 ComplexType * in,
+                 ComplexType * out,
+                 int           sign,
+                 unsigned      flags,
+                 int           threads = 1,
+                 bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    return CachedPlan((sign == FFTW_FORWARD) ? FFTWPlanKey::Kind::Forward : FFTWPlanKey::Kind::Backward,
+                      rank,
+                      n,
+                      reinterpret_cast<PixelType *>(in),
+                      reinterpret_cast<PixelType *>(out),
+                      flags,
+                      threads,
+                      [=] { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); });
+#  else
+    return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+#  endif
+  }
+
   static void
   Execute(PlanType p)
   {
     fftwf_execute(p);
   }
+
+  /** Execute the plan on other arrays, with the same placement and
+   * alignment as the arrays it was created for. */
+  static void
+  Execute_dft_r2c(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftwf_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute_dft_c2r(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftwf_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute_dft(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftwf_execute_dft(p, in, out);
+  }
+
+  /** Destroy the plan, unless it is owned by the plan cache. */
+  static void
+  ReleasePlan(PlanType p)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (FFTWGlobalConfiguration::IsCachedPlan(p))
+    {
+      return;
+    }
+#  endif
+    DestroyPlan(p);
+  }
+
   static void
   DestroyPlan(PlanType p)
   {
@@ -398,6 +510,38 @@ public:
 #  endif
     fftwf_destroy_plan(p);
   }
+
+#  ifndef ITK_USE_CUFFTW
+private:
+  template <typename TCreatePlan>
+  static PlanType
+  CachedPlan(FFTWPlanKey::Kind   kind,
+             int                 rank,
+             const int *         n,
+             PixelType *         in,
+             PixelType *         out,
+             unsigned            flags,
+             int                 threads,
+             const TCreatePlan & createPlan)
+  {
+    if (!FFTWGlobalConfiguration::GetUsePlanCache())
+    {
+      return createPlan();
+    }
+    const FFTWPlanKey key{ sizeof(PixelType),
+                           kind,
+                           std::vector<int>(n, n + rank),
+                           flags,
+                           threads,
+                           in == out,
+                           fftwf_alignment_of(in),
+                           fftwf_alignment_of(out) };
+    return static_cast<PlanType>(FFTWGlobalConfiguration::GetCachedPlan(
+      key,
+      [&createPlan]() -> void * { return createPlan(); },
+      [](void * plan) { fftwf_destroy_plan(static_cast<PlanType>(plan)); }));
+  }
+#  endif
 };
 
 #endif // ITK_USE_FFTWF
@@ -726,11 +870,122 @@ public:
   }
 
 
+  /** Plan a transform like Plan_dft_r2c(), or return the plan of a
+   * previous call with the same key, from the plan cache of
+   * FFTWGlobalConfiguration. The plan must be executed by Execute_dft_r2c()
+   * and released by ReleasePlan(). */
+  static PlanType
+  CachedPlan_dft_r2c(int           rank,
+                     const int *   n,
+                     PixelType *   in,
+                     ComplexType * out,
+                     unsigned      flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    return CachedPlan(FFTWPlanKey::Kind::RealToComplex,
+                      rank,
+                      n,
+                      in,
+                      reinterpret_cast<PixelType *>(out),
+                      flags,
+                      threads,
+                      [=] { return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput); });
+#  else
+    return Plan_dft_r2c(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  /** Plan a transform like Plan_dft_c2r(), or return the cached plan. The
+   * plan must be executed by Execute_dft_c2r() and released by
+   * ReleasePlan(). */
+  static PlanType
+  CachedPlan_dft_c2r(int           rank,
+                     const int *   n,
+                     ComplexType * in,
+                     PixelType *   out,
+                     unsigned      flags,
+                     int           threads = 1,
+                     bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    return CachedPlan(FFTWPlanKey::Kind::ComplexToReal,
+                      rank,
+                      n,
+                      reinterpret_cast<PixelType *>(in),
+                      out,
+                      flags,
+                      threads,
+                      [=] { return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput); });
+#  else
+    return Plan_dft_c2r(rank, n, in, out, flags, threads, canDestroyInput);
+#  endif
+  }
+
+  /** Plan a transform like Plan_dft(), or return the cached plan. The plan
+   * must be executed by Execute_dft() and released by ReleasePlan(). */
+  static PlanType
+  CachedPlan_dft(int           rank,
+                 const int *   n,
+                 ComplexType * in,
+                 ComplexType * out,
+                 int           sign,
+                 unsigned      flags,
+                 int           threads = 1,
+                 bool          canDestroyInput = false)
+  {
+#  ifndef ITK_USE_CUFFTW
+    return CachedPlan((sign == FFTW_FORWARD) ? FFTWPlanKey::Kind::Forward : FFTWPlanKey::Kind::Backward,
+                      rank,
+                      n,
+                      reinterpret_cast<PixelType *>(in),
+                      reinterpret_cast<PixelType *>(out),
+                      flags,
+                      threads,
+                      [=] { return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput); });
+#  else
+    return Plan_dft(rank, n, in, out, sign, flags, threads, canDestroyInput);
+#  endif
+  }
+
   static void
   Execute(PlanType p)
   {
     fftw_execute(p);
   }
+
+  /** Execute the plan on other arrays, with the same placement and
+   * alignment as the arrays it was created for. */
+  static void
+  Execute_dft_r2c(PlanType p, PixelType * in, ComplexType * out)
+  {
+    fftw_execute_dft_r2c(p, in, out);
+  }
+  static void
+  Execute_dft_c2r(PlanType p, ComplexType * in, PixelType * out)
+  {
+    fftw_execute_dft_c2r(p, in, out);
+  }
+  static void
+  Execute_dft(PlanType p, ComplexType * in, ComplexType * out)
+  {
+    fftw_execute_dft(p, in, out);
+  }
+
+  /** Destroy the plan, unless it is owned by the plan cache. */
+  static void
+  ReleasePlan(PlanType p)
+  {
+#  ifndef ITK_USE_CUFFTW
+    if (FFTWGlobalConfiguration::IsCachedPlan(p))
+    {
+      return;
+    }
+#  endif
+    DestroyPlan(p);
+  }
+
   static void
   DestroyPlan(PlanType p)
   {
@@ -739,6 +994,38 @@ public:
 #  endif
     fftw_destroy_plan(p);
   }
+
+#  ifndef ITK_USE_CUFFTW
+private:
+  template <typename TCreatePlan>
+  static PlanType
+  CachedPlan(FFTWPlanKey::Kind   kind,
+             int                 rank,
+             const int *         n,
+             PixelType *         in,
+             PixelType *         out,
+             unsigned            flags,
+             int                 threads,
+             const TCreatePlan & createPlan)
+  {
+    if (!FFTWGlobalConfiguration::GetUsePlanCache())
+    {
+      return createPlan();
+    }
+    const FFTWPlanKey key{ sizeof(PixelType),
+                           kind,
+                           std::vector<int>(n, n + rank),
+                           flags,
+                           threads,
+                           in == out,
+                           fftw_alignment_of(in),
+                           fftw_alignment_of(out) };
+    return static_cast<PlanType>(FFTWGlobalConfiguration::GetCachedPlan(
+      key,
+      [&createPlan]() -> void * { return createPlan(); },
+      [](void * plan) { fftw_destroy_plan(static_cast<PlanType>(plan)); }));
+  }
+#  endif
 };
 
 #endif
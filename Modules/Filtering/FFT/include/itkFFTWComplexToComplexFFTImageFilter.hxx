@@ -93,11 +93,11 @@ FFTWComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGen
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan =
-    FFTWProxyType::Plan_dft(ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits());
+  plan = FFTWProxyType::CachedPlan_dft(
+    ImageDimension, sizes, in, out, transformDirection, flags, this->GetNumberOfWorkUnits());
 
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::Execute_dft(plan, in, out);
+  FFTWProxyType::ReleasePlan(plan);
 }
 
 
@@ -18,12 +18,12 @@
 #ifndef itkFFTWForwardFFTImageFilter_hxx
 #define itkFFTWForwardFFTImageFilter_hxx
 
-#include "itkHalfToFullHermitianImageFilter.h"
 #include "itkIndent.h"
 #include "itkMetaDataObject.h"
 #include "itkProgressReporter.h"
 #include "itkMultiThreaderBase.h"
 
+#include <algorithm>
 #include <iostream>
 
 namespace itk
@@ -62,69 +62,75 @@ FFTWForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
   outputPtr->Allocate();
 
-  const typename InputImageType::SizeType &  inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
-  const typename OutputImageType::SizeType & outputSize = outputPtr->GetLargestPossibleRegion().GetSize();
+  const typename InputImageType::SizeType & inputSize = inputPtr->GetLargestPossibleRegion().GetSize();
 
-  // figure out sizes
-  // size of input and output aren't the same which is handled in the superclass,
-  // sort of.
-  // the input size and output size only differ in the fastest moving dimension
-  unsigned int totalInputSize = 1;
-  unsigned int totalOutputSize = 1;
+  // The transform is computed in place, in the output buffer: the real
+  // input rows are laid out with the padding required by the in-place
+  // real-to-complex transform of FFTW, and the half complex result is then
+  // expanded to the full image using the Hermitian symmetry. This avoids
+  // allocating an intermediate half image.
+  const SizeValueType rowSize = inputSize[0];
+  const SizeValueType halfRowSize = rowSize / 2 + 1;
+  const SizeValueType numberOfRows = inputPtr->GetLargestPossibleRegion().GetNumberOfPixels() / rowSize;
 
-  for (unsigned i = 0; i < ImageDimension; ++i)
+  OutputPixelType * out = outputPtr->GetBufferPointer();
+  auto *            inOut = reinterpret_cast<InputPixelType *>(out);
+
+  int sizes[ImageDimension];
+  for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    totalInputSize *= inputSize[i];
-    totalOutputSize *= outputSize[i];
+    sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  // Set up image to hold the half image results from FFTW.
-  typename OutputImageType::SizeType fftwOutputSize(outputSize);
-  fftwOutputSize[0] = (fftwOutputSize[0] / 2) + 1;
-  typename OutputImageType::RegionType fftwOutputRegion(outputPtr->GetLargestPossibleRegion());
-  fftwOutputRegion.SetSize(fftwOutputSize);
-
-  auto fftwOutput = OutputImageType::New();
-  // The information is copied to the half image so that it will then
-  // be copied to the final output of this filter.
-  fftwOutput->CopyInformation(inputPtr);
-  fftwOutput->SetRegions(fftwOutputRegion);
-  fftwOutput->Allocate();
-
-  typename FFTWProxyType::PlanType plan;
-  auto *                           in = const_cast<InputPixelType *>(inputPtr->GetBufferPointer());
-  int                              flags = m_PlanRigor;
-  if (!m_CanUseDestructiveAlgorithm)
+  // The plan must be created before the input is copied, because the planner
+  // may overwrite the buffer.
+  typename FFTWProxyType::PlanType plan =
+    FFTWProxyType::CachedPlan_dft_r2c(ImageDimension,
+                                      sizes,
+                                      inOut,
+                                      reinterpret_cast<typename FFTWProxyType::ComplexType *>(out),
+                                      m_PlanRigor,
+                                      MultiThreaderBase::GetGlobalDefaultNumberOfThreads(),
+                                      true);
+
+  const InputPixelType * in = inputPtr->GetBufferPointer();
+  for (SizeValueType row = 0; row < numberOfRows; ++row)
   {
-    // if the input is about to be destroyed, there is no need to force fftw
-    // to use an non destructive algorithm. If it is not released however,
-    // we must be careful to not destroy it.
-    flags = flags | FFTW_PRESERVE_INPUT;
+    std::copy_n(in + row * rowSize, rowSize, inOut + row * 2 * halfRowSize);
   }
-  int sizes[ImageDimension];
-  for (unsigned int i = 0; i < ImageDimension; ++i)
+
+  FFTWProxyType::Execute_dft_r2c(plan, inOut, reinterpret_cast<typename FFTWProxyType::ComplexType *>(out));
+  FFTWProxyType::ReleasePlan(plan);
+
+  // Move the half rows to their final location. The rows are moved from the
+  // last to the first one so that no row is overwritten before it is moved.
+  for (SizeValueType row = numberOfRows; row-- > 1;)
   {
-    sizes[(ImageDimension - 1) - i] = inputSize[i];
+    const OutputPixelType * halfRow = out + row * halfRowSize;
+    std::copy_backward(halfRow, halfRow + halfRowSize, out + row * rowSize + halfRowSize);
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(ImageDimension,
-                                     sizes,
-                                     in,
-                                     (typename FFTWProxyType::ComplexType *)fftwOutput->GetBufferPointer(),
-                                     flags,
-                                     MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
-
-  // Expand the half image to the full image size
-  using HalfToFullFilterType = HalfToFullHermitianImageFilter<OutputImageType>;
-  auto halfToFullFilter = HalfToFullFilterType::New();
-  halfToFullFilter->SetActualXDimensionIsOdd(inputSize[0] % 2 != 0);
-  halfToFullFilter->SetInput(fftwOutput);
-  halfToFullFilter->GraftOutput(this->GetOutput());
-  halfToFullFilter->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
-  halfToFullFilter->UpdateLargestPossibleRegion();
-  this->GraftOutput(halfToFullFilter->GetOutput());
+  // Fill the missing half of each row with the complex conjugate of the
+  // value at the mirrored frequency.
+  for (SizeValueType row = 0; row < numberOfRows; ++row)
+  {
+    SizeValueType mirrorRow = 0;
+    SizeValueType remainder = row;
+    SizeValueType stride = 1;
+    for (unsigned int i = 1; i < ImageDimension; ++i)
+    {
+      const SizeValueType k = remainder % inputSize[i];
+      remainder /= inputSize[i];
+      mirrorRow += ((inputSize[i] - k) % inputSize[i]) * stride;
+      stride *= inputSize[i];
+    }
+    OutputPixelType *       fullRow = out + row * rowSize;
+    const OutputPixelType * mirrorFullRow = out + mirrorRow * rowSize;
+    for (SizeValueType k = halfRowSize; k < rowSize; ++k)
+    {
+      fullRow[k] = std::conj(mirrorFullRow[rowSize - k]);
+    }
+  }
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -35,6 +35,10 @@
 #  endif
 #  include <algorithm>
 #  include <cctype>
+#  include <functional>
+#  include <map>
+#  include <tuple>
+#  include <vector>
 
 struct FFTWGlobalConfigurationGlobals;
 
@@ -183,6 +187,50 @@ private:
   bool m_UseSteppingCode{ true };
 };
 
+/**
+ * \class FFTWPlanKey
+ * Identifies a plan in the plan cache of FFTWGlobalConfiguration. A plan
+ * can only be executed on other arrays when they have the same placement
+ * and alignment as the arrays it was created for.
+ *
+ * \ingroup ITKFFT
+ */
+struct FFTWPlanKey
+{
+  /** Kind of transform of the plan. */
+  enum class Kind : uint8_t
+  {
+    RealToComplex,
+    ComplexToReal,
+    Forward,
+    Backward
+  };
+
+  /** Size in bytes of the real type of the plan, float or double. */
+  unsigned int     precision;
+  Kind             kind;
+  std::vector<int> sizes;
+  unsigned int     flags;
+  int              threads;
+  bool             inPlace;
+  int              inputAlignment;
+  int              outputAlignment;
+
+  bool
+  operator<(const FFTWPlanKey & other) const
+  {
+    return std::tie(precision, kind, sizes, flags, threads, inPlace, inputAlignment, outputAlignment) <
+           std::tie(other.precision,
+                    other.kind,
+                    other.sizes,
+                    other.flags,
+                    other.threads,
+                    other.inPlace,
+                    other.inputAlignment,
+                    other.outputAlignment);
+  }
+};
+
 /**
  * \class FFTWGlobalConfiguration
  * A class to contain all the global configuration options for
@@ -348,6 +396,39 @@ public:
   static bool
   ExportDefaultWisdomFile();
 
+  /**
+   * \brief Set/Get whether the plans of the FFTW image filters are cached
+   *
+   * When enabled, the plans are created once per FFTWPlanKey and reused by
+   * all the filter instances of the process, instead of being created and
+   * destroyed at each execution. If the environmental variable
+   * "ITK_FFTW_PLAN_CACHE" is set, then the environmental setting overrides
+   * the default setting, which is true.
+   */
+  static void
+  SetUsePlanCache(const bool & v);
+  static bool
+  GetUsePlanCache();
+
+  /** Destroy the cached plans. This must not be called while FFTW image
+   * filters are executing. */
+  static void
+  ClearPlanCache();
+
+  /** Get the number of cached plans. */
+  static SizeValueType
+  GetPlanCacheSize();
+
+  /** Return the cached plan of the key. If there is none, the plan is
+   * created by createPlan() and cached, until it is destroyed by
+   * destroyPlan() when the cache is cleared. Thread safe. */
+  static void *
+  GetCachedPlan(const FFTWPlanKey & key, const std::function<void *()> & createPlan, void (*destroyPlan)(void *));
+
+  /** Return whether the plan is owned by the plan cache. */
+  static bool
+  IsCachedPlan(const void * plan);
+
 private:
   FFTWGlobalConfiguration();           // This will process env variables
   ~FFTWGlobalConfiguration() override; // This will write cache file if requested.
@@ -367,7 +448,15 @@ private:
 
   static FFTWGlobalConfigurationGlobals * m_PimplGlobals;
 
+  struct CachedPlan
+  {
+    void * m_Plan;
+    void (*m_DestroyPlan)(void *);
+  };
+
   std::mutex  m_Lock;
+  std::mutex  m_PlanCacheLock;
+  bool        m_UsePlanCache{ true };
   bool        m_NewWisdomAvailable{ false };
   int         m_PlanRigor{ 0 };
   bool        m_WriteWisdomCache{ false };
@@ -376,6 +465,8 @@ private:
   // m_WriteWisdomCache Controls the behavior of default
   // wisdom file creation policies.
   WisdomFilenameGeneratorBase * m_WisdomFilenameGenerator;
+
+  std::map<FFTWPlanKey, CachedPlan> m_PlanCache;
 };
 } // namespace itk
 #endif
@@ -91,12 +91,12 @@ FFTWInverseFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData
     sizes[(ImageDimension - 1) - i] = outputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_c2r(
+  plan = FFTWProxyType::CachedPlan_dft_c2r(
     ImageDimension, sizes, in, out, m_PlanRigor, MultiThreaderBase::GetGlobalDefaultNumberOfThreads(), false);
-  FFTWProxyType::Execute(plan);
+  FFTWProxyType::Execute_dft_c2r(plan, in, out);
 
   // Some cleanup.
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::ReleasePlan(plan);
 }
 
 template <typename TInputImage, typename TOutputImage>
@@ -90,10 +90,10 @@ FFTWRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generat
     sizes[(ImageDimension - 1) - i] = inputSize[i];
   }
 
-  plan = FFTWProxyType::Plan_dft_r2c(
+  plan = FFTWProxyType::CachedPlan_dft_r2c(
     ImageDimension, sizes, in, out, flags, MultiThreaderBase::GetGlobalDefaultNumberOfThreads());
-  FFTWProxyType::Execute(plan);
-  FFTWProxyType::DestroyPlan(plan);
+  FFTWProxyType::Execute_dft_r2c(plan, in, out);
+  FFTWProxyType::ReleasePlan(plan);
 }
 
 template <typename TInputImage, typename TOutputImage>
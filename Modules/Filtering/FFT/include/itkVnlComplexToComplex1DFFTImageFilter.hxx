@@ -25,8 +25,7 @@
 #include "itkIndent.h"
 #include "itkMetaDataObject.h"
 #include "itkMacro.h"
-#include "vnl/algo/vnl_fft_base.h"
-#include "vnl/algo/vnl_fft_1d.h"
+#include "itkVnlFFTCommon.h"
 
 namespace itk
 {
@@ -46,12 +45,16 @@ VnlComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   const unsigned int direction = this->GetDirection();
   const unsigned int vectorSize = inputSize[direction];
 
+  using PixelType = typename TInputImage::PixelType;
+  const VnlFFTCommon::LineTransform<typename NumericTraits<PixelType>::ValueType> lineTransform(vectorSize);
+
   MultiThreaderBase * multiThreader = this->GetMultiThreader();
   multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   multiThreader->template ParallelizeImageRegionRestrictDirection<TOutputImage::ImageDimension>(
     direction,
     output->GetRequestedRegion(),
-    [this, input, output, direction, vectorSize](const typename OutputImageType::RegionType & lambdaRegion) {
+    [this, input, output, direction, vectorSize, &lineTransform](
+      const typename OutputImageType::RegionType & lambdaRegion) {
       using InputIteratorType = ImageLinearConstIteratorWithIndex<InputImageType>;
       using OutputIteratorType = ImageLinearIteratorWithIndex<OutputImageType>;
       InputIteratorType  inputIt(input, lambdaRegion);
@@ -60,13 +63,12 @@ VnlComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
       inputIt.SetDirection(direction);
       outputIt.SetDirection(direction);
 
-      using PixelType = typename TInputImage::PixelType;
       using VNLVectorType = vnl_vector<PixelType>;
       VNLVectorType                    inputBuffer(vectorSize);
       typename VNLVectorType::iterator inputBufferIt = inputBuffer.begin();
       // fft is done in-place
-      typename VNLVectorType::iterator                         outputBufferIt = inputBuffer.begin();
-      vnl_fft_1d<typename NumericTraits<PixelType>::ValueType> v1d(vectorSize);
+      typename VNLVectorType::iterator outputBufferIt = inputBuffer.begin();
+      std::vector<PixelType>           work(lineTransform.GetWorkSize());
 
       // for every fft line
       for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd(); outputIt.NextLine(), inputIt.NextLine())
@@ -84,7 +86,7 @@ VnlComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
         // do the transform
         if (this->m_TransformDirection == Superclass::DIRECT)
         {
-          v1d.bwd_transform(inputBuffer);
+          lineTransform.Transform(inputBuffer.data_block(), -1, work.data());
           // copy the output from the buffer into our line
           outputBufferIt = inputBuffer.begin();
           outputIt.GoToBeginOfLine();
@@ -97,7 +99,7 @@ VnlComplexToComplex1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
         }
         else // m_TransformDirection == INVERSE
         {
-          v1d.fwd_transform(inputBuffer);
+          lineTransform.Transform(inputBuffer.data_block(), 1, work.data());
           // copy the output from the buffer into our line
           outputBufferIt = inputBuffer.begin();
           outputIt.GoToBeginOfLine();
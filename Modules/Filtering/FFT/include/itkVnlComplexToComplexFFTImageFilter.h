@@ -28,7 +28,10 @@ namespace itk
  *
  * \brief VNL based complex to complex Fast Fourier Transform.
  *
- * This filter requires input images with sizes which are a power of two.
+ * The transform is the fastest when the image size is a multiple of
+ * combinations of 2s, 3s, and/or 5s in all dimensions. The other sizes are
+ * supported through the Bluestein algorithm, at a higher cost. The lines of
+ * each dimension are transformed in parallel.
  *
  * \ingroup FourierTransform
  * \ingroup ITKFFT
@@ -44,32 +44,25 @@ VnlComplexToComplexFFTImageFilter<TInputImage, TOutputImage>::BeforeThreadedGene
   const typename ImageType::RegionType bufferedRegion = input->GetBufferedRegion();
   const typename ImageType::SizeType & imageSize = bufferedRegion.GetSize();
 
-  for (unsigned int ii = 0; ii < ImageDimension; ++ii)
-  {
-    if (!VnlFFTCommon::IsDimensionSizeLegal(imageSize[ii]))
-    {
-      itkExceptionMacro(<< "Cannot compute FFT of image with size " << imageSize
-                        << ". VnlComplexToComplexFFTImageFilter operates "
-                        << "only on images whose size in each dimension has"
-                        << "only a combination of 2,3, and 5 as prime factors.");
-    }
-  }
-
   // Copy the input to the output, and we will work in place on the output.
   ImageAlgorithm::Copy<ImageType, ImageType>(input, output, bufferedRegion, bufferedRegion);
 
   using VclPixelType = std::complex<typename PixelType::value_type>;
   auto * outputBuffer = static_cast<VclPixelType *>(output->GetBufferPointer());
 
+  // The lines of each dimension are transformed in parallel.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<Image<typename PixelType::value_type, ImageDimension>> vnlfft(imageSize);
   if (this->GetTransformDirection() == Superclass::TransformDirectionEnum::INVERSE)
   {
-    vnlfft.transform(outputBuffer, 1);
+    vnlfft.transform(outputBuffer, 1, multiThreader);
   }
   else
   {
-    vnlfft.transform(outputBuffer, -1);
+    vnlfft.transform(outputBuffer, -1, multiThreader);
   }
 }
 
@@ -19,8 +19,14 @@
 #define itkVnlFFTCommon_h
 
 #include "itkIntTypes.h"
+#include "itkMultiThreaderBase.h"
+#include "ITKFFTExport.h"
 
 #include "vnl/algo/vnl_fft_base.h"
+#include "vnl/algo/vnl_fft_prime_factors.h"
+#include <complex>
+#include <memory>
+#include <vector>
 
 namespace itk
 {
@@ -34,25 +40,129 @@ namespace itk
 struct VnlFFTCommon
 {
 
-  /** Vnl's FFT supports discrete Fourier transforms for images whose
-  sizes have a prime factorization consisting of 2's, 3's, and 5's. */
+  /** Vnl's FFT computes the discrete Fourier transforms of the sizes
+  whose prime factorization consists of 2's, 3's, and 5's with its mixed
+  radix algorithm. The other sizes are supported too, but are computed with
+  the slower Bluestein algorithm. */
   template <typename TSizeValue>
   static bool
   IsDimensionSizeLegal(TSizeValue n);
 
   static constexpr SizeValueType GREATEST_PRIME_FACTOR = 5;
 
+  /** Get the prime factorization and the twiddle factors of a transform of
+   * size n. They are computed at the first request and shared by all the
+   * transforms of that size and precision afterwards. The returned factors
+   * are read-only and can be used concurrently by several threads. */
+  template <typename TValue>
+  static std::shared_ptr<const vnl_fft_prime_factors<TValue>>
+  GetPrimeFactors(SizeValueType n);
+
+  /** Release the cached prime factors. The factors still referenced by a
+   * transform remain valid until that transform is destroyed. */
+  static void
+  ClearPrimeFactorsCache();
+
+  /** Number of transform sizes in the prime factors cache. */
+  static SizeValueType
+  GetPrimeFactorsCacheSize();
+
+  /**
+   *\class LineTransform
+   * \brief Discrete Fourier transform of the lines of a given size.
+   *
+   * The sizes whose prime factors are 2, 3 and 5 are transformed by the
+   * mixed radix algorithm of vnl. The other sizes are transformed by the
+   * Bluestein algorithm, which computes the transform as the convolution of
+   * the line with a chirp, itself computed with mixed radix transforms of a
+   * larger size. The transform is read-only once constructed and can be
+   * used concurrently by several threads, each with its own work buffer.
+   *
+   * \ingroup ITKFFT
+   */
+  template <typename TValue>
+  class LineTransform
+  {
+  public:
+    using ValueType = TValue;
+    using ComplexType = std::complex<TValue>;
+    using PrimeFactorsPointer = std::shared_ptr<const vnl_fft_prime_factors<TValue>>;
+
+    /** Constructor takes the size of the lines. */
+    explicit LineTransform(SizeValueType n);
+
+    /** Size of the lines. */
+    SizeValueType
+    GetSize() const
+    {
+      return m_Size;
+    }
+
+    /** Whether the lines are transformed by the Bluestein algorithm. */
+    bool
+    GetUseBluestein() const
+    {
+      return m_BluesteinSize != 0;
+    }
+
+    /** Number of complex values of the work buffer of Transform(), 0 if
+     * none is needed. */
+    SizeValueType
+    GetWorkSize() const
+    {
+      return m_BluesteinSize;
+    }
+
+    /** Transform in place numberOfLines lines, dir = +1/-1 according to
+     * the direction of the transform, without normalization. The elements
+     * of a line are stride values apart, and the first elements of two
+     * consecutive lines are jump values apart. */
+    void
+    Transform(ComplexType * data,
+              int           dir,
+              ComplexType * work,
+              SizeValueType stride = 1,
+              SizeValueType numberOfLines = 1,
+              SizeValueType jump = 0) const;
+
+  private:
+    SizeValueType       m_Size;
+    PrimeFactorsPointer m_Factors;
+
+    // Bluestein algorithm.
+    SizeValueType            m_BluesteinSize{ 0 };
+    std::vector<ComplexType> m_Chirp;
+    std::vector<ComplexType> m_ChirpSpectrum[2];
+  };
+
   /** Convenience struct for computing the discrete Fourier
   Transform. */
   template <typename TImage>
-  struct VnlFFTTransform : public vnl_fft_base<TImage::ImageDimension, typename TImage::PixelType>
+  struct VnlFFTTransform
   {
-    using Base = vnl_fft_base<TImage::ImageDimension, typename TImage::PixelType>;
+    using ValueType = typename TImage::PixelType;
+    using LineTransformType = LineTransform<ValueType>;
 
     //: constructor takes size of signal.
     VnlFFTTransform(const typename TImage::SizeType & s);
+
+    //: dir = +1/-1 according to direction of transform. The lines of each
+    //: dimension are transformed in parallel when a multi-threader is given.
+    void
+    transform(std::complex<ValueType> * signal, int dir, MultiThreaderBase * multiThreader = nullptr) const;
+
+  protected:
+    //: transforms of the lines of the signal dimensions, in vnl order.
+    std::shared_ptr<const LineTransformType> m_LineTransforms[TImage::ImageDimension];
   };
 };
+
+template <>
+ITKFFT_EXPORT std::shared_ptr<const vnl_fft_prime_factors<float>>
+VnlFFTCommon::GetPrimeFactors<float>(SizeValueType n);
+template <>
+ITKFFT_EXPORT std::shared_ptr<const vnl_fft_prime_factors<double>>
+VnlFFTCommon::GetPrimeFactors<double>(SizeValueType n);
 } // namespace itk
 
 #ifndef ITK_MANUAL_INSTANTIATION
@@ -18,6 +18,10 @@
 #ifndef itkVnlFFTCommon_hxx
 #define itkVnlFFTCommon_hxx
 
+#include "itkMath.h"
+#include "vnl/algo/vnl_fft.h"
+#include <algorithm>
+#include <cmath>
 
 namespace itk
 {
@@ -39,12 +43,227 @@ VnlFFTCommon::IsDimensionSizeLegal(TSizeValue n)
   return (n == 1); // return false if decomposition failed
 }
 
+template <typename TValue>
+VnlFFTCommon::LineTransform<TValue>::LineTransform(SizeValueType n)
+  : m_Size(n)
+{
+  if (IsDimensionSizeLegal(n))
+  {
+    m_Factors = VnlFFTCommon::GetPrimeFactors<TValue>(n);
+    return;
+  }
+
+  // The Bluestein algorithm uses the identity jk = (j^2 + k^2 - (k - j)^2) / 2
+  // to write the transform as the convolution of x_j w_j with conj(w_j),
+  // where w_j = exp(-i pi j^2 / n), followed by a multiplication by w_k. The
+  // cyclic convolution is computed by mixed radix transforms of size at
+  // least 2n - 1.
+  m_BluesteinSize = 2 * n - 1;
+  while (!IsDimensionSizeLegal(m_BluesteinSize))
+  {
+    ++m_BluesteinSize;
+  }
+  m_Factors = VnlFFTCommon::GetPrimeFactors<TValue>(m_BluesteinSize);
+
+  // j^2 is reduced modulo 2n to keep the accuracy of the angle for the
+  // large indices.
+  m_Chirp.resize(n);
+  for (SizeValueType j = 0; j < n; ++j)
+  {
+    const auto   j2 = static_cast<unsigned long long>(j) * j % (2 * static_cast<unsigned long long>(n));
+    const double angle = -itk::Math::pi * static_cast<double>(j2) / static_cast<double>(n);
+    m_Chirp[j] = ComplexType(static_cast<TValue>(std::cos(angle)), static_cast<TValue>(std::sin(angle)));
+  }
+
+  // Spectrum of the convolution kernel for each direction, including the
+  // normalization of the inverse transform of the convolution.
+  const long m = static_cast<long>(m_BluesteinSize);
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    std::vector<ComplexType> & spectrum = m_ChirpSpectrum[d];
+    spectrum.assign(m_BluesteinSize, ComplexType());
+    for (SizeValueType j = 0; j < n; ++j)
+    {
+      // The kernel is conj(w) for the direct transform and w for the inverse
+      // one.
+      const ComplexType value = (d == 0) ? std::conj(m_Chirp[j]) : m_Chirp[j];
+      spectrum[j] = value;
+      if (j != 0)
+      {
+        spectrum[m_BluesteinSize - j] = value;
+      }
+    }
+    auto * data = reinterpret_cast<TValue *>(spectrum.data());
+    long   info = 0;
+    vnl_fft_gpfa(data, data + 1, m_Factors->trigs(), 2, 0, m, 1, -1, m_Factors->pqr(), &info);
+    const TValue scale = TValue{ 1 } / static_cast<TValue>(m_BluesteinSize);
+    for (ComplexType & value : spectrum)
+    {
+      value *= scale;
+    }
+  }
+}
+
+template <typename TValue>
+void
+VnlFFTCommon::LineTransform<TValue>::Transform(ComplexType * data,
+                                               int           dir,
+                                               ComplexType * work,
+                                               SizeValueType stride,
+                                               SizeValueType numberOfLines,
+                                               SizeValueType jump) const
+{
+  if (m_Size <= 1 || numberOfLines == 0)
+  {
+    return;
+  }
+
+  if (!this->GetUseBluestein())
+  {
+    // The mixed radix transform processes the lines together.
+    auto * values = reinterpret_cast<TValue *>(data);
+    long   info = 0;
+    vnl_fft_gpfa(values,
+                 values + 1,
+                 m_Factors->trigs(),
+                 2 * static_cast<long>(stride),
+                 2 * static_cast<long>(jump),
+                 static_cast<long>(m_Size),
+                 static_cast<long>(numberOfLines),
+                 dir,
+                 m_Factors->pqr(),
+                 &info);
+    return;
+  }
+
+  const bool                direct = (dir < 0);
+  const ComplexType * const spectrum = m_ChirpSpectrum[direct ? 0 : 1].data();
+  const long                m = static_cast<long>(m_BluesteinSize);
+  auto * const              workValues = reinterpret_cast<TValue *>(work);
+  for (SizeValueType line = 0; line < numberOfLines; ++line)
+  {
+    ComplexType * const lineData = data + line * jump;
+    for (SizeValueType j = 0; j < m_Size; ++j)
+    {
+      const ComplexType chirp = direct ? m_Chirp[j] : std::conj(m_Chirp[j]);
+      work[j] = lineData[j * stride] * chirp;
+    }
+    std::fill(work + m_Size, work + m_BluesteinSize, ComplexType());
+
+    long info = 0;
+    vnl_fft_gpfa(workValues, workValues + 1, m_Factors->trigs(), 2, 0, m, 1, -1, m_Factors->pqr(), &info);
+    for (SizeValueType k = 0; k < m_BluesteinSize; ++k)
+    {
+      work[k] *= spectrum[k];
+    }
+    vnl_fft_gpfa(workValues, workValues + 1, m_Factors->trigs(), 2, 0, m, 1, 1, m_Factors->pqr(), &info);
+
+    for (SizeValueType k = 0; k < m_Size; ++k)
+    {
+      const ComplexType chirp = direct ? m_Chirp[k] : std::conj(m_Chirp[k]);
+      lineData[k * stride] = work[k] * chirp;
+    }
+  }
+}
+
 template <typename TImage>
 VnlFFTCommon::VnlFFTTransform<TImage>::VnlFFTTransform(const typename TImage::SizeType & s)
 {
   for (unsigned int i = 0; i < TImage::ImageDimension; ++i)
   {
-    Base::factors_[TImage::ImageDimension - i - 1].resize(s[i]);
+    // The dimensions of the same size share their transform.
+    for (unsigned int j = 0; j < i; ++j)
+    {
+      if (s[j] == s[i])
+      {
+        m_LineTransforms[TImage::ImageDimension - i - 1] = m_LineTransforms[TImage::ImageDimension - j - 1];
+        break;
+      }
+    }
+    if (!m_LineTransforms[TImage::ImageDimension - i - 1])
+    {
+      m_LineTransforms[TImage::ImageDimension - i - 1] = std::make_shared<const LineTransformType>(s[i]);
+    }
+  }
+}
+
+template <typename TImage>
+void
+VnlFFTCommon::VnlFFTTransform<TImage>::transform(std::complex<ValueType> * signal,
+                                                 int                       dir,
+                                                 MultiThreaderBase *       multiThreader) const
+{
+  constexpr unsigned int Dimension = TImage::ImageDimension;
+
+  // transform along each dimension, i, in turn.
+  for (unsigned int i = 0; i < Dimension; ++i)
+  {
+    SizeValueType N1 = 1; // n[0] n[1] ... n[i-1]
+    SizeValueType N3 = 1; // n[i+1] n[i+2] ... n[D-1]
+    for (unsigned int j = 0; j < Dimension; ++j)
+    {
+      const SizeValueType d = m_LineTransforms[j]->GetSize();
+      if (j < i)
+      {
+        N1 *= d;
+      }
+      if (j > i)
+      {
+        N3 *= d;
+      }
+    }
+    const LineTransformType & lineTransform = *m_LineTransforms[i];
+    const SizeValueType       N2 = lineTransform.GetSize();
+    if (N2 <= 1)
+    {
+      continue;
+    }
+
+    // The signal is seen as a N1xN2xN3 array, transformed along its second
+    // dimension. Its N1 * N3 lines are split in contiguous chunks, in which
+    // the lines that are evenly spaced are transformed together.
+    const SizeValueType numberOfLines = N1 * N3;
+    const auto          transformLines = [&](SizeValueType firstLine, SizeValueType lastLine) {
+      std::vector<std::complex<ValueType>> work(lineTransform.GetWorkSize());
+      while (firstLine < lastLine)
+      {
+        const SizeValueType n1 = firstLine / N3;
+        const SizeValueType n3 = firstLine % N3;
+        SizeValueType       count = 0;
+        SizeValueType       jump = 0;
+        if (N3 == 1)
+        {
+          count = lastLine - firstLine;
+          jump = N2;
+        }
+        else
+        {
+          count = std::min(lastLine - firstLine, N3 - n3);
+          jump = 1;
+        }
+        lineTransform.Transform(signal + n1 * N2 * N3 + n3, dir, work.data(), N3, count, jump);
+        firstLine += count;
+      }
+    };
+
+    const SizeValueType numberOfChunks =
+      (multiThreader != nullptr)
+        ? std::min(numberOfLines, static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()))
+        : 1;
+    if (numberOfChunks <= 1)
+    {
+      transformLines(0, numberOfLines);
+    }
+    else
+    {
+      multiThreader->ParallelizeArray(
+        0,
+        numberOfChunks,
+        [&](SizeValueType chunk) {
+          transformLines(chunk * numberOfLines / numberOfChunks, (chunk + 1) * numberOfLines / numberOfChunks);
+        },
+        nullptr);
+    }
   }
 }
 
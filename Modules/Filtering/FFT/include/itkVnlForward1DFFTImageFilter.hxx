@@ -26,8 +26,6 @@
 #include "itkMetaDataObject.h"
 #include "itkMacro.h"
 #include "itkVnlFFTCommon.h"
-#include "vnl/algo/vnl_fft_base.h"
-#include "vnl/algo/vnl_fft_1d.h"
 
 namespace itk
 {
@@ -46,18 +44,16 @@ VnlForward1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   const unsigned int direction = this->GetDirection();
   unsigned int       vectorSize = inputSize[direction];
-  if (!VnlFFTCommon::IsDimensionSizeLegal(vectorSize))
-  {
-    itkExceptionMacro("Illegal Array DIM for FFT");
-  }
 
+  using PixelType = typename TInputImage::PixelType;
+  const VnlFFTCommon::LineTransform<PixelType> lineTransform(vectorSize);
 
   MultiThreaderBase * multiThreader = this->GetMultiThreader();
   multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   multiThreader->template ParallelizeImageRegionRestrictDirection<TOutputImage::ImageDimension>(
     direction,
     output->GetRequestedRegion(),
-    [input, output, direction, vectorSize](const typename OutputImageType::RegionType & lambdaRegion) {
+    [input, output, direction, vectorSize, &lineTransform](const typename OutputImageType::RegionType & lambdaRegion) {
       using InputIteratorType = ImageLinearConstIteratorWithIndex<InputImageType>;
       using OutputIteratorType = ImageLinearIteratorWithIndex<OutputImageType>;
       InputIteratorType  inputIt(input, lambdaRegion);
@@ -66,14 +62,13 @@ VnlForward1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
       inputIt.SetDirection(direction);
       outputIt.SetDirection(direction);
 
-      using PixelType = typename TInputImage::PixelType;
       using ComplexType = std::complex<PixelType>;
       using ComplexVectorType = vnl_vector<ComplexType>;
       ComplexVectorType                    inputBuffer(vectorSize);
       typename ComplexVectorType::iterator inputBufferIt = inputBuffer.begin();
       // fft is done in-place
       typename ComplexVectorType::iterator outputBufferIt = inputBuffer.begin();
-      vnl_fft_1d<PixelType>                v1d(vectorSize);
+      std::vector<ComplexType>             work(lineTransform.GetWorkSize());
 
       // for every fft line
       for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd(); outputIt.NextLine(), inputIt.NextLine())
@@ -89,7 +84,7 @@ VnlForward1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
         }
 
         // do the transform
-        v1d.bwd_transform(inputBuffer);
+        lineTransform.Transform(inputBuffer.data_block(), -1, work.data());
 
         // copy the output from the buffer into our line
         outputBufferIt = inputBuffer.begin();
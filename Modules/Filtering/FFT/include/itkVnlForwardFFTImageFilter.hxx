@@ -18,10 +18,11 @@
 #ifndef itkVnlForwardFFTImageFilter_hxx
 #define itkVnlForwardFFTImageFilter_hxx
 
-#include "itkImageRegionIteratorWithIndex.h"
 #include "itkProgressReporter.h"
 #include "itkVnlFFTCommon.h"
 
+#include <algorithm>
+
 namespace itk
 {
 
@@ -50,35 +51,22 @@ VnlForwardFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   unsigned int vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    if (!VnlFFTCommon::IsDimensionSizeLegal(inputSize[i]))
-    {
-      itkExceptionMacro(<< "Cannot compute FFT of image with size " << inputSize
-                        << ". VnlForwardFFTImageFilter operates "
-                        << "only on images whose size in each dimension has"
-                        << "only a combination of 2,3, and 5 as prime factors.");
-    }
     vectorSize *= inputSize[i];
   }
 
+  // The output has the size and the layout of the input, so the transform is
+  // computed in place in the output buffer.
   const InputPixelType * in = inputPtr->GetBufferPointer();
-  SignalVectorType       signal(vectorSize);
-  for (unsigned int i = 0; i < vectorSize; ++i)
-  {
-    signal[i] = in[i];
-  }
+  OutputPixelType *      out = outputPtr->GetBufferPointer();
+  std::copy_n(in, vectorSize, out);
+
+  // The lines of each dimension are transformed in parallel.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
 
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<InputImageType> vnlfft(inputSize);
-  vnlfft.transform(signal.data_block(), -1);
-
-  // Copy the VNL output back to the ITK image.
-  ImageRegionIteratorWithIndex<TOutputImage> oIt(outputPtr, outputPtr->GetLargestPossibleRegion());
-  for (oIt.GoToBegin(); !oIt.IsAtEnd(); ++oIt)
-  {
-    typename OutputImageType::IndexType       index = oIt.GetIndex();
-    typename OutputImageType::OffsetValueType offset = inputPtr->ComputeOffset(index);
-    oIt.Set(signal[offset]);
-  }
+  vnlfft.transform(out, -1, multiThreader);
 }
 
 template <typename TInputImage, typename TOutputImage>
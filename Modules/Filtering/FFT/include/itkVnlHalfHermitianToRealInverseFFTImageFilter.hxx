@@ -53,13 +53,6 @@ VnlHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::Generate
   unsigned int vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    if (!VnlFFTCommon::IsDimensionSizeLegal(outputSize[i]))
-    {
-      itkExceptionMacro(<< "Cannot compute FFT of image with size " << outputSize
-                        << ". VnlHalfHermitianToRealInverseFFTImageFilter operates "
-                        << "only on images whose size in each dimension has"
-                        << "only a combination of 2,3, and 5 as prime factors.");
-    }
     vectorSize *= outputSize[i];
   }
 
@@ -94,9 +87,13 @@ VnlHalfHermitianToRealInverseFFTImageFilter<TInputImage, TOutputImage>::Generate
 
   OutputPixelType * out = outputPtr->GetBufferPointer();
 
+  // The lines of each dimension are transformed in parallel.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<OutputImageType> vnlfft(outputSize);
-  vnlfft.transform(signal.data_block(), 1);
+  vnlfft.transform(signal.data_block(), 1, multiThreader);
 
   // Copy the VNL output back to the ITK image. Extract the real part
   // of the signal. Ideally, the normalization by the number of
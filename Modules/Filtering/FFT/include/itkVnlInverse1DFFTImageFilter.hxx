@@ -25,8 +25,7 @@
 #include "itkIndent.h"
 #include "itkMetaDataObject.h"
 #include "itkMacro.h"
-#include "vnl/algo/vnl_fft_base.h"
-#include "vnl/algo/vnl_fft_1d.h"
+#include "itkVnlFFTCommon.h"
 
 namespace itk
 {
@@ -46,12 +45,15 @@ VnlInverse1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
   const unsigned int direction = this->GetDirection();
   unsigned int       vectorSize = inputSize[direction];
 
+  using OutputPixelType = typename TOutputImage::PixelType;
+  const VnlFFTCommon::LineTransform<OutputPixelType> lineTransform(vectorSize);
+
   MultiThreaderBase * multiThreader = this->GetMultiThreader();
   multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
   multiThreader->template ParallelizeImageRegionRestrictDirection<TOutputImage::ImageDimension>(
     direction,
     output->GetRequestedRegion(),
-    [input, output, direction, vectorSize](const typename OutputImageType::RegionType & lambdaRegion) {
+    [input, output, direction, vectorSize, &lineTransform](const typename OutputImageType::RegionType & lambdaRegion) {
       using InputIteratorType = ImageLinearConstIteratorWithIndex<InputImageType>;
       using OutputIteratorType = ImageLinearIteratorWithIndex<OutputImageType>;
       InputIteratorType  inputIt(input, lambdaRegion);
@@ -60,12 +62,11 @@ VnlInverse1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
       inputIt.SetDirection(direction);
       outputIt.SetDirection(direction);
 
-      using OutputPixelType = typename TOutputImage::PixelType;
       vnl_vector<std::complex<OutputPixelType>>                    inputBuffer(vectorSize);
       typename vnl_vector<std::complex<OutputPixelType>>::iterator inputBufferIt = inputBuffer.begin();
       // fft is done in-place
       typename vnl_vector<std::complex<OutputPixelType>>::iterator outputBufferIt = inputBuffer.begin();
-      vnl_fft_1d<OutputPixelType>                                  v1d(vectorSize);
+      std::vector<std::complex<OutputPixelType>>                   work(lineTransform.GetWorkSize());
 
       // for every fft line
       for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd(); outputIt.NextLine(), inputIt.NextLine())
@@ -81,7 +82,7 @@ VnlInverse1DFFTImageFilter<TInputImage, TOutputImage>::GenerateData()
         }
 
         // do the transform
-        v1d.fwd_transform(inputBuffer);
+        lineTransform.Transform(inputBuffer.data_block(), 1, work.data());
 
         // copy the output from the buffer into our line
         outputBufferIt = inputBuffer.begin();
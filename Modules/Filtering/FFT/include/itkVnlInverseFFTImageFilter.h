@@ -32,9 +32,10 @@ namespace itk
  *
  * \brief VNL-based reverse Fast Fourier Transform.
  *
- * The input image size must be a multiple of combinations of 2s, 3s,
- * and/or 5s in all dimensions (2, 3, and 5 should be the only prime
- * factors of the image size along each dimension).
+ * The transform is the fastest when the image size is a multiple of
+ * combinations of 2s, 3s, and/or 5s in all dimensions. The other sizes are
+ * supported through the Bluestein algorithm, at a higher cost. The lines of
+ * each dimension are transformed in parallel.
  *
  * \ingroup FourierTransform
  *
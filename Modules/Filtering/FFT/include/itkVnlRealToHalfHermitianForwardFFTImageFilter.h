@@ -32,8 +32,10 @@ namespace itk
  *
  * \brief VNL-based forward Fast Fourier Transform.
  *
- * The input image size in all dimensions must have a prime
- * factorization consisting of 2s, 3s, and 5s.
+ * The transform is the fastest when the image size is a multiple of
+ * combinations of 2s, 3s, and/or 5s in all dimensions. The other sizes are
+ * supported through the Bluestein algorithm, at a higher cost. The lines of
+ * each dimension are transformed in parallel.
  *
  * \ingroup FourierTransform
  *
@@ -49,13 +49,6 @@ VnlRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generate
   unsigned int vectorSize = 1;
   for (unsigned int i = 0; i < ImageDimension; ++i)
   {
-    if (!VnlFFTCommon::IsDimensionSizeLegal(inputSize[i]))
-    {
-      itkExceptionMacro(<< "Cannot compute FFT of image with size " << inputSize
-                        << ". VnlRealToHalfHermitianForwardFFTImageFilter operates "
-                        << "only on images whose size in each dimension has a prime "
-                        << "factorization consisting of only 2s, 3s, or 5s.");
-    }
     vectorSize *= inputSize[i];
   }
 
@@ -66,9 +59,13 @@ VnlRealToHalfHermitianForwardFFTImageFilter<TInputImage, TOutputImage>::Generate
     signal[i] = in[i];
   }
 
+  // The lines of each dimension are transformed in parallel.
+  MultiThreaderBase * multiThreader = this->GetMultiThreader();
+  multiThreader->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+
   // call the proper transform, based on compile type template parameter
   VnlFFTCommon::VnlFFTTransform<InputImageType> vnlfft(inputSize);
-  vnlfft.transform(signal.data_block(), -1);
+  vnlfft.transform(signal.data_block(), -1, multiThreader);
 
   // Copy the VNL output back to the ITK image.
   ImageRegionIteratorWithIndex<TOutputImage> oIt(outputPtr, outputPtr->GetLargestPossibleRegion());
@@ -475,6 +475,14 @@ FFTWGlobalConfiguration ::FFTWGlobalConfiguration()
     }
   }
 
+  {
+    std::string plan_cache_env;
+    if (itksys::SystemTools::GetEnv("ITK_FFTW_PLAN_CACHE", plan_cache_env) && isDeclineString(plan_cache_env))
+    {
+      this->m_UsePlanCache = false;
+    }
+  }
+
   if (this->m_ReadWisdomCache)
   {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -491,6 +499,13 @@ FFTWGlobalConfiguration ::FFTWGlobalConfiguration()
 
 FFTWGlobalConfiguration::~FFTWGlobalConfiguration()
 {
+  // The plans must be destroyed before the cleanup of FFTW.
+  for (const auto & cachedPlan : this->m_PlanCache)
+  {
+    cachedPlan.second.m_DestroyPlan(cachedPlan.second.m_Plan);
+  }
+  this->m_PlanCache.clear();
+
   if (this->m_WriteWisdomCache && this->m_NewWisdomAvailable)
   {
     std::string cachePath = m_WisdomFilenameGenerator->GenerateWisdomFilename(m_WisdomCacheBase);
@@ -822,6 +837,80 @@ FFTWGlobalConfiguration::SetWisdomCacheBase(const std::string & v)
   ImportDefaultWisdomFile();
 }
 
+void
+FFTWGlobalConfiguration::SetUsePlanCache(const bool & v)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  GetInstance()->m_UsePlanCache = v;
+}
+
+bool
+FFTWGlobalConfiguration::GetUsePlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  return GetInstance()->m_UsePlanCache;
+}
+
+void
+FFTWGlobalConfiguration::ClearPlanCache()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Self * const                instance = GetInstance();
+  std::lock_guard<std::mutex> cacheLock(instance->m_PlanCacheLock);
+  std::lock_guard<std::mutex> lock(instance->m_Lock);
+  for (const auto & cachedPlan : instance->m_PlanCache)
+  {
+    cachedPlan.second.m_DestroyPlan(cachedPlan.second.m_Plan);
+  }
+  instance->m_PlanCache.clear();
+}
+
+SizeValueType
+FFTWGlobalConfiguration::GetPlanCacheSize()
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Self * const                instance = GetInstance();
+  std::lock_guard<std::mutex> cacheLock(instance->m_PlanCacheLock);
+  return static_cast<SizeValueType>(instance->m_PlanCache.size());
+}
+
+void *
+FFTWGlobalConfiguration::GetCachedPlan(const FFTWPlanKey &             key,
+                                       const std::function<void *()> & createPlan,
+                                       void (*destroyPlan)(void *))
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Self * const instance = GetInstance();
+  // The plan is created while holding the cache lock, so that concurrent
+  // requests of the same plan only create it once. The planner itself is
+  // serialized by the FFTW lock, which is never held while taking this one.
+  std::lock_guard<std::mutex> cacheLock(instance->m_PlanCacheLock);
+  const auto                  found = instance->m_PlanCache.find(key);
+  if (found != instance->m_PlanCache.end())
+  {
+    return found->second.m_Plan;
+  }
+  void * const plan = createPlan();
+  if (plan != nullptr)
+  {
+    instance->m_PlanCache.emplace(key, CachedPlan{ plan, destroyPlan });
+  }
+  return plan;
+}
+
+bool
+FFTWGlobalConfiguration::IsCachedPlan(const void * plan)
+{
+  itkInitGlobalsMacro(PimplGlobals);
+  Self * const                instance = GetInstance();
+  std::lock_guard<std::mutex> cacheLock(instance->m_PlanCacheLock);
+  return std::any_of(instance->m_PlanCache.cbegin(),
+                     instance->m_PlanCache.cend(),
+                     [plan](const std::pair<const FFTWPlanKey, CachedPlan> & cachedPlan) {
+                       return cachedPlan.second.m_Plan == plan;
+                     });
+}
+
 std::string
 FFTWGlobalConfiguration::GetWisdomCacheBase()
 {
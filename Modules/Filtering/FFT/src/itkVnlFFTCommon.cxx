@@ -0,0 +1,102 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkVnlFFTCommon.h"
+
+#include <map>
+#include <mutex>
+
+namespace itk
+{
+namespace
+{
+template <typename TValue>
+struct PrimeFactorsCache
+{
+  std::mutex                                                                    m_Lock;
+  std::map<SizeValueType, std::shared_ptr<const vnl_fft_prime_factors<TValue>>> m_Factors;
+};
+
+template <typename TValue>
+PrimeFactorsCache<TValue> &
+GetPrimeFactorsCacheInstance()
+{
+  static PrimeFactorsCache<TValue> cache;
+  return cache;
+}
+
+template <typename TValue>
+std::shared_ptr<const vnl_fft_prime_factors<TValue>>
+GetCachedPrimeFactors(SizeValueType n)
+{
+  PrimeFactorsCache<TValue> & cache = GetPrimeFactorsCacheInstance<TValue>();
+  std::lock_guard<std::mutex> lock(cache.m_Lock);
+  auto &                      factors = cache.m_Factors[n];
+  if (!factors)
+  {
+    factors = std::make_shared<const vnl_fft_prime_factors<TValue>>(static_cast<int>(n));
+  }
+  return factors;
+}
+
+template <typename TValue>
+void
+ClearCachedPrimeFactors()
+{
+  PrimeFactorsCache<TValue> & cache = GetPrimeFactorsCacheInstance<TValue>();
+  std::lock_guard<std::mutex> lock(cache.m_Lock);
+  cache.m_Factors.clear();
+}
+
+template <typename TValue>
+SizeValueType
+GetCachedPrimeFactorsSize()
+{
+  PrimeFactorsCache<TValue> & cache = GetPrimeFactorsCacheInstance<TValue>();
+  std::lock_guard<std::mutex> lock(cache.m_Lock);
+  return cache.m_Factors.size();
+}
+} // namespace
+
+template <>
+std::shared_ptr<const vnl_fft_prime_factors<float>>
+VnlFFTCommon::GetPrimeFactors<float>(SizeValueType n)
+{
+  return GetCachedPrimeFactors<float>(n);
+}
+
+template <>
+std::shared_ptr<const vnl_fft_prime_factors<double>>
+VnlFFTCommon::GetPrimeFactors<double>(SizeValueType n)
+{
+  return GetCachedPrimeFactors<double>(n);
+}
+
+void
+VnlFFTCommon::ClearPrimeFactorsCache()
+{
+  ClearCachedPrimeFactors<float>();
+  ClearCachedPrimeFactors<double>();
+}
+
+SizeValueType
+VnlFFTCommon::GetPrimeFactorsCacheSize()
+{
+  return GetCachedPrimeFactorsSize<float>() + GetCachedPrimeFactorsSize<double>();
+}
+
+} // end namespace itk
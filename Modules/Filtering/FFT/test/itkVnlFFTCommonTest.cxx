@@ -0,0 +1,165 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkVnlFFTCommon.h"
+#include "itkImage.h"
+#include "itkMath.h"
+#include "itkTestingMacros.h"
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+namespace
+{
+// Compare the transform of interleaved lines with a direct computation of
+// the discrete Fourier transform.
+template <typename TValue>
+int
+CompareLineTransformWithDFT(itk::SizeValueType n, itk::SizeValueType numberOfLines, int dir)
+{
+  using LineTransformType = itk::VnlFFTCommon::LineTransform<TValue>;
+  using ComplexType = std::complex<TValue>;
+
+  // The lines are interleaved: the elements of a line are numberOfLines
+  // values apart, and the lines start at consecutive values.
+  std::vector<ComplexType> data(n * numberOfLines);
+  for (itk::SizeValueType i = 0; i < data.size(); ++i)
+  {
+    data[i] = ComplexType(static_cast<TValue>(std::cos(0.3 * i)), static_cast<TValue>((i % 5) * 0.25));
+  }
+  const std::vector<ComplexType> original = data;
+
+  const LineTransformType  lineTransform(n);
+  std::vector<ComplexType> work(lineTransform.GetWorkSize());
+  lineTransform.Transform(data.data(), dir, work.data(), numberOfLines, numberOfLines, 1);
+
+  for (itk::SizeValueType line = 0; line < numberOfLines; ++line)
+  {
+    for (itk::SizeValueType k = 0; k < n; ++k)
+    {
+      std::complex<double> expected = 0.0;
+      for (itk::SizeValueType j = 0; j < n; ++j)
+      {
+        const double angle = dir * 2.0 * itk::Math::pi * static_cast<double>(j * k % n) / static_cast<double>(n);
+        const auto   value = original[j * numberOfLines + line];
+        expected += std::complex<double>(value.real(), value.imag()) * std::polar(1.0, angle);
+      }
+      const ComplexType actual = data[k * numberOfLines + line];
+      if (std::abs(std::complex<double>(actual.real(), actual.imag()) - expected) > 1e-3 * n)
+      {
+        std::cerr << "Test failed!" << std::endl;
+        std::cerr << "Error in the transform of size " << n << " (Bluestein: " << lineTransform.GetUseBluestein()
+                  << ") in direction " << dir << " at line " << line << ", index " << k << ": expected " << expected
+                  << " but got " << actual << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename TValue>
+int
+RoundTrip()
+{
+  using ImageType = itk::Image<TValue, 2>;
+  using TransformType = itk::VnlFFTCommon::VnlFFTTransform<ImageType>;
+
+  typename ImageType::SizeType size;
+  size[0] = 6;
+  size[1] = 7;
+  const unsigned int numberOfPixels = size[0] * size[1];
+
+  std::vector<std::complex<TValue>> signal(numberOfPixels);
+  for (unsigned int i = 0; i < numberOfPixels; ++i)
+  {
+    signal[i] = std::complex<TValue>(static_cast<TValue>(std::sin(0.5 * i)), static_cast<TValue>(i % 3));
+  }
+  const std::vector<std::complex<TValue>> original = signal;
+
+  // Two transforms of the same size share their factors, and a transform
+  // computed with cached factors is inverted by another one, computed in
+  // parallel.
+  const TransformType forward(size);
+  const TransformType inverse(size);
+  forward.transform(signal.data(), -1);
+
+  auto multiThreader = itk::MultiThreaderBase::New();
+  multiThreader->SetNumberOfWorkUnits(4);
+  inverse.transform(signal.data(), 1, multiThreader);
+
+  for (unsigned int i = 0; i < numberOfPixels; ++i)
+  {
+    if (std::abs(signal[i] / static_cast<TValue>(numberOfPixels) - original[i]) > 1e-4)
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "Error in the round trip at index " << i << ": expected " << original[i] << " but got "
+                << signal[i] / static_cast<TValue>(numberOfPixels) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkVnlFFTCommonTest(int, char *[])
+{
+  itk::VnlFFTCommon::ClearPrimeFactorsCache();
+  ITK_TEST_EXPECT_EQUAL(itk::VnlFFTCommon::GetPrimeFactorsCacheSize(), 0);
+
+  const auto factors = itk::VnlFFTCommon::GetPrimeFactors<float>(12);
+  ITK_TEST_EXPECT_TRUE(factors != nullptr);
+  ITK_TEST_EXPECT_EQUAL(factors->number(), 12);
+  ITK_TEST_EXPECT_TRUE(factors == itk::VnlFFTCommon::GetPrimeFactors<float>(12));
+  ITK_TEST_EXPECT_TRUE(factors != itk::VnlFFTCommon::GetPrimeFactors<float>(10));
+  ITK_TEST_EXPECT_EQUAL(itk::VnlFFTCommon::GetPrimeFactorsCacheSize(), 2);
+
+  // The precisions are cached separately.
+  ITK_TEST_EXPECT_EQUAL(itk::VnlFFTCommon::GetPrimeFactors<double>(12)->number(), 12);
+  ITK_TEST_EXPECT_EQUAL(itk::VnlFFTCommon::GetPrimeFactorsCacheSize(), 3);
+
+  // The factors remain valid after the cache is cleared.
+  itk::VnlFFTCommon::ClearPrimeFactorsCache();
+  ITK_TEST_EXPECT_EQUAL(itk::VnlFFTCommon::GetPrimeFactorsCacheSize(), 0);
+  ITK_TEST_EXPECT_EQUAL(factors->number(), 12);
+  ITK_TEST_EXPECT_TRUE(factors != itk::VnlFFTCommon::GetPrimeFactors<float>(12));
+
+  int testStatus = EXIT_SUCCESS;
+  if (RoundTrip<float>() == EXIT_FAILURE || RoundTrip<double>() == EXIT_FAILURE)
+  {
+    testStatus = EXIT_FAILURE;
+  }
+
+  // Mixed radix and Bluestein sizes, in both directions.
+  for (const itk::SizeValueType n : { 1, 2, 7, 12, 13, 45, 97 })
+  {
+    for (const int dir : { -1, 1 })
+    {
+      if (CompareLineTransformWithDFT<float>(n, 3, dir) == EXIT_FAILURE ||
+          CompareLineTransformWithDFT<double>(n, 1, dir) == EXIT_FAILURE)
+      {
+        testStatus = EXIT_FAILURE;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
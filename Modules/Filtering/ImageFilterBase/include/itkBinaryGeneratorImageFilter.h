@@ -20,6 +20,7 @@
 
 #include "itkInPlaceImageFilter.h"
 #include "itkSimpleDataObjectDecorator.h"
+#include "itkVectorizedPixelLoop.h"
 
 
 #include <functional>
@@ -45,6 +46,11 @@ namespace itk
  * the pipeline. The SetConstant() and GetConstant() methods are provided as shortcuts
  * to set or get the constant value without manipulating the decorator.
  *
+ * When the functor is vectorizable (see Functor::IsVectorizable) and the
+ * images are images of scalars, the pixels are processed by loops over the
+ * buffers, compiled for the SIMD instruction sets of the processor (see
+ * VectorizedPixelLoop), unless UseVectorization is off.
+ *
  * \sa UnaryGeneratorImageFilter
  * \sa BinaryFunctorImageFilter
  *
@@ -209,6 +215,12 @@ public:
   }
 #endif // !defined( ITK_WRAPPING_PARSER )
 
+  /** Set/Get whether the pixels are processed by vectorized loops when the
+   * functor and the images allow it. Default is true. */
+  itkSetMacro(UseVectorization, bool);
+  itkGetConstMacro(UseVectorization, bool);
+  itkBooleanMacro(UseVectorization);
+
 
   /** ImageDimension constants */
   static constexpr unsigned int InputImage1Dimension = TInputImage1::ImageDimension;
@@ -248,8 +260,33 @@ protected:
   void
   GenerateOutputInformation() override;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 private:
+  /** Whether the vectorized loops may be used with the functor. */
+  template <typename TFunctor>
+  using CanVectorize = std::integral_constant<bool,
+                                              Functor::IsVectorizable<TFunctor>::value &&
+                                                VectorizedPixelLoop::IsScalarImage<TInputImage1>::value &&
+                                                VectorizedPixelLoop::IsScalarImage<TInputImage2>::value &&
+                                                VectorizedPixelLoop::IsScalarImage<TOutputImage>::value>;
+
+  /** Process the region with the vectorized loops, and return whether it
+   * could. */
+  template <typename TFunctor>
+  bool
+  VectorizedGenerateData(const TFunctor & functor, const OutputImageRegionType & outputRegionForThread, std::true_type);
+  template <typename TFunctor>
+  bool
+  VectorizedGenerateData(const TFunctor &, const OutputImageRegionType &, std::false_type)
+  {
+    return false;
+  }
+
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction;
+
+  bool m_UseVectorization{ true };
 };
 } // end namespace itk
 
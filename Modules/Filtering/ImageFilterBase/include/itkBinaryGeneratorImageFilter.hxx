@@ -177,6 +177,11 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
   const TFunctor &              functor,
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (m_UseVectorization && this->VectorizedGenerateData(functor, outputRegionForThread, CanVectorize<TFunctor>()))
+  {
+    return;
+  }
+
   // We use dynamic_cast since inputs are stored as DataObjects. The
   // ImageToImageFilter::GetInput(int) always returns a pointer to a
   // TInputImage1 so it cannot be used for the second input.
@@ -253,6 +258,97 @@ BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::DynamicThr
     itkGenericExceptionMacro(<< "At most one of the inputs can be a constant.");
   }
 }
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+template <typename TFunctor>
+bool
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::VectorizedGenerateData(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  const auto *   inputPtr1 = dynamic_cast<const TInputImage1 *>(ProcessObject::GetInput(0));
+  const auto *   inputPtr2 = dynamic_cast<const TInputImage2 *>(ProcessObject::GetInput(1));
+  TOutputImage * outputPtr = this->GetOutput(0);
+
+  if (!inputPtr1 && !inputPtr2)
+  {
+    // reported by the scalar path
+    return false;
+  }
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  bool contiguous = VectorizedPixelLoop::IsContiguous(outputRegionForThread, outputPtr->GetBufferedRegion());
+  if (inputPtr1)
+  {
+    contiguous = contiguous && VectorizedPixelLoop::IsContiguous(outputRegionForThread, inputPtr1->GetBufferedRegion());
+  }
+  if (inputPtr2)
+  {
+    contiguous = contiguous && VectorizedPixelLoop::IsContiguous(outputRegionForThread, inputPtr2->GetBufferedRegion());
+  }
+
+  const auto bufferAt = [](auto * image, const typename OutputImageRegionType::IndexType & index) {
+    return image->GetBufferPointer() + image->ComputeOffset(index);
+  };
+
+  if (inputPtr1 && inputPtr2)
+  {
+    VectorizedPixelLoop::ForEachSpan(
+      outputRegionForThread,
+      contiguous,
+      [&](const typename OutputImageRegionType::IndexType & index, SizeValueType numberOfPixels) {
+        const Input1ImagePixelType * const input1 = bufferAt(inputPtr1, index);
+        const Input2ImagePixelType * const input2 = bufferAt(inputPtr2, index);
+        OutputImagePixelType * const       output = bufferAt(outputPtr, index);
+        VectorizedPixelLoop::Run(
+          [input1, input2, output, functor](SizeValueType i) { output[i] = functor(input1[i], input2[i]); },
+          numberOfPixels);
+        progress.Completed(numberOfPixels);
+      });
+  }
+  else if (inputPtr1)
+  {
+    const Input2ImagePixelType input2Value = this->GetConstant2();
+    VectorizedPixelLoop::ForEachSpan(
+      outputRegionForThread,
+      contiguous,
+      [&](const typename OutputImageRegionType::IndexType & index, SizeValueType numberOfPixels) {
+        const Input1ImagePixelType * const input1 = bufferAt(inputPtr1, index);
+        OutputImagePixelType * const       output = bufferAt(outputPtr, index);
+        VectorizedPixelLoop::Run(
+          [input1, input2Value, output, functor](SizeValueType i) { output[i] = functor(input1[i], input2Value); },
+          numberOfPixels);
+        progress.Completed(numberOfPixels);
+      });
+  }
+  else
+  {
+    const Input1ImagePixelType input1Value = this->GetConstant1();
+    VectorizedPixelLoop::ForEachSpan(
+      outputRegionForThread,
+      contiguous,
+      [&](const typename OutputImageRegionType::IndexType & index, SizeValueType numberOfPixels) {
+        const Input2ImagePixelType * const input2 = bufferAt(inputPtr2, index);
+        OutputImagePixelType * const       output = bufferAt(outputPtr, index);
+        VectorizedPixelLoop::Run(
+          [input1Value, input2, output, functor](SizeValueType i) { output[i] = functor(input1Value, input2[i]); },
+          numberOfPixels);
+        progress.Completed(numberOfPixels);
+      });
+  }
+  return true;
+}
+
+template <typename TInputImage1, typename TInputImage2, typename TOutputImage>
+void
+BinaryGeneratorImageFilter<TInputImage1, TInputImage2, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseVectorization: " << (m_UseVectorization ? "On" : "Off") << std::endl;
+}
 } // end namespace itk
 
 #endif
@@ -18,10 +18,13 @@
 #ifndef itkRecursiveSeparableImageFilter_h
 #define itkRecursiveSeparableImageFilter_h
 
+#include "itkImage.h"
 #include "itkInPlaceImageFilter.h"
 #include "itkNumericTraits.h"
 #include "itkVariableLengthVector.h"
 
+#include <type_traits> // For integral_constant.
+
 namespace itk
 {
 /** \class RecursiveSeparableImageFilter
@@ -45,6 +48,13 @@ namespace itk
  * Filters". J Math Imaging Vis 26, 293–299 (2006).
  * https://doi.org/10.1007/s10851-006-8464-z
  *
+ * For images of scalar pixels, the lines along the dimensions other than the
+ * first one are filtered in blocks of adjacent lines. The pixels of the lines
+ * of a block are interleaved, so that the memory is accessed contiguously
+ * even though the lines are strided, and the compiler can vectorize the
+ * recursion across the lines. The result is the same as filtering the lines
+ * one by one.
+ *
  * \ingroup ImageFilters
  * \ingroup ITKImageFilterBase
  */
@@ -140,6 +150,20 @@ protected:
   void
   FilterDataArray(RealType * outs, const RealType * data, RealType * scratch, SizeValueType ln) const;
 
+  /** Apply the Recursive Filter to a block of numberOfLanes lines at once.
+   * The pixels of the lines are interleaved: pixel i of line b is at index
+   * i * LineBlockSize + b of "outs", "data" and "scratch", which hold
+   * ln * LineBlockSize values. Each line is filtered as by FilterDataArray. */
+  void
+  FilterDataBlock(RealType *       outs,
+                  const RealType * data,
+                  RealType *       scratch,
+                  SizeValueType    ln,
+                  SizeValueType    numberOfLanes) const;
+
+  /** Maximum number of adjacent lines that are filtered together. */
+  static constexpr SizeValueType LineBlockSize = 16;
+
 protected:
   /** Causal coefficients that multiply the input data. */
   ScalarRealType m_N0;
@@ -252,6 +276,22 @@ protected:
   }
 
 private:
+  /** Whether the lines are filtered in blocks of adjacent lines, along the
+   * dimensions other than the first one. */
+  using SupportsLineBlocks = std::integral_constant<
+    bool,
+    (TOutputImage::ImageDimension > 1) && std::is_floating_point<RealType>::value &&
+      std::is_arithmetic<InputPixelType>::value && std::is_arithmetic<typename TOutputImage::PixelType>::value &&
+      std::is_same<TInputImage, Image<InputPixelType, TInputImage::ImageDimension>>::value &&
+      std::is_same<TOutputImage, Image<typename TOutputImage::PixelType, TOutputImage::ImageDimension>>::value>;
+
+  /** Filters the lines of the region in blocks of adjacent lines. */
+  void
+  BlockDynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  BlockDynamicThreadedGenerateData(const OutputImageRegionType &, std::false_type)
+  {}
+
   /** Direction in which the filter is to be applied
    * this should be in the range [0,ImageDimension-1]. */
   unsigned int m_Direction{ 0 };
@@ -20,6 +20,7 @@
 
 #include "itkObjectFactory.h"
 #include "itkImageLinearIteratorWithIndex.h"
+#include "itkIndexRange.h"
 #include <memory> // For unique_ptr
 
 namespace itk
@@ -165,6 +166,129 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataArray(RealTy
   }
 }
 
+/**
+ * Apply Recursive Filter to interleaved lines
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::FilterDataBlock(RealType * const       outs,
+                                                                          const RealType * const data,
+                                                                          RealType * const       scratch,
+                                                                          const SizeValueType    ln,
+                                                                          const SizeValueType    numberOfLanes) const
+{
+  // The operations are those of FilterDataArray, applied to each lane, so
+  // that the result is the same.
+  constexpr SizeValueType B = LineBlockSize;
+
+  RealType * const scratch1 = outs;
+  RealType * const scratch2 = scratch;
+
+  /**
+   * Causal direction pass
+   */
+  for (SizeValueType b = 0; b < numberOfLanes; ++b)
+  {
+    const RealType outV1 = data[b];
+
+    MathEMAMAMAM(scratch1[b], outV1, m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(scratch1[B + b], data[B + b], m_N0, outV1, m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(scratch1[2 * B + b], data[2 * B + b], m_N0, data[B + b], m_N1, outV1, m_N2, outV1, m_N3);
+    MathEMAMAMAM(
+      scratch1[3 * B + b], data[3 * B + b], m_N0, data[2 * B + b], m_N1, data[B + b], m_N2, outV1, m_N3);
+
+    MathSMAMAMAM(scratch1[b], outV1, m_BN1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(scratch1[B + b], scratch1[b], m_D1, outV1, m_BN2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(scratch1[2 * B + b], scratch1[B + b], m_D1, scratch1[b], m_D2, outV1, m_BN3, outV1, m_BN4);
+    MathSMAMAMAM(scratch1[3 * B + b],
+                 scratch1[2 * B + b],
+                 m_D1,
+                 scratch1[B + b],
+                 m_D2,
+                 scratch1[b],
+                 m_D3,
+                 outV1,
+                 m_BN4);
+  }
+
+  for (SizeValueType i = 4; i < ln; ++i)
+  {
+    RealType * const       out = scratch1 + i * B;
+    const RealType * const in = data + i * B;
+    for (SizeValueType b = 0; b < numberOfLanes; ++b)
+    {
+      MathEMAMAMAM(out[b], in[b], m_N0, in[b - B], m_N1, in[b - 2 * B], m_N2, in[b - 3 * B], m_N3);
+      MathSMAMAMAM(out[b], out[b - B], m_D1, out[b - 2 * B], m_D2, out[b - 3 * B], m_D3, out[b - 4 * B], m_D4);
+    }
+  }
+
+  /**
+   * AntiCausal direction pass
+   */
+  const SizeValueType last = (ln - 1) * B;
+  for (SizeValueType b = 0; b < numberOfLanes; ++b)
+  {
+    const RealType outV2 = data[last + b];
+
+    MathEMAMAMAM(scratch2[last + b], outV2, m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch2[last - B + b], data[last + b], m_M1, outV2, m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(
+      scratch2[last - 2 * B + b], data[last - B + b], m_M1, data[last + b], m_M2, outV2, m_M3, outV2, m_M4);
+    MathEMAMAMAM(scratch2[last - 3 * B + b],
+                 data[last - 2 * B + b],
+                 m_M1,
+                 data[last - B + b],
+                 m_M2,
+                 data[last + b],
+                 m_M3,
+                 outV2,
+                 m_M4);
+
+    MathSMAMAMAM(scratch2[last + b], outV2, m_BM1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch2[last - B + b], scratch2[last + b], m_D1, outV2, m_BM2, outV2, m_BM3, outV2, m_BM4);
+    MathSMAMAMAM(scratch2[last - 2 * B + b],
+                 scratch2[last - B + b],
+                 m_D1,
+                 scratch2[last + b],
+                 m_D2,
+                 outV2,
+                 m_BM3,
+                 outV2,
+                 m_BM4);
+    MathSMAMAMAM(scratch2[last - 3 * B + b],
+                 scratch2[last - 2 * B + b],
+                 m_D1,
+                 scratch2[last - B + b],
+                 m_D2,
+                 scratch2[last + b],
+                 m_D3,
+                 outV2,
+                 m_BM4);
+  }
+
+  for (SizeValueType i = ln - 4; i > 0; i--)
+  {
+    RealType * const       out = scratch2 + (i - 1) * B;
+    const RealType * const in = data + i * B;
+    for (SizeValueType b = 0; b < numberOfLanes; ++b)
+    {
+      MathEMAMAMAM(out[b], in[b], m_M1, in[b + B], m_M2, in[b + 2 * B], m_M3, in[b + 3 * B], m_M4);
+      MathSMAMAMAM(out[b], out[b + B], m_D1, out[b + 2 * B], m_D2, out[b + 3 * B], m_D3, out[b + 4 * B], m_D4);
+    }
+  }
+
+  /**
+   * Roll the antiCausal part into the output
+   */
+  for (SizeValueType i = 0; i < ln * B; i += B)
+  {
+    for (SizeValueType b = 0; b < numberOfLanes; ++b)
+    {
+      outs[i + b] += scratch2[i + b];
+    }
+  }
+}
+
 //
 // we need all of the image in just the "Direction" we are separated into
 //
@@ -268,6 +392,12 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
 
   using RegionType = ImageRegion<TInputImage::ImageDimension>;
 
+  if (SupportsLineBlocks::value && this->m_Direction != 0)
+  {
+    this->BlockDynamicThreadedGenerateData(outputRegionForThread, SupportsLineBlocks());
+    return;
+  }
+
   typename TInputImage::ConstPointer inputImage(this->GetInputImage());
   typename TOutputImage::Pointer     outputImage(this->GetOutput());
 
@@ -311,6 +441,72 @@ RecursiveSeparableImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerat
   }
 }
 
+/**
+ * Compute Recursive filter
+ * by blocks of adjacent lines in one of the dimensions
+ */
+template <typename TInputImage, typename TOutputImage>
+void
+RecursiveSeparableImageFilter<TInputImage, TOutputImage>::BlockDynamicThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  using OutputPixelType = typename TOutputImage::PixelType;
+
+  const TInputImage * const inputImage = this->GetInputImage();
+  TOutputImage * const      outputImage = this->GetOutput();
+
+  const unsigned int  direction = this->m_Direction;
+  const SizeValueType ln = outputRegionForThread.GetSize(direction);
+  const SizeValueType totalNumberOfLanes = outputRegionForThread.GetSize(0);
+
+  const OffsetValueType inputStride = inputImage->GetOffsetTable()[direction];
+  const OffsetValueType outputStride = outputImage->GetOffsetTable()[direction];
+
+  const std::unique_ptr<RealType[]> inps(new RealType[ln * LineBlockSize]);
+  const std::unique_ptr<RealType[]> outs(new RealType[ln * LineBlockSize]);
+  const std::unique_ptr<RealType[]> scratch(new RealType[ln * LineBlockSize]);
+
+  // Each index of this region is the first pixel of a row of lines that
+  // are adjacent along the first dimension.
+  OutputImageRegionType blocksRegion = outputRegionForThread;
+  blocksRegion.SetSize(direction, 1);
+  blocksRegion.SetSize(0, 1);
+
+  for (const auto & blocksIndex : ImageRegionIndexRange<TOutputImage::ImageDimension>(blocksRegion))
+  {
+    const InputPixelType * const inputLines = inputImage->GetBufferPointer() + inputImage->ComputeOffset(blocksIndex);
+    OutputPixelType * const outputLines = outputImage->GetBufferPointer() + outputImage->ComputeOffset(blocksIndex);
+
+    for (SizeValueType firstLane = 0; firstLane < totalNumberOfLanes; firstLane += LineBlockSize)
+    {
+      const SizeValueType numberOfLanes = std::min(LineBlockSize, totalNumberOfLanes - firstLane);
+
+      for (SizeValueType i = 0; i < ln; ++i)
+      {
+        const InputPixelType * const in = inputLines + static_cast<OffsetValueType>(i) * inputStride + firstLane;
+        RealType * const             block = inps.get() + i * LineBlockSize;
+        for (SizeValueType b = 0; b < numberOfLanes; ++b)
+        {
+          block[b] = static_cast<RealType>(in[b]);
+        }
+      }
+
+      this->FilterDataBlock(outs.get(), inps.get(), scratch.get(), ln, numberOfLanes);
+
+      for (SizeValueType i = 0; i < ln; ++i)
+      {
+        OutputPixelType * const out = outputLines + static_cast<OffsetValueType>(i) * outputStride + firstLane;
+        const RealType * const  block = outs.get() + i * LineBlockSize;
+        for (SizeValueType b = 0; b < numberOfLanes; ++b)
+        {
+          out[b] = static_cast<OutputPixelType>(block[b]);
+        }
+      }
+    }
+  }
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 RecursiveSeparableImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
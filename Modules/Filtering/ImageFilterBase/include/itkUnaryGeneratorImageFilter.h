@@ -21,6 +21,7 @@
 #include "itkMath.h"
 #include "itkInPlaceImageFilter.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkVectorizedPixelLoop.h"
 
 #include <functional>
 
@@ -45,6 +46,12 @@ namespace itk
  * UnaryGeneratorImageFilter can be used to promote a 2D image to a 3D
  * image, etc.
  *
+ * When the functor is vectorizable (see Functor::IsVectorizable) and both
+ * images are images of scalars of the same dimension, the pixels are
+ * processed by loops over the buffers, compiled for the SIMD instruction
+ * sets of the processor (see VectorizedPixelLoop), unless UseVectorization
+ * is off.
+ *
  * \sa UnaryFunctorImageFilter
  * \sa BinaryGeneratorImageFilter TernaryGeneratormageFilter
  *
@@ -151,6 +158,12 @@ public:
   }
 #endif // !defined( ITK_WRAPPING_PARSER )
 
+  /** Set/Get whether the pixels are processed by vectorized loops when the
+   * functor and the images allow it. Default is true. */
+  itkSetMacro(UseVectorization, bool);
+  itkGetConstMacro(UseVectorization, bool);
+  itkBooleanMacro(UseVectorization);
+
 protected:
   UnaryGeneratorImageFilter();
   ~UnaryGeneratorImageFilter() override = default;
@@ -182,8 +195,34 @@ protected:
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
 private:
+  /** Whether the vectorized loops may be used with the functor. */
+  template <typename TFunctor>
+  using CanVectorize =
+    std::integral_constant<bool,
+                           Functor::IsVectorizable<TFunctor>::value &&
+                             VectorizedPixelLoop::IsScalarImage<TInputImage>::value &&
+                             VectorizedPixelLoop::IsScalarImage<TOutputImage>::value &&
+                             int{ TInputImage::ImageDimension } == int{ TOutputImage::ImageDimension }>;
+
+  /** Process the region with the vectorized loops, and return whether it
+   * could. */
+  template <typename TFunctor>
+  bool
+  VectorizedGenerateData(const TFunctor & functor, const OutputImageRegionType & outputRegionForThread, std::true_type);
+  template <typename TFunctor>
+  bool
+  VectorizedGenerateData(const TFunctor &, const OutputImageRegionType &, std::false_type)
+  {
+    return false;
+  }
+
   std::function<void(const OutputImageRegionType &)> m_DynamicThreadedGenerateDataFunction;
+
+  bool m_UseVectorization{ true };
 };
 } // end namespace itk
 
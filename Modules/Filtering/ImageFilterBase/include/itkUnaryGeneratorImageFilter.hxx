@@ -89,6 +89,11 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
   const TFunctor &              functor,
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (m_UseVectorization && this->VectorizedGenerateData(functor, outputRegionForThread, CanVectorize<TFunctor>()))
+  {
+    return;
+  }
+
   const typename OutputImageRegionType::SizeType & regionSize = outputRegionForThread.GetSize();
 
   const TInputImage * inputPtr = this->GetInput();
@@ -122,6 +127,54 @@ UnaryGeneratorImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateDat
     outputIt.NextLine();
   }
 }
+
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TFunctor>
+bool
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::VectorizedGenerateData(
+  const TFunctor &              functor,
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  const TInputImage * inputPtr = this->GetInput();
+  TOutputImage *      outputPtr = this->GetOutput(0);
+
+  InputImageRegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+  if (inputRegionForThread != outputRegionForThread)
+  {
+    return false;
+  }
+
+  TotalProgressReporter progress(this, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  const bool contiguous =
+    VectorizedPixelLoop::IsContiguous(outputRegionForThread, inputPtr->GetBufferedRegion()) &&
+    VectorizedPixelLoop::IsContiguous(outputRegionForThread, outputPtr->GetBufferedRegion());
+
+  VectorizedPixelLoop::ForEachSpan(
+    outputRegionForThread,
+    contiguous,
+    [&](const typename OutputImageRegionType::IndexType & index, SizeValueType numberOfPixels) {
+      const InputImagePixelType * const input = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(index);
+      OutputImagePixelType * const      output = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+      VectorizedPixelLoop::Run([input, output, functor](SizeValueType i) { output[i] = functor(input[i]); },
+                               numberOfPixels);
+      progress.Completed(numberOfPixels);
+    });
+  return true;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+UnaryGeneratorImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "UseVectorization: " << (m_UseVectorization ? "On" : "Off") << std::endl;
+}
 } // end namespace itk
 
 #endif
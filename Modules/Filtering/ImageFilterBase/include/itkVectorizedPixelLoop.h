@@ -0,0 +1,210 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkVectorizedPixelLoop_h
+#define itkVectorizedPixelLoop_h
+
+#include "itkImage.h"
+#include "itkIndexRange.h"
+
+#include <type_traits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+/** The pixel loops are compiled for several instruction sets, one of
+ * which is selected at run time. */
+#  define ITK_VECTORIZED_PIXEL_LOOP_DISPATCH
+#endif
+
+namespace itk
+{
+namespace Functor
+{
+/** \class IsVectorizable
+ * \brief Whether the pixel loops of the generator image filters may be
+ * vectorized for a functor.
+ *
+ * A functor opts in by declaring
+ * \code
+ *   static constexpr bool IsVectorizable = true;
+ * \endcode
+ * which states that its operator() has no side effect, so that it may be
+ * evaluated on the pixels in any order, in the lanes of SIMD registers.
+ * Lambdas, function pointers and std::function do not opt in.
+ *
+ * \sa VectorizedPixelLoop
+ * \ingroup ITKImageFilterBase
+ */
+template <typename TFunctor, typename = void>
+struct IsVectorizable : std::false_type
+{};
+
+template <typename TFunctor>
+struct IsVectorizable<TFunctor, typename std::enable_if<TFunctor::IsVectorizable>::type> : std::true_type
+{};
+} // namespace Functor
+
+/** \class VectorizedPixelLoop
+ * \brief Loops over the contiguous pixels of scalar images, compiled for
+ * the SIMD instruction sets of the processor.
+ *
+ * Run() calls a loop body for consecutive pixels, in a loop simple enough
+ * to be vectorized by the compiler. With GCC and Clang on x86, the loop is
+ * compiled for the baseline instruction set of the build (SSE2 on x86-64),
+ * for AVX2 and for AVX-512, and the most capable variant supported by the
+ * processor is selected at run time. Elsewhere, the loop is compiled for
+ * the baseline instruction set only. Multiplications and additions are
+ * not fused, so all the variants compute the same results.
+ *
+ * \sa UnaryGeneratorImageFilter, BinaryGeneratorImageFilter
+ * \ingroup ITKImageFilterBase
+ */
+class VectorizedPixelLoop
+{
+public:
+  /** Instruction sets for which the loops are compiled. */
+  enum class InstructionSetEnum : uint8_t
+  {
+    Baseline,
+    AVX2,
+    AVX512
+  };
+
+  /** Whether TImage is an Image of scalars, the buffer of which can be
+   * accessed directly. */
+  template <typename TImage>
+  using IsScalarImage =
+    std::integral_constant<bool,
+                           std::is_arithmetic<typename TImage::PixelType>::value &&
+                             std::is_same<TImage, Image<typename TImage::PixelType, TImage::ImageDimension>>::value>;
+
+  /** Instruction set of the loops run on this processor. */
+  static InstructionSetEnum
+  GetInstructionSet()
+  {
+#ifdef ITK_VECTORIZED_PIXEL_LOOP_DISPATCH
+    static const InstructionSetEnum instructionSet = []() {
+      if (__builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+          __builtin_cpu_supports("avx512dq") && __builtin_cpu_supports("avx512vl"))
+      {
+        return InstructionSetEnum::AVX512;
+      }
+      if (__builtin_cpu_supports("avx2"))
+      {
+        return InstructionSetEnum::AVX2;
+      }
+      return InstructionSetEnum::Baseline;
+    }();
+    return instructionSet;
+#else
+    return InstructionSetEnum::Baseline;
+#endif
+  }
+
+  /** Call body(i) for i in [0, numberOfPixels). */
+  template <typename TBody>
+  static void
+  Run(const TBody & body, SizeValueType numberOfPixels)
+  {
+#ifdef ITK_VECTORIZED_PIXEL_LOOP_DISPATCH
+    switch (GetInstructionSet())
+    {
+      case InstructionSetEnum::AVX512:
+        LoopAVX512(body, numberOfPixels);
+        return;
+      case InstructionSetEnum::AVX2:
+        LoopAVX2(body, numberOfPixels);
+        return;
+      default:
+        break;
+    }
+#endif
+    Loop(body, numberOfPixels);
+  }
+
+  /** Whether the pixels of region are contiguous in a buffer holding
+   * bufferedRegion, i.e. whether the region spans the buffered region in
+   * all the dimensions but the last one. */
+  template <unsigned int VDimension>
+  static bool
+  IsContiguous(const ImageRegion<VDimension> & region, const ImageRegion<VDimension> & bufferedRegion)
+  {
+    for (unsigned int d = 0; d + 1 < VDimension; ++d)
+    {
+      if (region.GetSize(d) != bufferedRegion.GetSize(d))
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  /** Call spanFunction(index, numberOfPixels) for the spans of contiguous
+   * pixels of region: the whole region when it is contiguous, and each
+   * line otherwise. */
+  template <unsigned int VDimension, typename TSpanFunction>
+  static void
+  ForEachSpan(const ImageRegion<VDimension> & region, bool contiguous, const TSpanFunction & spanFunction)
+  {
+    if (contiguous)
+    {
+      spanFunction(region.GetIndex(), region.GetNumberOfPixels());
+      return;
+    }
+    ImageRegion<VDimension> lineStarts = region;
+    lineStarts.SetSize(0, 1);
+    for (const auto & index : ImageRegionIndexRange<VDimension>(lineStarts))
+    {
+      spanFunction(index, region.GetSize(0));
+    }
+  }
+
+private:
+  template <typename TBody>
+  static void
+  Loop(const TBody & body, SizeValueType numberOfPixels)
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      body(i);
+    }
+  }
+
+#ifdef ITK_VECTORIZED_PIXEL_LOOP_DISPATCH
+  template <typename TBody>
+  __attribute__((target("avx2"))) static void
+  LoopAVX2(const TBody & body, SizeValueType numberOfPixels)
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      body(i);
+    }
+  }
+
+  template <typename TBody>
+  __attribute__((target("avx512f,avx512bw,avx512dq,avx512vl"))) static void
+  LoopAVX512(const TBody & body, SizeValueType numberOfPixels)
+  {
+    for (SizeValueType i = 0; i < numberOfPixels; ++i)
+    {
+      body(i);
+    }
+  }
+#endif
+};
+} // end namespace itk
+
+#endif
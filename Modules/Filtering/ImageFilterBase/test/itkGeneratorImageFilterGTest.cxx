@@ -21,6 +21,7 @@
 #include "itkTernaryGeneratorImageFilter.h"
 #include "itkImage.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 #include "itkGTest.h"
 
@@ -92,6 +93,60 @@ struct Utilities
 };
 
 
+// Functors processed by the vectorized loops
+struct AffineFunctor
+{
+  static constexpr bool IsVectorizable = true;
+
+  double
+  operator()(float p) const
+  {
+    return 2.0 * p + 1.0;
+  }
+};
+
+struct WeightedSumFunctor
+{
+  static constexpr bool IsVectorizable = true;
+
+  double
+  operator()(float p1, short p2) const
+  {
+    return p1 + 3.0 * p2;
+  }
+};
+
+template <typename TImage>
+typename TImage::Pointer
+CreateRampImage(typename TImage::PixelType scale)
+{
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { 37, 11, 5 } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const auto & index = it.GetIndex();
+    it.Set(static_cast<typename TImage::PixelType>(scale * (index[0] - 3 * index[1] + 7 * index[2])));
+  }
+  return image;
+}
+
+// Check the output in region, or in its requested region
+template <typename TImage, typename TExpected>
+void
+CheckOutput(const TImage * output, const TExpected & expected, typename TImage::RegionType region = {})
+{
+  if (region.GetNumberOfPixels() == 0)
+  {
+    region = output->GetRequestedRegion();
+  }
+  ASSERT_TRUE(output->GetBufferedRegion().IsInside(region));
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(output, region); !it.IsAtEnd(); ++it)
+  {
+    ASSERT_EQ(it.Get(), expected(it.GetIndex())) << " at " << it.GetIndex();
+  }
+}
+
 } // namespace
 
 
@@ -444,3 +499,106 @@ TEST(TernaryGeneratorImageFilter, Constants)
 
   EXPECT_NEAR(103.0, outputImage->GetPixel(idx), 1e-8);
 }
+
+
+TEST(UnaryGeneratorImageFilter, Vectorization)
+{
+  using InputImageType = itk::Image<float, 3>;
+  using OutputImageType = itk::Image<double, 3>;
+
+  EXPECT_TRUE(itk::Functor::IsVectorizable<AffineFunctor>::value);
+  EXPECT_FALSE(itk::Functor::IsVectorizable<std::function<double(float)>>::value);
+  EXPECT_FALSE(itk::Functor::IsVectorizable<double (*)(float)>::value);
+
+  const auto input = CreateRampImage<InputImageType>(0.5f);
+  const auto expected = [&input](const OutputImageType::IndexType & index) {
+    return AffineFunctor()(input->GetPixel(index));
+  };
+
+  using FilterType = itk::UnaryGeneratorImageFilter<InputImageType, OutputImageType>;
+  auto filter = FilterType::New();
+  EXPECT_TRUE(filter->GetUseVectorization());
+  filter->SetInput(input);
+  filter->SetFunctor(AffineFunctor());
+  filter->SetNumberOfWorkUnits(3);
+  filter->Update();
+  CheckOutput(filter->GetOutput(), expected);
+
+  // Lines of a region which is not contiguous in the input
+  const OutputImageType::RegionType region({ { 5, 2, 1 } }, { { 20, 6, 3 } });
+  filter->GetOutput()->SetRequestedRegion(region);
+  filter->Modified();
+  filter->Update();
+  EXPECT_EQ(filter->GetOutput()->GetBufferedRegion(), region);
+  CheckOutput(filter->GetOutput(), expected);
+
+  // The scalar path gives the same results
+  filter->UseVectorizationOff();
+  filter->GetOutput()->SetRequestedRegion(input->GetLargestPossibleRegion());
+  filter->Update();
+  CheckOutput(filter->GetOutput(), expected);
+
+  // In place
+  using InPlaceFilterType = itk::UnaryGeneratorImageFilter<InputImageType, InputImageType>;
+  auto inPlaceFilter = InPlaceFilterType::New();
+  inPlaceFilter->SetInput(CreateRampImage<InputImageType>(0.5f));
+  inPlaceFilter->SetFunctor(AffineFunctor());
+  inPlaceFilter->InPlaceOn();
+  inPlaceFilter->Update();
+  CheckOutput(inPlaceFilter->GetOutput(),
+              [&input](const InputImageType::IndexType & index) { return 2.0f * input->GetPixel(index) + 1.0f; });
+}
+
+
+TEST(BinaryGeneratorImageFilter, Vectorization)
+{
+  using Input1ImageType = itk::Image<float, 3>;
+  using Input2ImageType = itk::Image<short, 3>;
+  using OutputImageType = itk::Image<double, 3>;
+
+  const auto input1 = CreateRampImage<Input1ImageType>(0.25f);
+  const auto input2 = CreateRampImage<Input2ImageType>(-2);
+
+  using FilterType = itk::BinaryGeneratorImageFilter<Input1ImageType, Input2ImageType, OutputImageType>;
+  auto filter = FilterType::New();
+  EXPECT_TRUE(filter->GetUseVectorization());
+  filter->SetInput1(input1);
+  filter->SetInput2(input2);
+  filter->SetFunctor(WeightedSumFunctor());
+  filter->SetNumberOfWorkUnits(3);
+
+  for (const bool useVectorization : { true, false })
+  {
+    filter->SetUseVectorization(useVectorization);
+    filter->GetOutput()->SetRequestedRegion(input1->GetLargestPossibleRegion());
+    filter->Update();
+    CheckOutput(filter->GetOutput(), [&](const OutputImageType::IndexType & index) {
+      return WeightedSumFunctor()(input1->GetPixel(index), input2->GetPixel(index));
+    });
+
+    const OutputImageType::RegionType region({ { 1, 0, 2 } }, { { 30, 11, 2 } });
+    filter->GetOutput()->SetRequestedRegion(region);
+    filter->Modified();
+    filter->Update();
+    EXPECT_EQ(filter->GetOutput()->GetBufferedRegion(), region);
+    CheckOutput(filter->GetOutput(), [&](const OutputImageType::IndexType & index) {
+      return WeightedSumFunctor()(input1->GetPixel(index), input2->GetPixel(index));
+    });
+  }
+
+  // With a constant
+  filter->UseVectorizationOn();
+  filter->SetConstant2(5);
+  filter->GetOutput()->SetRequestedRegion(input1->GetLargestPossibleRegion());
+  filter->Update();
+  CheckOutput(filter->GetOutput(), [&](const OutputImageType::IndexType & index) {
+    return WeightedSumFunctor()(input1->GetPixel(index), 5);
+  });
+
+  filter->SetConstant1(-1.5f);
+  filter->SetInput2(input2);
+  filter->Update();
+  CheckOutput(filter->GetOutput(), [&](const OutputImageType::IndexType & index) {
+    return WeightedSumFunctor()(-1.5f, input2->GetPixel(index));
+  });
+}
@@ -27,7 +27,9 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkImageAlgorithm.h"
 
+#include <memory>      // For unique_ptr.
 #include <type_traits> // For is_same.
+#include <vector>
 
 namespace itk
 {
@@ -382,51 +384,62 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 
 
   // Create an iterator that will walk the output region for this thread.
-  using OutputIterator = ImageRegionIteratorWithIndex<TOutputImage>;
+  using OutputIterator = ImageScanlineIterator<TOutputImage>;
   OutputIterator outIt(outputPtr, outputRegionForThread);
 
-  // Define a few indices that will be used to translate from an input pixel
-  // to an output pixel
-  OutputPointType outputPoint; // Coordinates of current output pixel
-  InputPointType  inputPoint;  // Coordinates of current input pixel
-
-  ContinuousInputIndexType inputIndex;
-
   using OutputType = typename InterpolatorType::OutputType;
 
-  // Walk the output region
-  outIt.GoToBegin();
+  // The points of a scan line are transformed, and the input is
+  // interpolated at them, in batches, which saves the virtual calls per
+  // pixel.
+  const SizeValueType                                  scanlineSize = outputRegionForThread.GetSize(0);
+  std::vector<typename TransformType::InputPointType>  outputPoints(scanlineSize);
+  std::vector<typename TransformType::OutputPointType> inputPoints(scanlineSize);
+  std::vector<ContinuousInputIndexType>                inputIndices(scanlineSize);
+  std::vector<OutputType>                              values(scanlineSize);
+  const std::unique_ptr<bool[]>                        isInsideBuffer(new bool[scanlineSize]);
+  const std::unique_ptr<bool[]>                        isInsideInput(new bool[scanlineSize]);
 
+  // Walk the output region
   while (!outIt.IsAtEnd())
   {
-    // Determine the index of the current output pixel
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), outputPoint);
-
-    // Compute corresponding input pixel position
-    inputPoint = transformPtr->TransformPoint(outputPoint);
-    const bool isInsideInput = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoint, inputIndex);
+    // Determine the coordinates of the output pixels of the scan line
+    IndexType index = outIt.GetIndex();
+    for (SizeValueType i = 0; i < scanlineSize; ++i, ++index[0])
+    {
+      outputPtr->TransformIndexToPhysicalPoint(index, outputPoints[i]);
+    }
 
-    OutputType value;
-    // Evaluate input at right position and copy to the output
-    if (m_Interpolator->IsInsideBuffer(inputIndex) && (!isSpecialCoordinatesImage || isInsideInput))
+    // Compute the corresponding input pixel positions
+    transformPtr->TransformPoints(outputPoints.data(), inputPoints.data(), scanlineSize);
+    for (SizeValueType i = 0; i < scanlineSize; ++i)
     {
-      value = m_Interpolator->EvaluateAtContinuousIndex(inputIndex);
-      outIt.Set(Self::CastPixelWithBoundsChecking(value));
+      isInsideInput[i] = inputPtr->TransformPhysicalPointToContinuousIndex(inputPoints[i], inputIndices[i]);
     }
-    else
+
+    // Evaluate input at right positions and copy to the output
+    m_Interpolator->EvaluateAtContinuousIndices(inputIndices.data(), values.data(), isInsideBuffer.get(), scanlineSize);
+    for (SizeValueType i = 0; i < scanlineSize; ++i)
     {
-      if (m_Extrapolator.IsNull())
+      if (isInsideBuffer[i] && (!isSpecialCoordinatesImage || isInsideInput[i]))
       {
-        outIt.Set(m_DefaultPixelValue); // default background value
+        outIt.Set(Self::CastPixelWithBoundsChecking(values[i]));
       }
       else
       {
-        value = m_Extrapolator->EvaluateAtContinuousIndex(inputIndex);
-        outIt.Set(Self::CastPixelWithBoundsChecking(value));
+        if (m_Extrapolator.IsNull())
+        {
+          outIt.Set(m_DefaultPixelValue); // default background value
+        }
+        else
+        {
+          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndices[i])));
+        }
       }
+      ++outIt;
     }
-    progress.CompletedPixel();
-    ++outIt;
+    outIt.NextLine();
+    progress.Completed(scanlineSize);
   }
 }
 
@@ -474,6 +487,15 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
       transformPtr->TransformPoint(outputPtr->template TransformIndexToPhysicalPoint<double>(index)));
   };
 
+  using OutputType = typename InterpolatorType::OutputType;
+
+  // The input is interpolated at the points of a scan line in batches,
+  // which saves the virtual calls per pixel.
+  const SizeValueType                   scanlineSize = outputRegionForThread.GetSize(0);
+  std::vector<ContinuousInputIndexType> inputIndices(scanlineSize);
+  std::vector<OutputType>               values(scanlineSize);
+  const std::unique_ptr<bool[]>         isInsideBuffer(new bool[scanlineSize]);
+
   while (!outIt.IsAtEnd())
   {
     // Determine the continuous index of the first and end pixel of output
@@ -488,24 +510,27 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
 
     IndexValueType scanlineIndex = outIt.GetIndex()[0];
 
-
-    while (!outIt.IsAtEndOfLine())
+    for (SizeValueType i = 0; i < scanlineSize; ++i, ++scanlineIndex)
     {
-
       // Perform linear interpolation from startIndex, along vectorFromStartIndex
       const double alpha =
         (scanlineIndex - firstIndexValueOfLargestPossibleRegion) / firstSizeValueOfLargestPossibleRegion;
 
-      ContinuousInputIndexType inputIndex(startIndex);
-      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      ContinuousInputIndexType & inputIndex = inputIndices[i];
+      inputIndex = startIndex;
+      for (unsigned int j = 0; j < InputImageDimension; ++j)
       {
-        inputIndex[i] += alpha * vectorFromStartIndex[i];
+        inputIndex[j] += alpha * vectorFromStartIndex[j];
       }
+    }
 
-      // Evaluate input at right position and copy to the output
-      if (m_Interpolator->IsInsideBuffer(inputIndex))
+    // Evaluate input at right positions and copy to the output
+    m_Interpolator->EvaluateAtContinuousIndices(inputIndices.data(), values.data(), isInsideBuffer.get(), scanlineSize);
+    for (SizeValueType i = 0; i < scanlineSize; ++i)
+    {
+      if (isInsideBuffer[i])
       {
-        outIt.Set(Self::CastPixelWithBoundsChecking(m_Interpolator->EvaluateAtContinuousIndex(inputIndex)));
+        outIt.Set(Self::CastPixelWithBoundsChecking(values[i]));
       }
       else
       {
@@ -515,15 +540,13 @@ ResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType, TTran
         }
         else
         {
-          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndex)));
+          outIt.Set(Self::CastPixelWithBoundsChecking(m_Extrapolator->EvaluateAtContinuousIndex(inputIndices[i])));
         }
       }
-
       ++outIt;
-      ++scanlineIndex;
     }
     outIt.NextLine();
-    progress.Completed(outputRegionForThread.GetSize()[0]);
+    progress.Completed(scanlineSize);
   }
 }
 
@@ -19,12 +19,20 @@
 // The header file to be tested:
 #include "itkResampleImageFilter.h"
 
+#include "itkAffineTransform.h"
+#include "itkBSplineInterpolateImageFunction.h"
+#include "itkBSplineTransform.h"
 #include "itkImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkWindowedSincInterpolateImageFunction.h"
 
 // Google Test header file:
 #include <gtest/gtest.h>
 
 // Standard C++ header files:
+#include <atomic>
 #include <limits>
 #include <random>
 
@@ -111,6 +119,128 @@ Expect_ResampleImageFilter_thows_on_incomplete_configuration(const TPixel inputP
   EXPECT_EQ(TestThrowErrorOnEmptyResampleSpace(inputPixel, true), inputPixel);
 }
 
+
+// Interpolator that counts its calls of EvaluateAtContinuousIndex. As its
+// type differs from the one of its base class, it does not get the batched
+// evaluation of the base class, but evaluates each index by a virtual call.
+template <typename TInterpolator>
+class PointwiseInterpolator : public TInterpolator
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(PointwiseInterpolator);
+
+  using Self = PointwiseInterpolator;
+  using Superclass = TInterpolator;
+  using Pointer = itk::SmartPointer<Self>;
+  using typename Superclass::ContinuousIndexType;
+  using typename Superclass::OutputType;
+
+  itkNewMacro(Self);
+
+  using Superclass::EvaluateAtContinuousIndex;
+
+  OutputType
+  EvaluateAtContinuousIndex(const ContinuousIndexType & index) const override
+  {
+    ++m_NumberOfEvaluations;
+    return Superclass::EvaluateAtContinuousIndex(index);
+  }
+
+  itk::SizeValueType
+  GetNumberOfEvaluations() const
+  {
+    return m_NumberOfEvaluations;
+  }
+
+protected:
+  PointwiseInterpolator() = default;
+  ~PointwiseInterpolator() override = default;
+
+private:
+  mutable std::atomic<itk::SizeValueType> m_NumberOfEvaluations{ 0 };
+};
+
+
+// Expects that resampling by the specified interpolator, which evaluates the
+// indices of a scan line in a batch, yields exactly the same output as
+// resampling by a PointwiseInterpolator.
+template <typename TInterpolator, typename TImage, typename TTransform>
+void
+Expect_batched_interpolation_equal_to_pointwise_interpolation(const TImage & inputImage, const TTransform & transform)
+{
+  using FilterType = itk::ResampleImageFilter<TImage, TImage>;
+
+  const auto resample = [&inputImage, &transform](typename FilterType::InterpolatorType & interpolator) {
+    const auto filter = FilterType::New();
+    filter->SetInput(&inputImage);
+    filter->SetTransform(&transform);
+    filter->SetInterpolator(&interpolator);
+    filter->SetSize({ { 40, 30 } });
+    filter->SetOutputSpacing(itk::MakeVector(0.8, 0.8));
+    filter->SetOutputOrigin(itk::MakePoint(-4.0, -3.0));
+    filter->SetDefaultPixelValue(-1.0f);
+    filter->Update();
+    return typename TImage::Pointer(filter->GetOutput());
+  };
+
+  const auto pointwiseInterpolator = PointwiseInterpolator<TInterpolator>::New();
+  const auto expectedImage = resample(*pointwiseInterpolator);
+  const auto actualImage = resample(*TInterpolator::New());
+
+  EXPECT_GT(pointwiseInterpolator->GetNumberOfEvaluations(), 0u);
+
+  itk::ImageRegionConstIterator<TImage> expectedIt(expectedImage, expectedImage->GetBufferedRegion());
+  itk::ImageRegionConstIterator<TImage> actualIt(actualImage, actualImage->GetBufferedRegion());
+  itk::SizeValueType                    numberOfInsidePixels{};
+
+  for (; !expectedIt.IsAtEnd(); ++expectedIt, ++actualIt)
+  {
+    EXPECT_EQ(actualIt.Get(), expectedIt.Get());
+    numberOfInsidePixels += (expectedIt.Get() != -1.0f);
+  }
+  EXPECT_GT(numberOfInsidePixels, 0u);
+  EXPECT_LT(numberOfInsidePixels, expectedImage->GetBufferedRegion().GetNumberOfPixels());
+}
+
+
+template <typename TImage, typename TTransform>
+void
+Expect_batched_interpolation_equal_to_pointwise_interpolation_for_each_interpolator(const TImage &     inputImage,
+                                                                                    const TTransform & transform)
+{
+  using CoordRepType = double;
+  using WindowedSincInterpolatorType = itk::WindowedSincInterpolateImageFunction<TImage, 3>;
+
+  Expect_batched_interpolation_equal_to_pointwise_interpolation<
+    itk::NearestNeighborInterpolateImageFunction<TImage, CoordRepType>>(inputImage, transform);
+  Expect_batched_interpolation_equal_to_pointwise_interpolation<
+    itk::LinearInterpolateImageFunction<TImage, CoordRepType>>(inputImage, transform);
+  Expect_batched_interpolation_equal_to_pointwise_interpolation<
+    itk::BSplineInterpolateImageFunction<TImage, CoordRepType>>(inputImage, transform);
+  Expect_batched_interpolation_equal_to_pointwise_interpolation<WindowedSincInterpolatorType>(inputImage, transform);
+}
+
+
+// Creates a 2D image of 32x24 random pixel values.
+itk::Image<float>::Pointer
+CreateRandomImage()
+{
+  using ImageType = itk::Image<float>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { 32, 24 } });
+  image->Allocate();
+
+  std::mt19937                          randomNumberEngine;
+  std::uniform_real_distribution<float> distribution(0.0f, 100.0f);
+
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(distribution(randomNumberEngine));
+  }
+  return image;
+}
+
 } // namespace
 
 // Compile time check of mixing transform and precision types
@@ -172,3 +302,42 @@ TEST(ResampleImageFilter, Expect_ResampleImageFilter_thows_on_incomplete_configu
 {
   Expect_ResampleImageFilter_thows_on_incomplete_configuration(128.0);
 }
+
+
+// Tests that the interpolation along the scan lines of the output, by a
+// linear transform, yields the same output as pointwise interpolation.
+TEST(ResampleImageFilter, BatchedInterpolationWithLinearTransform)
+{
+  const auto transform = itk::AffineTransform<double, 2>::New();
+  transform->Rotate2D(0.3);
+  transform->Scale(1.2);
+  transform->SetTranslation(itk::MakeVector(2.5, -1.5));
+
+  Expect_batched_interpolation_equal_to_pointwise_interpolation_for_each_interpolator(*CreateRandomImage(), *transform);
+}
+
+
+// Tests that the interpolation at the transformed points of the scan lines of
+// the output, by a nonlinear transform, yields the same output as pointwise
+// interpolation.
+TEST(ResampleImageFilter, BatchedInterpolationWithNonlinearTransform)
+{
+  using TransformType = itk::BSplineTransform<double, 2, 3>;
+
+  const auto transform = TransformType::New();
+  transform->SetTransformDomainPhysicalDimensions(itk::MakeVector(32.0, 24.0));
+  transform->SetTransformDomainMeshSize(TransformType::MeshSizeType{ { 4, 3 } });
+
+  std::mt19937                           randomNumberEngine;
+  std::uniform_real_distribution<double> distribution(-2.0, 2.0);
+
+  TransformType::ParametersType parameters(transform->GetNumberOfParameters());
+  for (auto & parameter : parameters)
+  {
+    parameter = distribution(randomNumberEngine);
+  }
+  transform->SetParametersByValue(parameters);
+  ASSERT_FALSE(transform->IsLinear());
+
+  Expect_batched_interpolation_equal_to_pointwise_interpolation_for_each_interpolator(*CreateRandomImage(), *transform);
+}
@@ -43,6 +43,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Abs);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput & A) const
   {
@@ -44,6 +44,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Add2);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput1 & A, const TInput2 & B) const
   {
@@ -98,6 +101,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Sub2);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput1 & A, const TInput2 & B) const
   {
@@ -125,6 +131,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Mult);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput1 & A, const TInput2 & B) const
   {
@@ -152,6 +161,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Div);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput1 & A, const TInput2 & B) const
   {
@@ -378,6 +390,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(UnaryMinus);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput1 & A) const
   {
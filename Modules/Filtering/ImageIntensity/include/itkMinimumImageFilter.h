@@ -43,6 +43,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Minimum);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput1 & A, const TInput2 & B) const
   {
@@ -44,6 +44,9 @@ public:
 
   ITK_UNEQUAL_OPERATOR_MEMBER_FUNCTION(Sqrt);
 
+  /** See Functor::IsVectorizable */
+  static constexpr bool IsVectorizable = true;
+
   inline TOutput
   operator()(const TInput & A) const
   {
@@ -0,0 +1,160 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkAbsImageFilter.h"
+#include "itkAddImageFilter.h"
+#include "itkDivideImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMaximumImageFilter.h"
+#include "itkMultiplyImageFilter.h"
+#include "itkSqrtImageFilter.h"
+#include "itkSquareImageFilter.h"
+#include "itkSubtractImageFilter.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+
+#include <cstring>
+#include <iomanip>
+
+// Throughput of the arithmetic filters, with and without the vectorized
+// loops of the generator image filters. The vectorized loops must compute
+// the same results as the scalar ones.
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+
+ImageType::Pointer
+CreateImage(unsigned int size, float offset)
+{
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::SizeType{ { size, size, size } });
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType & index = it.GetIndex();
+    it.Set(offset + 0.5f * index[0] - 0.25f * index[1] + 0.125f * index[2]);
+  }
+  return image;
+}
+
+// Update the filter with and without vectorization, print the best
+// throughput of each, and compare their outputs.
+template <typename TFilter>
+bool
+MeasureThroughput(const std::string & name, TFilter * filter, unsigned int numberOfInputs, unsigned int repetitions)
+{
+  const ImageType::RegionType region = filter->GetInput()->GetLargestPossibleRegion();
+  const double                numberOfBytes =
+    static_cast<double>(region.GetNumberOfPixels() * sizeof(ImageType::PixelType) * (numberOfInputs + 1));
+
+  ImageType::Pointer outputs[2];
+  double             throughputs[2];
+  for (const bool useVectorization : { false, true })
+  {
+    filter->SetUseVectorization(useVectorization);
+    itk::TimeProbe probe;
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+      filter->Modified();
+      probe.Start();
+      filter->Update();
+      probe.Stop();
+    }
+    throughputs[useVectorization] = numberOfBytes / probe.GetMinimum() / 1e9;
+
+    outputs[useVectorization] = filter->GetOutput();
+    outputs[useVectorization]->DisconnectPipeline();
+  }
+
+  std::cout << std::setw(10) << name << std::setw(12) << throughputs[0] << std::setw(12) << throughputs[1]
+            << std::setw(10) << throughputs[1] / throughputs[0] << std::endl;
+
+  const ImageType::PixelType * scalar = outputs[0]->GetBufferPointer();
+  const ImageType::PixelType * vectorized = outputs[1]->GetBufferPointer();
+  for (itk::SizeValueType i = 0; i < region.GetNumberOfPixels(); ++i)
+  {
+    // NaNs are compared by their representation
+    if (std::memcmp(scalar + i, vectorized + i, sizeof(ImageType::PixelType)) != 0)
+    {
+      std::cerr << name << ": the vectorized loop computed " << vectorized[i] << " instead of " << scalar[i]
+                << " at offset " << i << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+template <typename TFilter>
+bool
+MeasureUnaryThroughput(const std::string & name, const ImageType * input, unsigned int repetitions)
+{
+  auto filter = TFilter::New();
+  filter->SetInput(input);
+  return MeasureThroughput(name, filter.GetPointer(), 1, repetitions);
+}
+
+template <typename TFilter>
+bool
+MeasureBinaryThroughput(const std::string & name,
+                        const ImageType *   input1,
+                        const ImageType *   input2,
+                        unsigned int        repetitions)
+{
+  auto filter = TFilter::New();
+  filter->SetInput1(input1);
+  filter->SetInput2(input2);
+  return MeasureThroughput(name, filter.GetPointer(), 2, repetitions);
+}
+} // namespace
+
+int
+itkArithmeticImageFilterThroughputTest(int argc, char * argv[])
+{
+  if (argc > 3)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " [ImageSize] [NumberOfRepetitions]" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned int size = argc > 1 ? std::stoi(argv[1]) : 64;
+  const unsigned int repetitions = argc > 2 ? std::stoi(argv[2]) : 5;
+
+  const auto input1 = CreateImage(size, -3.0f);
+  const auto input2 = CreateImage(size, 0.0f);
+
+  static const char * const instructionSets[] = { "baseline", "AVX2", "AVX-512" };
+  std::cout << "Vectorized loops compiled for "
+            << instructionSets[static_cast<int>(itk::VectorizedPixelLoop::GetInstructionSet())] << std::endl;
+  std::cout << "Throughput (GB/s) on " << size << "^3 float images" << std::endl;
+  std::cout << std::setw(10) << "Filter" << std::setw(12) << "Scalar" << std::setw(12) << "Vectorized"
+            << std::setw(10) << "Speedup" << std::endl;
+
+  bool success = true;
+  success &= MeasureBinaryThroughput<itk::AddImageFilter<ImageType>>("Add", input1, input2, repetitions);
+  success &= MeasureBinaryThroughput<itk::SubtractImageFilter<ImageType>>("Subtract", input1, input2, repetitions);
+  success &= MeasureBinaryThroughput<itk::MultiplyImageFilter<ImageType>>("Multiply", input1, input2, repetitions);
+  success &= MeasureBinaryThroughput<itk::DivideImageFilter<ImageType, ImageType, ImageType>>(
+    "Divide", input1, input2, repetitions);
+  success &= MeasureBinaryThroughput<itk::MaximumImageFilter<ImageType>>("Maximum", input1, input2, repetitions);
+  success &= MeasureUnaryThroughput<itk::AbsImageFilter<ImageType, ImageType>>("Abs", input1, repetitions);
+  success &= MeasureUnaryThroughput<itk::SqrtImageFilter<ImageType, ImageType>>("Sqrt", input2, repetitions);
+  success &= MeasureUnaryThroughput<itk::SquareImageFilter<ImageType, ImageType>>("Square", input1, repetitions);
+
+  std::cout << "Test finished." << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
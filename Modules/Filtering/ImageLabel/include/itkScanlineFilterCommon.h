@@ -20,10 +20,12 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkConstShapedNeighborhoodIterator.h"
+#include <algorithm>
 #include <atomic>
 #include <deque>
 #include <functional>
 #include <mutex>
+#include <numeric>
 #include <vector>
 
 namespace itk
@@ -133,7 +135,7 @@ protected:
 
   using LineMapType = std::vector<LineEncodingType>;
 
-  using UnionFindType = std::vector<InternalLabelType>;
+  using UnionFindType = std::vector<std::atomic<InternalLabelType>>;
   using ConsecutiveVectorType = std::vector<OutputPixelType>;
 
   SizeValueType
@@ -152,82 +154,181 @@ protected:
     return linearIndex;
   }
 
+  /** Gives consecutive labels to all the runs, in the order of the lines,
+   * and makes each label a set of its own. The work units are labeled in
+   * parallel, from the prefix sum of their numbers of runs. */
   void
   InitUnion(InternalLabelType numberOfLabels)
   {
     m_UnionFind = UnionFindType(numberOfLabels + 1);
-
-    typename LineMapType::iterator MapBegin, MapEnd, LineIt;
-    MapBegin = m_LineMap.begin();
-    MapEnd = m_LineMap.end();
-    LineIt = MapBegin;
-    InternalLabelType label = 1;
-    for (LineIt = MapBegin; LineIt != MapEnd; ++LineIt)
-    {
-      LineEncodingIterator cIt;
-      for (cIt = LineIt->begin(); cIt != LineIt->end(); ++cIt)
-      {
-        cIt->label = label;
-        m_UnionFind[label] = label;
-        label++;
-      }
-    }
+    m_UnionFind[0].store(0, std::memory_order_relaxed);
+
+    // the work units are stored in completion order
+    std::sort(m_WorkUnitResults.begin(),
+              m_WorkUnitResults.end(),
+              [](const WorkUnitData & a, const WorkUnitData & b) { return a.firstLine < b.firstLine; });
+
+    const SizeValueType        numberOfWorkUnits = m_WorkUnitResults.size();
+    std::vector<SizeValueType> firstLabels(numberOfWorkUnits + 1, 0);
+
+    MultiThreaderBase * multiThreader = m_EnclosingFilter->GetMultiThreader();
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfWorkUnits,
+      [this, &firstLabels](SizeValueType index) {
+        const WorkUnitData & wud = m_WorkUnitResults[index];
+        SizeValueType        numberOfRuns = 0;
+        for (SizeValueType line = wud.firstLine; line <= wud.lastLine; ++line)
+        {
+          numberOfRuns += m_LineMap[line].size();
+        }
+        firstLabels[index + 1] = numberOfRuns;
+      },
+      nullptr);
+    // labels start at 1
+    firstLabels[0] = 1;
+    std::partial_sum(firstLabels.begin(), firstLabels.end(), firstLabels.begin());
+
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfWorkUnits,
+      [this, &firstLabels](SizeValueType index) {
+        const WorkUnitData & wud = m_WorkUnitResults[index];
+        InternalLabelType    label = firstLabels[index];
+        for (SizeValueType line = wud.firstLine; line <= wud.lastLine; ++line)
+        {
+          for (auto & run : m_LineMap[line])
+          {
+            run.label = label;
+            m_UnionFind[label].store(label, std::memory_order_relaxed);
+            ++label;
+          }
+        }
+      },
+      nullptr);
   }
 
+  /** Finds the root of the set of the label. The path is halved on the way,
+   * which is safe while other threads link the sets: a label is only ever
+   * made to point to one of its ancestors. */
   InternalLabelType
   LookupSet(const InternalLabelType label)
   {
     InternalLabelType l = label;
-    while (l != m_UnionFind[l])
+    while (true)
     {
-      l = m_UnionFind[l]; // transitively sets equivalence
+      InternalLabelType parent = m_UnionFind[l].load(std::memory_order_relaxed);
+      if (parent == l)
+      {
+        return l;
+      }
+      const InternalLabelType grandParent = m_UnionFind[parent].load(std::memory_order_relaxed);
+      if (grandParent != parent)
+      {
+        m_UnionFind[l].compare_exchange_weak(parent, grandParent, std::memory_order_relaxed);
+      }
+      l = grandParent;
     }
-    return l;
   }
 
+  /** Merges the sets of the two labels, without locking. The larger root is
+   * linked to the smaller one, so that the root of a set is always its
+   * smallest label, whatever the order in which the sets are merged. */
   void
   LinkLabels(const InternalLabelType label1, const InternalLabelType label2)
   {
-    std::lock_guard<std::mutex> mutexHolder(m_Mutex);
-    InternalLabelType           E1 = this->LookupSet(label1);
-    InternalLabelType           E2 = this->LookupSet(label2);
-
-    if (E1 < E2)
+    InternalLabelType E1 = label1;
+    InternalLabelType E2 = label2;
+    while (true)
     {
-      m_UnionFind[E2] = E1;
-    }
-    else
-    {
-      m_UnionFind[E1] = E2;
+      E1 = this->LookupSet(E1);
+      E2 = this->LookupSet(E2);
+      if (E1 == E2)
+      {
+        return;
+      }
+      if (E1 < E2)
+      {
+        std::swap(E1, E2);
+      }
+      // fails if E1 was linked by another thread in the meantime
+      InternalLabelType expected = E1;
+      if (m_UnionFind[E1].compare_exchange_strong(expected, E2))
+      {
+        return;
+      }
     }
   }
 
+  /** Gives consecutive output labels to the sets, in the order of their
+   * roots, skipping the background value. The labels are made to point
+   * directly to their roots, so that looking them up afterwards is a single
+   * access. The work is split in chunks of labels, which are relabeled in
+   * parallel from the prefix sum of their numbers of roots. */
   SizeValueType
   CreateConsecutive(OutputPixelType backgroundValue)
   {
-    const size_t N = m_UnionFind.size();
+    const SizeValueType N = m_UnionFind.size();
 
     m_Consecutive = ConsecutiveVectorType(N);
     m_Consecutive[0] = backgroundValue;
 
-    OutputPixelType consecutiveLabel = 0;
-    SizeValueType   count = 0;
-
-    for (size_t i = 1; i < N; ++i)
-    {
-      const auto label = static_cast<size_t>(m_UnionFind[i]);
-      if (label == i)
-      {
-        if (consecutiveLabel == backgroundValue)
+    MultiThreaderBase * multiThreader = m_EnclosingFilter->GetMultiThreader();
+    const SizeValueType numberOfChunks =
+      std::max<SizeValueType>(1, std::min<SizeValueType>(N / 1024, multiThreader->GetNumberOfWorkUnits()));
+    const SizeValueType        chunkSize = (N - 1 + numberOfChunks - 1) / numberOfChunks;
+    std::vector<SizeValueType> firstRoots(numberOfChunks + 1, 0);
+
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [this, N, chunkSize, &firstRoots](SizeValueType chunk) {
+        const SizeValueType first = 1 + chunk * chunkSize;
+        const SizeValueType last = std::min(first + chunkSize, N);
+        SizeValueType       numberOfRoots = 0;
+        for (SizeValueType i = first; i < last; ++i)
+        {
+          const InternalLabelType root = this->LookupSet(i);
+          m_UnionFind[i].store(root, std::memory_order_relaxed);
+          if (root == i)
+          {
+            ++numberOfRoots;
+          }
+        }
+        firstRoots[chunk + 1] = numberOfRoots;
+      },
+      nullptr);
+    std::partial_sum(firstRoots.begin(), firstRoots.end(), firstRoots.begin());
+
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [this, N, chunkSize, backgroundValue, &firstRoots](SizeValueType chunk) {
+        const SizeValueType first = 1 + chunk * chunkSize;
+        const SizeValueType last = std::min(first + chunkSize, N);
+        // the label of the first root of the chunk, as if all the previous
+        // roots had been labeled before
+        auto consecutiveLabel = static_cast<OutputPixelType>(firstRoots[chunk]);
+        if (NumericTraits<OutputPixelType>::IsNonnegative(backgroundValue) &&
+            firstRoots[chunk] > static_cast<SizeValueType>(backgroundValue))
         {
           ++consecutiveLabel;
         }
-        m_Consecutive[label] = consecutiveLabel;
-        ++consecutiveLabel;
-        ++count;
-      }
-    }
-    return count;
+        for (SizeValueType i = first; i < last; ++i)
+        {
+          if (m_UnionFind[i].load(std::memory_order_relaxed) == i)
+          {
+            if (consecutiveLabel == backgroundValue)
+            {
+              ++consecutiveLabel;
+            }
+            m_Consecutive[i] = consecutiveLabel;
+            ++consecutiveLabel;
+          }
+        }
+      },
+      nullptr);
+    return firstRoots[numberOfChunks];
   }
 
   bool
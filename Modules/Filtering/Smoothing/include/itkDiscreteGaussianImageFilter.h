@@ -20,8 +20,11 @@
 
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
+#include "itkGaussianOperator.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 
+#include <type_traits> // For integral_constant.
+
 namespace itk
 {
 /**
@@ -44,7 +47,20 @@ namespace itk
  * When the Gaussian kernel is small, this filter tends to run faster than
  * itk::RecursiveGaussianImageFilter.
  *
+ * For images of scalar pixels, the filter convolves the lines of the image
+ * along one dimension after the other, using a single intermediate image,
+ * which is convolved in place. Lines along the dimensions other than the first
+ * one are convolved in blocks of adjacent lines, so that the memory is
+ * accessed contiguously and the compiler can vectorize the convolution.
+ * Other images are convolved by a mini-pipeline of
+ * NeighborhoodOperatorImageFilters. Both compute the same output. When
+ * the output is streamed, only the input region that is needed by the
+ * requested output region is convolved.
+ *
+ * For very large kernels, FFTDiscreteGaussianImageFilter can be faster.
+ *
  * \sa GaussianOperator
+ * \sa FFTDiscreteGaussianImageFilter
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -108,6 +124,10 @@ public:
   using RealBoundaryConditionPointerType = ImageBoundaryCondition<RealOutputImageType> *;
   using RealDefaultBoundaryConditionType = ZeroFluxNeumannBoundaryCondition<RealOutputImageType>;
 
+  /** Type of the directional kernel used along each dimension. */
+  using KernelType = GaussianOperator<RealOutputPixelValueType, ImageDimension>;
+  using RadiusType = typename KernelType::SizeType;
+
   /** Typedef of double containers */
   using ArrayType = FixedArray<double, Self::ImageDimension>;
   using SigmaArrayType = ArrayType;
@@ -302,6 +322,13 @@ public:
   void
   GenerateInputRequestedRegion() override;
 
+  /** Returns the radius of the kernel along each dimension, in pixels. The
+   * radius is zero along the dimensions that are not smoothed. When
+   * UseImageSpacing is on, the spacing of the input is used, so the input
+   * must be set. */
+  RadiusType
+  GetKernelRadius() const;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
 
@@ -334,7 +361,55 @@ protected:
   void
   GenerateData() override;
 
+  /** Creates the directional kernel along the specified dimension. */
+  void
+  GenerateKernel(unsigned int dimension, KernelType & kernel) const;
+
+  /** Returns the number of dimensions to smooth, which is at most
+   * ImageDimension. */
+  unsigned int
+  GetValidFilterDimensionality() const
+  {
+    if (m_FilterDimensionality > ImageDimension)
+    {
+      return ImageDimension;
+    }
+    return m_FilterDimensionality;
+  }
+
 private:
+  /** Whether the images are convolved by lines, rather than by a
+   * mini-pipeline of NeighborhoodOperatorImageFilters. */
+  using SupportsLineConvolution =
+    std::integral_constant<bool,
+                           std::is_arithmetic<InputPixelType>::value && std::is_arithmetic<OutputPixelType>::value &&
+                             std::is_same<InputImageType, Image<InputPixelType, ImageDimension>>::value &&
+                             std::is_same<OutputImageType, Image<OutputPixelType, ImageDimension>>::value>;
+
+  /** Number of adjacent lines that are convolved together, along the
+   * dimensions other than the first one. */
+  static constexpr SizeValueType LineBlockSize = 16;
+
+  /** Convolves the input by lines, along the dimensions to smooth. */
+  void
+  LineConvolutionGenerateData(const InputImageType & input, std::true_type);
+  void
+  LineConvolutionGenerateData(const InputImageType &, std::false_type)
+  {}
+
+  /** Convolves the lines of the source image along the specified dimension,
+   * and writes them to the specified region of the destination image. The
+   * source and the destination may be the same image. */
+  template <typename TSourceImage, typename TDestinationImage>
+  void
+  ConvolveLines(const TSourceImage &                         source,
+                const ImageBoundaryCondition<TSourceImage> & boundaryCondition,
+                TDestinationImage &                          destination,
+                const typename TOutputImage::RegionType &    region,
+                unsigned int                                 dimension,
+                const KernelType &                           kernel,
+                SizeValueType                                totalNumberOfPixels);
+
   /** The variance of the gaussian blurring kernel in each dimensional
     direction. */
   ArrayType m_Variance;
@@ -23,6 +23,11 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressAccumulator.h"
 #include "itkImageAlgorithm.h"
+#include "itkIndexRange.h"
+#include "itkTotalProgressReporter.h"
+
+#include <algorithm>
+#include <vector>
 
 namespace itk
 {
@@ -42,40 +47,8 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRe
     return;
   }
 
-  // Build an operator so that we can determine the kernel size
-  GaussianOperator<OutputPixelValueType, ImageDimension> oper;
-
-  typename TInputImage::SizeType radius;
-
-  for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
-  {
-    // Determine the size of the operator in this dimension.  Note that the
-    // Gaussian is built as a 1D operator in each of the specified directions.
-    oper.SetDirection(i);
-    if (m_UseImageSpacing == true)
-    {
-      if (this->GetInput()->GetSpacing()[i] == 0.0)
-      {
-        itkExceptionMacro(<< "Pixel spacing cannot be zero");
-      }
-      else
-      {
-        // convert the variance from physical units to pixels
-        double s = this->GetInput()->GetSpacing()[i];
-        s = s * s;
-        oper.SetVariance(m_Variance[i] / s);
-      }
-    }
-    else
-    {
-      oper.SetVariance(m_Variance[i]);
-    }
-    oper.SetMaximumError(m_MaximumError[i]);
-    oper.SetMaximumKernelWidth(m_MaximumKernelWidth);
-    oper.CreateDirectional();
-
-    radius[i] = oper.GetRadius(i);
-  }
+  // Determine the size of the kernel along each dimension
+  const RadiusType radius = this->GetKernelRadius();
 
   // get a copy of the input requested region (should equal the output
   // requested region)
@@ -108,6 +81,54 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRe
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+auto
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GetKernelRadius() const -> RadiusType
+{
+  RadiusType radius;
+  radius.Fill(0);
+
+  for (unsigned int i = 0; i < this->GetValidFilterDimensionality(); ++i)
+  {
+    // Determine the size of the operator in this dimension.  Note that the
+    // Gaussian is built as a 1D operator in each of the specified directions.
+    KernelType kernel;
+    this->GenerateKernel(i, kernel);
+    radius[i] = kernel.GetRadius(i);
+  }
+  return radius;
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateKernel(unsigned int dimension,
+                                                                       KernelType & kernel) const
+{
+  kernel.SetDirection(dimension);
+  if (m_UseImageSpacing == true)
+  {
+    if (this->GetInput()->GetSpacing()[dimension] == 0.0)
+    {
+      itkExceptionMacro(<< "Pixel spacing cannot be zero");
+    }
+    else
+    {
+      // convert the variance from physical units to pixels
+      double s = this->GetInput()->GetSpacing()[dimension];
+      s = s * s;
+      kernel.SetVariance(m_Variance[dimension] / s);
+    }
+  }
+  else
+  {
+    kernel.SetVariance(m_Variance[dimension]);
+  }
+
+  kernel.SetMaximumKernelWidth(m_MaximumKernelWidth);
+  kernel.SetMaximumError(m_MaximumError[dimension]);
+  kernel.CreateDirectional();
+}
+
 template <typename TInputImage, typename TOutputImage>
 void
 DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
@@ -124,11 +145,7 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
   localInput->Graft(this->GetInput());
 
   // Determine the dimensionality to filter
-  unsigned int filterDimensionality = m_FilterDimensionality;
-  if (filterDimensionality > ImageDimension)
-  {
-    filterDimensionality = ImageDimension;
-  }
+  const unsigned int filterDimensionality = this->GetValidFilterDimensionality();
   if (filterDimensionality == 0)
   {
     // no smoothing, copy input to output
@@ -139,6 +156,12 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
     return;
   }
 
+  if (SupportsLineConvolution::value)
+  {
+    this->LineConvolutionGenerateData(*localInput, SupportsLineConvolution());
+    return;
+  }
+
   // Type definition for the internal neighborhood filter
   //
   // First filter convolves and changes type from input type to real type
@@ -160,9 +183,7 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
   using SingleFilterPointer = typename SingleFilterType::Pointer;
 
   // Create a series of operators
-  using OperatorType = GaussianOperator<RealOutputPixelValueType, ImageDimension>;
-
-  std::vector<OperatorType> oper;
+  std::vector<KernelType> oper;
   oper.resize(filterDimensionality);
 
   // Create a process accumulator for tracking the progress of minipipeline
@@ -178,29 +199,7 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
     unsigned int reverse_i = filterDimensionality - i - 1;
 
     // Set up the operator for this dimension
-    oper[reverse_i].SetDirection(i);
-    if (m_UseImageSpacing == true)
-    {
-      if (localInput->GetSpacing()[i] == 0.0)
-      {
-        itkExceptionMacro(<< "Pixel spacing cannot be zero");
-      }
-      else
-      {
-        // convert the variance from physical units to pixels
-        double s = localInput->GetSpacing()[i];
-        s = s * s;
-        oper[reverse_i].SetVariance(m_Variance[i] / s);
-      }
-    }
-    else
-    {
-      oper[reverse_i].SetVariance(m_Variance[i]);
-    }
-
-    oper[reverse_i].SetMaximumKernelWidth(m_MaximumKernelWidth);
-    oper[reverse_i].SetMaximumError(m_MaximumError[i]);
-    oper[reverse_i].CreateDirectional();
+    this->GenerateKernel(i, oper[reverse_i]);
   }
 
   // Create a chain of filters
@@ -214,7 +213,7 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
     singleFilter->SetOperator(oper[0]);
     singleFilter->SetInput(localInput);
     singleFilter->OverrideBoundaryCondition(m_InputBoundaryCondition);
-    progress->RegisterInternalFilter(singleFilter, 1.0f / m_FilterDimensionality);
+    progress->RegisterInternalFilter(singleFilter, 1.0f / filterDimensionality);
 
     // Graft this filters output onto the mini-pipeline so the mini-pipeline
     // has the correct region ivars and will write to this filters bulk data
@@ -299,6 +298,197 @@ DiscreteGaussianImageFilter<TInputImage, TOutputImage>::GenerateData()
   }
 }
 
+template <typename TInputImage, typename TOutputImage>
+void
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::LineConvolutionGenerateData(const InputImageType & input,
+                                                                                    std::true_type)
+{
+  OutputImageType * output = this->GetOutput();
+
+  const unsigned int filterDimensionality = this->GetValidFilterDimensionality();
+
+  std::vector<KernelType> kernels(filterDimensionality);
+  for (unsigned int i = 0; i < filterDimensionality; ++i)
+  {
+    this->GenerateKernel(i, kernels[i]);
+  }
+
+  // The dimensions are convolved from the last one to the first one, like by
+  // the mini-pipeline. The convolution along a dimension produces the region
+  // that is needed by the convolutions along the remaining dimensions: the
+  // output requested region, padded by the kernel radius along these
+  // dimensions.
+  std::vector<typename TOutputImage::RegionType> regions(filterDimensionality);
+  typename TOutputImage::RegionType              region = output->GetRequestedRegion();
+  SizeValueType                      totalNumberOfPixels = 0;
+  for (unsigned int i = 0; i < filterDimensionality; ++i)
+  {
+    regions[i] = region;
+    totalNumberOfPixels += region.GetNumberOfPixels();
+
+    auto radius = RadiusType::Filled(0);
+    radius[i] = kernels[i].GetRadius(i);
+    region.PadByRadius(radius);
+    region.Crop(output->GetLargestPossibleRegion());
+  }
+
+  const unsigned int lastDimension = filterDimensionality - 1;
+
+  if (filterDimensionality == 1)
+  {
+    this->ConvolveLines(input, *m_InputBoundaryCondition, *output, regions[0], 0, kernels[0], totalNumberOfPixels);
+    return;
+  }
+
+  // A single intermediate image is convolved in place along all the
+  // dimensions but the first and the last ones.
+  const auto intermediate = RealOutputImageType::New();
+  intermediate->CopyInformation(output);
+  intermediate->SetBufferedRegion(regions[lastDimension]);
+  intermediate->SetRequestedRegion(regions[lastDimension]);
+  intermediate->Allocate();
+
+  this->ConvolveLines(input,
+                      *m_InputBoundaryCondition,
+                      *intermediate,
+                      regions[lastDimension],
+                      lastDimension,
+                      kernels[lastDimension],
+                      totalNumberOfPixels);
+  for (unsigned int i = lastDimension - 1; i > 0; --i)
+  {
+    this->ConvolveLines(
+      *intermediate, *m_RealBoundaryCondition, *intermediate, regions[i], i, kernels[i], totalNumberOfPixels);
+  }
+  this->ConvolveLines(*intermediate, *m_RealBoundaryCondition, *output, regions[0], 0, kernels[0], totalNumberOfPixels);
+}
+
+template <typename TInputImage, typename TOutputImage>
+template <typename TSourceImage, typename TDestinationImage>
+void
+DiscreteGaussianImageFilter<TInputImage, TOutputImage>::ConvolveLines(
+  const TSourceImage &                         source,
+  const ImageBoundaryCondition<TSourceImage> & boundaryCondition,
+  TDestinationImage &                          destination,
+  const typename TOutputImage::RegionType &    region,
+  unsigned int                                 dimension,
+  const KernelType &                           kernel,
+  SizeValueType                                totalNumberOfPixels)
+{
+  using SourcePixelType = typename TSourceImage::PixelType;
+  using DestinationPixelType = typename TDestinationImage::PixelType;
+  using IndexType = typename TOutputImage::IndexType;
+
+  // The types of the inner product of NeighborhoodOperatorImageFilter, so
+  // that both compute the same output.
+  using SourceRealType = typename NumericTraits<SourcePixelType>::RealType;
+  using AccumulateType = typename NumericTraits<SourceRealType>::AccumulateType;
+  using ComputingType = typename NumericTraits<DestinationPixelType>::RealType;
+
+  const std::vector<ComputingType> coefficients(kernel.Begin(), kernel.End());
+  const auto                       radius = static_cast<IndexValueType>(kernel.GetRadius(dimension));
+  const SizeValueType              lineLength = region.GetSize(dimension);
+  const SizeValueType              windowLength = lineLength + coefficients.size() - 1;
+
+  // Pixels outside the buffered region of the source are provided by the
+  // boundary condition.
+  const auto &            sourceRegion = source.GetBufferedRegion();
+  const IndexValueType    sourceBegin = sourceRegion.GetIndex(dimension);
+  const IndexValueType    sourceEnd = sourceBegin + static_cast<IndexValueType>(sourceRegion.GetSize(dimension));
+  const OffsetValueType   sourceStride = source.GetOffsetTable()[dimension];
+  const OffsetValueType   destinationStride = destination.GetOffsetTable()[dimension];
+  const SourcePixelType * sourceBuffer = source.GetBufferPointer();
+  DestinationPixelType *  destinationBuffer = destination.GetBufferPointer();
+  const SizeValueType     maximumNumberOfLanes = (dimension == 0) ? 1 : LineBlockSize;
+
+  this->GetMultiThreader()->template ParallelizeImageRegionRestrictDirection<ImageDimension>(
+    dimension,
+    region,
+    [&](const typename TOutputImage::RegionType & linesRegion) {
+      TotalProgressReporter progress(this, totalNumberOfPixels);
+
+      // The window of each line is copied, so that the lines can be
+      // convolved in place. The pixels of adjacent lines (the lanes) are
+      // interleaved, so that they are convolved together.
+      std::vector<SourceRealType> window(windowLength * maximumNumberOfLanes);
+      std::vector<AccumulateType> sums(maximumNumberOfLanes);
+
+      typename TOutputImage::RegionType blocksRegion = linesRegion;
+      blocksRegion.SetSize(dimension, 1);
+      blocksRegion.SetSize(0, 1);
+      const SizeValueType totalNumberOfLanes = (dimension == 0) ? 1 : linesRegion.GetSize(0);
+
+      for (const auto & blocksIndex : ImageRegionIndexRange<ImageDimension>(blocksRegion))
+      {
+        for (SizeValueType firstLane = 0; firstLane < totalNumberOfLanes; firstLane += maximumNumberOfLanes)
+        {
+          const SizeValueType numberOfLanes = std::min(maximumNumberOfLanes, totalNumberOfLanes - firstLane);
+
+          IndexType index = blocksIndex;
+          index[0] += static_cast<IndexValueType>(firstLane);
+
+          // Check whether the lines of the block are inside the source,
+          // along the other dimensions.
+          IndexType firstSourceIndex = index;
+          firstSourceIndex[dimension] = sourceBegin;
+          IndexType lastSourceIndex = firstSourceIndex;
+          lastSourceIndex[0] += static_cast<IndexValueType>(numberOfLanes - 1);
+          const bool isBlockInside = sourceRegion.IsInside(firstSourceIndex) && sourceRegion.IsInside(lastSourceIndex);
+          const SourcePixelType * const sourceLines =
+            isBlockInside ? sourceBuffer + source.ComputeOffset(firstSourceIndex) : nullptr;
+
+          index[dimension] = region.GetIndex(dimension) - radius;
+          for (SizeValueType j = 0; j < windowLength; ++j, ++index[dimension])
+          {
+            SourceRealType * const windowPixels = &window[j * numberOfLanes];
+            if (isBlockInside && index[dimension] >= sourceBegin && index[dimension] < sourceEnd)
+            {
+              const SourcePixelType * const sourcePixels =
+                sourceLines + (index[dimension] - sourceBegin) * sourceStride;
+              for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+              {
+                windowPixels[lane] = static_cast<SourceRealType>(sourcePixels[lane]);
+              }
+            }
+            else
+            {
+              IndexType laneIndex = index;
+              for (SizeValueType lane = 0; lane < numberOfLanes; ++lane, ++laneIndex[0])
+              {
+                windowPixels[lane] = static_cast<SourceRealType>(boundaryCondition.GetPixel(laneIndex, &source));
+              }
+            }
+          }
+
+          index[dimension] = region.GetIndex(dimension);
+          DestinationPixelType * const destinationLines = destinationBuffer + destination.ComputeOffset(index);
+
+          for (SizeValueType i = 0; i < lineLength; ++i)
+          {
+            std::fill_n(sums.begin(), numberOfLanes, NumericTraits<AccumulateType>::ZeroValue());
+            for (SizeValueType k = 0; k < coefficients.size(); ++k)
+            {
+              const ComputingType          coefficient = coefficients[k];
+              const SourceRealType * const windowPixels = &window[(i + k) * numberOfLanes];
+              for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+              {
+                sums[lane] += static_cast<AccumulateType>(coefficient * windowPixels[lane]);
+              }
+            }
+
+            DestinationPixelType * const destinationPixels = destinationLines + i * destinationStride;
+            for (SizeValueType lane = 0; lane < numberOfLanes; ++lane)
+            {
+              destinationPixels[lane] = static_cast<DestinationPixelType>(static_cast<ComputingType>(sums[lane]));
+            }
+          }
+          progress.Completed(lineLength * numberOfLanes);
+        }
+      }
+    },
+    nullptr);
+}
+
 #if !defined(ITK_LEGACY_REMOVE)
 template <typename TInputImage, typename TOutputImage>
 unsigned int
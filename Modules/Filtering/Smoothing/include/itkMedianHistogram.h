@@ -0,0 +1,167 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkMedianHistogram_h
+#define itkMedianHistogram_h
+
+#include "itkIntTypes.h"
+#include "itkNumericTraits.h"
+
+#include <type_traits>
+#include <vector>
+
+namespace itk
+{
+namespace Function
+{
+
+/**
+ * \class MedianHistogram
+ * \brief Sliding histogram of 8-bit or 16-bit integer pixel values,
+ * which keeps track of their median.
+ *
+ * The pixel values are counted in a histogram having a bin for each
+ * possible value, and in a coarse histogram, whose bins each cover a
+ * range of 2^(b/2) values, b being the number of bits of the pixel
+ * type. As in the Huang algorithm, the coarse bin of the median is
+ * remembered, together with the number of values below it. When the
+ * window slides, only a few values are added and removed, so the
+ * median is usually found again by moving over a few coarse bins, and
+ * then scanning the fine bins of a single coarse bin (Perreault and
+ * Hebert, "Median Filtering in Constant Time", IEEE TIP 2007).
+ *
+ * The class has the interface of the histograms of
+ * MovingHistogramImageFilter. For an even number of values, the lower
+ * one of the two middle values is returned, like RankHistogram does.
+ *
+ * \sa MedianImageFilter
+ * \sa RankHistogram
+ * \ingroup ITKSmoothing
+ */
+template <typename TInputPixel>
+class MedianHistogram
+{
+public:
+  /** Whether the histogram supports the pixel type. */
+  static constexpr bool IsSupportedPixelType = std::is_integral<TInputPixel>::value &&
+                                               !std::is_same<TInputPixel, bool>::value && sizeof(TInputPixel) <= 2;
+
+  MedianHistogram()
+    : m_Counts(SupportedPixelType::NumberOfBins)
+    , m_CoarseCounts(SupportedPixelType::NumberOfBins >> SupportedPixelType::CoarseShift)
+  {}
+
+  void
+  AddPixel(const TInputPixel & p)
+  {
+    const SizeValueType bin = ToBin(p);
+    const SizeValueType coarseBin = bin >> SupportedPixelType::CoarseShift;
+    ++m_Counts[bin];
+    ++m_CoarseCounts[coarseBin];
+    m_Below += (coarseBin < m_MedianCoarseBin);
+    ++m_Entries;
+  }
+
+  void
+  RemovePixel(const TInputPixel & p)
+  {
+    const SizeValueType bin = ToBin(p);
+    const SizeValueType coarseBin = bin >> SupportedPixelType::CoarseShift;
+    --m_Counts[bin];
+    --m_CoarseCounts[coarseBin];
+    m_Below -= (coarseBin < m_MedianCoarseBin);
+    --m_Entries;
+  }
+
+  void
+  AddBoundary()
+  {}
+
+  void
+  RemoveBoundary()
+  {}
+
+  bool
+  IsValid() const
+  {
+    return m_Entries > 0;
+  }
+
+  /** Returns the median of the values in the histogram, which must not
+   * be empty. */
+  TInputPixel
+  GetValue(const TInputPixel & = TInputPixel())
+  {
+    // Zero based rank of the median
+    const SizeValueType rank = (m_Entries - 1) / 2;
+
+    // Move to the coarse bin of the median
+    while (m_Below > rank)
+    {
+      --m_MedianCoarseBin;
+      m_Below -= m_CoarseCounts[m_MedianCoarseBin];
+    }
+    while (m_Below + m_CoarseCounts[m_MedianCoarseBin] <= rank)
+    {
+      m_Below += m_CoarseCounts[m_MedianCoarseBin];
+      ++m_MedianCoarseBin;
+    }
+
+    // Find the median within its coarse bin
+    SizeValueType bin = m_MedianCoarseBin << SupportedPixelType::CoarseShift;
+    SizeValueType count = m_Below + m_Counts[bin];
+    while (count <= rank)
+    {
+      ++bin;
+      count += m_Counts[bin];
+    }
+    return static_cast<TInputPixel>(static_cast<OffsetValueType>(bin) + NumericTraits<TInputPixel>::min());
+  }
+
+private:
+  // Constants of the supported pixel types. For other pixel types, they
+  // are just chosen to let the class be instantiated.
+  struct SupportedPixelType
+  {
+    static constexpr unsigned int  NumberOfBits = IsSupportedPixelType ? 8 * sizeof(TInputPixel) : 2;
+    static constexpr SizeValueType NumberOfBins = SizeValueType{ 1 } << NumberOfBits;
+    static constexpr unsigned int  CoarseShift = NumberOfBits / 2;
+  };
+
+  static SizeValueType
+  ToBin(const TInputPixel & p)
+  {
+    return static_cast<SizeValueType>(static_cast<OffsetValueType>(p) -
+                                      static_cast<OffsetValueType>(NumericTraits<TInputPixel>::min()));
+  }
+
+  // The counts of a neighborhood always fit in 32 bits, and the smaller
+  // type keeps the histogram of 16-bit values in the cache.
+  std::vector<uint32_t> m_Counts;
+  std::vector<uint32_t> m_CoarseCounts;
+
+  // Coarse bin of the last median, and number of values in the coarse
+  // bins below it.
+  SizeValueType m_MedianCoarseBin{ 0 };
+  SizeValueType m_Below{ 0 };
+  SizeValueType m_Entries{ 0 };
+};
+
+} // end namespace Function
+} // end namespace itk
+
+#endif
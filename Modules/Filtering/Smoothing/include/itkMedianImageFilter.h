@@ -20,9 +20,35 @@
 
 #include "itkBoxImageFilter.h"
 #include "itkImage.h"
+#include "itkMedianHistogram.h"
+#include "ITKSmoothingExport.h"
 
 namespace itk
 {
+/**\class MedianImageFilterEnums
+ * \brief Contains all enum classes used by MedianImageFilter class.
+ * \ingroup ITKSmoothing
+ */
+class MedianImageFilterEnums
+{
+public:
+  /**\class Algorithm
+   * \ingroup ITKSmoothing
+   * Algorithm used to compute the median of each neighborhood. */
+  enum class Algorithm : uint8_t
+  {
+    /** Histogram if the pixel type supports it and the neighborhood is large enough, otherwise Selection. */
+    Automatic = 0,
+    /** Selection of the median from a copy of each neighborhood, by std::nth_element. */
+    Selection = 1,
+    /** Sliding histogram along the lines of the image, for 8-bit and 16-bit integer pixel types. */
+    Histogram = 2
+  };
+};
+// Define how to print enumeration
+extern ITKSmoothing_EXPORT std::ostream &
+                           operator<<(std::ostream & out, const MedianImageFilterEnums::Algorithm value);
+
 /**
  *\class MedianImageFilter
  * \brief Applies a median filter to an image
@@ -36,6 +62,14 @@ namespace itk
  * This filter requires that the input pixel type provides an operator<()
  * (LessThan Comparable).
  *
+ * By default, the median of each neighborhood is selected from a copy of
+ * its pixels, which costs O(r^N) per pixel for a radius r in N dimensions.
+ * For 8-bit and 16-bit integer pixel types and large neighborhoods, the
+ * filter instead slides a histogram of the neighborhood along the lines
+ * of the image (Huang, Perreault and Hebert), which costs O(r^(N-1)) per
+ * pixel. Both algorithms compute the same output. SetAlgorithm() allows
+ * to choose one of them explicitly.
+ *
  * \sa Image
  * \sa Neighborhood
  * \sa NeighborhoodOperator
@@ -84,6 +118,21 @@ public:
 
   using InputSizeType = typename InputImageType::SizeType;
 
+  using AlgorithmEnum = MedianImageFilterEnums::Algorithm;
+
+  /** Histogram type of the histogram algorithm. */
+  using HistogramType = Function::MedianHistogram<InputPixelType>;
+
+  /** Set/Get the algorithm used to compute the medians. Defaults to
+   * Automatic. */
+  itkSetEnumMacro(Algorithm, AlgorithmEnum);
+  itkGetEnumMacro(Algorithm, AlgorithmEnum);
+
+  /** Returns whether the filter uses the histogram algorithm, with its
+   * current algorithm, pixel type and radius. */
+  bool
+  GetUseHistogramAlgorithm() const;
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   // Begin concept checking
   itkConceptMacro(SameDimensionCheck, (Concept::SameDimension<InputImageDimension, OutputImageDimension>));
@@ -96,6 +145,14 @@ protected:
   MedianImageFilter();
   ~MedianImageFilter() override = default;
 
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+  /** Verifies that the pixel type supports the histogram algorithm, when
+   * it is selected explicitly. */
+  void
+  VerifyPreconditions() ITKv5_CONST override;
+
   /** MedianImageFilter can be implemented as a multithreaded filter.
    * Therefore, this implementation provides a ThreadedGenerateData()
    * routine which is called for each processing thread. The output
@@ -108,6 +165,17 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void
   DynamicThreadedGenerateData(const OutputImageRegionType & outputRegionForThread) override;
+
+private:
+  /** Computes the medians by sliding a histogram along the lines of the
+   * output region, if the pixel type supports it. */
+  void
+  HistogramThreadedGenerateData(const OutputImageRegionType & outputRegionForThread, std::true_type);
+  void
+  HistogramThreadedGenerateData(const OutputImageRegionType &, std::false_type)
+  {}
+
+  AlgorithmEnum m_Algorithm{ AlgorithmEnum::Automatic };
 };
 } // end namespace itk
 
@@ -21,6 +21,7 @@
 #include "itkBufferedImageNeighborhoodPixelAccessPolicy.h"
 #include "itkImageNeighborhoodOffsets.h"
 #include "itkImageRegionRange.h"
+#include "itkImageScanlineIterator.h"
 #include "itkIndexRange.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
@@ -29,6 +30,7 @@
 
 #include <vector>
 #include <algorithm>
+#include <type_traits> // For integral_constant.
 
 namespace itk
 {
@@ -39,11 +41,67 @@ MedianImageFilter<TInputImage, TOutputImage>::MedianImageFilter()
   this->ThreaderUpdateProgressOff();
 }
 
+template <typename TInputImage, typename TOutputImage>
+bool
+MedianImageFilter<TInputImage, TOutputImage>::GetUseHistogramAlgorithm() const
+{
+  switch (m_Algorithm)
+  {
+    case AlgorithmEnum::Selection:
+      return false;
+    case AlgorithmEnum::Histogram:
+      return true;
+    default:
+      break;
+  }
+  if (!HistogramType::IsSupportedPixelType)
+  {
+    return false;
+  }
+
+  // Selection costs about a copy and a partial sort of the neighborhood per
+  // pixel. The histogram costs two columns of the neighborhood (added and
+  // removed), each histogram update being about twice cheaper than a pixel of
+  // the selection, plus the search of the median among the fine bins of a
+  // coarse bin. The search cost is measured by itkMedianImageFilterThroughputTest.
+  const auto    radius = this->GetRadius();
+  SizeValueType neighborhoodSize = 1;
+  for (unsigned int i = 0; i < InputImageDimension; ++i)
+  {
+    neighborhoodSize *= 2 * radius[i] + 1;
+  }
+  const SizeValueType columnSize = neighborhoodSize / (2 * radius[0] + 1);
+  const SizeValueType searchCost = (sizeof(InputPixelType) == 1) ? 4 : 16;
+
+  return columnSize + searchCost < neighborhoodSize;
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::VerifyPreconditions() ITKv5_CONST
+{
+  Superclass::VerifyPreconditions();
+
+  if (m_Algorithm == AlgorithmEnum::Histogram && !HistogramType::IsSupportedPixelType)
+  {
+    itkExceptionMacro("The histogram algorithm only supports 8-bit and 16-bit integer pixel types.");
+  }
+}
+
+
 template <typename TInputImage, typename TOutputImage>
 void
 MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
   const OutputImageRegionType & outputRegionForThread)
 {
+  if (this->GetUseHistogramAlgorithm())
+  {
+    this->HistogramThreadedGenerateData(outputRegionForThread,
+                                        std::integral_constant<bool, HistogramType::IsSupportedPixelType>());
+    return;
+  }
+
   // Allocate output
   OutputImageType *      output = this->GetOutput();
   const InputImageType * input = this->GetInput();
@@ -104,6 +162,127 @@ MedianImageFilter<TInputImage, TOutputImage>::DynamicThreadedGenerateData(
     }
   }
 }
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::HistogramThreadedGenerateData(
+  const OutputImageRegionType & outputRegionForThread,
+  std::true_type)
+{
+  OutputImageType *      output = this->GetOutput();
+  const InputImageType * input = this->GetInput();
+
+  const auto radius = this->GetRadius();
+
+  // Indices outside the buffered region are clamped to its border, as by the
+  // zero flux Neumann boundary condition of the selection algorithm.
+  const InputImageRegionType & bufferedRegion = input->GetBufferedRegion();
+  const auto * const           offsetTable = input->GetOffsetTable();
+  const auto clampedOffset = [&bufferedRegion, offsetTable](unsigned int dimension, IndexValueType indexValue) {
+    const IndexValueType first = bufferedRegion.GetIndex(dimension);
+    const IndexValueType last = first + static_cast<IndexValueType>(bufferedRegion.GetSize(dimension)) - 1;
+    return (std::min(std::max(indexValue, first), last) - first) * offsetTable[dimension];
+  };
+
+  const auto * const buffer = input->GetBufferPointer();
+  const auto         accessor = input->GetNeighborhoodAccessor();
+
+  // The neighborhood slides along the first dimension. A column holds the
+  // pixels of the neighborhood that have the same index along the first
+  // dimension.
+  SizeValueType columnSize = 1;
+  for (unsigned int i = 1; i < InputImageDimension; ++i)
+  {
+    columnSize *= 2 * radius[i] + 1;
+  }
+  std::vector<OffsetValueType> columnOffsets(columnSize);
+
+  // Offsets of the columns, from the radius before the first output pixel of
+  // a line, to the radius after its last one.
+  const auto          lineRadius = static_cast<IndexValueType>(radius[0]);
+  const SizeValueType lineLength = outputRegionForThread.GetSize(0);
+  const SizeValueType windowLength = 2 * radius[0] + 1;
+
+  std::vector<OffsetValueType> lineOffsets(lineLength + windowLength - 1);
+  for (SizeValueType i = 0; i < lineOffsets.size(); ++i)
+  {
+    lineOffsets[i] = clampedOffset(0, outputRegionForThread.GetIndex(0) - lineRadius + static_cast<IndexValueType>(i));
+  }
+
+  HistogramType histogram;
+
+  const auto addColumn = [&](OffsetValueType lineOffset) {
+    for (const OffsetValueType columnOffset : columnOffsets)
+    {
+      histogram.AddPixel(accessor.Get(buffer + lineOffset + columnOffset));
+    }
+  };
+  const auto removeColumn = [&](OffsetValueType lineOffset) {
+    for (const OffsetValueType columnOffset : columnOffsets)
+    {
+      histogram.RemovePixel(accessor.Get(buffer + lineOffset + columnOffset));
+    }
+  };
+
+  TotalProgressReporter progress(this, output->GetRequestedRegion().GetNumberOfPixels());
+
+  ImageScanlineIterator<OutputImageType> outputIterator(output, outputRegionForThread);
+
+  while (!outputIterator.IsAtEnd())
+  {
+    const typename OutputImageType::IndexType & lineIndex = outputIterator.GetIndex();
+
+    for (SizeValueType j = 0; j < columnSize; ++j)
+    {
+      OffsetValueType columnOffset = 0;
+      SizeValueType   remainder = j;
+      for (unsigned int i = 1; i < InputImageDimension; ++i)
+      {
+        const SizeValueType diameter = 2 * radius[i] + 1;
+        columnOffset += clampedOffset(
+          i, lineIndex[i] - static_cast<IndexValueType>(radius[i]) + static_cast<IndexValueType>(remainder % diameter));
+        remainder /= diameter;
+      }
+      columnOffsets[j] = columnOffset;
+    }
+
+    for (SizeValueType i = 0; i < windowLength; ++i)
+    {
+      addColumn(lineOffsets[i]);
+    }
+    for (SizeValueType i = 0; i < lineLength; ++i)
+    {
+      outputIterator.Set(static_cast<OutputPixelType>(histogram.GetValue()));
+      ++outputIterator;
+
+      if (i + 1 < lineLength)
+      {
+        addColumn(lineOffsets[i + windowLength]);
+        removeColumn(lineOffsets[i]);
+      }
+    }
+
+    // Empty the histogram for the next line.
+    for (SizeValueType i = lineLength - 1; i < lineOffsets.size(); ++i)
+    {
+      removeColumn(lineOffsets[i]);
+    }
+
+    outputIterator.NextLine();
+    progress.Completed(lineLength);
+  }
+}
+
+
+template <typename TInputImage, typename TOutputImage>
+void
+MedianImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream & os, Indent indent) const
+{
+  BoxImageFilter<TInputImage, TOutputImage>::PrintSelf(os, indent);
+
+  os << indent << "Algorithm: " << m_Algorithm << std::endl;
+}
 } // end namespace itk
 
 #endif
@@ -0,0 +1,40 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMedianImageFilter.h"
+
+namespace itk
+{
+/** Print enum values */
+std::ostream &
+operator<<(std::ostream & out, const MedianImageFilterEnums::Algorithm value)
+{
+  return out << [value] {
+    switch (value)
+    {
+      case MedianImageFilterEnums::Algorithm::Automatic:
+        return "itk::MedianImageFilterEnums::Algorithm::Automatic";
+      case MedianImageFilterEnums::Algorithm::Selection:
+        return "itk::MedianImageFilterEnums::Algorithm::Selection";
+      case MedianImageFilterEnums::Algorithm::Histogram:
+        return "itk::MedianImageFilterEnums::Algorithm::Histogram";
+      default:
+        return "INVALID VALUE FOR itk::MedianImageFilterEnums::Algorithm";
+    }
+  }();
+}
+} // namespace itk
@@ -0,0 +1,261 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkDiscreteGaussianImageFilter.h"
+
+#include "itkConstantBoundaryCondition.h"
+#include "itkGaussianOperator.h"
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionRange.h"
+#include "itkNeighborhoodOperatorImageFilter.h"
+
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+// Creates a test image, filled with random pixel values.
+template <typename TImage>
+typename TImage::Pointer
+CreateImageFilledWithRandomPixelValues(const typename TImage::SizeType & imageSize)
+{
+  using PixelType = typename TImage::PixelType;
+
+  const auto image = TImage::New();
+  image->SetRegions(imageSize);
+  image->Allocate();
+
+  std::mt19937                       randomNumberEngine;
+  std::uniform_int_distribution<int> distribution(0, 255);
+  for (auto & pixel : itk::ImageBufferRange<TImage>{ *image })
+  {
+    pixel = static_cast<PixelType>(distribution(randomNumberEngine));
+  }
+  return image;
+}
+
+
+// Smooths the input by a chain of NeighborhoodOperatorImageFilters, one per dimension, starting with the last
+// dimension to smooth, the way DiscreteGaussianImageFilter does for images that do not support line convolution.
+template <typename TInputImage, typename TOutputImage>
+std::vector<typename TOutputImage::PixelType>
+SmoothByNeighborhoodOperatorImageFilters(
+  const TInputImage &                                                             input,
+  const itk::DiscreteGaussianImageFilter<TInputImage, TOutputImage> &             gaussianFilter,
+  typename itk::DiscreteGaussianImageFilter<TInputImage, TOutputImage>::ArrayType variance,
+  const typename TOutputImage::RegionType &                                       requestedRegion)
+{
+  using GaussianFilterType = itk::DiscreteGaussianImageFilter<TInputImage, TOutputImage>;
+  using RealImageType = typename GaussianFilterType::RealOutputImageType;
+  using OperatorValueType = typename GaussianFilterType::RealOutputPixelValueType;
+
+  const unsigned int filterDimensionality = gaussianFilter.GetFilterDimensionality();
+
+  itk::ImageSource<RealImageType> *        lastRealFilter = nullptr;
+  std::vector<itk::ProcessObject::Pointer> filters;
+  typename TOutputImage::Pointer           output;
+  for (unsigned int i = filterDimensionality; i > 0; --i)
+  {
+    const unsigned int dimension = i - 1;
+
+    typename GaussianFilterType::KernelType kernel;
+    kernel.SetDirection(dimension);
+    kernel.SetVariance(variance[dimension]);
+    kernel.SetMaximumError(gaussianFilter.GetMaximumError()[dimension]);
+    kernel.SetMaximumKernelWidth(gaussianFilter.GetMaximumKernelWidth());
+    kernel.CreateDirectional();
+
+    if (dimension == 0)
+    {
+      if (lastRealFilter == nullptr)
+      {
+        const auto filter = itk::NeighborhoodOperatorImageFilter<TInputImage, TOutputImage, OperatorValueType>::New();
+        filter->SetInput(&input);
+        filter->SetOperator(kernel);
+        filter->OverrideBoundaryCondition(gaussianFilter.GetInputBoundaryCondition());
+        filter->GetOutput()->SetRequestedRegion(requestedRegion);
+        filter->Update();
+        output = filter->GetOutput();
+      }
+      else
+      {
+        const auto filter = itk::NeighborhoodOperatorImageFilter<RealImageType, TOutputImage, OperatorValueType>::New();
+        filter->SetInput(lastRealFilter->GetOutput());
+        filter->SetOperator(kernel);
+        filter->OverrideBoundaryCondition(gaussianFilter.GetRealBoundaryCondition());
+        filter->GetOutput()->SetRequestedRegion(requestedRegion);
+        filter->Update();
+        output = filter->GetOutput();
+      }
+    }
+    else if (lastRealFilter == nullptr)
+    {
+      const auto filter = itk::NeighborhoodOperatorImageFilter<TInputImage, RealImageType, OperatorValueType>::New();
+      filter->SetInput(&input);
+      filter->SetOperator(kernel);
+      filter->OverrideBoundaryCondition(gaussianFilter.GetInputBoundaryCondition());
+      filters.push_back(filter.GetPointer());
+      lastRealFilter = filter;
+    }
+    else
+    {
+      const auto filter = itk::NeighborhoodOperatorImageFilter<RealImageType, RealImageType, OperatorValueType>::New();
+      filter->SetInput(lastRealFilter->GetOutput());
+      filter->SetOperator(kernel);
+      filter->OverrideBoundaryCondition(gaussianFilter.GetRealBoundaryCondition());
+      filters.push_back(filter.GetPointer());
+      lastRealFilter = filter;
+    }
+  }
+
+  std::vector<typename TOutputImage::PixelType> pixels;
+  for (const auto pixel : itk::ImageRegionRange<const TOutputImage>(*output, requestedRegion))
+  {
+    pixels.push_back(pixel);
+  }
+  return pixels;
+}
+
+
+// Expects that the line convolution of DiscreteGaussianImageFilter produces exactly the same output as the
+// chain of NeighborhoodOperatorImageFilters, for the specified requested region of the output.
+template <typename TInputImage, typename TOutputImage>
+void
+Expect_line_convolution_equal_to_neighborhood_operator_image_filters(
+  const typename TInputImage::SizeType &                                          imageSize,
+  const typename TOutputImage::RegionType &                                       requestedRegion,
+  typename itk::DiscreteGaussianImageFilter<TInputImage, TOutputImage>::ArrayType variance,
+  const unsigned int                                                              filterDimensionality,
+  itk::ImageBoundaryCondition<TInputImage> * const                                inputBoundaryCondition = nullptr)
+{
+  const auto input = CreateImageFilledWithRandomPixelValues<TInputImage>(imageSize);
+
+  const auto filter = itk::DiscreteGaussianImageFilter<TInputImage, TOutputImage>::New();
+  filter->SetInput(input);
+  filter->SetVariance(variance);
+  filter->SetMaximumKernelWidth(64);
+  filter->SetFilterDimensionality(filterDimensionality);
+  if (inputBoundaryCondition != nullptr)
+  {
+    filter->SetInputBoundaryCondition(inputBoundaryCondition);
+  }
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+
+  std::vector<typename TOutputImage::PixelType> pixels;
+  for (const auto pixel : itk::ImageRegionRange<const TOutputImage>(*filter->GetOutput(), requestedRegion))
+  {
+    pixels.push_back(pixel);
+  }
+
+  EXPECT_EQ(pixels, SmoothByNeighborhoodOperatorImageFilters(*input, *filter, variance, requestedRegion));
+}
+} // namespace
+
+
+// Tests that the line convolution produces the same output as the mini-pipeline of NeighborhoodOperatorImageFilters.
+TEST(DiscreteGaussianImageFilter, LineConvolutionSameOutputAsNeighborhoodOperatorImageFilters)
+{
+  using ImageType2D = itk::Image<float, 2>;
+  using ImageType3D = itk::Image<float, 3>;
+  using ImageType3UC = itk::Image<unsigned char, 3>;
+
+  const itk::Size<2>               size2D{ { 37, 23 } };
+  const itk::Size<3>               size3D{ { 41, 19, 13 } };
+  const itk::ImageRegion<2>        region2D{ size2D };
+  const itk::ImageRegion<3>        region3D{ size3D };
+  const itk::FixedArray<double, 2> variance2D{ { { 2.0, 0.5 } } };
+  const itk::FixedArray<double, 3> variance3D{ { { 1.5, 4.0, 0.75 } } };
+
+  for (unsigned int filterDimensionality = 1; filterDimensionality <= 2; ++filterDimensionality)
+  {
+    Expect_line_convolution_equal_to_neighborhood_operator_image_filters<ImageType2D, ImageType2D>(
+      size2D, region2D, variance2D, filterDimensionality);
+  }
+  for (unsigned int filterDimensionality = 1; filterDimensionality <= 3; ++filterDimensionality)
+  {
+    Expect_line_convolution_equal_to_neighborhood_operator_image_filters<ImageType3D, ImageType3D>(
+      size3D, region3D, variance3D, filterDimensionality);
+    Expect_line_convolution_equal_to_neighborhood_operator_image_filters<ImageType3UC, ImageType3UC>(
+      size3D, region3D, variance3D, filterDimensionality);
+    Expect_line_convolution_equal_to_neighborhood_operator_image_filters<ImageType3UC, ImageType3D>(
+      size3D, region3D, variance3D, filterDimensionality);
+  }
+}
+
+
+// Tests the line convolution of a requested region that is smaller than the image, as when the output is streamed.
+TEST(DiscreteGaussianImageFilter, LineConvolutionOfRequestedRegion)
+{
+  using ImageType = itk::Image<short, 3>;
+
+  const itk::Size<3>               imageSize{ { 29, 31, 17 } };
+  const itk::FixedArray<double, 3> variance{ { { 3.0, 1.0, 2.0 } } };
+
+  const itk::ImageRegion<3> requestedRegions[] = {
+    { itk::Index<3>{ { 0, 0, 0 } }, itk::Size<3>{ { 29, 31, 1 } } },
+    { itk::Index<3>{ { 3, 5, 8 } }, itk::Size<3>{ { 9, 20, 4 } } },
+    { itk::Index<3>{ { 28, 0, 16 } }, itk::Size<3>{ { 1, 31, 1 } } }
+  };
+
+  for (const auto & requestedRegion : requestedRegions)
+  {
+    Expect_line_convolution_equal_to_neighborhood_operator_image_filters<ImageType, ImageType>(
+      imageSize, requestedRegion, variance, 3);
+  }
+}
+
+
+// Tests the line convolution with a boundary condition other than the default one.
+TEST(DiscreteGaussianImageFilter, LineConvolutionWithConstantBoundaryCondition)
+{
+  using ImageType = itk::Image<float, 2>;
+
+  const itk::Size<2>                        imageSize{ { 20, 18 } };
+  const itk::FixedArray<double, 2>          variance{ { { 4.0, 4.0 } } };
+  itk::ConstantBoundaryCondition<ImageType> boundaryCondition;
+  boundaryCondition.SetConstant(100.0f);
+
+  Expect_line_convolution_equal_to_neighborhood_operator_image_filters<ImageType, ImageType>(
+    imageSize, itk::ImageRegion<2>{ imageSize }, variance, 2, &boundaryCondition);
+}
+
+
+// Tests that GetKernelRadius() only has a non-zero radius along the dimensions to smooth.
+TEST(DiscreteGaussianImageFilter, GetKernelRadius)
+{
+  using ImageType = itk::Image<float, 3>;
+
+  const auto image = ImageType::New();
+  image->SetRegions(itk::Size<3>{ { 8, 8, 8 } });
+  image->Allocate(true);
+
+  const auto filter = itk::DiscreteGaussianImageFilter<ImageType>::New();
+  filter->SetInput(image);
+  filter->SetVariance(4.0);
+  filter->SetFilterDimensionality(2);
+
+  const auto radius = filter->GetKernelRadius();
+  EXPECT_GT(radius[0], 0);
+  EXPECT_GT(radius[1], 0);
+  EXPECT_EQ(radius[2], 0);
+}
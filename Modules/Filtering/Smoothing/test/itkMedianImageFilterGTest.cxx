@@ -21,8 +21,11 @@
 
 #include "itkImage.h"
 #include "itkImageBufferRange.h"
+#include "itkImageRegionRange.h"
 
-#include <numeric> // For iota.
+#include <algorithm> // For all_of.
+#include <numeric>   // For iota.
+#include <random>
 #include <vector>
 
 #include <gtest/gtest.h>
@@ -92,6 +95,72 @@ Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numb
   EXPECT_EQ(outputPixelValues, expectedPixelValues);
 }
 
+
+// Creates a test image, filled with random pixel values.
+template <typename TImage>
+typename TImage::Pointer
+CreateImageFilledWithRandomPixelValues(const typename TImage::RegionType & imageRegion)
+{
+  using PixelType = typename TImage::PixelType;
+
+  const auto image = TImage::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+
+  std::mt19937                       randomNumberEngine;
+  std::uniform_int_distribution<int> distribution(itk::NumericTraits<PixelType>::min(),
+                                                  itk::NumericTraits<PixelType>::max());
+  for (auto & pixel : itk::ImageBufferRange<TImage>{ *image })
+  {
+    pixel = static_cast<PixelType>(distribution(randomNumberEngine));
+  }
+  return image;
+}
+
+
+// Expects that the histogram algorithm computes the same output as the selection algorithm, for the
+// specified radius, both for the largest possible region and for a requested region inside the image.
+template <typename TImage>
+void
+Expect_histogram_algorithm_same_output_as_selection_algorithm(const typename TImage::RegionType & imageRegion,
+                                                               const typename TImage::SizeType &   radius)
+{
+  using FilterType = itk::MedianImageFilter<TImage, TImage>;
+  using PixelType = typename TImage::PixelType;
+
+  const auto inputImage = CreateImageFilledWithRandomPixelValues<TImage>(imageRegion);
+
+  std::vector<typename TImage::RegionType> outputRegions{ imageRegion };
+  const auto imageSize = imageRegion.GetSize();
+  if (std::all_of(imageSize.begin(), imageSize.end(), [](const itk::SizeValueType value) { return value > 2; }))
+  {
+    outputRegions.push_back(imageRegion);
+    outputRegions.back().ShrinkByRadius(1);
+  }
+
+  for (const auto & outputRegion : outputRegions)
+  {
+    std::vector<PixelType> outputPixelValues[2];
+
+    for (const auto algorithm : { FilterType::AlgorithmEnum::Selection, FilterType::AlgorithmEnum::Histogram })
+    {
+      const auto filter = FilterType::New();
+      filter->SetInput(inputImage);
+      filter->SetRadius(radius);
+      filter->SetAlgorithm(algorithm);
+      filter->GetOutput()->SetRequestedRegion(outputRegion);
+      filter->Update();
+
+      EXPECT_EQ(filter->GetUseHistogramAlgorithm(), algorithm == FilterType::AlgorithmEnum::Histogram);
+
+      const auto outputImageRegionRange = itk::ImageRegionRange<const TImage>(*filter->GetOutput(), outputRegion);
+      outputPixelValues[filter->GetUseHistogramAlgorithm()].assign(outputImageRegionRange.cbegin(),
+                                                                     outputImageRegionRange.cend());
+    }
+    EXPECT_EQ(outputPixelValues[1], outputPixelValues[0]);
+  }
+}
+
 } // namespace
 
 
@@ -122,3 +191,56 @@ TEST(MedianImageFilter, ExpectedOutputPixelValuesForSequenceOfNaturalNumbers)
   Expect_output_has_specified_pixel_values_when_input_has_sequence_of_natural_numbers<itk::Image<int, 3>>(
     itk::Size<3>{ { 2, 2, 2 } }, { 3, 3, 3, 4, 5, 6, 6, 6 });
 }
+
+
+// Tests that the histogram algorithm computes the same output as the selection algorithm.
+TEST(MedianImageFilter, HistogramAlgorithmSameOutputAsSelectionAlgorithm)
+{
+  Expect_histogram_algorithm_same_output_as_selection_algorithm<itk::Image<unsigned char>>(itk::Size<>{ { 1, 1 } },
+                                                                                           itk::Size<>{ { 1, 1 } });
+  Expect_histogram_algorithm_same_output_as_selection_algorithm<itk::Image<unsigned char>>(itk::Size<>{ { 21, 17 } },
+                                                                                           itk::Size<>{ { 3, 2 } });
+  Expect_histogram_algorithm_same_output_as_selection_algorithm<itk::Image<char>>(itk::Size<>{ { 21, 17 } },
+                                                                                  itk::Size<>{ { 0, 4 } });
+  Expect_histogram_algorithm_same_output_as_selection_algorithm<itk::Image<short>>(itk::Size<>{ { 9, 30 } },
+                                                                                   itk::Size<>{ { 12, 1 } });
+  Expect_histogram_algorithm_same_output_as_selection_algorithm<itk::Image<unsigned short, 3>>(
+    itk::Size<3>{ { 12, 10, 8 } }, itk::Size<3>{ { 2, 3, 1 } });
+  Expect_histogram_algorithm_same_output_as_selection_algorithm<itk::Image<unsigned char, 1>>(itk::Size<1>{ { 50 } },
+                                                                                              itk::Size<1>{ { 7 } });
+}
+
+
+// Tests which algorithm is selected automatically.
+TEST(MedianImageFilter, AutomaticAlgorithm)
+{
+  const auto uint8Filter = itk::MedianImageFilter<itk::Image<unsigned char, 3>, itk::Image<unsigned char, 3>>::New();
+  EXPECT_EQ(uint8Filter->GetAlgorithm(), itk::MedianImageFilterEnums::Algorithm::Automatic);
+  uint8Filter->SetRadius(0);
+  EXPECT_FALSE(uint8Filter->GetUseHistogramAlgorithm());
+  uint8Filter->SetRadius(5);
+  EXPECT_TRUE(uint8Filter->GetUseHistogramAlgorithm());
+
+  // The histogram does not pay off when the neighborhood does not extend along the lines of the image.
+  uint8Filter->SetRadius(itk::Size<3>{ { 0, 5, 5 } });
+  EXPECT_FALSE(uint8Filter->GetUseHistogramAlgorithm());
+  uint8Filter->SetRadius(5);
+  uint8Filter->SetAlgorithm(itk::MedianImageFilterEnums::Algorithm::Selection);
+  EXPECT_FALSE(uint8Filter->GetUseHistogramAlgorithm());
+
+  const auto floatFilter = itk::MedianImageFilter<itk::Image<float, 3>, itk::Image<float, 3>>::New();
+  floatFilter->SetRadius(5);
+  EXPECT_FALSE(floatFilter->GetUseHistogramAlgorithm());
+}
+
+
+// Tests that selecting the histogram algorithm for a pixel type that it does not support throws an exception.
+TEST(MedianImageFilter, HistogramAlgorithmThrowsForUnsupportedPixelType)
+{
+  using ImageType = itk::Image<float>;
+
+  const auto filter = itk::MedianImageFilter<ImageType, ImageType>::New();
+  filter->SetInput(CreateImageFilledWithSequenceOfNaturalNumbers<ImageType>(itk::Size<>{ { 3, 3 } }));
+  filter->SetAlgorithm(itk::MedianImageFilterEnums::Algorithm::Histogram);
+  EXPECT_THROW(filter->Update(), itk::ExceptionObject);
+}
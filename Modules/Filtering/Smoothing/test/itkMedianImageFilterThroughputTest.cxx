@@ -0,0 +1,145 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMedianImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+#include "itkTimeProbe.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iomanip>
+
+// Throughput of MedianImageFilter on 8-bit and 16-bit 3D images, with the
+// selection algorithm and with the histogram algorithm, for increasing
+// radii. Both algorithms must compute the same output.
+
+namespace
+{
+template <typename TImage>
+typename TImage::Pointer
+CreateImage(unsigned int size)
+{
+  using PixelType = typename TImage::PixelType;
+
+  auto image = TImage::New();
+  image->SetRegions(typename TImage::SizeType{ { size, size, size } });
+  image->Allocate();
+
+  // A smooth pattern plus a pseudo random texture, spanning the pixel type.
+  unsigned int seed = 1;
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    const typename TImage::IndexType & index = it.GetIndex();
+    seed = seed * 1103515245u + 12345u;
+    const double value = 0.5 + 0.2 * std::sin(0.1 * index[0] + 0.07 * index[1] - 0.05 * index[2]) +
+                         0.3 * ((seed >> 16) & 0x7fff) / 32768.0 - 0.15;
+    it.Set(static_cast<PixelType>(value * itk::NumericTraits<PixelType>::max()));
+  }
+  return image;
+}
+
+// Update the filter with each algorithm, print the best throughput of each,
+// in millions of pixels per second, and compare their outputs.
+template <typename TImage>
+bool
+MeasureThroughput(const std::string & name, const TImage * input, unsigned int radius, unsigned int repetitions)
+{
+  using FilterType = itk::MedianImageFilter<TImage, TImage>;
+
+  auto filter = FilterType::New();
+  filter->SetInput(input);
+  filter->SetRadius(radius);
+  const bool automaticHistogram = filter->GetUseHistogramAlgorithm();
+
+  const double numberOfPixels = static_cast<double>(input->GetLargestPossibleRegion().GetNumberOfPixels());
+
+  typename TImage::Pointer outputs[2];
+  double                   throughputs[2];
+  for (const bool useHistogram : { false, true })
+  {
+    filter->SetAlgorithm(useHistogram ? FilterType::AlgorithmEnum::Histogram : FilterType::AlgorithmEnum::Selection);
+    itk::TimeProbe probe;
+    for (unsigned int i = 0; i < repetitions; ++i)
+    {
+      filter->Modified();
+      probe.Start();
+      filter->Update();
+      probe.Stop();
+    }
+    throughputs[useHistogram] = numberOfPixels / probe.GetMinimum() / 1e6;
+
+    outputs[useHistogram] = filter->GetOutput();
+    outputs[useHistogram]->DisconnectPipeline();
+  }
+
+  std::cout << std::setw(8) << name << std::setw(8) << radius << std::setw(12) << throughputs[0] << std::setw(12)
+            << throughputs[1] << std::setw(10) << throughputs[1] / throughputs[0] << std::setw(12)
+            << (automaticHistogram ? "Histogram" : "Selection") << std::endl;
+
+  const auto   numberOfBufferedPixels = outputs[0]->GetBufferedRegion().GetNumberOfPixels();
+  const auto * selection = outputs[0]->GetBufferPointer();
+  const auto * histogram = outputs[1]->GetBufferPointer();
+  const auto   mismatch = std::mismatch(selection, selection + numberOfBufferedPixels, histogram);
+  if (mismatch.first != selection + numberOfBufferedPixels)
+  {
+    std::cerr << name << ": the histogram algorithm computed " << +*mismatch.second << " instead of "
+              << +*mismatch.first << " at offset " << (mismatch.first - selection) << " for radius " << radius
+              << std::endl;
+    return false;
+  }
+  return true;
+}
+} // namespace
+
+int
+itkMedianImageFilterThroughputTest(int argc, char * argv[])
+{
+  if (argc > 4)
+  {
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " [ImageSize] [MaximumRadius] [NumberOfRepetitions]"
+              << std::endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned int size = argc > 1 ? std::stoi(argv[1]) : 32;
+  const unsigned int maximumRadius = argc > 2 ? std::stoi(argv[2]) : 4;
+  const unsigned int repetitions = argc > 3 ? std::stoi(argv[3]) : 3;
+
+  using UInt8ImageType = itk::Image<unsigned char, 3>;
+  using UInt16ImageType = itk::Image<unsigned short, 3>;
+
+  const auto uint8Input = CreateImage<UInt8ImageType>(size);
+  const auto uint16Input = CreateImage<UInt16ImageType>(size);
+
+  std::cout << "Throughput (Mpixel/s) on " << size << "^3 images" << std::endl;
+  std::cout << std::setw(8) << "Pixel" << std::setw(8) << "Radius" << std::setw(12) << "Selection" << std::setw(12)
+            << "Histogram" << std::setw(10) << "Speedup" << std::setw(12) << "Automatic" << std::endl;
+
+  bool success = true;
+  for (unsigned int radius = 1; radius <= maximumRadius; ++radius)
+  {
+    success &= MeasureThroughput("uint8", uint8Input.GetPointer(), radius, repetitions);
+  }
+  for (unsigned int radius = 1; radius <= maximumRadius; ++radius)
+  {
+    success &= MeasureThroughput("uint16", uint16Input.GetPointer(), radius, repetitions);
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return success ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,148 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+// First include the header file to be tested:
+#include "itkRecursiveGaussianImageFilter.h"
+
+#include "itkImage.h"
+#include "itkImageBufferRange.h"
+#include "itkImageRegionRange.h"
+#include "itkIndexRange.h"
+
+#include <random>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using FilterType = itk::RecursiveGaussianImageFilter<ImageType, ImageType>;
+
+
+// Creates a test image, filled with random pixel values.
+ImageType::Pointer
+CreateImageFilledWithRandomPixelValues(const ImageType::RegionType & imageRegion)
+{
+  const auto image = ImageType::New();
+  image->SetRegions(imageRegion);
+  image->Allocate();
+
+  std::mt19937                          randomNumberEngine;
+  std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+  for (auto & pixel : itk::ImageBufferRange<ImageType>{ *image })
+  {
+    pixel = distribution(randomNumberEngine);
+  }
+  return image;
+}
+
+
+// Returns a copy of the image in which the first dimension and the specified dimension are swapped.
+ImageType::Pointer
+SwapDimensions(const ImageType & image, const unsigned int dimension)
+{
+  ImageType::RegionType region = image.GetBufferedRegion();
+  ImageType::IndexType  index = region.GetIndex();
+  ImageType::SizeType   size = region.GetSize();
+  std::swap(index[0], index[dimension]);
+  std::swap(size[0], size[dimension]);
+
+  const auto swappedImage = ImageType::New();
+  swappedImage->SetRegions(ImageType::RegionType(index, size));
+  swappedImage->Allocate();
+  for (const auto & pixelIndex : itk::ImageRegionIndexRange<3>(image.GetBufferedRegion()))
+  {
+    ImageType::IndexType swappedIndex = pixelIndex;
+    std::swap(swappedIndex[0], swappedIndex[dimension]);
+    swappedImage->SetPixel(swappedIndex, image.GetPixel(pixelIndex));
+  }
+  return swappedImage;
+}
+
+
+// Expects that filtering along the specified dimension, which filters blocks of adjacent lines together, gives the
+// same output as filtering along the first dimension, which filters the lines one by one, the image in which both
+// dimensions are swapped.
+void
+Expect_blocks_of_lines_same_output_as_single_lines(const ImageType::RegionType & imageRegion,
+                                                    const ImageType::RegionType & requestedRegion,
+                                                    const unsigned int            dimension,
+                                                    const itk::GaussianOrderEnum  order,
+                                                    const bool                    inPlace)
+{
+  const auto inputImage = CreateImageFilledWithRandomPixelValues(imageRegion);
+  const auto swappedInputImage = SwapDimensions(*inputImage, dimension);
+
+  const auto filter = FilterType::New();
+  filter->SetInput(inputImage);
+  filter->SetDirection(dimension);
+  filter->SetOrder(order);
+  filter->SetSigma(1.5);
+  filter->SetNumberOfWorkUnits(3);
+  filter->SetInPlace(inPlace);
+  filter->GetOutput()->SetRequestedRegion(requestedRegion);
+  filter->Update();
+
+  const auto referenceFilter = FilterType::New();
+  referenceFilter->SetInput(swappedInputImage);
+  referenceFilter->SetDirection(0);
+  referenceFilter->SetOrder(order);
+  referenceFilter->SetSigma(1.5);
+  referenceFilter->Update();
+
+  const ImageType * const output = filter->GetOutput();
+  const ImageType * const referenceOutput = referenceFilter->GetOutput();
+
+  ImageType::RegionType comparedRegion = requestedRegion;
+  comparedRegion.SetIndex(dimension, imageRegion.GetIndex(dimension));
+  comparedRegion.SetSize(dimension, imageRegion.GetSize(dimension));
+  ASSERT_TRUE(output->GetBufferedRegion().IsInside(comparedRegion));
+
+  for (const auto & pixelIndex : itk::ImageRegionIndexRange<3>(comparedRegion))
+  {
+    ImageType::IndexType swappedIndex = pixelIndex;
+    std::swap(swappedIndex[0], swappedIndex[dimension]);
+    EXPECT_NEAR(output->GetPixel(pixelIndex), referenceOutput->GetPixel(swappedIndex), 1e-6);
+  }
+}
+
+} // namespace
+
+
+// Tests that the lines along the dimensions other than the first one, which are filtered in blocks of adjacent
+// lines, have the same output as when they are filtered one by one.
+TEST(RecursiveGaussianImageFilter, BlocksOfLinesSameOutputAsSingleLines)
+{
+  // The size along the first dimension is not a multiple of the number of lines of a block.
+  const ImageType::RegionType imageRegion(ImageType::IndexType{ { 2, -3, 1 } }, ImageType::SizeType{ { 37, 6, 9 } });
+  const ImageType::RegionType requestedRegion(ImageType::IndexType{ { 7, -2, 3 } },
+                                              ImageType::SizeType{ { 20, 4, 5 } });
+
+  for (const unsigned int dimension : { 1, 2 })
+  {
+    for (const auto order :
+         { itk::GaussianOrderEnum::ZeroOrder, itk::GaussianOrderEnum::FirstOrder, itk::GaussianOrderEnum::SecondOrder })
+    {
+      for (const bool inPlace : { false, true })
+      {
+        Expect_blocks_of_lines_same_output_as_single_lines(imageRegion, imageRegion, dimension, order, inPlace);
+        Expect_blocks_of_lines_same_output_as_single_lines(imageRegion, requestedRegion, dimension, order, inPlace);
+      }
+    }
+  }
+}
@@ -118,6 +118,17 @@ public:
   itkGetConstReferenceMacro(UseStreaming, bool);
   itkBooleanMacro(UseStreaming);
 
+  /** Set/Get whether the reader may memory map the file instead of reading
+   * it into a newly allocated buffer. When enabled, and the ImageIO is able
+   * to map the requested data (see ImageIOBase::MemoryMapRead()), the
+   * output pixel container adopts a private copy-on-write mapping of the
+   * file, so that pixels are loaded on demand and the page cache is shared
+   * between processes. Otherwise the file is read as usual. Default is
+   * off. */
+  itkSetMacro(UseMemoryMapping, bool);
+  itkGetConstMacro(UseMemoryMapping, bool);
+  itkBooleanMacro(UseMemoryMapping);
+
 protected:
   ImageFileReader();
   ~ImageFileReader() override = default;
@@ -160,6 +171,8 @@ protected:
 
   bool m_UseStreaming;
 
+  bool m_UseMemoryMapping{ false };
+
 private:
   std::string m_ExceptionMessage;
 
@@ -50,6 +50,7 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::PrintSelf(std::ostream & os,
 
   os << indent << "UserSpecifiedImageIO flag: " << m_UserSpecifiedImageIO << "\n";
   os << indent << "m_UseStreaming: " << m_UseStreaming << "\n";
+  os << indent << "m_UseMemoryMapping: " << m_UseMemoryMapping << "\n";
 }
 
 template <typename TOutputImage, typename ConvertPixelTraits>
@@ -356,9 +357,6 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
                 << "Allocating the buffer with the EnlargedRequestedRegion \n"
                 << output->GetRequestedRegion() << "\n");
 
-  // allocated the output image to the size of the enlarge requested region
-  this->AllocateOutputs();
-
   // Test if the file exists and if it can be opened.
   // An exception will be thrown otherwise, since we can't
   // successfully read the file. We catch the exception because some
@@ -388,8 +386,34 @@ ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
     m_ActualIORegion.GetNumberOfPixels() * (m_ImageIO->GetComponentSize() * m_ImageIO->GetNumberOfComponents());
 
   IOComponentEnum ioType = ImageIOBase::MapPixelType<typename ConvertPixelTraits::ComponentType>::CType;
-  if (m_ImageIO->GetComponentType() != ioType ||
-      (m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents()))
+  const bool      conversionRequired =
+    m_ImageIO->GetComponentType() != ioType ||
+    (m_ImageIO->GetNumberOfComponents() != ConvertPixelTraits::GetNumberOfComponents());
+
+  if (m_UseMemoryMapping && !conversionRequired &&
+      m_ActualIORegion.GetNumberOfPixels() == output->GetRequestedRegion().GetNumberOfPixels())
+  {
+    ImageIOBase::MemoryMappedBufferPointer mappedBuffer = m_ImageIO->MemoryMapRead();
+    if (mappedBuffer)
+    {
+      itkDebugMacro(<< "Adopting memory mapped buffer, no read required.");
+
+      // The pixel container takes ownership of the mapping, and unmaps
+      // the file when the buffer is released.
+      output->SetBufferedRegion(output->GetRequestedRegion());
+      auto unmap = mappedBuffer.get_deleter();
+      output->GetPixelContainer()->SetImportPointer(static_cast<OutputImagePixelType *>(mappedBuffer.release()),
+                                                    sizeOfActualIORegion / sizeof(OutputImagePixelType),
+                                                    [unmap](OutputImagePixelType * buffer) { unmap(buffer); });
+      this->UpdateProgress(1.0f);
+      return;
+    }
+  }
+
+  // allocated the output image to the size of the enlarge requested region
+  this->AllocateOutputs();
+
+  if (conversionRequired)
   {
     // the pixel types don't match so a type conversion needs to be
     // performed
@@ -38,6 +38,8 @@
 #include "vcl_compiler.h"
 
 #include <fstream>
+#include <functional>
+#include <memory>
 #include <string>
 
 namespace itk
@@ -440,6 +442,22 @@ public:
   virtual void
   Read(void * buffer) = 0;
 
+  /** Owning pointer to a memory mapped pixel buffer. The deleter unmaps the
+   * file. */
+  using MemoryMappedBufferPointer = std::unique_ptr<void, std::function<void(void *)>>;
+
+  /** Maps the data of the current IORegion from disk into memory, as an
+   * alternative to Read() that avoids copying. The mapping is private
+   * (copy-on-write): pages are loaded on first access, are shared with the
+   * operating system page cache, and modifications are never written back
+   * to the file. The buffer holds exactly the bytes Read() would produce.
+   * A null pointer is returned when the data cannot be mapped, e.g. when it
+   * is compressed, must be byte swapped, is not contiguous on disk, or when
+   * the ImageIO does not support memory mapping; the caller is then
+   * expected to fall back to Read(). The default returns a null pointer. */
+  virtual MemoryMappedBufferPointer
+  MemoryMapRead();
+
   /*-------- This part of the interfaces deals with writing data ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -860,6 +878,20 @@ protected:
   bool
   ReadBufferAsBinary(std::istream & is, void * buffer, SizeType num);
 
+  /** Convenient method to memory map the current IORegion from a file
+   * which stores the whole image uncompressed and contiguously, starting
+   * at byte dataOffset. Returns a null pointer when the IORegion is not
+   * contiguous in the file, when the mapped components would not be
+   * properly aligned in memory, or when the file cannot be mapped. */
+  MemoryMappedBufferPointer
+  MemoryMapIORegion(const std::string & fileName, SizeType dataOffset) const;
+
+  /** Memory map numberOfBytes bytes of a file, starting at byte offset, as
+   * a private copy-on-write mapping. Returns a null pointer on failure, or
+   * when memory mapping is not supported by the platform. */
+  static MemoryMappedBufferPointer
+  MemoryMapFile(const std::string & fileName, SizeType offset, SizeType numberOfBytes);
+
   /** Insert an extension to the list of supported extensions for reading. */
   void
   AddSupportedReadExtension(const char * extension);
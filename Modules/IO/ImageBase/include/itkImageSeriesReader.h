@@ -20,6 +20,8 @@
 #include "ITKIOImageBaseExport.h"
 
 #include "itkSize.h"
+#include <future>
+#include <memory>
 #include <vector>
 #include <string>
 #include "itkMetaDataDictionary.h"
@@ -35,6 +37,13 @@ namespace itk
  * the files, but the image data must have the same Size for all
  * dimensions.
  *
+ * The files are read sequentially by default. With
+ * NumberOfParallelReads greater than one, several files are read
+ * concurrently, each directly in its slice of the output buffer. With
+ * UsePrefetching on, when the output is streamed in slabs of slices,
+ * the slab following the requested one is read in the background while
+ * the downstream filters process the current slab.
+ *
  * \sa GDCMSeriesFileNames
  * \sa NumericSeriesFileNames
  * \ingroup IOFilters
@@ -173,6 +182,21 @@ public:
   itkSetMacro(SpacingWarningRelThreshold, double);
   itkGetConstMacro(SpacingWarningRelThreshold, double);
 
+  /** Set/Get the number of files read concurrently. The default of one
+   * reads the files sequentially. Each file read concurrently has its own
+   * ImageIO: when an ImageIO is set, it is duplicated with CreateAnother(),
+   * which does not copy its settings. */
+  itkSetClampMacro(NumberOfParallelReads, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfParallelReads, unsigned int);
+
+  /** Set/Get whether the slab of slices following the requested region
+   * is read in the background, when streaming. The next execution uses
+   * the slab when it requests it, and the reader has not been modified
+   * since. Off by default. */
+  itkSetMacro(UsePrefetching, bool);
+  itkGetConstMacro(UsePrefetching, bool);
+  itkBooleanMacro(UsePrefetching);
+
 protected:
   ImageSeriesReader()
     : m_ImageIO(nullptr)
@@ -215,17 +239,72 @@ protected:
 
   double m_SpacingWarningRelThreshold{ 1e-4 };
 
+  unsigned int m_NumberOfParallelReads{ 1 };
+
+  bool m_UsePrefetching{ false };
+
 private:
   using ReaderType = ImageFileReader<TOutputImage>;
 
+  /** The settings of the reading of the slices, copied so that a slab
+   * can be read in the background while the reader is modified. */
+  struct SliceReadSettings
+  {
+    FileNamesContainer   FileNames;
+    ImageIOBase::Pointer ImageIO;
+    bool                 ReverseOrder;
+    bool                 UseStreaming;
+    unsigned int         NumberOfDimensionsInImage;
+    unsigned int         NumberOfParallelReads;
+    bool                 DuplicateImageIO;
+  };
+
+  /** What is known of a file after the reading of the slices. */
+  struct SliceInformation
+  {
+    bool                             Visited{ false };
+    bool                             Read{ false };
+    typename TOutputImage::PointType Origin;
+    std::unique_ptr<DictionaryType>  Dictionary;
+  };
+  using SliceInformationContainer = std::vector<SliceInformation>;
+
+  /** A slab read in the background. */
+  struct SlabType
+  {
+    typename TOutputImage::Pointer Image;
+    SliceInformationContainer      Slices;
+  };
+
   int
   ComputeMovingDimensionIndex(ReaderType * reader);
 
+  /** Read the slices of the files intersecting the buffered region of
+   * image, which must be allocated, and only the information of the other
+   * files when visitAllFiles is true. The dictionaries of the files are
+   * kept when keepDictionaries is true. */
+  void
+  ReadSlices(const SliceReadSettings &   settings,
+             TOutputImage *              image,
+             bool                        visitAllFiles,
+             bool                        keepDictionaries,
+             SliceInformationContainer & slices,
+             ProcessObject *             filter) const;
+
+  /** Start the reading of the region in the background. */
+  void
+  PrefetchRegion(const ImageRegionType & region);
+
   /** Modified time of the MetaDataDictionaryArray */
   TimeStamp m_MetaDataDictionaryArrayMTime;
 
   /** Indicated if the MMDA should be updated */
   bool m_MetaDataDictionaryArrayUpdate{ true };
+
+  /** The slab read in the background, and the modified time of the
+   * reader when the reading started. */
+  std::future<SlabType> m_Prefetch;
+  ModifiedTimeType      m_PrefetchMTime{ 0 };
 };
 } // namespace itk
 
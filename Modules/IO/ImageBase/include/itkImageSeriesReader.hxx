@@ -25,6 +25,9 @@
 #include "itkMath.h"
 #include "itkProgressReporter.h"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTotalProgressReporter.h"
+#include <algorithm>
 #include <iomanip>
 
 namespace itk
@@ -33,6 +36,12 @@ namespace itk
 template <typename TOutputImage>
 ImageSeriesReader<TOutputImage>::~ImageSeriesReader()
 {
+  // The slab read in the background uses the reader
+  if (m_Prefetch.valid())
+  {
+    m_Prefetch.wait();
+  }
+
   // Clear the eventual previous content of the MetaDictionary array
   if (!m_MetaDataDictionaryArray.empty())
   {
@@ -54,6 +63,8 @@ ImageSeriesReader<TOutputImage>::PrintSelf(std::ostream & os, Indent indent) con
   os << indent << "ReverseOrder: " << m_ReverseOrder << std::endl;
   os << indent << "ForceOrthogonalDirection: " << m_ForceOrthogonalDirection << std::endl;
   os << indent << "UseStreaming: " << m_UseStreaming << std::endl;
+  os << indent << "NumberOfParallelReads: " << m_NumberOfParallelReads << std::endl;
+  os << indent << "UsePrefetching: " << m_UsePrefetching << std::endl;
 
   itkPrintSelfObjectMacro(ImageIO);
 
@@ -258,31 +269,8 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 {
   TOutputImage * output = this->GetOutput();
 
-  ImageRegionType requestedRegion = output->GetRequestedRegion();
-  ImageRegionType largestRegion = output->GetLargestPossibleRegion();
-  ImageRegionType sliceRegionToRequest = output->GetRequestedRegion();
-
-  // Each file must have the same size.
-  SizeType validSize = largestRegion.GetSize();
-
-  // If more than one file is being read, then the input dimension
-  // will be less than the output dimension.  In this case, set
-  // the last dimension that is other than 1 of validSize to 1.  However, if the
-  // input and output have the same number of dimensions, this should
-  // not be done because it will lower the dimension of the output image.
-  if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-  {
-    validSize[this->m_NumberOfDimensionsInImage] = 1;
-    sliceRegionToRequest.SetSize(this->m_NumberOfDimensionsInImage, 1);
-    sliceRegionToRequest.SetIndex(this->m_NumberOfDimensionsInImage, 0);
-  }
-
-  // Allocate the output buffer
-  output->SetBufferedRegion(requestedRegion);
-  output->Allocate();
-
-  // progress reported on a per slice basis
-  ProgressReporter progress(this, 0, requestedRegion.GetSize(TOutputImage::ImageDimension - 1), 100);
+  const ImageRegionType requestedRegion = output->GetRequestedRegion();
+  const ImageRegionType largestRegion = output->GetLargestPossibleRegion();
 
   // We utilize the modified time of the output information to
   // know when the meta array needs to be updated, when the output
@@ -292,44 +280,238 @@ ImageSeriesReader<TOutputImage>::GenerateData()
   bool needToUpdateMetaDataDictionaryArray =
     this->m_OutputInformationMTime > this->m_MetaDataDictionaryArrayMTime && m_MetaDataDictionaryArrayUpdate;
 
-  typename TOutputImage::InternalPixelType * outputBuffer = output->GetBufferPointer();
-  IndexType                                  sliceStartIndex = requestedRegion.GetIndex();
-  const auto                                 numberOfFiles = static_cast<int>(m_FileNames.size());
+  // Use the slab read in the background when it is the requested region,
+  // and it was read with the current settings. Otherwise it is read again,
+  // which reports the errors of the reading in the background.
+  SliceInformationContainer slices;
+  bool                      prefetched = false;
+  if (m_Prefetch.valid())
+  {
+    try
+    {
+      SlabType slab = m_Prefetch.get();
+      if (slab.Image->GetBufferedRegion() == requestedRegion && m_PrefetchMTime == this->GetMTime() &&
+          !needToUpdateMetaDataDictionaryArray)
+      {
+        output->SetBufferedRegion(requestedRegion);
+        output->SetPixelContainer(slab.Image->GetPixelContainer());
+        slices = std::move(slab.Slices);
+        prefetched = true;
+      }
+    }
+    catch (const ExceptionObject &)
+    {}
+  }
+
+  if (prefetched)
+  {
+    this->UpdateProgress(1.0f);
+  }
+  else
+  {
+    // Allocate the output buffer
+    output->SetBufferedRegion(requestedRegion);
+    output->Allocate();
+
+    const SliceReadSettings settings{ m_FileNames,
+                                      m_ImageIO,
+                                      m_ReverseOrder,
+                                      m_UseStreaming,
+                                      m_NumberOfDimensionsInImage,
+                                      m_NumberOfParallelReads,
+                                      m_NumberOfParallelReads > 1 };
+
+    // The dictionaries of the files read are needed when non uniform
+    // sampling is detected
+    this->ReadSlices(settings,
+                     output,
+                     needToUpdateMetaDataDictionaryArray,
+                     needToUpdateMetaDataDictionaryArray || this->m_SpacingDefined,
+                     slices,
+                     this);
+  }
 
   typename TOutputImage::PointType   prevSliceOrigin = output->GetOrigin();
   typename TOutputImage::SpacingType outputSpacing = output->GetSpacing();
   double                             maxSpacingDeviation = 0.0;
   bool                               prevSliceIsValid = false;
 
-  for (int i = 0; i != numberOfFiles; ++i)
+  for (SliceInformation & slice : slices)
   {
-    if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+    if (!slice.Visited)
+    {
+      continue;
+    }
+
+    bool   nonUniformSampling = false;
+    double spacingDeviation = 0.0;
+
+    if (slice.Read)
+    {
+      // verify that slice spacing is the expected one
+      // since we can be skipping some slices because they are outside of requested region
+      // I am using additional variable
+      if (prevSliceIsValid)
+      {
+        const typename TOutputImage::PointType & sliceOrigin = slice.Origin;
+        using SpacingScalarType = typename TOutputImage::SpacingValueType;
+        Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
+        for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
+        {
+          dirN[j] = static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
+        }
+        SpacingScalarType dirNnorm = dirN.GetNorm();
+
+        if (this->m_SpacingDefined &&
+            !Math::AlmostEquals(
+              dirNnorm,
+              outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
+        {
+          nonUniformSampling = true;
+          spacingDeviation = itk::Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
+          if (spacingDeviation > maxSpacingDeviation)
+          {
+            maxSpacingDeviation = spacingDeviation;
+          }
+
+          needToUpdateMetaDataDictionaryArray = true;
+        }
+        prevSliceOrigin = sliceOrigin;
+      }
+      else
+      {
+        prevSliceOrigin = slice.Origin;
+        prevSliceIsValid = true;
+      }
+    }
+
+    // Move the deep copy of the MetaDataDictionary into the array
+    if (slice.Dictionary && needToUpdateMetaDataDictionaryArray)
     {
-      sliceStartIndex[this->m_NumberOfDimensionsInImage] = i;
+      if (nonUniformSampling)
+      {
+        // slice-specific information
+        EncapsulateMetaData<double>(*slice.Dictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
+      }
+      m_MetaDataDictionaryArray.push_back(slice.Dictionary.release());
+    }
+  } // end per slice loop
+
+
+  if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage &&
+      maxSpacingDeviation > m_SpacingWarningRelThreshold * outputSpacing[this->m_NumberOfDimensionsInImage])
+  {
+    itkWarningMacro(<< "Non uniform sampling or missing slices detected,  maximum nonuniformity:"
+                    << maxSpacingDeviation);
+  }
+  if (maxSpacingDeviation > 0.0)
+  {
+    EncapsulateMetaData<double>(output->GetMetaDataDictionary(),
+                                "ITK_non_uniform_sampling_deviation",
+                                maxSpacingDeviation); // maximum deviation
+  }
+
+
+  // update the time if we modified the meta array
+  if (needToUpdateMetaDataDictionaryArray)
+  {
+    m_MetaDataDictionaryArrayMTime.Modified();
+  }
+
+  // When streaming slabs of slices, the next slab is likely requested next
+  if (m_UsePrefetching && m_UseStreaming && TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+  {
+    const unsigned int   movingDimension = this->m_NumberOfDimensionsInImage;
+    const IndexValueType nextIndex =
+      requestedRegion.GetIndex(movingDimension) + static_cast<IndexValueType>(requestedRegion.GetSize(movingDimension));
+    const IndexValueType largestEnd =
+      largestRegion.GetIndex(movingDimension) + static_cast<IndexValueType>(largestRegion.GetSize(movingDimension));
+    if (nextIndex < largestEnd)
+    {
+      ImageRegionType nextRegion = requestedRegion;
+      nextRegion.SetIndex(movingDimension, nextIndex);
+      nextRegion.SetSize(movingDimension,
+                         std::min(requestedRegion.GetSize(movingDimension),
+                                  static_cast<SizeValueType>(largestEnd - nextIndex)));
+      this->PrefetchRegion(nextRegion);
+    }
+  }
+}
+
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::ReadSlices(const SliceReadSettings &   settings,
+                                            TOutputImage *              image,
+                                            bool                        visitAllFiles,
+                                            bool                        keepDictionaries,
+                                            SliceInformationContainer & slices,
+                                            ProcessObject *             filter) const
+{
+  const ImageRegionType requestedRegion = image->GetBufferedRegion();
+  const ImageRegionType largestRegion = image->GetLargestPossibleRegion();
+  ImageRegionType       sliceRegionToRequest = requestedRegion;
+  const unsigned int    numberOfDimensionsInImage = settings.NumberOfDimensionsInImage;
+
+  // Each file must have the same size.
+  SizeType validSize = largestRegion.GetSize();
+
+  // If more than one file is being read, then the input dimension
+  // will be less than the output dimension.  In this case, set
+  // the last dimension that is other than 1 of validSize to 1.  However, if the
+  // input and output have the same number of dimensions, this should
+  // not be done because it will lower the dimension of the output image.
+  if (TOutputImage::ImageDimension != numberOfDimensionsInImage)
+  {
+    validSize[numberOfDimensionsInImage] = 1;
+    sliceRegionToRequest.SetSize(numberOfDimensionsInImage, 1);
+    sliceRegionToRequest.SetIndex(numberOfDimensionsInImage, 0);
+  }
+
+  const auto numberOfFiles = static_cast<int>(settings.FileNames.size());
+  slices.clear();
+  slices.resize(numberOfFiles);
+
+  // progress reported on a per slice basis
+  const SizeValueType numberOfSlicesToRead = requestedRegion.GetSize(TOutputImage::ImageDimension - 1);
+
+  typename TOutputImage::InternalPixelType * outputBuffer = image->GetBufferPointer();
+
+  const auto readSlice = [&](SizeValueType fileIndex) {
+    const auto i = static_cast<int>(fileIndex);
+    IndexType  sliceStartIndex = requestedRegion.GetIndex();
+    if (TOutputImage::ImageDimension != numberOfDimensionsInImage)
+    {
+      sliceStartIndex[numberOfDimensionsInImage] = i;
     }
 
     const bool insideRequestedRegion = requestedRegion.IsInside(sliceStartIndex);
-    const int  iFileName = (m_ReverseOrder ? numberOfFiles - i - 1 : i);
-    bool       nonUniformSampling = false;
-    double     spacingDeviation = 0.0;
+    const int  iFileName = (settings.ReverseOrder ? numberOfFiles - i - 1 : i);
 
     // check if we need this slice
-    if (!insideRequestedRegion && !needToUpdateMetaDataDictionaryArray)
+    if (!insideRequestedRegion && !visitAllFiles)
     {
-      continue;
+      return;
     }
 
     // configure reader
     auto reader = ReaderType::New();
-    reader->SetFileName(m_FileNames[iFileName].c_str());
+    reader->SetFileName(settings.FileNames[iFileName].c_str());
 
     TOutputImage * readerOutput = reader->GetOutput();
 
-    if (m_ImageIO)
+    if (settings.ImageIO)
     {
-      reader->SetImageIO(m_ImageIO);
+      if (settings.DuplicateImageIO)
+      {
+        // an ImageIO cannot read several files at once
+        reader->SetImageIO(dynamic_cast<ImageIOBase *>(settings.ImageIO->CreateAnother().GetPointer()));
+      }
+      else
+      {
+        reader->SetImageIO(settings.ImageIO);
+      }
     }
-    reader->SetUseStreaming(m_UseStreaming);
+    reader->SetUseStreaming(settings.UseStreaming);
     readerOutput->SetRequestedRegion(sliceRegionToRequest);
 
     // update the data or info
@@ -339,6 +521,8 @@ ImageSeriesReader<TOutputImage>::GenerateData()
     }
     else
     {
+      TotalProgressReporter progress(filter, numberOfSlicesToRead);
+
       // read the meta data information
       readerOutput->UpdateOutputInformation();
 
@@ -349,10 +533,10 @@ ImageSeriesReader<TOutputImage>::GenerateData()
       // check that the size of each slice is the same
       if (readerOutput->GetLargestPossibleRegion().GetSize() != validSize)
       {
-        itkExceptionMacro(<< "Size mismatch! The size of  " << m_FileNames[iFileName].c_str() << " is "
+        itkExceptionMacro(<< "Size mismatch! The size of  " << settings.FileNames[iFileName].c_str() << " is "
                           << readerOutput->GetLargestPossibleRegion().GetSize()
                           << " and does not match the required size " << validSize << " from file "
-                          << m_FileNames[m_ReverseOrder ? numberOfFiles - 1 : 0].c_str());
+                          << settings.FileNames[settings.ReverseOrder ? numberOfFiles - 1 : 0].c_str());
       }
 
       // get the size of the region to be read
@@ -367,11 +551,11 @@ ImageSeriesReader<TOutputImage>::GenerateData()
         const size_t numberOfPixelsInSlice = sliceRegionToRequest.GetNumberOfPixels();
 
         using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
-        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(output);
+        const size_t numberOfInternalComponentsPerPixel = AccessorFunctorType::GetVectorLength(image);
 
 
-        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
-                                        ? (i - requestedRegion.GetIndex(this->m_NumberOfDimensionsInImage))
+        const ptrdiff_t sliceOffset = (TOutputImage::ImageDimension != numberOfDimensionsInImage)
+                                        ? (i - requestedRegion.GetIndex(numberOfDimensionsInImage))
                                         : 0;
 
         const ptrdiff_t numberOfPixelComponentsUpToSlice =
@@ -380,7 +564,7 @@ ImageSeriesReader<TOutputImage>::GenerateData()
 
         typename TOutputImage::InternalPixelType * outputSliceBuffer = outputBuffer + numberOfPixelComponentsUpToSlice;
 
-        if (strcmp(output->GetNameOfClass(), "VectorImage") == 0)
+        if (strcmp(image->GetNameOfClass(), "VectorImage") == 0)
         {
           // if the input image type is a vector image then the number
           // of components needs to be set for the size
@@ -409,88 +593,77 @@ ImageSeriesReader<TOutputImage>::GenerateData()
         outRegion.SetIndex(sliceStartIndex);
 
         // set the moving dimension to a size of 1
-        if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage)
+        if (TOutputImage::ImageDimension != numberOfDimensionsInImage)
         {
-          outRegion.SetSize(this->m_NumberOfDimensionsInImage, 1);
+          outRegion.SetSize(numberOfDimensionsInImage, 1);
         }
 
-        ImageAlgorithm::Copy(readerOutput, output, sliceRegionToRequest, outRegion);
+        ImageAlgorithm::Copy(readerOutput, image, sliceRegionToRequest, outRegion);
       }
 
-      // verify that slice spacing is the expected one
-      // since we can be skipping some slices because they are outside of requested region
-      // I am using additional variable
-      if (prevSliceIsValid)
-      {
-        typename TOutputImage::PointType sliceOrigin = readerOutput->GetOrigin();
-        using SpacingScalarType = typename TOutputImage::SpacingValueType;
-        Vector<SpacingScalarType, TOutputImage::ImageDimension> dirN;
-        for (size_t j = 0; j < TOutputImage::ImageDimension; ++j)
-        {
-          dirN[j] = static_cast<SpacingScalarType>(sliceOrigin[j]) - static_cast<SpacingScalarType>(prevSliceOrigin[j]);
-        }
-        SpacingScalarType dirNnorm = dirN.GetNorm();
-
-        if (this->m_SpacingDefined &&
-            !Math::AlmostEquals(
-              dirNnorm,
-              outputSpacing[this->m_NumberOfDimensionsInImage])) // either non-uniform sampling or missing slice
-        {
-          nonUniformSampling = true;
-          spacingDeviation = itk::Math::abs(outputSpacing[this->m_NumberOfDimensionsInImage] - dirNnorm);
-          if (spacingDeviation > maxSpacingDeviation)
-          {
-            maxSpacingDeviation = spacingDeviation;
-          }
-
-          needToUpdateMetaDataDictionaryArray = true;
-        }
-        prevSliceOrigin = sliceOrigin;
-      }
-      else
-      {
-        prevSliceOrigin = readerOutput->GetOrigin();
-        prevSliceIsValid = true;
-      }
+      slices[i].Read = true;
+      slices[i].Origin = readerOutput->GetOrigin();
 
       // report progress for read slices
       progress.CompletedPixel();
     } // end !insidedRequestedRegion
 
-    // Deep copy the MetaDataDictionary into the array
-    if (reader->GetImageIO() && needToUpdateMetaDataDictionaryArray)
+    // Deep copy the MetaDataDictionary
+    if (reader->GetImageIO() && keepDictionaries)
     {
-      auto newDictionary = new DictionaryType;
-      *newDictionary = reader->GetImageIO()->GetMetaDataDictionary();
-      if (nonUniformSampling)
-      {
-        // slice-specific information
-        EncapsulateMetaData<double>(*newDictionary, "ITK_non_uniform_sampling_deviation", spacingDeviation);
-      }
-      m_MetaDataDictionaryArray.push_back(newDictionary);
+      slices[i].Dictionary.reset(new DictionaryType(reader->GetImageIO()->GetMetaDataDictionary()));
     }
-  } // end per slice loop
-
+    slices[i].Visited = true;
+  };
 
-  if (TOutputImage::ImageDimension != this->m_NumberOfDimensionsInImage &&
-      maxSpacingDeviation > m_SpacingWarningRelThreshold * outputSpacing[this->m_NumberOfDimensionsInImage])
+  if (settings.NumberOfParallelReads > 1)
   {
-    itkWarningMacro(<< "Non uniform sampling or missing slices detected,  maximum nonuniformity:"
-                    << maxSpacingDeviation);
+    // each slice is read in its own part of the buffer
+    const MultiThreaderBase::Pointer multiThreader = MultiThreaderBase::New();
+    multiThreader->SetNumberOfWorkUnits(settings.NumberOfParallelReads);
+    multiThreader->ParallelizeArray(0, numberOfFiles, readSlice, nullptr);
   }
-  if (maxSpacingDeviation > 0.0)
+  else
   {
-    EncapsulateMetaData<double>(output->GetMetaDataDictionary(),
-                                "ITK_non_uniform_sampling_deviation",
-                                maxSpacingDeviation); // maximum deviation
+    for (int i = 0; i != numberOfFiles; ++i)
+    {
+      readSlice(i);
+    }
   }
+}
 
-
-  // update the time if we modified the meta array
-  if (needToUpdateMetaDataDictionaryArray)
-  {
-    m_MetaDataDictionaryArrayMTime.Modified();
-  }
+template <typename TOutputImage>
+void
+ImageSeriesReader<TOutputImage>::PrefetchRegion(const ImageRegionType & region)
+{
+  const TOutputImage * output = this->GetOutput();
+
+  auto image = TOutputImage::New();
+  image->CopyInformation(output);
+  using AccessorFunctorType = typename TOutputImage::AccessorFunctorType;
+  AccessorFunctorType::SetVectorLength(image, AccessorFunctorType::GetVectorLength(output));
+  image->SetRequestedRegion(region);
+  image->SetBufferedRegion(region);
+
+  // The ImageIO is always duplicated, since the reader may use it while
+  // the slab is read
+  const SliceReadSettings settings{ m_FileNames,
+                                    m_ImageIO,
+                                    m_ReverseOrder,
+                                    m_UseStreaming,
+                                    m_NumberOfDimensionsInImage,
+                                    m_NumberOfParallelReads,
+                                    true };
+  const bool keepDictionaries = this->m_SpacingDefined;
+
+  m_PrefetchMTime = this->GetMTime();
+  m_Prefetch = std::async(std::launch::async, [this, settings, image, keepDictionaries]() {
+    image->Allocate();
+    SlabType slab;
+    slab.Image = image;
+    this->ReadSlices(settings, image, false, keepDictionaries, slab.Slices, nullptr);
+    return slab;
+  });
 }
 
 template <typename TOutputImage>
@@ -18,10 +18,20 @@
 
 #include "itkImageIOBase.h"
 #include "itkImageRegionSplitterSlowDimension.h"
+#include <algorithm>
 #include <mutex>
 #include "itksys/SystemTools.hxx"
 #include "itkPrintHelper.h"
 
+#if defined(_WIN32)
+#  include "itkWindows.h"
+#  include "itksys/Encoding.hxx"
+#else
+#  include <fcntl.h>
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
 
 namespace itk
 {
@@ -323,6 +333,126 @@ ImageIOBase::ReadBufferAsBinary(std::istream & is, void * buffer, ImageIOBase::S
   return true;
 }
 
+ImageIOBase::MemoryMappedBufferPointer
+ImageIOBase::MemoryMapRead()
+{
+  return nullptr;
+}
+
+ImageIOBase::MemoryMappedBufferPointer
+ImageIOBase::MemoryMapIORegion(const std::string & fileName, SizeType dataOffset) const
+{
+  // The IORegion maps to a single block of the file when every dimension
+  // below some dimension k spans the whole image, and every dimension
+  // above k has a size of one.
+  const unsigned int regionDimension = m_IORegion.GetImageDimension();
+  const SizeType     pixelSize = this->GetPixelSize();
+  SizeType           regionOffset = 0;
+  SizeType           stride = pixelSize;
+  bool               spansImage = true;
+  for (unsigned int i = 0; i < std::max(regionDimension, m_NumberOfDimensions); ++i)
+  {
+    const ImageIORegion::IndexValueType index = (i < regionDimension) ? m_IORegion.GetIndex(i) : 0;
+    const ImageIORegion::SizeValueType  size = (i < regionDimension) ? m_IORegion.GetSize(i) : 1;
+    const SizeValueType                 dimension = (i < m_NumberOfDimensions) ? m_Dimensions[i] : 1;
+    if (index < 0 || (!spansImage && size != 1))
+    {
+      return nullptr;
+    }
+    spansImage = spansImage && (index == 0 && size == dimension);
+    regionOffset += static_cast<SizeType>(index) * stride;
+    stride *= static_cast<SizeType>(dimension);
+  }
+
+  const SizeType numberOfBytes = static_cast<SizeType>(m_IORegion.GetNumberOfPixels()) * pixelSize;
+  const SizeType fileOffset = dataOffset + regionOffset;
+  if (numberOfBytes == 0 || fileOffset % this->GetComponentSize() != 0)
+  {
+    return nullptr;
+  }
+  return MemoryMapFile(fileName, fileOffset, numberOfBytes);
+}
+
+ImageIOBase::MemoryMappedBufferPointer
+ImageIOBase::MemoryMapFile(const std::string & fileName, SizeType offset, SizeType numberOfBytes)
+{
+  if (numberOfBytes == 0)
+  {
+    return nullptr;
+  }
+#if defined(_WIN32)
+  SYSTEM_INFO systemInfo;
+  GetSystemInfo(&systemInfo);
+  const SizeType alignedOffset = offset - offset % systemInfo.dwAllocationGranularity;
+  const SizeType mappedBytes = numberOfBytes + (offset - alignedOffset);
+
+  const HANDLE file = CreateFileW(itksys::Encoding::ToWindowsExtendedPath(fileName).c_str(),
+                                  GENERIC_READ,
+                                  FILE_SHARE_READ,
+                                  nullptr,
+                                  OPEN_EXISTING,
+                                  FILE_ATTRIBUTE_NORMAL,
+                                  nullptr);
+  if (file == INVALID_HANDLE_VALUE)
+  {
+    return nullptr;
+  }
+  LARGE_INTEGER fileSize;
+  if (!GetFileSizeEx(file, &fileSize) || static_cast<SizeType>(fileSize.QuadPart) < offset + numberOfBytes)
+  {
+    CloseHandle(file);
+    return nullptr;
+  }
+  const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+  CloseHandle(file);
+  if (mapping == nullptr)
+  {
+    return nullptr;
+  }
+  void * base = MapViewOfFile(mapping,
+                              FILE_MAP_COPY,
+                              static_cast<DWORD>(static_cast<uint64_t>(alignedOffset) >> 32),
+                              static_cast<DWORD>(alignedOffset & 0xFFFFFFFF),
+                              static_cast<SIZE_T>(mappedBytes));
+  // The view keeps a reference to the mapping object.
+  CloseHandle(mapping);
+  if (base == nullptr)
+  {
+    return nullptr;
+  }
+  return MemoryMappedBufferPointer(static_cast<char *>(base) + (offset - alignedOffset),
+                                   [base](void *) { UnmapViewOfFile(base); });
+#else
+  const auto     pageSize = static_cast<SizeType>(sysconf(_SC_PAGESIZE));
+  const SizeType alignedOffset = offset - offset % pageSize;
+  const SizeType mappedBytes = numberOfBytes + (offset - alignedOffset);
+
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return nullptr;
+  }
+  const off_t fileSize = lseek(fd, 0, SEEK_END);
+  if (fileSize < 0 || static_cast<SizeType>(fileSize) < offset + numberOfBytes)
+  {
+    close(fd);
+    return nullptr;
+  }
+  // A private writable mapping gives copy-on-write semantics, so that
+  // in-place filters may modify the buffer without touching the file.
+  void * base = mmap(
+    nullptr, static_cast<size_t>(mappedBytes), PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, static_cast<off_t>(alignedOffset));
+  // The mapping stays valid after the file descriptor is closed.
+  close(fd);
+  if (base == MAP_FAILED)
+  {
+    return nullptr;
+  }
+  return MemoryMappedBufferPointer(static_cast<char *>(base) + (offset - alignedOffset),
+                                   [base, mappedBytes](void *) { munmap(base, static_cast<size_t>(mappedBytes)); });
+#endif
+}
+
 unsigned int
 ImageIOBase::GetPixelSize() const
 {
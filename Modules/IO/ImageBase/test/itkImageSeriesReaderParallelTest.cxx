@@ -0,0 +1,218 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageSeriesReader.h"
+#include "itkMetaImageIO.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTestingMacros.h"
+
+// Parallel reads of the slices of a series, and prefetching of the slabs
+// when streaming
+
+namespace
+{
+using ImageType = itk::Image<float, 3>;
+using ReaderType = itk::ImageSeriesReader<ImageType>;
+
+float
+ExpectedValue(const ImageType::IndexType & index)
+{
+  return static_cast<float>(index[0] + 100 * index[1] + 10000 * index[2]);
+}
+
+bool
+CheckImage(const ImageType * image, const ImageType::RegionType & region, bool reversed = false)
+{
+  if (!image->GetBufferedRegion().IsInside(region))
+  {
+    std::cerr << "The buffered region " << image->GetBufferedRegion() << " does not contain " << region << std::endl;
+    return false;
+  }
+  const auto lastSlice = static_cast<itk::IndexValueType>(image->GetLargestPossibleRegion().GetSize(2) - 1);
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    ImageType::IndexType index = it.GetIndex();
+    if (reversed)
+    {
+      index[2] = lastSlice - index[2];
+    }
+    if (itk::Math::NotExactlyEquals(it.Get(), ExpectedValue(index)))
+    {
+      std::cerr << "Read " << it.Get() << " instead of " << ExpectedValue(index) << " at " << it.GetIndex()
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageSeriesReaderParallelTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " <TempOutputDirectory>" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Slices 2.5 apart, stored as volumes of one slice
+  constexpr unsigned int         numberOfSlices = 12;
+  ReaderType::FileNamesContainer fileNames;
+  for (unsigned int z = 0; z < numberOfSlices; ++z)
+  {
+    const ImageType::SizeType size = { { 33, 17, 1 } };
+    ImageType::PointType      origin;
+    origin.Fill(0.0);
+    origin[2] = 2.5 * z;
+
+    auto slice = ImageType::New();
+    slice->SetRegions(size);
+    slice->SetOrigin(origin);
+    slice->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<ImageType> it(slice, slice->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+    {
+      ImageType::IndexType index = it.GetIndex();
+      index[2] = z;
+      it.Set(ExpectedValue(index));
+    }
+
+    fileNames.push_back(std::string(argv[1]) + "/itkImageSeriesReaderParallelTest" + std::to_string(z) + ".mha");
+    ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(slice, fileNames.back()));
+  }
+
+  int testStatus = EXIT_SUCCESS;
+
+  auto reader = ReaderType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(reader, ImageSeriesReader, ImageSource);
+  ITK_TEST_EXPECT_EQUAL(reader->GetNumberOfParallelReads(), 1u);
+  ITK_TEST_EXPECT_TRUE(!reader->GetUsePrefetching());
+
+  // Sequential and parallel reads, with an ImageIO which is duplicated for
+  // the parallel reads
+  for (const unsigned int numberOfParallelReads : { 1u, 4u, 20u })
+  {
+    for (const bool setImageIO : { false, true })
+    {
+      std::cout << "Reading with " << numberOfParallelReads << " parallel reads" << std::endl;
+      reader = ReaderType::New();
+      reader->SetFileNames(fileNames);
+      reader->SetNumberOfParallelReads(numberOfParallelReads);
+      ITK_TEST_SET_GET_VALUE(numberOfParallelReads, reader->GetNumberOfParallelReads());
+      if (setImageIO)
+      {
+        reader->SetImageIO(itk::MetaImageIO::New());
+      }
+      ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+      const ImageType * output = reader->GetOutput();
+      ITK_TEST_EXPECT_EQUAL(output->GetSpacing()[2], 2.5);
+      ITK_TEST_EXPECT_EQUAL(reader->GetMetaDataDictionaryArray()->size(), numberOfSlices);
+      if (!CheckImage(output, output->GetLargestPossibleRegion()))
+      {
+        testStatus = EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The non uniform sampling is detected as in sequential reads
+  {
+    ReaderType::FileNamesContainer duplicatedFileNames = fileNames;
+    duplicatedFileNames.insert(duplicatedFileNames.begin() + 5, fileNames[5]);
+
+    reader = ReaderType::New();
+    reader->SetFileNames(duplicatedFileNames);
+    reader->SetNumberOfParallelReads(3);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+    double maxSamplingDeviation = 0.0;
+    ITK_TEST_EXPECT_TRUE(itk::ExposeMetaData<double>(
+      reader->GetOutput()->GetMetaDataDictionary(), "ITK_non_uniform_sampling_deviation", maxSamplingDeviation));
+    ITK_TEST_EXPECT_EQUAL(reader->GetMetaDataDictionaryArray()->size(), numberOfSlices + 1);
+  }
+
+  // The errors of the parallel reads are reported
+  {
+    ReaderType::FileNamesContainer missingFileNames = fileNames;
+    missingFileNames[7] = std::string(argv[1]) + "/itkImageSeriesReaderParallelTestMissing.mha";
+
+    reader = ReaderType::New();
+    reader->SetFileNames(missingFileNames);
+    reader->SetNumberOfParallelReads(4);
+    ITK_TRY_EXPECT_EXCEPTION(reader->Update());
+  }
+
+  // Streamed reads of slabs, the next of which is read in the background
+  for (const unsigned int numberOfParallelReads : { 1u, 4u })
+  {
+    std::cout << "Streaming with prefetching and " << numberOfParallelReads << " parallel reads" << std::endl;
+    reader = ReaderType::New();
+    reader->SetFileNames(fileNames);
+    reader->SetNumberOfParallelReads(numberOfParallelReads);
+    ITK_TEST_SET_GET_BOOLEAN(reader, UsePrefetching, true);
+
+    auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+    streamer->SetInput(reader->GetOutput());
+    streamer->SetNumberOfStreamDivisions(5);
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+    // the reader read the last slab only
+    ITK_TEST_EXPECT_TRUE(reader->GetOutput()->GetBufferedRegion().GetSize(2) < numberOfSlices);
+    if (!CheckImage(streamer->GetOutput(), streamer->GetOutput()->GetLargestPossibleRegion()))
+    {
+      testStatus = EXIT_FAILURE;
+    }
+
+    // Slabs requested out of order, and after the reader is modified, when
+    // the slab read in the background is not used
+    ImageType::RegionType slab = reader->GetOutput()->GetLargestPossibleRegion();
+    slab.SetIndex(2, 2);
+    slab.SetSize(2, 3);
+    reader->GetOutput()->SetRequestedRegion(slab);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->GetOutput()->Update());
+    if (!CheckImage(reader->GetOutput(), slab))
+    {
+      testStatus = EXIT_FAILURE;
+    }
+
+    reader->ReverseOrderOn();
+    slab.SetIndex(2, 5);
+    reader->GetOutput()->SetRequestedRegion(slab);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->GetOutput()->Update());
+    if (!CheckImage(reader->GetOutput(), slab, true))
+    {
+      testStatus = EXIT_FAILURE;
+    }
+
+    // the slab read in the background after the previous one
+    slab.SetIndex(2, 8);
+    reader->GetOutput()->SetRequestedRegion(slab);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->GetOutput()->Update());
+    if (!CheckImage(reader->GetOutput(), slab, true))
+    {
+      testStatus = EXIT_FAILURE;
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
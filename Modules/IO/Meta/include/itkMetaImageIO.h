@@ -82,6 +82,12 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Maps the data of the current IORegion directly from the file. This
+   * is supported for uncompressed binary data stored in the header file
+   * ("LOCAL") or in a single external data file, in native byte order. */
+  MemoryMappedBufferPointer
+  MemoryMapRead() override;
+
   MetaImage *
   GetMetaImagePointer();
 
@@ -134,12 +140,13 @@ public:
                            const ImageIORegion & largestPossibleRegion) override;
 
   /** Determine if the ImageIO can stream reading from this
-   *  file. Only time cannot stream read/write is if compression is used.
+   *  file. Only time cannot stream read/write is if compression is used,
+   *  unless the data is compressed in chunks.
    *  CanRead must be called prior to this function. */
   bool
   CanStreamRead() override
   {
-    if (m_MetaImage.CompressedData())
+    if (m_MetaImage.CompressedData() && m_CompressedDataChunkSize == 0)
     {
       return false;
     }
@@ -167,6 +174,17 @@ public:
   itkSetMacro(SubSamplingFactor, unsigned int);
   itkGetConstMacro(SubSamplingFactor, unsigned int);
 
+  /** Set/Get the size, in bytes of uncompressed data, of the chunks which
+   * are compressed independently when UseCompression is on. The chunks are
+   * compressed and decompressed in parallel, and a streamed read only
+   * decompresses the chunks covering the requested region. The compressed
+   * chunks are preceded by a table of their end offsets, and the header has
+   * a CompressedDataChunkSize field: such files can only be read by
+   * MetaImageIO. The default, 0, compresses the data as a single stream,
+   * readable by any MetaIO reader. */
+  itkSetMacro(CompressionChunkSize, SizeValueType);
+  itkGetConstMacro(CompressionChunkSize, SizeValueType);
+
   /**
    * Set the default precision when writing out the MetaImage header.
    * MetaImage header contains values stored in memory as double,
@@ -195,10 +213,30 @@ private:
   /** Only used to synchronize the global variable across static libraries.*/
   itkGetGlobalDeclarationMacro(unsigned int, DefaultDoublePrecision);
 
+  /** Path of the file holding the data, given the ElementDataFile field
+   * of the header. */
+  std::string
+  GetDataFilePath(const std::string & elementDataFileName) const;
+
+  /** Write the header and the data compressed in chunks of
+   * m_CompressionChunkSize bytes. */
+  void
+  WriteChunkCompressed(const void * buffer);
+
+  /** Read the chunks of compressed data covering m_IORegion. */
+  void
+  ReadChunkCompressed(void * buffer);
+
   MetaImage m_MetaImage;
 
   unsigned int m_SubSamplingFactor;
 
+  SizeValueType m_CompressionChunkSize{ 0 };
+
+  /** Chunk size of the file being read, 0 when it is not compressed in
+   * chunks. */
+  SizeValueType m_CompressedDataChunkSize{ 0 };
+
   static unsigned int * m_DefaultDoublePrecision;
 };
 
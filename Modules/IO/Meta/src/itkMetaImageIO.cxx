@@ -22,9 +22,42 @@
 #include "itksys/SystemTools.hxx"
 #include "itkMath.h"
 #include "itkSingleton.h"
+#include "itkByteSwapper.h"
+#include "itkMultiThreaderBase.h"
+#include <atomic>
+#include <cstdlib>
+#include <memory>
+#include <sstream>
 
 namespace itk
 {
+namespace
+{
+// Header field of the files compressed in chunks
+const char * const CompressedDataChunkSizeField = "CompressedDataChunkSize";
+
+// Position of the data which follows the header of a file with attached
+// data ("ElementDataFile = LOCAL"), or -1 when the header is not found.
+std::streamoff
+GetAttachedDataOffset(std::ifstream & file)
+{
+  std::string line;
+  while (std::getline(file, line))
+  {
+    const std::string::size_type nameStart = line.find_first_not_of(" \t");
+    if (nameStart != std::string::npos && line.compare(nameStart, 15, "ElementDataFile") == 0)
+    {
+      const std::string::size_type separator = line.find_first_not_of(" \t", nameStart + 15);
+      if (separator != std::string::npos && line[separator] == '=')
+      {
+        return file.tellg();
+      }
+    }
+  }
+  return -1;
+}
+} // namespace
+
 // Explicitly set std::numeric_limits<double>::max_digits10 this will provide
 // better accuracy when writing out floating point number in MetaImage header.
 itkGetGlobalValueMacro(MetaImageIO, unsigned int, DefaultDoublePrecision, 17);
@@ -66,6 +99,8 @@ MetaImageIO::PrintSelf(std::ostream & os, Indent indent) const
   Superclass::PrintSelf(os, indent);
   m_MetaImage.PrintInfo();
   os << indent << "SubSamplingFactor: " << m_SubSamplingFactor << "\n";
+  os << indent << "CompressionChunkSize: " << m_CompressionChunkSize << "\n";
+  os << indent << "CompressedDataChunkSize: " << m_CompressedDataChunkSize << "\n";
 }
 
 void
@@ -100,6 +135,7 @@ MetaImageIO::ReadImageInformation()
     itkExceptionMacro("File cannot be read: " << this->GetFileName() << " for reading." << std::endl
                                               << "Reason: " << itksys::SystemTools::GetLastSystemError());
   }
+  m_CompressedDataChunkSize = 0;
 
   if (m_MetaImage.BinaryData())
   {
@@ -411,6 +447,15 @@ MetaImageIO::ReadImageInformation()
   {
     std::string key(m_MetaImage.GetAdditionalReadFieldName(f));
     std::string value(m_MetaImage.GetAdditionalReadFieldValue(f));
+    if (key == CompressedDataChunkSizeField)
+    {
+      // Describes the layout of the data, not the image
+      if (m_MetaImage.CompressedData())
+      {
+        m_CompressedDataChunkSize = std::strtoull(value.c_str(), nullptr, 10);
+      }
+      continue;
+    }
     EncapsulateMetaData<std::string>(thisMetaDict, key, value);
   }
 
@@ -434,6 +479,12 @@ MetaImageIO::ReadImageInformation()
 void
 MetaImageIO::Read(void * buffer)
 {
+  if (m_CompressedDataChunkSize > 0)
+  {
+    this->ReadChunkCompressed(buffer);
+    return;
+  }
+
   const unsigned int nDims = this->GetNumberOfDimensions();
 
   // this will check to see if we are actually streaming
@@ -493,6 +544,64 @@ MetaImageIO::Read(void * buffer)
   }
 }
 
+ImageIOBase::MemoryMappedBufferPointer
+MetaImageIO::MemoryMapRead()
+{
+  if (!m_MetaImage.BinaryData() || m_MetaImage.CompressedData() || m_SubSamplingFactor != 1)
+  {
+    return nullptr;
+  }
+  if (this->GetComponentSize() > 1 && m_MetaImage.BinaryDataByteOrderMSB() != MET_SystemByteOrderMSB())
+  {
+    return nullptr;
+  }
+
+  // Lists of slice files and file name patterns are not a single
+  // contiguous block of data.
+  const std::string elementDataFileName = m_MetaImage.ElementDataFileName();
+  if (elementDataFileName.compare(0, 4, "LIST") == 0 || elementDataFileName.find('%') != std::string::npos)
+  {
+    return nullptr;
+  }
+
+  const std::string dataFileName = this->GetDataFilePath(elementDataFileName);
+
+  // Uncompressed data is stored at the end of the data file, unless an
+  // explicit header size is given.
+  SizeType  dataOffset = 0;
+  const int headerSize = m_MetaImage.HeaderSize();
+  if (headerSize > 0)
+  {
+    dataOffset = static_cast<SizeType>(headerSize);
+  }
+  else if (headerSize == -1 || dataFileName == m_FileName)
+  {
+    const auto fileSize = static_cast<SizeType>(itksys::SystemTools::FileLength(dataFileName));
+    if (fileSize < this->GetImageSizeInBytes())
+    {
+      return nullptr;
+    }
+    dataOffset = fileSize - this->GetImageSizeInBytes();
+  }
+
+  return this->MemoryMapIORegion(dataFileName, dataOffset);
+}
+
+std::string
+MetaImageIO::GetDataFilePath(const std::string & elementDataFileName) const
+{
+  if (elementDataFileName == "LOCAL" || elementDataFileName == "Local" || elementDataFileName == "local")
+  {
+    return m_FileName;
+  }
+  if (itksys::SystemTools::FileIsFullPath(elementDataFileName))
+  {
+    return elementDataFileName;
+  }
+  const std::string path = itksys::SystemTools::GetFilenamePath(m_FileName);
+  return path.empty() ? elementDataFileName : path + '/' + elementDataFileName;
+}
+
 MetaImage *
 MetaImageIO::GetMetaImagePointer()
 {
@@ -1106,6 +1215,20 @@ MetaImageIO ::Write(const void * buffer)
     delete[] indexMin;
     delete[] indexMax;
   }
+  else if (m_UseCompression && m_CompressionChunkSize > 0 && binaryData)
+  {
+    try
+    {
+      this->WriteChunkCompressed(buffer);
+    }
+    catch (...)
+    {
+      delete[] dSize;
+      delete[] eSpacing;
+      delete[] eOrigin;
+      throw;
+    }
+  }
   else
   {
     if (!m_MetaImage.Write(m_FileName.c_str()))
@@ -1123,6 +1246,298 @@ MetaImageIO ::Write(const void * buffer)
   delete[] eOrigin;
 }
 
+void
+MetaImageIO::WriteChunkCompressed(const void * buffer)
+{
+  const auto          dataSize = static_cast<SizeValueType>(this->GetImageSizeInBytes());
+  const SizeValueType chunkSize = m_CompressionChunkSize;
+  const SizeValueType numberOfChunks = (dataSize + chunkSize - 1) / chunkSize;
+
+  // Compress the chunks in parallel
+  std::vector<std::unique_ptr<unsigned char[]>> chunks(numberOfChunks);
+  std::vector<std::streamoff>                   chunkSizes(numberOfChunks);
+  const int                                     compressionLevel = this->GetCompressionLevel();
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    numberOfChunks,
+    [&](SizeValueType chunk) {
+      const SizeValueType first = chunk * chunkSize;
+      chunks[chunk].reset(MET_PerformCompression(static_cast<const unsigned char *>(buffer) + first,
+                                                 static_cast<std::streamoff>(std::min(chunkSize, dataSize - first)),
+                                                 &chunkSizes[chunk],
+                                                 compressionLevel));
+    },
+    nullptr);
+
+  // The compressed data starts with the end offsets of the chunks, relative
+  // to the first chunk, as little endian 64 bits integers.
+  std::vector<uint64_t> endOffsets(numberOfChunks);
+  uint64_t              endOffset = 0;
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    endOffset += static_cast<uint64_t>(chunkSizes[chunk]);
+    endOffsets[chunk] = endOffset;
+  }
+  const uint64_t compressedDataSize = numberOfChunks * sizeof(uint64_t) + endOffset;
+  ByteSwapper<uint64_t>::SwapRangeFromSystemToLittleEndian(endOffsets.data(), numberOfChunks);
+
+  // MetaIO compresses the data as a single stream, so let it write the
+  // header of uncompressed data, then describe the chunks in the header.
+  const bool  userDataFileName = std::strlen(m_MetaImage.ElementDataFileName()) > 0;
+  std::string dataFileName = m_MetaImage.ElementDataFileName();
+  if (!userDataFileName)
+  {
+    dataFileName = (itksys::SystemTools::GetFilenameLastExtension(m_FileName) == ".mha")
+                     ? "LOCAL"
+                     : itksys::SystemTools::GetFilenameWithoutLastExtension(m_FileName) + ".zraw";
+  }
+  m_MetaImage.CompressedData(false);
+  const bool headerWritten =
+    m_MetaImage.Write(m_FileName.c_str(), userDataFileName ? nullptr : dataFileName.c_str(), false);
+  m_MetaImage.CompressedData(true);
+  const std::string headerFileName = m_MetaImage.FileName();
+  if (!headerWritten)
+  {
+    itkExceptionMacro("File cannot be written: " << headerFileName << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  std::string header;
+  {
+    std::ifstream      headerFile(headerFileName.c_str(), std::ios::in | std::ios::binary);
+    std::ostringstream headerStream;
+    headerStream << headerFile.rdbuf();
+    header = headerStream.str();
+  }
+  const std::string            uncompressedField = "CompressedData = False\n";
+  const std::string::size_type fieldPosition = header.find(uncompressedField);
+  if (fieldPosition == std::string::npos)
+  {
+    itkExceptionMacro("Unexpected header written for " << headerFileName);
+  }
+  std::ostringstream compressionFields;
+  compressionFields << "CompressedData = True\n"
+                    << "CompressedDataSize = " << compressedDataSize << '\n'
+                    << CompressedDataChunkSizeField << " = " << chunkSize << '\n';
+  header.replace(fieldPosition, uncompressedField.size(), compressionFields.str());
+
+  std::ofstream headerFile(headerFileName.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+  headerFile.write(header.data(), static_cast<std::streamsize>(header.size()));
+
+  std::ofstream   dataFile;
+  std::ofstream * dataStream = &headerFile;
+  const bool      attachedData = dataFileName == "LOCAL" || dataFileName == "Local" || dataFileName == "local";
+  if (!attachedData)
+  {
+    dataFile.open(this->GetDataFilePath(dataFileName).c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+    dataStream = &dataFile;
+  }
+  dataStream->write(reinterpret_cast<const char *>(endOffsets.data()),
+                    static_cast<std::streamsize>(numberOfChunks * sizeof(uint64_t)));
+  for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+  {
+    dataStream->write(reinterpret_cast<const char *>(chunks[chunk].get()), chunkSizes[chunk]);
+  }
+
+  if (!headerFile || !*dataStream)
+  {
+    itkExceptionMacro("File cannot be written: " << headerFileName << std::endl
+                                                 << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+}
+
+void
+MetaImageIO::ReadChunkCompressed(void * buffer)
+{
+  if (m_SubSamplingFactor != 1)
+  {
+    itkExceptionMacro("SubSamplingFactor is not supported for data compressed in chunks: " << m_FileName);
+  }
+
+  const unsigned int  nDims = this->GetNumberOfDimensions();
+  const auto          pixelSize = static_cast<SizeValueType>(this->GetPixelSize());
+  const auto          dataSize = static_cast<SizeValueType>(this->GetImageSizeInBytes());
+  const SizeValueType chunkSize = m_CompressedDataChunkSize;
+  const SizeValueType numberOfChunks = (dataSize + chunkSize - 1) / chunkSize;
+
+  // Region of the file to read, like MetaImage::ReadROI
+  ImageIORegion region(nDims);
+  bool          wholeImage = true;
+  for (unsigned int i = 0; i < nDims; ++i)
+  {
+    if (m_IORegion.GetImageDimension() == 0)
+    {
+      region.SetIndex(i, 0);
+      region.SetSize(i, this->GetDimensions(i));
+    }
+    else if (i < m_IORegion.GetImageDimension())
+    {
+      region.SetIndex(i, m_IORegion.GetIndex(i));
+      region.SetSize(i, m_IORegion.GetSize(i));
+    }
+    else
+    {
+      region.SetIndex(i, 0);
+      region.SetSize(i, 1);
+    }
+    wholeImage = wholeImage && region.GetIndex(i) == 0 && region.GetSize(i) == this->GetDimensions(i);
+  }
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // The rows of the region are contiguous in the file
+  const SizeValueType rowSize = region.GetSize(0) * pixelSize;
+  const SizeValueType numberOfRows = region.GetNumberOfPixels() / region.GetSize(0);
+  const auto          getRowOffset = [this, &region, nDims, pixelSize](SizeValueType row) {
+    SizeValueType offset = 0;
+    SizeValueType stride = 1;
+    for (unsigned int i = 0; i < nDims; ++i)
+    {
+      SizeValueType index = region.GetIndex(i);
+      if (i > 0)
+      {
+        index += row % region.GetSize(i);
+        row /= region.GetSize(i);
+      }
+      offset += index * stride;
+      stride *= this->GetDimensions(i);
+    }
+    return offset * pixelSize;
+  };
+
+  std::vector<SizeValueType> neededChunks;
+  if (wholeImage)
+  {
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      neededChunks.push_back(chunk);
+    }
+  }
+  else
+  {
+    std::vector<bool> isNeeded(numberOfChunks, false);
+    for (SizeValueType row = 0; row < numberOfRows; ++row)
+    {
+      const SizeValueType rowOffset = getRowOffset(row);
+      for (SizeValueType chunk = rowOffset / chunkSize; chunk <= (rowOffset + rowSize - 1) / chunkSize; ++chunk)
+      {
+        isNeeded[chunk] = true;
+      }
+    }
+    for (SizeValueType chunk = 0; chunk < numberOfChunks; ++chunk)
+    {
+      if (isNeeded[chunk])
+      {
+        neededChunks.push_back(chunk);
+      }
+    }
+  }
+
+  // Read the table of the end offsets of the chunks, then the needed chunks
+  const std::string dataFileName = this->GetDataFilePath(m_MetaImage.ElementDataFileName());
+  std::ifstream     file(dataFileName.c_str(), std::ios::in | std::ios::binary);
+  std::streamoff    dataOffset = 0;
+  if (dataFileName == m_FileName)
+  {
+    dataOffset = GetAttachedDataOffset(file);
+  }
+  std::vector<uint64_t> endOffsets(numberOfChunks);
+  if (file && dataOffset >= 0)
+  {
+    file.seekg(dataOffset);
+    file.read(reinterpret_cast<char *>(endOffsets.data()),
+              static_cast<std::streamsize>(numberOfChunks * sizeof(uint64_t)));
+  }
+  if (!file || dataOffset < 0)
+  {
+    itkExceptionMacro("File cannot be read: " << dataFileName << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+  ByteSwapper<uint64_t>::SwapRangeFromSystemToLittleEndian(endOffsets.data(), numberOfChunks);
+  const std::streamoff chunksOffset = dataOffset + static_cast<std::streamoff>(numberOfChunks * sizeof(uint64_t));
+
+  std::vector<std::vector<unsigned char>> compressedChunks(neededChunks.size());
+  for (size_t i = 0; i < neededChunks.size(); ++i)
+  {
+    const SizeValueType chunk = neededChunks[i];
+    const uint64_t      beginOffset = (chunk == 0) ? 0 : endOffsets[chunk - 1];
+    if (endOffsets[chunk] < beginOffset)
+    {
+      itkExceptionMacro("Corrupted table of compressed chunks in " << dataFileName);
+    }
+    compressedChunks[i].resize(endOffsets[chunk] - beginOffset);
+    file.seekg(chunksOffset + static_cast<std::streamoff>(beginOffset));
+    file.read(reinterpret_cast<char *>(compressedChunks[i].data()),
+              static_cast<std::streamsize>(compressedChunks[i].size()));
+  }
+  if (!file)
+  {
+    itkExceptionMacro("File cannot be read: " << dataFileName << " for reading." << std::endl
+                                              << "Reason: " << itksys::SystemTools::GetLastSystemError());
+  }
+
+  // Decompress the chunks in parallel, directly in the buffer when the whole
+  // image is read.
+  std::vector<std::unique_ptr<unsigned char[]>> chunks(wholeImage ? 0 : neededChunks.size());
+  std::atomic<bool>                             failed{ false };
+  MultiThreaderBase::New()->ParallelizeArray(
+    0,
+    neededChunks.size(),
+    [&](SizeValueType i) {
+      const SizeValueType first = neededChunks[i] * chunkSize;
+      const SizeValueType size = std::min(chunkSize, dataSize - first);
+      unsigned char *     destination = static_cast<unsigned char *>(buffer) + first;
+      if (!wholeImage)
+      {
+        chunks[i].reset(new unsigned char[size]);
+        destination = chunks[i].get();
+      }
+      if (!MET_PerformUncompression(compressedChunks[i].data(),
+                                    static_cast<std::streamoff>(compressedChunks[i].size()),
+                                    destination,
+                                    static_cast<std::streamoff>(size)))
+      {
+        failed = true;
+      }
+    },
+    nullptr);
+  if (failed)
+  {
+    itkExceptionMacro("Cannot decompress the data of " << dataFileName);
+  }
+
+  if (!wholeImage)
+  {
+    // Position of each needed chunk in chunks
+    std::vector<SizeValueType> chunkPositions(numberOfChunks);
+    for (size_t i = 0; i < neededChunks.size(); ++i)
+    {
+      chunkPositions[neededChunks[i]] = i;
+    }
+    auto * destination = static_cast<unsigned char *>(buffer);
+    for (SizeValueType row = 0; row < numberOfRows; ++row)
+    {
+      SizeValueType rowOffset = getRowOffset(row);
+      SizeValueType remaining = rowSize;
+      while (remaining > 0)
+      {
+        const SizeValueType chunk = rowOffset / chunkSize;
+        const SizeValueType offsetInChunk = rowOffset - chunk * chunkSize;
+        const SizeValueType count = std::min(remaining, chunkSize - offsetInChunk);
+        std::copy_n(chunks[chunkPositions[chunk]].get() + offsetInChunk, count, destination);
+        destination += count;
+        rowOffset += count;
+        remaining -= count;
+      }
+    }
+  }
+
+  m_MetaImage.ElementData(buffer, false);
+  m_MetaImage.ElementByteOrderFix(region.GetNumberOfPixels());
+}
+
 /** Given a requested region, determine what could be the region that we can
  * read from the file. This is called the streamable region, which will be
  * smaller than the LargestPossibleRegion and greater or equal to the
@@ -0,0 +1,143 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+
+
+namespace
+{
+using PixelType = float;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+RampValue(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(index[0] + 100 * index[1] + 10000 * index[2]);
+}
+
+bool
+IsRamp(const ImageType * image)
+{
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != RampValue(it.GetIndex()))
+    {
+      std::cerr << "Pixel mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << RampValue(it.GetIndex())
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int
+ReadChunked(const std::string & fileName)
+{
+  auto io = itk::MetaImageIO::New();
+  io->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(io->ReadImageInformation());
+  ITK_TEST_EXPECT_TRUE(io->CanStreamRead());
+  // The layout of the data is not part of the meta data
+  ITK_TEST_EXPECT_TRUE(!io->GetMetaDataDictionary().HasKey("CompressedDataChunkSize"));
+
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(io);
+  reader->SetFileName(fileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_TRUE(IsRamp(reader->GetOutput()));
+
+  // Streamed reads only decompress the chunks covering the requested region
+  ImageType::RegionType region = reader->GetOutput()->GetLargestPossibleRegion();
+  for (const auto & requestedRegion :
+       { ImageType::RegionType({ { 0, 0, 3 } }, { { region.GetSize(0), region.GetSize(1), 2 } }),
+         ImageType::RegionType({ { 5, 2, 1 } }, { { 7, 11, 6 } }),
+         ImageType::RegionType({ { 32, 16, 8 } }, { { 1, 1, 1 } }) })
+  {
+    reader->Modified();
+    reader->GetOutput()->SetRequestedRegion(requestedRegion);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->GetOutput()->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), requestedRegion);
+    ITK_TEST_EXPECT_TRUE(IsRamp(reader->GetOutput()));
+  }
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkMetaImageIOChunkedCompressionTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize({ { 33, 17, 9 } });
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(RampValue(it.GetIndex()));
+  }
+
+  auto io = itk::MetaImageIO::New();
+  ITK_TEST_SET_GET_VALUE(0, io->GetCompressionChunkSize());
+  // Chunks which do not hold a whole number of pixels
+  io->SetCompressionChunkSize(1001);
+  ITK_TEST_SET_GET_VALUE(1001, io->GetCompressionChunkSize());
+
+  int result = EXIT_SUCCESS;
+  for (const std::string & fileName :
+       { outputDirectory + "/ChunkedCompressionTest.mha", outputDirectory + "/ChunkedCompressionTest.mhd" })
+  {
+    std::cout << "Writing " << fileName << std::endl;
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetImageIO(io);
+    writer->SetInput(image);
+    writer->SetFileName(fileName);
+    writer->UseCompressionOn();
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    if (ReadChunked(fileName) != EXIT_SUCCESS)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+
+  // Data compressed as a single stream cannot be streamed
+  const std::string singleStreamFileName = outputDirectory + "/ChunkedCompressionTestSingleStream.mha";
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, singleStreamFileName, true));
+  auto singleStreamIO = itk::MetaImageIO::New();
+  singleStreamIO->SetFileName(singleStreamFileName);
+  ITK_TRY_EXPECT_NO_EXCEPTION(singleStreamIO->ReadImageInformation());
+  ITK_TEST_EXPECT_TRUE(!singleStreamIO->CanStreamRead());
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
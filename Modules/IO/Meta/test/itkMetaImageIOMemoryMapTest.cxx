@@ -0,0 +1,150 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMetaImageIO.h"
+#include "itkTestingMacros.h"
+#include "itksys/SystemTools.hxx"
+
+
+namespace
+{
+using PixelType = float;
+using ImageType = itk::Image<PixelType, 3>;
+
+PixelType
+RampValue(const ImageType::IndexType & index)
+{
+  return static_cast<PixelType>(index[0] + 100 * index[1] + 10000 * index[2]);
+}
+
+bool
+IsRamp(const ImageType * image)
+{
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, image->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != RampValue(it.GetIndex()))
+    {
+      std::cerr << "Pixel mismatch at " << it.GetIndex() << ": " << it.Get() << " != " << RampValue(it.GetIndex())
+                << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+int
+ReadMapped(const std::string & fileName, bool expectMapped)
+{
+  auto io = itk::MetaImageIO::New();
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(io);
+  reader->SetFileName(fileName);
+  reader->UseMemoryMappingOn();
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+
+  ImageType::Pointer image = reader->GetOutput();
+  ITK_TEST_EXPECT_TRUE(IsRamp(image));
+
+  // The IO must be able to map the region the reader requested
+  ITK_TEST_EXPECT_EQUAL(io->MemoryMapRead() != nullptr, expectMapped);
+
+  // Writing to the mapped buffer must not modify the file
+  image->FillBuffer(-1.0f);
+  image->DisconnectPipeline();
+  reader->UseMemoryMappingOff();
+  reader->Modified();
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+  ITK_TEST_EXPECT_TRUE(IsRamp(reader->GetOutput()));
+
+  // Streamed read of a slab, which is contiguous in the file when the data
+  // is not compressed, and inflated otherwise
+  reader->UseMemoryMappingOn();
+  reader->Modified();
+  ImageType::RegionType slab = reader->GetOutput()->GetLargestPossibleRegion();
+  slab.SetIndex(2, 3);
+  slab.SetSize(2, 2);
+  reader->GetOutput()->SetRequestedRegion(slab);
+  ITK_TRY_EXPECT_NO_EXCEPTION(reader->GetOutput()->Update());
+  ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), slab);
+  ITK_TEST_EXPECT_EQUAL(io->MemoryMapRead() != nullptr, expectMapped);
+  ITK_TEST_EXPECT_TRUE(IsRamp(reader->GetOutput()));
+
+  return EXIT_SUCCESS;
+}
+} // namespace
+
+int
+itkMetaImageIOMemoryMapTest(int argc, char * argv[])
+{
+  if (argc < 2)
+  {
+    std::cerr << "Missing parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " outputDirectory" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string outputDirectory = argv[1];
+
+  auto                  image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize({ { 33, 17, 9 } });
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(RampValue(it.GetIndex()));
+  }
+
+  // Attached data, detached data, and compressed data which cannot be mapped
+  const std::string localFileName = outputDirectory + "/MemoryMapTest.mha";
+  const std::string detachedFileName = outputDirectory + "/MemoryMapTest.mhd";
+  const std::string compressedFileName = outputDirectory + "/MemoryMapTestCompressed.mha";
+
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, localFileName));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, detachedFileName));
+  ITK_TRY_EXPECT_NO_EXCEPTION(itk::WriteImage(image, compressedFileName, true));
+
+  // The data attached to the header is mapped only when it is aligned on
+  // the size of the pixels, which depends on the length of the header
+  const auto dataOffset =
+    itksys::SystemTools::FileLength(localFileName) - region.GetNumberOfPixels() * sizeof(PixelType);
+
+  int result = EXIT_SUCCESS;
+  std::cout << "Reading " << localFileName << std::endl;
+  if (ReadMapped(localFileName, dataOffset % sizeof(PixelType) == 0) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+  std::cout << "Reading " << detachedFileName << std::endl;
+  if (ReadMapped(detachedFileName, true) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+  std::cout << "Reading " << compressedFileName << std::endl;
+  if (ReadMapped(compressedFileName, false) != EXIT_SUCCESS)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
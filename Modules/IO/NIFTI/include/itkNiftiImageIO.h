@@ -149,6 +149,16 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Any region of the image can be read. The data of compressed files
+   * is accessed through an index of the compressed stream, built while
+   * the file is read, so that successive reads of regions of the same
+   * file do not inflate the file from its beginning each time. */
+  bool
+  CanStreamRead() override
+  {
+    return true;
+  }
+
   //-------- This part of the interfaces deals with writing data. -----
 
   /** Determine if the file can be written with this ImageIO implementation.
@@ -172,6 +182,20 @@ public:
   void
   Write(const void * buffer) override;
 
+  /** Determine if the ImageIO can stream write from the current
+   * settings: the file must not be compressed, and the voxels must be
+   * stored in the same layout as in ITK, i.e. the pixels must not be
+   * vectors or tensors. */
+  bool
+  CanStreamWrite() override;
+
+  /** Remove the existing files before streaming, or check that the
+   * existing file is compatible before pasting. */
+  unsigned int
+  GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                    const ImageIORegion & pasteRegion,
+                                    const ImageIORegion & largestPossibleRegion) override;
+
   /** Calculate the region of the image that can be efficiently read
    *  in response to a given requested region. */
   ImageIORegion
@@ -225,6 +249,16 @@ private:
   void
   SetImageIOMetadataFromNIfTI();
 
+  /** Read the subregion of the data file starting at origin, of size
+   * size (in NIfTI dimensions), into a buffer allocated with malloc. */
+  void
+  ReadSubregion(const int origin[7], const int size[7], void ** data);
+
+  /** Write the IORegion into the data file, which is created with the
+   * header if it does not exist. */
+  void
+  WriteRegion(const void * buffer);
+
   // This proxy class provides a nifti_image pointer interface to the internal implementation
   // of itk::NiftiImageIO, while hiding the niftilib interface from the external ITK interface.
   class NiftiImageProxy;
@@ -235,6 +269,11 @@ private:
 
   NiftiImageProxy & m_NiftiImage;
 
+  // Random access to the content of the last gzip compressed file read.
+  class GzipIndex;
+
+  std::unique_ptr<GzipIndex> m_GzipIndex;
+
   double m_RescaleSlope{ 1.0 };
   double m_RescaleIntercept{ 0.0 };
 
@@ -8,6 +8,7 @@ itk_module(ITKIONIFTI
   PRIVATE_DEPENDS
     ITKTransform
     ITKNIFTI
+    ITKZLIB
   TEST_DEPENDS
     ITKTestKernel
     ITKNIFTI
@@ -21,6 +21,10 @@
 #include "itkSpatialOrientationAdapter.h"
 #include <nifti1_io.h>
 #include "itkNiftiImageIOConfigurePrivate.h"
+#include "itk_zlib.h"
+#include "itksys/SystemTools.hxx"
+#include <algorithm>
+#include <cmath>
 
 namespace itk
 {
@@ -322,6 +326,81 @@ str_xform(unsigned int xform)
   }
   return str_xform(NIFTI_XFORM_UNKNOWN);
 }
+
+// Call function(fileOffset, bufferOffset, numberOfBytes) for each run of
+// voxels of a region which is contiguous in the data file, in file order.
+// The arrays have an element per NIfTI dimension.
+template <typename TFunction>
+void
+ForEachContiguousRun(const SizeValueType dims[7],
+                     const SizeValueType start[7],
+                     const SizeValueType size[7],
+                     SizeValueType       voxelSize,
+                     TFunction           function)
+{
+  SizeValueType stride[7];
+  stride[0] = voxelSize;
+  for (unsigned int d = 1; d < 7; ++d)
+  {
+    stride[d] = stride[d - 1] * dims[d - 1];
+  }
+
+  // the run extends over the following dimension when a dimension is complete
+  unsigned int  runDimensions = 1;
+  SizeValueType runLength = size[0] * voxelSize;
+  while (runDimensions < 7 && size[runDimensions - 1] == dims[runDimensions - 1])
+  {
+    runLength *= size[runDimensions];
+    ++runDimensions;
+  }
+  SizeValueType numberOfRuns = 1;
+  for (unsigned int d = runDimensions; d < 7; ++d)
+  {
+    numberOfRuns *= size[d];
+  }
+
+  SizeValueType position[7] = { 0, 0, 0, 0, 0, 0, 0 };
+  for (SizeValueType run = 0; run < numberOfRuns; ++run)
+  {
+    SizeValueType fileOffset = 0;
+    for (unsigned int d = 0; d < 7; ++d)
+    {
+      fileOffset += (start[d] + position[d]) * stride[d];
+    }
+    function(fileOffset, run * runLength, runLength);
+
+    for (unsigned int d = runDimensions; d < 7 && ++position[d] == size[d]; ++d)
+    {
+      position[d] = 0;
+    }
+  }
+}
+
+// Dimensions of the NIfTI image, with the unused dimensions set to one
+void
+GetNiftiDimensions(const nifti_image * nim, SizeValueType dims[7])
+{
+  for (int d = 0; d < 7; ++d)
+  {
+    dims[d] = (d < nim->ndim && nim->dim[d + 1] > 1) ? static_cast<SizeValueType>(nim->dim[d + 1]) : 1;
+  }
+}
+
+// Same as nifti_read_buffer, which sets the non finite floating point
+// values to zero
+template <typename TValue>
+void
+ZeroNonFiniteValues(void * data, size_t numberOfBytes)
+{
+  auto * values = static_cast<TValue *>(data);
+  for (size_t i = 0; i < numberOfBytes / sizeof(TValue); ++i)
+  {
+    if (!std::isfinite(values[i]))
+    {
+      values[i] = 0;
+    }
+  }
+}
 } // namespace
 
 // returns an ordering array for converting upper triangular symmetric matrix
@@ -444,6 +523,222 @@ public:
 };
 
 
+// Random access to the uncompressed content of a gzip file, as in the zran
+// example of zlib. The state of the inflation is saved in an access point
+// about every AccessPointSpacing uncompressed bytes, the first time the
+// file is inflated up to there, so that the inflation can later restart
+// from the last access point before the data to read, instead of from the
+// beginning of the file.
+class NiftiImageIO::GzipIndex
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(GzipIndex);
+
+  explicit GzipIndex(const std::string & fileName)
+    : m_FileName(fileName)
+    , m_ModifiedTime(itksys::SystemTools::ModifiedTime(fileName))
+    , m_FileLength(itksys::SystemTools::FileLength(fileName))
+    , m_Input(InputSize)
+    , m_Window(WindowSize)
+  {}
+
+  ~GzipIndex()
+  {
+    if (m_StreamInitialized)
+    {
+      inflateEnd(&m_Stream);
+    }
+  }
+
+  /** Whether this is the index of the current content of the file. */
+  bool
+  IsIndexOf(const std::string & fileName) const
+  {
+    return fileName == m_FileName && itksys::SystemTools::ModifiedTime(fileName) == m_ModifiedTime &&
+           itksys::SystemTools::FileLength(fileName) == m_FileLength;
+  }
+
+  /** Read numberOfBytes uncompressed bytes, starting at offset. Returns
+   * false if the data cannot be read, e.g. when the file is made of
+   * several gzip members. */
+  bool
+  Read(SizeValueType offset, char * buffer, SizeValueType numberOfBytes)
+  {
+    const SizeValueType end = offset + numberOfBytes;
+
+    // restart when going backward, or when an access point allows to skip data
+    const AccessPoint * accessPoint = this->FindAccessPoint(offset);
+    if (!m_StreamInitialized || offset < m_Output || (accessPoint != nullptr && accessPoint->Output > m_Output))
+    {
+      if (!this->Restart(accessPoint))
+      {
+        return false;
+      }
+    }
+
+    while (m_Output < end)
+    {
+      if (m_StreamEnd)
+      {
+        return false;
+      }
+      if (m_Stream.avail_in == 0)
+      {
+        m_File.read(reinterpret_cast<char *>(m_Input.data()), InputSize);
+        const auto numberOfBytesRead = static_cast<uInt>(m_File.gcount());
+        if (numberOfBytesRead == 0)
+        {
+          return false;
+        }
+        m_Stream.next_in = m_Input.data();
+        m_Stream.avail_in = numberOfBytesRead;
+        m_InputEnd += numberOfBytesRead;
+      }
+
+      // inflate into the circular window, which keeps the last uncompressed
+      // bytes for the access points
+      m_Stream.next_out = m_Window.data() + m_WindowPosition;
+      m_Stream.avail_out = static_cast<uInt>(WindowSize - m_WindowPosition);
+      const int status = inflate(&m_Stream, Z_BLOCK);
+      if (status != Z_OK && status != Z_STREAM_END && status != Z_BUF_ERROR)
+      {
+        return false;
+      }
+      const SizeValueType inflated = WindowSize - m_WindowPosition - m_Stream.avail_out;
+
+      const SizeValueType first = std::max(m_Output, offset);
+      const SizeValueType last = std::min(m_Output + inflated, end);
+      if (first < last)
+      {
+        std::copy_n(m_Window.data() + m_WindowPosition + (first - m_Output), last - first, buffer + (first - offset));
+      }
+      m_Output += inflated;
+      m_WindowPosition = (m_WindowPosition + inflated) % WindowSize;
+
+      if (status == Z_STREAM_END)
+      {
+        m_StreamEnd = true;
+      }
+      else if ((m_Stream.data_type & 128) && !(m_Stream.data_type & 64) &&
+               (m_AccessPoints.empty() || m_Output >= m_AccessPoints.back().Output + AccessPointSpacing))
+      {
+        // at the end of a deflate block, which is not the last one
+        this->AddAccessPoint();
+      }
+    }
+    return true;
+  }
+
+private:
+  static constexpr SizeValueType WindowSize = 32768;
+  static constexpr SizeValueType InputSize = 16384;
+  static constexpr SizeValueType AccessPointSpacing = 1048576;
+
+  struct AccessPoint
+  {
+    SizeValueType              Output;
+    SizeValueType              Input;
+    int                        Bits;
+    std::vector<unsigned char> Window;
+  };
+
+  // last access point before offset, if any
+  const AccessPoint *
+  FindAccessPoint(SizeValueType offset) const
+  {
+    const auto next = std::upper_bound(
+      m_AccessPoints.begin(), m_AccessPoints.end(), offset, [](SizeValueType value, const AccessPoint & point) {
+        return value < point.Output;
+      });
+    return (next == m_AccessPoints.begin()) ? nullptr : &*(next - 1);
+  }
+
+  void
+  AddAccessPoint()
+  {
+    AccessPoint point;
+    point.Output = m_Output;
+    point.Input = m_InputEnd - m_Stream.avail_in;
+    point.Bits = m_Stream.data_type & 7;
+    point.Window.reserve(WindowSize);
+    point.Window.insert(point.Window.end(), m_Window.begin() + m_WindowPosition, m_Window.end());
+    point.Window.insert(point.Window.end(), m_Window.begin(), m_Window.begin() + m_WindowPosition);
+    m_AccessPoints.push_back(std::move(point));
+  }
+
+  // restart the inflation at the access point, or at the beginning of the
+  // file if there is no access point
+  bool
+  Restart(const AccessPoint * accessPoint)
+  {
+    if (m_StreamInitialized)
+    {
+      inflateEnd(&m_Stream);
+      m_StreamInitialized = false;
+    }
+    if (!m_File.is_open())
+    {
+      m_File.open(m_FileName.c_str(), std::ios::in | std::ios::binary);
+    }
+    m_File.clear();
+    m_Stream = z_stream();
+    m_StreamEnd = false;
+    m_WindowPosition = 0;
+
+    if (accessPoint == nullptr)
+    {
+      // gzip stream
+      if (inflateInit2(&m_Stream, 15 + 16) != Z_OK)
+      {
+        return false;
+      }
+      m_StreamInitialized = true;
+      m_InputEnd = 0;
+      m_Output = 0;
+      m_File.seekg(0);
+      return !m_File.fail();
+    }
+
+    // raw deflate stream, starting at a bit of the compressed data
+    if (inflateInit2(&m_Stream, -15) != Z_OK)
+    {
+      return false;
+    }
+    m_StreamInitialized = true;
+    m_InputEnd = accessPoint->Input - (accessPoint->Bits ? 1 : 0);
+    m_File.seekg(static_cast<std::streamoff>(m_InputEnd));
+    if (accessPoint->Bits)
+    {
+      const int byte = m_File.get();
+      if (byte == std::char_traits<char>::eof())
+      {
+        return false;
+      }
+      ++m_InputEnd;
+      inflatePrime(&m_Stream, accessPoint->Bits, byte >> (8 - accessPoint->Bits));
+    }
+    inflateSetDictionary(&m_Stream, accessPoint->Window.data(), static_cast<uInt>(WindowSize));
+    std::copy(accessPoint->Window.begin(), accessPoint->Window.end(), m_Window.begin());
+    m_Output = accessPoint->Output;
+    return !m_File.fail();
+  }
+
+  const std::string          m_FileName;
+  const long int             m_ModifiedTime;
+  const unsigned long        m_FileLength;
+  std::ifstream              m_File;
+  z_stream                   m_Stream{};
+  bool                       m_StreamInitialized{ false };
+  bool                       m_StreamEnd{ false };
+  SizeValueType              m_InputEnd{ 0 };
+  SizeValueType              m_Output{ 0 };
+  std::vector<unsigned char> m_Input;
+  std::vector<unsigned char> m_Window;
+  SizeValueType              m_WindowPosition{ 0 };
+  std::vector<AccessPoint>   m_AccessPoints;
+};
+
+
 NiftiImageIO::NiftiImageIO()
   : m_NiftiImageHolder(new NiftiImageProxy(nullptr))
   , m_NiftiImage(*m_NiftiImageHolder.get())
@@ -555,8 +850,11 @@ NiftiImageIO::Read(void * buffer)
     // other dims out of the way
     _size[6] = _size[5];
     _size[5] = _size[4];
+    _origin[6] = _origin[5];
+    _origin[5] = _origin[4];
     // sizes = x y z t vecsize
     _size[4] = numComponents;
+    _origin[4] = 0;
   }
   // Free memory if any was occupied already (incase of re-using the IO filter).
   nifti_image_free(this->m_NiftiImage);
@@ -592,10 +890,7 @@ NiftiImageIO::Read(void * buffer)
   else
   {
     // read in a subregion
-    if (nifti_read_subregion_image(this->m_NiftiImage, _origin, _size, &data) == -1)
-    {
-      itkExceptionMacro(<< "nifti_read_subregion_image failed for file: " << this->GetFileName());
-    }
+    this->ReadSubregion(_origin, _size, &data);
   }
   unsigned int pixelSize = this->m_NiftiImage->nbyper;
   //
@@ -682,10 +977,11 @@ NiftiImageIO::Read(void * buffer)
     // vec x y z t l m o
     const auto * niftibuf = (const char *)data;
     auto *       itkbuf = (char *)buffer;
-    const size_t rowdist = this->m_NiftiImage->dim[1];
-    const size_t slicedist = rowdist * this->m_NiftiImage->dim[2];
-    const size_t volumedist = slicedist * this->m_NiftiImage->dim[3];
-    const size_t seriesdist = volumedist * this->m_NiftiImage->dim[4];
+    // the buffer holds the region read
+    const size_t rowdist = _size[0];
+    const size_t slicedist = rowdist * _size[1];
+    const size_t volumedist = slicedist * _size[2];
+    const size_t seriesdist = volumedist * _size[3];
     //
     // as per ITK bug 0007485
     // NIfTI is lower triangular, ITK is upper triangular.
@@ -704,13 +1000,13 @@ NiftiImageIO::Read(void * buffer)
         vecOrder[i] = i;
       }
     }
-    for (int t = 0; t < this->m_NiftiImage->dim[4]; ++t)
+    for (int t = 0; t < _size[3]; ++t)
     {
-      for (int z = 0; z < this->m_NiftiImage->dim[3]; ++z)
+      for (int z = 0; z < _size[2]; ++z)
       {
-        for (int y = 0; y < this->m_NiftiImage->dim[2]; ++y)
+        for (int y = 0; y < _size[1]; ++y)
         {
-          for (int x = 0; x < this->m_NiftiImage->dim[1]; ++x)
+          for (int x = 0; x < _size[0]; ++x)
           {
             for (unsigned int c = 0; c < numComponents; ++c)
             {
@@ -792,6 +1088,106 @@ NiftiImageIO::Read(void * buffer)
   }
 }
 
+void
+NiftiImageIO::ReadSubregion(const int origin[7], const int size[7], void ** data)
+{
+  const std::string imageFileName(this->m_NiftiImage->iname);
+  const auto        voxelSize = static_cast<SizeValueType>(this->m_NiftiImage->nbyper);
+
+  SizeValueType dims[7];
+  SizeValueType start[7];
+  SizeValueType regionSize[7];
+  SizeValueType numberOfBytes = voxelSize;
+  GetNiftiDimensions(this->m_NiftiImage, dims);
+  for (unsigned int d = 0; d < 7; ++d)
+  {
+    start[d] = static_cast<SizeValueType>(origin[d]);
+    regionSize[d] = static_cast<SizeValueType>(size[d]);
+    if (start[d] + regionSize[d] > dims[d])
+    {
+      itkExceptionMacro(<< "Region to read is outside of the image in file: " << this->GetFileName());
+    }
+    numberOfBytes *= regionSize[d];
+  }
+
+  // Malloc instead of new to be consistent with allocation used in niftilib
+  *data = malloc(numberOfBytes);
+  if (*data == nullptr)
+  {
+    itkExceptionMacro(<< "Failed to allocate " << numberOfBytes << " bytes to read file: " << this->GetFileName());
+  }
+  char * const buffer = static_cast<char *>(*data);
+  const auto   dataOffset = static_cast<SizeValueType>(this->m_NiftiImage->iname_offset);
+
+  bool success = true;
+  if (nifti_is_gzfile(imageFileName.c_str()))
+  {
+    // the index is kept while the same file is read, e.g. in a streamed pipeline
+    if (this->m_GzipIndex == nullptr || !this->m_GzipIndex->IsIndexOf(imageFileName))
+    {
+      this->m_GzipIndex.reset(new GzipIndex(imageFileName));
+    }
+    ForEachContiguousRun(dims,
+                         start,
+                         regionSize,
+                         voxelSize,
+                         [this, buffer, dataOffset, &success](
+                           SizeValueType fileOffset, SizeValueType bufferOffset, SizeValueType runLength) {
+                           success = success &&
+                                     this->m_GzipIndex->Read(dataOffset + fileOffset, buffer + bufferOffset, runLength);
+                         });
+    if (!success)
+    {
+      // e.g. concatenated gzip members: let niftilib inflate the file
+      this->m_GzipIndex.reset();
+      if (nifti_read_subregion_image(this->m_NiftiImage, const_cast<int *>(origin), const_cast<int *>(size), data) ==
+          -1)
+      {
+        itkExceptionMacro(<< "nifti_read_subregion_image failed for file: " << this->GetFileName());
+      }
+      return;
+    }
+  }
+  else
+  {
+    std::ifstream file;
+    this->OpenFileForReading(file, imageFileName);
+    ForEachContiguousRun(
+      dims,
+      start,
+      regionSize,
+      voxelSize,
+      [&file, buffer, dataOffset](SizeValueType fileOffset, SizeValueType bufferOffset, SizeValueType runLength) {
+        file.seekg(static_cast<std::streamoff>(dataOffset + fileOffset));
+        file.read(buffer + bufferOffset, static_cast<std::streamsize>(runLength));
+      });
+    success = !file.fail();
+  }
+  if (!success)
+  {
+    itkExceptionMacro(<< "Failed to read the region " << this->GetIORegion() << " of file: " << this->GetFileName());
+  }
+
+  // same processing as nifti_read_buffer
+  if (this->m_NiftiImage->swapsize > 1 && this->m_NiftiImage->byteorder != nifti_short_order())
+  {
+    nifti_swap_Nbytes(numberOfBytes / this->m_NiftiImage->swapsize, this->m_NiftiImage->swapsize, buffer);
+  }
+  switch (this->m_NiftiImage->datatype)
+  {
+    case NIFTI_TYPE_FLOAT32:
+    case NIFTI_TYPE_COMPLEX64:
+      ZeroNonFiniteValues<float>(buffer, numberOfBytes);
+      break;
+    case NIFTI_TYPE_FLOAT64:
+    case NIFTI_TYPE_COMPLEX128:
+      ZeroNonFiniteValues<double>(buffer, numberOfBytes);
+      break;
+    default:
+      break;
+  }
+}
+
 NiftiImageIOEnums::NiftiFileEnum
 NiftiImageIO::DetermineFileType(const char * FileNameToRead)
 {
@@ -2181,6 +2577,24 @@ NiftiImageIO ::Write(const void * buffer)
 {
   // Write the image Information before writing data
   this->WriteImageInformation();
+
+  // this is a check to see if we are actually streaming
+  // we initialize with m_IORegion to match dimensions
+  ImageIORegion largestRegion(m_IORegion);
+  for (unsigned int ii = 0; ii < largestRegion.GetImageDimension(); ++ii)
+  {
+    largestRegion.SetIndex(ii, 0);
+    largestRegion.SetSize(ii, this->GetDimensions(ii));
+  }
+  if (largestRegion != m_IORegion && m_IORegion.GetImageDimension() > 0)
+  {
+    if (!this->CanStreamWrite())
+    {
+      itkExceptionMacro(<< "Writing a region of the image is not supported for file: " << this->GetFileName());
+    }
+    this->WriteRegion(buffer);
+    return;
+  }
   const unsigned int numComponents = this->GetNumberOfComponents();
   if (numComponents == 1 || (numComponents == 2 && this->GetPixelType() == IOPixelEnum::COMPLEX) ||
       (numComponents == 3 && this->GetPixelType() == IOPixelEnum::RGB) ||
@@ -2275,6 +2689,150 @@ NiftiImageIO ::Write(const void * buffer)
   }
 }
 
+void
+NiftiImageIO::WriteRegion(const void * buffer)
+{
+  const std::string headerFileName(this->m_NiftiImage->fname);
+  const std::string imageFileName(this->m_NiftiImage->iname);
+  const auto        voxelSize = static_cast<SizeValueType>(this->m_NiftiImage->nbyper);
+
+  SizeValueType dims[7];
+  SizeValueType start[7];
+  SizeValueType regionSize[7];
+  SizeValueType imageNumberOfBytes = voxelSize;
+  GetNiftiDimensions(this->m_NiftiImage, dims);
+  for (unsigned int d = 0; d < 7; ++d)
+  {
+    const bool inRegion = d < m_IORegion.GetImageDimension();
+    start[d] = inRegion ? static_cast<SizeValueType>(m_IORegion.GetIndex(d)) : 0;
+    regionSize[d] = inRegion ? m_IORegion.GetSize(d) : 1;
+    imageNumberOfBytes *= dims[d];
+  }
+
+  const bool    createFile =
+    !itksys::SystemTools::FileExists(headerFileName) || !itksys::SystemTools::FileExists(imageFileName);
+  SizeValueType dataOffset;
+  if (createFile)
+  {
+    nifti_image_write_hdr_img(this->m_NiftiImage, 0, "wb");
+    if (!itksys::SystemTools::FileExists(headerFileName))
+    {
+      itkExceptionMacro(<< "Failed to write the header of file: " << this->GetFileName());
+    }
+    dataOffset = static_cast<SizeValueType>(this->m_NiftiImage->iname_offset);
+  }
+  else
+  {
+    // paste in the data of the existing file, which was checked in
+    // GetActualNumberOfSplitsForWriting
+    nifti_image * fileImage = nifti_image_read(headerFileName.c_str(), false);
+    if (fileImage == nullptr)
+    {
+      itkExceptionMacro(<< "nifti_image_read (just header) failed for file: " << this->GetFileName());
+    }
+    dataOffset = static_cast<SizeValueType>(fileImage->iname_offset);
+    nifti_image_free(fileImage);
+  }
+
+  std::ofstream file;
+  this->OpenFileForWriting(file, imageFileName, false);
+  if (createFile)
+  {
+    // the voxels which are not written are null
+    file.seekp(static_cast<std::streamoff>(dataOffset + imageNumberOfBytes - 1));
+    file.put('\0');
+  }
+  const auto * const data = static_cast<const char *>(buffer);
+  ForEachContiguousRun(
+    dims,
+    start,
+    regionSize,
+    voxelSize,
+    [&file, data, dataOffset](SizeValueType fileOffset, SizeValueType bufferOffset, SizeValueType runLength) {
+      file.seekp(static_cast<std::streamoff>(dataOffset + fileOffset));
+      file.write(data + bufferOffset, static_cast<std::streamsize>(runLength));
+    });
+  if (file.fail())
+  {
+    itkExceptionMacro(<< "Failed to write the region " << m_IORegion << " of file: " << this->GetFileName());
+  }
+}
+
+bool
+NiftiImageIO::CanStreamWrite()
+{
+  const std::string fileName(this->GetFileName());
+  const char *      extension = nifti_find_file_extension(fileName.c_str());
+  if (extension == nullptr || nifti_is_gzfile(fileName.c_str()) ||
+      itksys::SystemTools::LowerCase(extension) == ".nia")
+  {
+    return false;
+  }
+  // the vector images are rearranged on write
+  const unsigned int numComponents = this->GetNumberOfComponents();
+  return numComponents == 1 || (numComponents == 2 && this->GetPixelType() == IOPixelEnum::COMPLEX) ||
+         (numComponents == 3 && this->GetPixelType() == IOPixelEnum::RGB) ||
+         (numComponents == 4 && this->GetPixelType() == IOPixelEnum::RGBA);
+}
+
+unsigned int
+NiftiImageIO::GetActualNumberOfSplitsForWriting(unsigned int          numberOfRequestedSplits,
+                                                const ImageIORegion & pasteRegion,
+                                                const ImageIORegion & largestPossibleRegion)
+{
+  if (!this->CanStreamWrite())
+  {
+    return Superclass::GetActualNumberOfSplitsForWriting(numberOfRequestedSplits, pasteRegion, largestPossibleRegion);
+  }
+
+  // fill in the header, for the names of the files and the layout of the data
+  this->WriteImageInformation();
+  const std::string headerFileName(this->m_NiftiImage->fname);
+  const std::string imageFileName(this->m_NiftiImage->iname);
+
+  if (!itksys::SystemTools::FileExists(headerFileName) || !itksys::SystemTools::FileExists(imageFileName))
+  {
+    // file doesn't exits so we don't have potential problems
+  }
+  else if (pasteRegion != largestPossibleRegion)
+  {
+    // we are going to be pasting (may be streaming too)
+
+    // need to check that the data of the file has the same layout
+    nifti_image * fileImage = nifti_image_read(headerFileName.c_str(), false);
+    bool          sameLayout =
+      fileImage != nullptr && fileImage->datatype == this->m_NiftiImage->datatype &&
+      fileImage->byteorder == nifti_short_order() &&
+      (fileImage->scl_slope == 0.0f || (fileImage->scl_slope == 1.0f && fileImage->scl_inter == 0.0f));
+    if (sameLayout)
+    {
+      SizeValueType fileDims[7];
+      SizeValueType dims[7];
+      GetNiftiDimensions(fileImage, fileDims);
+      GetNiftiDimensions(this->m_NiftiImage, dims);
+      sameLayout = std::equal(fileDims, fileDims + 7, dims);
+    }
+    nifti_image_free(fileImage);
+    if (!sameLayout)
+    {
+      itkExceptionMacro("Unable to paste because pasting file exists and is different: " << this->GetFileName());
+    }
+  }
+  else if (numberOfRequestedSplits != 1)
+  {
+    // we are going be streaming
+
+    // need to remove the file incase the file doesn't match our
+    // current header/meta data information
+    if (!itksys::SystemTools::RemoveFile(headerFileName) || !itksys::SystemTools::RemoveFile(imageFileName))
+    {
+      itkExceptionMacro("Unable to remove file for streaming: " << this->GetFileName());
+    }
+  }
+
+  return GetActualNumberOfSplitsForWritingCanStreamWrite(numberOfRequestedSplits, pasteRegion);
+}
+
 std::ostream &
 operator<<(std::ostream & out, const NiftiImageIOEnums::Analyze75Flavor value)
 {
@@ -0,0 +1,222 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkNiftiImageIOTest.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+// Streamed reads and writes of NIfTI files
+
+namespace
+{
+using ImageType = itk::Image<float, 4>;
+
+float
+ExpectedValue(const ImageType::IndexType & index)
+{
+  return static_cast<float>(index[0] + 100 * index[1] + 10000 * index[2] + 1000000 * index[3]);
+}
+
+ImageType::RegionType
+MakeRegion(const ImageType::IndexType & index, const ImageType::SizeType & size)
+{
+  return ImageType::RegionType(index, size);
+}
+
+// Read the region of the file through imageIO, and check that only the
+// region was read, with the expected values. pasteRegion, if not empty,
+// holds the value pasteValue.
+bool
+ReadAndCheckRegion(itk::NiftiImageIO *           imageIO,
+                   const std::string &           fileName,
+                   const ImageType::RegionType & region,
+                   const ImageType::RegionType & pasteRegion = ImageType::RegionType(),
+                   float                         pasteValue = 0)
+{
+  auto reader = itk::ImageFileReader<ImageType>::New();
+  reader->SetImageIO(imageIO);
+  reader->SetFileName(fileName);
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+
+  const ImageType * image = reader->GetOutput();
+  if (image->GetBufferedRegion() != region)
+  {
+    std::cerr << "Read " << image->GetBufferedRegion() << " instead of " << region << " from " << fileName
+              << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const float expected = pasteRegion.IsInside(it.GetIndex()) ? pasteValue : ExpectedValue(it.GetIndex());
+    if (itk::Math::NotExactlyEquals(it.Get(), expected))
+    {
+      std::cerr << "Read " << it.Get() << " instead of " << expected << " at " << it.GetIndex() << " from "
+                << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkNiftiImageIOTest13(int ac, char * av[])
+{
+  if (ac != 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(av) << " <TempOutputDirectory>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  itksys::SystemTools::ChangeDirectory(av[1]);
+
+  // more than a MiB per volume, to have several access points in the
+  // compressed files
+  const ImageType::RegionType largestRegion = MakeRegion({ { 0, 0, 0, 0 } }, { { 64, 64, 32, 5 } });
+
+  auto image = ImageType::New();
+  image->SetRegions(largestRegion);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, largestRegion); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue(it.GetIndex()));
+  }
+
+  // a volume, a slab, a region of interest, then backward in the file
+  const std::vector<ImageType::RegionType> regions = { MakeRegion({ { 0, 0, 0, 3 } }, { { 64, 64, 32, 1 } }),
+                                                       MakeRegion({ { 0, 0, 10, 1 } }, { { 64, 64, 5, 2 } }),
+                                                       MakeRegion({ { 5, 7, 9, 2 } }, { { 11, 13, 3, 3 } }),
+                                                       MakeRegion({ { 0, 0, 0, 4 } }, { { 64, 64, 32, 1 } }),
+                                                       MakeRegion({ { 0, 0, 31, 0 } }, { { 64, 64, 1, 1 } }),
+                                                       largestRegion };
+
+  int testStatus = EXIT_SUCCESS;
+
+  for (const std::string fileName : { "streaming.nii", "streaming.nii.gz", "streaming.hdr", "streaming.img.gz" })
+  {
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetImageIO(itk::NiftiImageIO::New());
+    writer->SetFileName(fileName);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    // the same ImageIO reads all the regions, as in a streamed pipeline
+    auto imageIO = itk::NiftiImageIO::New();
+    ITK_TEST_EXPECT_TRUE(imageIO->CanStreamRead());
+    for (const auto & region : regions)
+    {
+      if (!ReadAndCheckRegion(imageIO, fileName, region))
+      {
+        testStatus = EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Streamed writing
+  for (const std::string fileName : { "streamed.nii", "streamed.hdr" })
+  {
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetImageIO(itk::NiftiImageIO::New());
+    writer->SetFileName(fileName);
+    writer->SetNumberOfStreamDivisions(7);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+    ITK_TEST_EXPECT_TRUE(writer->GetImageIO()->CanStreamWrite());
+
+    if (!ReadAndCheckRegion(itk::NiftiImageIO::New(), fileName, largestRegion))
+    {
+      testStatus = EXIT_FAILURE;
+    }
+  }
+
+  // Pasting in an existing file. The writer pastes only when its input is
+  // streamed, so the pasted image is read from a file.
+  {
+    auto pasteImage = ImageType::New();
+    pasteImage->SetRegions(largestRegion);
+    pasteImage->Allocate();
+    pasteImage->FillBuffer(-1.0f);
+    itk::IOTestHelper::WriteImage<ImageType, itk::NiftiImageIO>(pasteImage, "paste.nii");
+
+    auto pasteReader = itk::ImageFileReader<ImageType>::New();
+    pasteReader->SetFileName("paste.nii");
+
+    const ImageType::RegionType pasteRegion = MakeRegion({ { 3, 4, 5, 1 } }, { { 10, 10, 10, 2 } });
+    itk::ImageIORegion          pasteIORegion(ImageType::ImageDimension);
+    itk::ImageIORegionAdaptor<ImageType::ImageDimension>::Convert(
+      pasteRegion, pasteIORegion, largestRegion.GetIndex());
+
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(pasteReader->GetOutput());
+    writer->SetImageIO(itk::NiftiImageIO::New());
+    writer->SetFileName("streamed.nii");
+    writer->SetIORegion(pasteIORegion);
+    ITK_TRY_EXPECT_NO_EXCEPTION(writer->Update());
+
+    if (!ReadAndCheckRegion(itk::NiftiImageIO::New(), "streamed.nii", largestRegion, pasteRegion, -1.0f))
+    {
+      testStatus = EXIT_FAILURE;
+    }
+
+    // a region cannot be written in a compressed file
+    writer->SetFileName("streaming.nii.gz");
+    ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+  }
+
+  // Streamed reading of an image of vectors, which are stored in the fifth
+  // dimension of the file
+  {
+    using VectorImageType = itk::VectorImage<float, 3>;
+    const VectorImageType::RegionType vectorLargestRegion({ { 0, 0, 0 } }, { { 8, 7, 6 } });
+    auto                              vectorImage = VectorImageType::New();
+    vectorImage->SetRegions(vectorLargestRegion);
+    vectorImage->SetNumberOfComponentsPerPixel(2);
+    vectorImage->Allocate();
+    for (itk::ImageRegionIteratorWithIndex<VectorImageType> it(vectorImage, vectorLargestRegion); !it.IsAtEnd(); ++it)
+    {
+      VectorImageType::PixelType value(2);
+      value[0] = static_cast<float>(it.GetIndex()[0] + 10 * it.GetIndex()[1] + 100 * it.GetIndex()[2]);
+      value[1] = -value[0];
+      it.Set(value);
+    }
+    itk::IOTestHelper::WriteImage<VectorImageType, itk::NiftiImageIO>(vectorImage, "streamingvector.nii");
+
+    const VectorImageType::RegionType region({ { 2, 1, 3 } }, { { 4, 5, 2 } });
+    auto                              reader = itk::ImageFileReader<VectorImageType>::New();
+    reader->SetFileName("streamingvector.nii");
+    reader->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(region);
+    ITK_TRY_EXPECT_NO_EXCEPTION(reader->Update());
+    ITK_TEST_EXPECT_EQUAL(reader->GetOutput()->GetBufferedRegion(), region);
+    for (itk::ImageRegionConstIteratorWithIndex<VectorImageType> it(reader->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      if (it.Get() != vectorImage->GetPixel(it.GetIndex()))
+      {
+        std::cerr << "Read " << it.Get() << " instead of " << vectorImage->GetPixel(it.GetIndex()) << " at "
+                  << it.GetIndex() << std::endl;
+        testStatus = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
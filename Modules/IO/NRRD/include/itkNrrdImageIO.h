@@ -78,6 +78,13 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Maps the data directly from the file. This is supported for "raw"
+   * encoded data in native byte order, attached to the header or stored in
+   * a single detached data file, whose non-scalar axis (if any) is the
+   * fastest one. */
+  MemoryMappedBufferPointer
+  MemoryMapRead() override;
+
   /** Determine the file type. Returns true if this ImageIO can write the
    * file specified. */
   bool
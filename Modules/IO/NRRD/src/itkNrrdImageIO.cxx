@@ -22,6 +22,7 @@
 #include "itkMetaDataObject.h"
 #include "itkIOCommon.h"
 #include "itkFloatingPointExceptions.h"
+#include "itksys/SystemTools.hxx"
 
 namespace itk
 {
@@ -849,6 +850,76 @@ NrrdImageIO::Read(void * buffer)
   }
 }
 
+ImageIOBase::MemoryMappedBufferPointer
+NrrdImageIO::MemoryMapRead()
+{
+  // Masked tensors are cropped by Read(), hence do not match the file layout
+  if (IOPixelEnum::SYMMETRICSECONDRANKTENSOR == this->GetPixelType())
+  {
+    return nullptr;
+  }
+
+  Nrrd *        nrrd = nrrdNew();
+  NrrdIoState * nio = nrrdIoStateNew();
+
+  // Read the header only, and keep the data file open, positioned at the
+  // first byte of the data.
+  nrrdIoStateSet(nio, nrrdIoStateSkipData, 1);
+  nrrdIoStateSet(nio, nrrdIoStateKeepNrrdDataFileOpen, 1);
+
+#if !defined(__MINGW32__) && (defined(ITK_HAS_FEENABLEEXCEPT) || defined(_MSC_VER))
+  // nrrd causes exceptions on purpose, so mask them
+  bool saveFPEState{ FloatingPointExceptions::GetExceptionAction() ==
+                     itk::FloatingPointExceptions::ExceptionActionEnum::EXIT };
+  FloatingPointExceptions::Disable();
+#endif
+
+  MemoryMappedBufferPointer mappedBuffer;
+  if (nrrdLoad(nrrd, this->GetFileName(), nio) != 0)
+  {
+    free(biffGetDone(NRRD));
+  }
+  else
+  {
+    unsigned int       rangeAxisIdx[NRRD_DIM_MAX];
+    const unsigned int rangeAxisNum = nrrdRangeAxesGet(nrrd, rangeAxisIdx);
+    const bool         rangeAxisIsFastest = (0 == rangeAxisNum) || (1 == rangeAxisNum && 0 == rangeAxisIdx[0]);
+    const bool         nativeByteOrder =
+      (airEndianUnknown == nio->endian) || (airMyEndian() == nio->endian) || (1 == nrrdElementSize(nrrd));
+    const bool singleDataFile = (nullptr == nio->dataFNFormat) && (nio->dataFNArr->len <= 1);
+
+    if (nrrdEncodingRaw == nio->encoding && nativeByteOrder && rangeAxisIsFastest && singleDataFile &&
+        nullptr != nio->dataFile)
+    {
+      std::string dataFileName = this->GetFileName();
+      if (1 == nio->dataFNArr->len)
+      {
+        dataFileName = nio->dataFN[0];
+        if (!itksys::SystemTools::FileIsFullPath(dataFileName) && airStrlen(nio->path))
+        {
+          dataFileName = std::string(nio->path) + '/' + dataFileName;
+        }
+      }
+      const long dataOffset = ftell(nio->dataFile);
+      if (dataOffset >= 0)
+      {
+        mappedBuffer = this->MemoryMapIORegion(dataFileName, static_cast<SizeType>(dataOffset));
+      }
+    }
+  }
+
+#if !defined(__MINGW32__) && (defined(ITK_HAS_FEENABLEEXCEPT) || defined(_MSC_VER))
+  // restore state
+  FloatingPointExceptions::SetEnabled(saveFPEState);
+#endif
+
+  airFclose(nio->dataFile);
+  nrrdNuke(nrrd);
+  nrrdIoStateNix(nio);
+
+  return mappedBuffer;
+}
+
 bool
 NrrdImageIO::CanWriteFile(const char * name)
 {
@@ -123,6 +123,11 @@ public:
   void
   Read(void * buffer) override;
 
+  /** Maps the data directly from the file, following the header. This is
+   * supported for binary files stored in native byte order. */
+  MemoryMappedBufferPointer
+  MemoryMapRead() override;
+
   /** Set/Get the Data mask. */
   itkGetConstReferenceMacro(ImageMask, unsigned short);
   void
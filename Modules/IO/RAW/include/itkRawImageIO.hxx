@@ -161,6 +161,24 @@ RawImageIO<TPixel, VImageDimension>::Read(void * buffer)
   ReadRawBytesAfterSwapping(componentType, buffer, m_ByteOrder, numberOfComponents);
 }
 
+template <typename TPixel, unsigned int VImageDimension>
+ImageIOBase::MemoryMappedBufferPointer
+RawImageIO<TPixel, VImageDimension>::MemoryMapRead()
+{
+  if (m_FileType != IOFileEnum::Binary)
+  {
+    return nullptr;
+  }
+  const bool systemIsBigEndian = ByteSwapper<char>::SystemIsBigEndian();
+  if (this->GetComponentSize() > 1 && ((m_ByteOrder == IOByteOrderEnum::BigEndian && !systemIsBigEndian) ||
+                                       (m_ByteOrder == IOByteOrderEnum::LittleEndian && systemIsBigEndian)))
+  {
+    return nullptr;
+  }
+
+  return this->MemoryMapIORegion(m_FileName, this->GetHeaderSize());
+}
+
 template <typename TPixel, unsigned int VImageDimension>
 bool
 RawImageIO<TPixel, VImageDimension>::CanWriteFile(const char * fname)
@@ -38,6 +38,11 @@ class TIFFReaderInternal;
  * supports the compression level for JPEG quality parameter in the
  * range 0-100.
  *
+ * Images which are stored natively (grayscale, RGB or palette pixels of 8,
+ * 16 or 32 bits per sample) can be streamed: only the strips or tiles which
+ * intersect the requested region are decoded, in parallel. Images can be
+ * written as tiles, see SetTileWidth() and SetTileHeight().
+ *
  * \ingroup IOFilters
  * \ingroup ITKIOTIFF
  *
@@ -83,6 +88,21 @@ public:
   virtual void
   ReadVolume(void * buffer);
 
+  /** The images which are read natively can be streamed. Images which are
+   * read through the RGBA interface of libtiff, such as YCbCr or 1 bit
+   * images, are read whole. The file must have been read by
+   * ReadImageInformation(). */
+  bool
+  CanStreamRead() override
+  {
+    return m_CanStreamRead;
+  }
+
+  /** The streamable region is the requested region when the file can be
+   * streamed, and the largest possible region otherwise. */
+  ImageIORegion
+  GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const override;
+
   /*-------- This part of the interfaces deals with writing data. ----- */
 
   /** Determine the file type. Returns true if this ImageIO can read the
@@ -172,6 +192,16 @@ public:
   }
 
 
+  /** Set/Get the size of the tiles of the written images, in pixels. When
+   * both are not zero, the pages are written as tiles, which are compressed
+   * independently, instead of strips of rows. Tiled images are efficiently
+   * read by regions. The TIFF specification requires multiples of 16.
+   * Default is 0, to write strips. */
+  itkSetMacro(TileWidth, unsigned int);
+  itkGetConstMacro(TileWidth, unsigned int);
+  itkSetMacro(TileHeight, unsigned int);
+  itkGetConstMacro(TileHeight, unsigned int);
+
   /** Get a const ref to the palette of the image. In the case of non palette
    * image or ExpandRGBPalette set to true, a vector of size
    * 0 is returned.
@@ -259,6 +289,20 @@ private:
   void
   ReadGenericImage(void * _out, unsigned int width, unsigned int height);
 
+  /** Read the IORegion from the strips or tiles of the pages, which must be
+   * read natively. */
+  void
+  ReadRegion(void * buffer);
+
+  template <typename TComponent>
+  void
+  ReadRegion(void * buffer);
+
+  /** Convert a row of width pixels, as decoded from the file. */
+  template <typename TComponent>
+  void
+  PutRow(TComponent * to, void * from, unsigned int width);
+
   template <typename TComponent>
   void
   RGBAImageToBuffer(void * out, const uint32_t * tempImage);
@@ -309,6 +353,9 @@ private:
   uint16_t *   m_ColorBlue;
   uint64_t     m_TotalColors{ 0 };
   unsigned int m_ImageFormat{ TIFFImageIO::NOFORMAT };
+  bool         m_CanStreamRead{ false };
+  unsigned int m_TileWidth{ 0 };
+  unsigned int m_TileHeight{ 0 };
 };
 } // end namespace itk
 
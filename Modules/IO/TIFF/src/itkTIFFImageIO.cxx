@@ -20,12 +20,51 @@
 #include "itkTIFFReaderInternal.h"
 #include "itksys/SystemTools.hxx"
 #include "itkMetaDataObject.h"
+#include "itkMultiThreaderBase.h"
 
 #include "itk_tiff.h"
 
+#include <algorithm>
+#include <atomic>
+
 namespace itk
 {
 
+namespace
+{
+// A strip or a tile of a page, which intersects the region being read
+struct TIFFBlock
+{
+  tdir_t   Directory;
+  bool     Tiled;
+  uint32_t Number;
+  uint32_t X;
+  uint32_t Row;
+  uint32_t Width;
+  uint32_t Height;
+  size_t   PageOffset; // of the page in the region, in pixels
+};
+
+// Make directory the current directory of tiff, reading the following
+// directories rather than going through the previous ones when possible
+bool
+SetTIFFDirectory(TIFF * tiff, tdir_t directory)
+{
+  if (TIFFCurrentDirectory(tiff) > directory)
+  {
+    return TIFFSetDirectory(tiff, directory) == 1;
+  }
+  while (TIFFCurrentDirectory(tiff) < directory)
+  {
+    if (TIFFReadDirectory(tiff) != 1)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
 bool
 TIFFImageIO::CanReadFile(const char * file)
 {
@@ -189,9 +228,13 @@ TIFFImageIO::Read(void * buffer)
     }
   }
 
+  if (m_InternalImage->CanRead())
+  {
+    this->ReadRegion(buffer);
+  }
   // The IO region should be of dimensions 3 otherwise we read only the first
   // page
-  if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
+  else if (m_InternalImage->m_NumberOfPages > 0 && this->GetIORegion().GetImageDimension() > 2)
   {
     this->ReadVolume(buffer);
   }
@@ -203,6 +246,37 @@ TIFFImageIO::Read(void * buffer)
   m_InternalImage->Clean();
 }
 
+void
+TIFFImageIO::ReadRegion(void * buffer)
+{
+  switch (m_ComponentType)
+  {
+    case IOComponentEnum::UCHAR:
+      this->ReadRegion<unsigned char>(buffer);
+      break;
+    case IOComponentEnum::CHAR:
+      this->ReadRegion<char>(buffer);
+      break;
+    case IOComponentEnum::USHORT:
+      this->ReadRegion<unsigned short>(buffer);
+      break;
+    case IOComponentEnum::SHORT:
+      this->ReadRegion<short>(buffer);
+      break;
+    case IOComponentEnum::UINT:
+      this->ReadRegion<unsigned int>(buffer);
+      break;
+    case IOComponentEnum::INT:
+      this->ReadRegion<int>(buffer);
+      break;
+    case IOComponentEnum::FLOAT:
+      this->ReadRegion<float>(buffer);
+      break;
+    default:
+      itkExceptionMacro("Logic Error: Unexpected component type!");
+  }
+}
+
 TIFFImageIO::TIFFImageIO()
   : m_ColorPalette(0)
 
@@ -248,6 +322,8 @@ TIFFImageIO::PrintSelf(std::ostream & os, Indent indent) const
 
   os << indent << "Compression: " << m_Compression << std::endl;
   os << indent << "JPEGQuality: " << this->GetJPEGQuality() << std::endl;
+  os << indent << "TileWidth: " << m_TileWidth << std::endl;
+  os << indent << "TileHeight: " << m_TileHeight << std::endl;
   if (!m_ColorPalette.empty())
   {
     os << indent << "Image RGB palette:"
@@ -528,6 +604,18 @@ TIFFImageIO::ReadImageInformation()
     // make sure the palette is empty
     m_ColorPalette.resize(0);
   }
+
+  m_CanStreamRead = m_InternalImage->CanRead();
+}
+
+ImageIORegion
+TIFFImageIO::GenerateStreamableReadRegionFromRequestedRegion(const ImageIORegion & requestedRegion) const
+{
+  if (!m_UseStreamedReading || !m_CanStreamRead)
+  {
+    return ImageIOBase::GenerateStreamableReadRegionFromRequestedRegion(requestedRegion);
+  }
+  return requestedRegion;
 }
 
 bool
@@ -605,6 +693,13 @@ TIFFImageIO::InternalWrite(const void * buffer)
 
   uint16_t predictor;
 
+  const bool tiled = m_TileWidth > 0 && m_TileHeight > 0;
+  if (tiled && (m_TileWidth % 16 != 0 || m_TileHeight % 16 != 0))
+  {
+    itkExceptionMacro(<< "The tile width and height must be multiples of 16, not " << m_TileWidth << " and "
+                      << m_TileHeight);
+  }
+
   const char * mode = "w";
 
   // If the size of the image is greater than 2 GiB then use big tiff
@@ -762,22 +857,30 @@ TIFFImageIO::InternalWrite(const void * buffer)
     // Using 1 MB per strip leads to 256 rows per strip, which takes only 4 seconds to write over sshfs.
     // Rather than change that value in the third party libtiff library, we instead compute the
     // rowsperstrip here to lead to this same value.
-#ifdef TIFF_INT64_T // detect if libtiff4
-    uint64_t scanlinesize = TIFFScanlineSize64(tif);
-#else
-    tsize_t scanlinesize = TIFFScanlineSize(tif);
-#endif
-    if (scanlinesize == 0)
+    if (tiled)
     {
-      itkExceptionMacro("TIFFScanlineSize returned 0");
+      TIFFSetField(tif, TIFFTAG_TILEWIDTH, m_TileWidth);
+      TIFFSetField(tif, TIFFTAG_TILELENGTH, m_TileHeight);
     }
-    rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
-    if (rowsperstrip < 1)
+    else
     {
-      rowsperstrip = 1;
-    }
+#ifdef TIFF_INT64_T // detect if libtiff4
+      uint64_t scanlinesize = TIFFScanlineSize64(tif);
+#else
+      tsize_t scanlinesize = TIFFScanlineSize(tif);
+#endif
+      if (scanlinesize == 0)
+      {
+        itkExceptionMacro("TIFFScanlineSize returned 0");
+      }
+      rowsperstrip = static_cast<uint32_t>(1024 * 1024 / scanlinesize);
+      if (rowsperstrip < 1)
+      {
+        rowsperstrip = 1;
+      }
 
-    TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+      TIFFSetField(tif, TIFFTAG_ROWSPERSTRIP, TIFFDefaultStripSize(tif, rowsperstrip));
+    }
 
     if (resolution_x > 0 && resolution_y > 0)
     {
@@ -817,17 +920,49 @@ TIFFImageIO::InternalWrite(const void * buffer)
     }
 
     rowLength *= this->GetNumberOfComponents();
+    const SizeValueType pixelLength = rowLength; // in bytes
     rowLength *= width;
 
-    uint32_t row = 0;
-    for (unsigned int idx2 = 0; idx2 < height; ++idx2)
+    if (tiled)
+    {
+      // Each tile is compressed independently. The tiles on the right and
+      // bottom edges are padded with zeros.
+      const tmsize_t    tileSize = TIFFTileSize(tif);
+      const size_t      tileRowLength = pixelLength * m_TileWidth;
+      std::vector<char> tile(static_cast<size_t>(tileSize));
+      for (uint32_t y = 0; y < h; y += m_TileHeight)
+      {
+        for (uint32_t x = 0; x < w; x += m_TileWidth)
+        {
+          const uint32_t tileWidth = std::min(m_TileWidth, w - x);
+          const uint32_t tileHeight = std::min(m_TileHeight, h - y);
+          std::fill(tile.begin(), tile.end(), char{ 0 });
+          for (uint32_t row = 0; row < tileHeight; ++row)
+          {
+            std::copy_n(outPtr + (y + row) * rowLength + x * pixelLength,
+                        tileWidth * pixelLength,
+                        tile.data() + row * tileRowLength);
+          }
+          if (TIFFWriteEncodedTile(tif, TIFFComputeTile(tif, x, y, 0, 0), tile.data(), tileSize) < 0)
+          {
+            itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
+          }
+        }
+      }
+      outPtr += rowLength * height;
+    }
+    else
     {
-      if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+      uint32_t row = 0;
+      for (unsigned int idx2 = 0; idx2 < height; ++idx2)
       {
-        itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
+        if (TIFFWriteScanline(tif, const_cast<char *>(outPtr), row, 0) < 0)
+        {
+          itkExceptionMacro(<< "TIFFImageIO: error out of disk space");
+        }
+        outPtr += rowLength;
+        ++row;
       }
-      outPtr += rowLength;
-      ++row;
     }
 
     if (m_NumberOfDimensions == 3)
@@ -1418,71 +1553,254 @@ TIFFImageIO::ReadGenericImage(void * _out, unsigned int width, unsigned int heig
       image = out + inc * width * (height - (row + 1));
     }
 
-    switch (this->GetFormat())
+    this->PutRow<ComponentType>(image, buf, width);
+  }
+
+  _TIFFfree(buf);
+}
+
+template <typename TComponent>
+void
+TIFFImageIO::ReadRegion(void * buffer)
+{
+  TIFF * const   image = m_InternalImage->m_Image;
+  const uint32_t width = m_InternalImage->m_Width;
+  const uint32_t height = m_InternalImage->m_Height;
+
+  const ImageIORegion & region = this->GetIORegion();
+  const auto            regionX = static_cast<uint32_t>(region.GetIndex(0));
+  const auto            regionY = static_cast<uint32_t>(region.GetIndex(1));
+  const auto            regionWidth = static_cast<uint32_t>(region.GetSize(0));
+  const auto            regionHeight = static_cast<uint32_t>(region.GetSize(1));
+
+  // The IO region should be of dimensions 3 otherwise we read only the first
+  // page
+  uint32_t regionPage = 0;
+  uint32_t numberOfRegionPages = 1;
+  if (region.GetImageDimension() > 2)
+  {
+    regionPage = static_cast<uint32_t>(region.GetIndex(2));
+    numberOfRegionPages = static_cast<uint32_t>(region.GetSize(2));
+  }
+
+  // The rows of the region in the file, where they are upside down for
+  // ORIENTATION_BOTLEFT
+  const bool     bottomLeft = (m_InternalImage->m_Orientation == ORIENTATION_BOTLEFT);
+  const uint32_t firstRow = bottomLeft ? height - regionY - regionHeight : regionY;
+  const uint32_t endRow = firstRow + regionHeight;
+
+  const size_t numberOfComponents = this->GetNumberOfComponents();
+  const size_t bytesPerPixel = size_t{ m_InternalImage->m_SamplesPerPixel } * (m_InternalImage->m_BitsPerSample / 8);
+  const bool   isPalette = (this->GetFormat() == TIFFImageIO::PALETTE_GRAYSCALE ||
+                          this->GetFormat() == TIFFImageIO::PALETTE_RGB);
+
+  auto * const out = static_cast<TComponent *>(buffer);
+
+  std::vector<TIFFBlock> blocks;
+
+  // Decode the blocks in parallel, and copy their intersection with the region
+  const auto decodeBlocks = [&]() {
+    const auto          multiThreader = MultiThreaderBase::New();
+    const SizeValueType numberOfBlocks = blocks.size();
+    const SizeValueType numberOfChunks =
+      std::min(numberOfBlocks, static_cast<SizeValueType>(multiThreader->GetNumberOfWorkUnits()));
+    std::atomic<bool> failed{ false };
+    multiThreader->ParallelizeArray(
+      0,
+      numberOfChunks,
+      [&](SizeValueType chunk) {
+        // A TIFF handle cannot be shared between threads
+        TIFF * tiff = (numberOfChunks == 1) ? image : TIFFOpen(m_FileName.c_str(), "r");
+        if (tiff == nullptr)
+        {
+          failed = true;
+          return;
+        }
+
+        std::vector<uint8_t> decoded;
+        const SizeValueType  endBlock = (chunk + 1) * numberOfBlocks / numberOfChunks;
+        for (SizeValueType b = chunk * numberOfBlocks / numberOfChunks; b < endBlock && !failed; ++b)
+        {
+          const TIFFBlock & block = blocks[b];
+          if (!SetTIFFDirectory(tiff, block.Directory))
+          {
+            failed = true;
+            break;
+          }
+
+          const tmsize_t blockSize = block.Tiled ? TIFFTileSize(tiff) : TIFFStripSize(tiff);
+          const tmsize_t rowSize = block.Tiled ? TIFFTileRowSize(tiff) : TIFFScanlineSize(tiff);
+          decoded.resize(static_cast<size_t>(blockSize));
+          const tmsize_t decodedSize =
+            block.Tiled ? TIFFReadEncodedTile(tiff, block.Number, decoded.data(), blockSize)
+                        : TIFFReadEncodedStrip(tiff, block.Number, decoded.data(), blockSize);
+          if (decodedSize < 0)
+          {
+            failed = true;
+            break;
+          }
+
+          const uint32_t xBegin = std::max(block.X, regionX);
+          const uint32_t xEnd = std::min(block.X + block.Width, regionX + regionWidth);
+          const uint32_t rowBegin = std::max(block.Row, firstRow);
+          const uint32_t rowEnd = std::min(block.Row + block.Height, endRow);
+          for (uint32_t row = rowBegin; row < rowEnd; ++row)
+          {
+            const uint32_t y = bottomLeft ? height - 1 - row : row;
+            TComponent *   to =
+              out + (block.PageOffset + size_t{ y - regionY } * regionWidth + (xBegin - regionX)) * numberOfComponents;
+            uint8_t * from = decoded.data() + size_t{ row - block.Row } * rowSize + (xBegin - block.X) * bytesPerPixel;
+            this->PutRow<TComponent>(to, from, xEnd - xBegin);
+          }
+        }
+
+        if (tiff != image)
+        {
+          TIFFClose(tiff);
+        }
+      },
+      nullptr);
+    if (failed)
     {
-      case TIFFImageIO::GRAYSCALE:
-        // check inverted
-        PutGrayscale<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
-      case TIFFImageIO::RGB_:
-        PutRGB_<ComponentType>(image, static_cast<ComponentType *>(buf), width, 1, 0, 0);
-        break;
+      itkExceptionMacro(<< "Cannot read the strips or tiles of " << m_FileName);
+    }
+    blocks.clear();
+  };
+
+  uint32_t page = 0;
+  for (tdir_t directory = 0; directory < m_InternalImage->m_NumberOfPages && page < regionPage + numberOfRegionPages;
+       ++directory)
+  {
+    if (!SetTIFFDirectory(image, directory))
+    {
+      itkExceptionMacro(<< "Cannot read the directory " << directory << " of " << m_FileName);
+    }
+    if (m_InternalImage->m_IgnoredSubFiles > 0)
+    {
+      int32_t subfiletype = 6;
+      if (TIFFGetField(image, TIFFTAG_SUBFILETYPE, &subfiletype) &&
+          (subfiletype & FILETYPE_REDUCEDIMAGE || subfiletype & FILETYPE_MASK))
+      {
+        // skip subfile
+        continue;
+      }
+    }
+    if (page < regionPage)
+    {
+      ++page;
+      continue;
+    }
+    const size_t pageOffset = size_t{ page - regionPage } * regionWidth * regionHeight;
+    ++page;
+
+    const bool tiled = TIFFIsTiled(image);
+    uint32_t   blockWidth = width;
+    uint32_t   blockHeight = height;
+    if (tiled)
+    {
+      TIFFGetField(image, TIFFTAG_TILEWIDTH, &blockWidth);
+      TIFFGetField(image, TIFFTAG_TILELENGTH, &blockHeight);
+    }
+    else
+    {
+      TIFFGetFieldDefaulted(image, TIFFTAG_ROWSPERSTRIP, &blockHeight);
+      blockHeight = std::min(blockHeight, height);
+    }
+    if (blockWidth == 0 || blockHeight == 0)
+    {
+      itkExceptionMacro(<< "Invalid strip or tile size in " << m_FileName);
+    }
+
+    for (uint32_t row = firstRow - firstRow % blockHeight; row < endRow; row += blockHeight)
+    {
+      for (uint32_t x = regionX - regionX % blockWidth; x < regionX + regionWidth; x += blockWidth)
+      {
+        const uint32_t number = tiled ? TIFFComputeTile(image, x, row, 0, 0) : TIFFComputeStrip(image, row, 0);
+        blocks.push_back(TIFFBlock{ directory, tiled, number, x, row, blockWidth, blockHeight, pageOffset });
+      }
+    }
+
+    // The colors of the palette belong to the current directory
+    if (isPalette)
+    {
+      this->InitializeColors();
+      decodeBlocks();
+    }
+  }
+
+  if (page < regionPage + numberOfRegionPages)
+  {
+    itkExceptionMacro(<< "Cannot read the page " << page << " of " << m_FileName);
+  }
+  decodeBlocks();
+}
 
-      case TIFFImageIO::PALETTE_GRAYSCALE:
+template <typename TComponent>
+void
+TIFFImageIO::PutRow(TComponent * to, void * from, unsigned int width)
+{
+  using ComponentType = TComponent;
+
+  switch (this->GetFormat())
+  {
+    case TIFFImageIO::GRAYSCALE:
+      // check inverted
+      PutGrayscale<ComponentType>(to, static_cast<ComponentType *>(from), width, 1, 0, 0);
+      break;
+    case TIFFImageIO::RGB_:
+      PutRGB_<ComponentType>(to, static_cast<ComponentType *>(from), width, 1, 0, 0);
+      break;
+
+    case TIFFImageIO::PALETTE_GRAYSCALE:
+      switch (m_InternalImage->m_BitsPerSample)
+      {
+        case 8:
+          PutPaletteGrayscale<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), width, 1, 0, 0);
+          break;
+        case 16:
+          PutPaletteGrayscale<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), width, 1, 0, 0);
+          break;
+        default:
+          itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                            << "-bit samples with palette.");
+      }
+      break;
+    case TIFFImageIO::PALETTE_RGB:
+      if (!this->GetIsReadAsScalarPlusPalette())
+      {
         switch (m_InternalImage->m_BitsPerSample)
         {
           case 8:
-            PutPaletteGrayscale<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), width, 1, 0, 0);
             break;
           case 16:
-            PutPaletteGrayscale<ComponentType, unsigned short>(
-              image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
+            PutPaletteRGB<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), width, 1, 0, 0);
             break;
           default:
             itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
                               << "-bit samples with palette.");
         }
-        break;
-      case TIFFImageIO::PALETTE_RGB:
-        if (!this->GetIsReadAsScalarPlusPalette())
-        {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteRGB<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteRGB<ComponentType, unsigned short>(image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
-        }
-        else
+      }
+      else
+      {
+        switch (m_InternalImage->m_BitsPerSample)
         {
-          switch (m_InternalImage->m_BitsPerSample)
-          {
-            case 8:
-              PutPaletteScalar<ComponentType, unsigned char>(image, static_cast<unsigned char *>(buf), width, 1, 0, 0);
-              break;
-            case 16:
-              PutPaletteScalar<ComponentType, unsigned short>(
-                image, static_cast<unsigned short *>(buf), width, 1, 0, 0);
-              break;
-            default:
-              itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
-                                << "-bit samples with palette.");
-          }
+          case 8:
+            PutPaletteScalar<ComponentType, unsigned char>(to, static_cast<unsigned char *>(from), width, 1, 0, 0);
+            break;
+          case 16:
+            PutPaletteScalar<ComponentType, unsigned short>(to, static_cast<unsigned short *>(from), width, 1, 0, 0);
+            break;
+          default:
+            itkExceptionMacro(<< "Sorry, can not handle image with " << m_InternalImage->m_BitsPerSample
+                              << "-bit samples with palette.");
         }
-        break;
+      }
+      break;
 
-      default:
-        itkExceptionMacro("Logic Error: Unexpected format!");
-    }
+    default:
+      itkExceptionMacro("Logic Error: Unexpected format!");
   }
-
-  _TIFFfree(buf);
 }
 
 // iso component scalar
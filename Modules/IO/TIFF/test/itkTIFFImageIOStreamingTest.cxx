@@ -0,0 +1,247 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkDefaultConvertPixelTraits.h"
+#include "itkImageFileReader.h"
+#include "itkImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkRGBPixel.h"
+#include "itkStreamingImageFilter.h"
+#include "itkTIFFImageIO.h"
+#include "itkTestingMacros.h"
+
+// Reads of regions of stripped and tiled TIFF files
+
+namespace
+{
+
+template <typename TImage>
+typename TImage::PixelType
+ExpectedValue(const typename TImage::IndexType & index)
+{
+  using PixelTraits = itk::DefaultConvertPixelTraits<typename TImage::PixelType>;
+
+  typename TImage::PixelType value{};
+  for (unsigned int i = 0; i < PixelTraits::GetNumberOfComponents(); ++i)
+  {
+    const itk::IndexValueType component = index[0] + 3 * index[1] + 7 * index[TImage::ImageDimension - 1] + 11 * i;
+    PixelTraits::SetNthComponent(i, value, static_cast<typename PixelTraits::ComponentType>(component));
+  }
+  return value;
+}
+
+template <typename TImage>
+typename TImage::Pointer
+MakeImage(const typename TImage::RegionType & region)
+{
+  auto image = TImage::New();
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    it.Set(ExpectedValue<TImage>(it.GetIndex()));
+  }
+  return image;
+}
+
+// Read the region of the file through imageIO, and check that only the
+// region was read, with the expected values.
+template <typename TImage>
+bool
+ReadAndCheckRegion(itk::TIFFImageIO *                  imageIO,
+                   const std::string &                 fileName,
+                   const typename TImage::RegionType & region)
+{
+  auto reader = itk::ImageFileReader<TImage>::New();
+  reader->SetImageIO(imageIO);
+  reader->SetFileName(fileName);
+  reader->UpdateOutputInformation();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+
+  const TImage * image = reader->GetOutput();
+  if (image->GetBufferedRegion() != region)
+  {
+    std::cerr << "Read " << image->GetBufferedRegion() << " instead of " << region << " from " << fileName
+              << std::endl;
+    return false;
+  }
+  for (itk::ImageRegionConstIteratorWithIndex<TImage> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get() != ExpectedValue<TImage>(it.GetIndex()))
+    {
+      std::cerr << "Read " << it.Get() << " instead of " << ExpectedValue<TImage>(it.GetIndex()) << " at "
+                << it.GetIndex() << " from " << fileName << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+// Write the image with the tile size and the compressor, then read the
+// regions from the file.
+template <typename TImage>
+bool
+WriteAndReadRegions(const TImage *                                  image,
+                    const std::string &                             fileName,
+                    unsigned int                                    tileSize,
+                    const std::string &                             compressor,
+                    const std::vector<typename TImage::RegionType> & regions)
+{
+  auto writerIO = itk::TIFFImageIO::New();
+  writerIO->SetTileWidth(tileSize);
+  writerIO->SetTileHeight(tileSize);
+  writerIO->SetCompressor(compressor);
+
+  auto writer = itk::ImageFileWriter<TImage>::New();
+  writer->SetInput(image);
+  writer->SetImageIO(writerIO);
+  writer->SetUseCompression(!compressor.empty());
+  writer->SetFileName(fileName);
+  writer->Update();
+
+  // the same ImageIO reads all the regions, as in a streamed pipeline
+  auto imageIO = itk::TIFFImageIO::New();
+  imageIO->SetFileName(fileName);
+  imageIO->ReadImageInformation();
+  if (!imageIO->CanStreamRead())
+  {
+    std::cerr << fileName << " cannot be streamed" << std::endl;
+    return false;
+  }
+
+  bool success = true;
+  for (const auto & region : regions)
+  {
+    if (!ReadAndCheckRegion<TImage>(imageIO, fileName, region))
+    {
+      success = false;
+    }
+  }
+  return success;
+}
+} // namespace
+
+int
+itkTIFFImageIOStreamingTest(int argc, char * argv[])
+{
+  if (argc != 2)
+  {
+    std::cerr << "Missing Parameters." << std::endl;
+    std::cerr << "Usage: " << itkNameOfTestExecutableMacro(argv) << " <TempOutputDirectory>" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const std::string directory = std::string(argv[1]) + "/";
+
+  int testStatus = EXIT_SUCCESS;
+
+  // Grayscale 2D images, the size of which is not a multiple of the tiles
+  {
+    using ImageType = itk::Image<unsigned short, 2>;
+    const ImageType::RegionType largestRegion({ { 0, 0 } }, { { 301, 203 } });
+    const auto                  image = MakeImage<ImageType>(largestRegion);
+
+    // whole image, within a tile, across tiles, on the edges
+    const std::vector<ImageType::RegionType> regions = { largestRegion,
+                                                         ImageType::RegionType({ { 3, 5 } }, { { 10, 10 } }),
+                                                         ImageType::RegionType({ { 50, 40 } }, { { 100, 90 } }),
+                                                         ImageType::RegionType({ { 290, 0 } }, { { 11, 203 } }),
+                                                         ImageType::RegionType({ { 0, 200 } }, { { 301, 3 } }) };
+
+    for (const std::string compressor : { "", "PackBits", "Deflate" })
+    {
+      for (const unsigned int tileSize : { 0u, 16u, 64u })
+      {
+        const std::string fileName =
+          directory + "itkTIFFImageIOStreamingTest_" + compressor + std::to_string(tileSize) + ".tif";
+        if (!WriteAndReadRegions<ImageType>(image, fileName, tileSize, compressor, regions))
+        {
+          testStatus = EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  // Multi-page RGB images
+  {
+    using ImageType = itk::Image<itk::RGBPixel<unsigned char>, 3>;
+    const ImageType::RegionType largestRegion({ { 0, 0, 0 } }, { { 70, 50, 5 } });
+    const auto                  image = MakeImage<ImageType>(largestRegion);
+
+    const std::vector<ImageType::RegionType> regions = { largestRegion,
+                                                         ImageType::RegionType({ { 0, 0, 2 } }, { { 70, 50, 1 } }),
+                                                         ImageType::RegionType({ { 20, 10, 1 } }, { { 40, 30, 3 } }),
+                                                         ImageType::RegionType({ { 60, 45, 4 } }, { { 10, 5, 1 } }) };
+
+    for (const unsigned int tileSize : { 0u, 32u })
+    {
+      const std::string fileName = directory + "itkTIFFImageIOStreamingTestRGB" + std::to_string(tileSize) + ".tif";
+      if (!WriteAndReadRegions<ImageType>(image, fileName, tileSize, "Deflate", regions))
+      {
+        testStatus = EXIT_FAILURE;
+      }
+    }
+  }
+
+  // Streamed reading in a pipeline
+  {
+    using ImageType = itk::Image<unsigned short, 2>;
+    const std::string fileName = directory + "itkTIFFImageIOStreamingTest_Deflate64.tif";
+
+    auto reader = itk::ImageFileReader<ImageType>::New();
+    reader->SetFileName(fileName);
+    auto streamer = itk::StreamingImageFilter<ImageType, ImageType>::New();
+    streamer->SetInput(reader->GetOutput());
+    streamer->SetNumberOfStreamDivisions(7);
+    ITK_TRY_EXPECT_NO_EXCEPTION(streamer->Update());
+
+    // the reader read the last piece only
+    ITK_TEST_EXPECT_TRUE(reader->GetOutput()->GetBufferedRegion().GetNumberOfPixels() < 301 * 203);
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(streamer->GetOutput(),
+                                                             streamer->GetOutput()->GetLargestPossibleRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      if (it.Get() != ExpectedValue<ImageType>(it.GetIndex()))
+      {
+        std::cerr << "Streamed " << it.Get() << " instead of " << ExpectedValue<ImageType>(it.GetIndex()) << " at "
+                  << it.GetIndex() << std::endl;
+        testStatus = EXIT_FAILURE;
+        break;
+      }
+    }
+  }
+
+  // The tile size must be a multiple of 16
+  {
+    using ImageType = itk::Image<unsigned char, 2>;
+    const auto image = MakeImage<ImageType>(ImageType::RegionType({ { 0, 0 } }, { { 40, 40 } }));
+
+    auto imageIO = itk::TIFFImageIO::New();
+    imageIO->SetTileWidth(20);
+    imageIO->SetTileHeight(16);
+    auto writer = itk::ImageFileWriter<ImageType>::New();
+    writer->SetInput(image);
+    writer->SetImageIO(imageIO);
+    writer->SetFileName(directory + "itkTIFFImageIOStreamingTestInvalidTiles.tif");
+    ITK_TRY_EXPECT_EXCEPTION(writer->Update());
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return testStatus;
+}
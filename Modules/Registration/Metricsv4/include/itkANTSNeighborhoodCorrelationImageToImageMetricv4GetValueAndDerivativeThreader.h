@@ -150,6 +150,13 @@ protected:
     : m_ANTSAssociate(nullptr)
   {}
 
+  /** The sparse Jacobian of a BSpline moving transform is supported. */
+  bool
+  GetSupportsSparseJacobian() const override
+  {
+    return true;
+  }
+
   /**
    * Dense threader and sparse threader invoke different in multi-threading. This class uses overloaded
    * implementations of \c ProcessVirtualPoint_impl and \c ThreadExecution_impl in order to handle the
@@ -546,6 +546,24 @@ ANTSNeighborhoodCorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
                           (fixedI - sFixedMoving / sMovingMoving * movingI) * movingImageGradient[qq];
     }
 
+    if (this->GetSparseJacobianMovingTransform() != nullptr)
+    {
+      /* Only the derivatives with respect to the parameters with a non-zero
+       * Jacobian, the weight of their coefficient. */
+      this->ComputeSparseJacobian(scanMem.virtualPoint, threadId);
+      const auto & weights =
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformSparseJacobianWeights;
+      NumberOfParametersType par = 0;
+      for (ImageDimensionType dim = 0; dim < TImageToImageMetric::MovingImageDimension; ++dim)
+      {
+        for (unsigned int k = 0; k < Superclass::SparseJacobianNumberOfWeights; ++k, ++par)
+        {
+          deriv[par] = derivWRTImage[dim] * weights[k];
+        }
+      }
+      return;
+    }
+
     /* Use a pre-allocated jacobian object for efficiency */
     using JacobianReferenceType = JacobianType &;
     JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
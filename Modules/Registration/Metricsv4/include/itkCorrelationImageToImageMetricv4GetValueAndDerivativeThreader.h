@@ -75,6 +75,13 @@ protected:
   CorrelationImageToImageMetricv4GetValueAndDerivativeThreader();
   ~CorrelationImageToImageMetricv4GetValueAndDerivativeThreader() override;
 
+  /** The sparse Jacobian of a BSpline moving transform is supported. */
+  bool
+  GetSupportsSparseJacobian() const override
+  {
+    return true;
+  }
+
   /** Overload: Resize and initialize per thread objects:
    *    number of valid points
    *    moving transform jacobian
@@ -310,7 +310,25 @@ CorrelationImageToImageMetricv4GetValueAndDerivativeThreader<
   cumsum.m2 += m1 * m1;
   cumsum.fm += f1 * m1;
 
-  if (this->m_CorrelationAssociate->GetComputeDerivative())
+  if (this->m_CorrelationAssociate->GetComputeDerivative() && this->GetSparseJacobianMovingTransform() != nullptr)
+  {
+    /* Only the parameters with a non-zero Jacobian, the weight of their coefficient, are updated */
+    this->ComputeSparseJacobian(virtualPoint, threadId);
+    const auto & weights =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformSparseJacobianWeights;
+    for (unsigned int dim = 0; dim < ImageToImageMetricv4Type::MovingImageDimension; ++dim)
+    {
+      for (unsigned int k = 0; k < Superclass::SparseJacobianNumberOfWeights; ++k)
+      {
+        const InternalComputationValueType sum = movingImageGradient[dim] * weights[k];
+        const NumberOfParametersType       par = this->GetSparseJacobianParameterIndex(threadId, k, dim);
+
+        cumsum.fdm[par] += f1 * sum;
+        cumsum.mdm[par] += m1 * sum;
+      }
+    }
+  }
+  else if (this->m_CorrelationAssociate->GetComputeDerivative())
   {
     /* Use a pre-allocated jacobian object for efficiency */
     using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
@@ -20,7 +20,9 @@
 
 #include "itkCovariantVector.h"
 #include "itkImageFunction.h"
+#include "itkCachedImageGradientImageFunction.h"
 #include "itkObjectToObjectMetric.h"
+#include "itkBSplineBaseTransform.h"
 #include "itkInterpolateImageFunction.h"
 #include "itkSpatialObject.h"
 #include "itkResampleImageFilter.h"
@@ -77,6 +79,12 @@ namespace itk
  *  gradients at each iteration of a registration instead of just computing
  *  once at the beginning. The user can supply a different function by calling
  *  SetFixedImageGradientCalculator and/or SetMovingImageGradientCalculator.
+ *  With \c Use[Fixed|Moving]ImageGradientCache set to true, the gradients
+ *  computed by the calculator at the pixels are cached as float, and linearly
+ *  interpolated. They are cached by blocks of pixels computed the first time
+ *  they are needed, only within the bounding box of the virtual domain mapped
+ *  into the image by the transform at \c Initialize. This uses less memory than
+ *  a gradient image filter, and the gradient of each pixel is computed once.
  *
  * Both image gradient calculation methods are threaded.
  * Generally it is not recommended to use different image gradient methods for
@@ -116,6 +124,17 @@ namespace itk
  * Derived classes must provide special handling for vector pixel
  * types. MeanSquaresImageToImageMetricv4 can be used as an example.
  *
+ * BSpline Transforms
+ *
+ * The Jacobian of a cubic BSpline moving transform with respect to the
+ * parameters is non-zero only for the coefficients in the support region of
+ * each point. With UseSparseJacobian on, the default, the threaders that
+ * support it compute this sparse Jacobian with
+ * BSplineBaseTransform::ComputeSparseJacobianWithRespectToParameters()
+ * instead of the dense one, and update only the derivatives with respect to
+ * these parameters. See
+ * ImageToImageMetricv4GetValueAndDerivativeThreaderBase::GetSupportsSparseJacobian().
+ *
  * Threading
  *
  * This class is threaded. Threading is handled by friend classes
@@ -347,6 +366,16 @@ public:
   using DefaultFixedImageGradientCalculator = typename MetricTraits::DefaultFixedImageGradientCalculator;
   using DefaultMovingImageGradientCalculator = typename MetricTraits::DefaultMovingImageGradientCalculator;
 
+  /** Types of the caches of the gradients of the image gradient calculators. */
+  using FixedImageGradientCacheType =
+    CachedImageGradientImageFunction<FixedImageType,
+                                     CoordinateRepresentationType,
+                                     typename FixedImageGradientCalculatorType::OutputType>;
+  using MovingImageGradientCacheType =
+    CachedImageGradientImageFunction<MovingImageType,
+                                     CoordinateRepresentationType,
+                                     typename MovingImageGradientCalculatorType::OutputType>;
+
   /**  Type of the measure. */
   using typename Superclass::MeasureType;
 
@@ -471,6 +500,24 @@ public:
   itkGetConstReferenceMacro(UseMovingImageGradientFilter, bool);
   itkBooleanMacro(UseMovingImageGradientFilter);
 
+  /** Set/Get the caching of the gradients of the gradient calculator,
+   * for fixed image. Only used when UseFixedImageGradientFilter is off.
+   * Default is off. */
+  itkSetMacro(UseFixedImageGradientCache, bool);
+  itkGetConstReferenceMacro(UseFixedImageGradientCache, bool);
+  itkBooleanMacro(UseFixedImageGradientCache);
+
+  /** Set/Get the caching of the gradients of the gradient calculator,
+   * for moving image. Only used when UseMovingImageGradientFilter is off.
+   * Default is off. */
+  itkSetMacro(UseMovingImageGradientCache, bool);
+  itkGetConstReferenceMacro(UseMovingImageGradientCache, bool);
+  itkBooleanMacro(UseMovingImageGradientCache);
+
+  /** Get the gradient caches */
+  itkGetModifiableObjectMacro(FixedImageGradientCache, FixedImageGradientCacheType);
+  itkGetModifiableObjectMacro(MovingImageGradientCache, MovingImageGradientCacheType);
+
   /** Get number of work units to used in the the most recent
    * evaluation.  Only valid after GetValueAndDerivative() or
    * GetValue() has been called. */
@@ -556,6 +603,26 @@ public:
   itkSetMacro(FloatingPointCorrectionResolution, DerivativeValueType);
   itkGetConstMacro(FloatingPointCorrectionResolution, DerivativeValueType);
 
+  /** Type of the cubic BSpline moving transforms, whose Jacobian with respect
+   * to the parameters is sparse. */
+  using MovingBSplineTransformType =
+    BSplineBaseTransform<typename MovingTransformType::ParametersValueType, MovingImageDimension, 3>;
+
+  /** Set/Get the option for using the sparse Jacobian of a cubic BSpline
+   * moving transform, i.e. only the weights of the coefficients in the support
+   * region of each point, instead of its dense Jacobian with respect to all
+   * the parameters. The derivatives are then computed and accumulated only for
+   * these parameters, by the threaders that support it. True by default. */
+  itkSetMacro(UseSparseJacobian, bool);
+  itkGetConstReferenceMacro(UseSparseJacobian, bool);
+  itkBooleanMacro(UseSparseJacobian);
+
+  /** Get the moving transform as a cubic BSpline transform, when UseSparseJacobian
+   * is on and the moving transform is a BSplineBaseTransform. Returns nullptr
+   * otherwise. */
+  const MovingBSplineTransformType *
+  GetSparseJacobianMovingTransform() const;
+
   /* Initialize the metric before calling GetValue or GetDerivative.
    * Derived classes must call this Superclass version if they override
    * this to perform their own initialization.
@@ -672,6 +739,13 @@ protected:
   virtual void
   ComputeMovingImageGradientFilterImage() const;
 
+  /** Computes the region of the image that contains the corners of the
+   * virtual region mapped by the transform, padded by one pixel. Used to
+   * limit the gradient caches to the pixels that are expected to be sampled. */
+  template <typename TImage, typename TTransform>
+  typename TImage::RegionType
+  ComputeMappedVirtualRegion(const TImage * image, const TTransform * transform) const;
+
   /** Perform the actual threaded processing, using the appropriate
    * GetValueAndDerivativeThreader. Results get written to
    * member vars. This is available as a separate method so it
@@ -727,6 +801,12 @@ protected:
   FixedImageGradientCalculatorPointer  m_FixedImageGradientCalculator;
   MovingImageGradientCalculatorPointer m_MovingImageGradientCalculator;
 
+  /** Caches of the gradients of the image gradient calculators. */
+  bool                                           m_UseFixedImageGradientCache{ false };
+  bool                                           m_UseMovingImageGradientCache{ false };
+  typename FixedImageGradientCacheType::Pointer  m_FixedImageGradientCache;
+  typename MovingImageGradientCacheType::Pointer m_MovingImageGradientCache;
+
   /** Derivative results holder. Uses a raw pointer so we can point it
    * to a user-provided object. This is used in internal methods so
    * the user-provided variable does not have to be passed around. It also enables
@@ -818,6 +898,8 @@ private:
   bool                m_UseFloatingPointCorrection;
   DerivativeValueType m_FloatingPointCorrectionResolution;
 
+  bool m_UseSparseJacobian{ true };
+
   MetricTraits m_MetricTraits;
 
   /** Flag to know if derivative should be calculated */
@@ -24,6 +24,8 @@
 #include "itkLinearInterpolateImageFunction.h"
 #include "itkIdentityTransform.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -61,6 +63,9 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   this->m_DefaultMovingImageGradientCalculator->UseImageDirectionOn();
   this->m_MovingImageGradientCalculator = this->m_DefaultMovingImageGradientCalculator;
 
+  this->m_FixedImageGradientCache = FixedImageGradientCacheType::New();
+  this->m_MovingImageGradientCache = MovingImageGradientCacheType::New();
+
   /* Setup default options assuming dense-sampling */
   this->m_UseFixedImageGradientFilter = true;
   this->m_UseMovingImageGradientFilter = true;
@@ -161,12 +166,26 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     itkDebugMacro("Initialize FixedImageGradientCalculator");
     this->m_FixedImageGradientImage = nullptr;
     this->m_FixedImageGradientCalculator->SetInputImage(this->m_FixedImage);
+    if (this->m_UseFixedImageGradientCache)
+    {
+      this->m_FixedImageGradientCache->SetGradientCalculator(this->m_FixedImageGradientCalculator);
+      this->m_FixedImageGradientCache->SetInputImage(this->m_FixedImage);
+      this->m_FixedImageGradientCache->SetCachedRegion(
+        this->ComputeMappedVirtualRegion(this->m_FixedImage.GetPointer(), this->m_FixedTransform.GetPointer()));
+    }
   }
   if (!this->m_UseMovingImageGradientFilter)
   {
     itkDebugMacro("Initialize MovingImageGradientCalculator");
     this->m_MovingImageGradientImage = nullptr;
     this->m_MovingImageGradientCalculator->SetInputImage(this->m_MovingImage);
+    if (this->m_UseMovingImageGradientCache)
+    {
+      this->m_MovingImageGradientCache->SetGradientCalculator(this->m_MovingImageGradientCalculator);
+      this->m_MovingImageGradientCache->SetInputImage(this->m_MovingImage);
+      this->m_MovingImageGradientCache->SetCachedRegion(
+        this->ComputeMappedVirtualRegion(this->m_MovingImage.GetPointer(), this->m_MovingTransform.GetPointer()));
+    }
   }
 
   /* Initialize default gradient image filters. */
@@ -413,6 +432,10 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     }
     gradient = m_FixedImageGradientInterpolator->Evaluate(mappedPoint);
   }
+  else if (this->m_UseFixedImageGradientCache)
+  {
+    gradient = this->m_FixedImageGradientCache->Evaluate(mappedPoint);
+  }
   else
   {
     // if not using the gradient image
@@ -439,6 +462,10 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     }
     gradient = m_MovingImageGradientInterpolator->Evaluate(mappedPoint);
   }
+  else if (this->m_UseMovingImageGradientCache)
+  {
+    gradient = this->m_MovingImageGradientCache->Evaluate(mappedPoint);
+  }
   else
   {
     // if not using the gradient image
@@ -608,12 +635,24 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
                       " point set.");
   }
 
+  /* Map all the points with a single call to the inverse transform. */
+  using InverseTransformBaseType = typename FixedTransformType::InverseTransformBaseType;
+  std::vector<typename InverseTransformBaseType::InputPointType>  fixedPoints;
+  std::vector<typename InverseTransformBaseType::OutputPointType> mappedPoints(points->Size());
+  fixedPoints.reserve(points->Size());
+  while (fixedIt != points->End())
+  {
+    fixedPoints.push_back(fixedIt.Value());
+    ++fixedIt;
+  }
+  inverseTransform->TransformPoints(fixedPoints.data(), mappedPoints.data(), fixedPoints.size());
+
   this->m_NumberOfSkippedFixedSampledPoints = 0;
   SizeValueType virtualIndex = 0;
-  while (fixedIt != points->End())
+  for (const auto & mappedPoint : mappedPoints)
   {
-    typename FixedSampledPointSetType::PointType point = inverseTransform->TransformPoint(fixedIt.Value());
-    typename VirtualImageType::IndexType         tempIndex;
+    const typename FixedSampledPointSetType::PointType point(mappedPoint);
+    typename VirtualImageType::IndexType               tempIndex;
     /* Verify that the point is valid. We may be working with a resized virtual domain,
      * and a fixed sampled point list that was created before the resizing. */
     if (this->TransformPhysicalPointToVirtualIndex(point, tempIndex))
@@ -625,7 +664,6 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
     {
       this->m_NumberOfSkippedFixedSampledPoints++;
     }
-    ++fixedIt;
   }
   if (this->m_VirtualSampledPointSet->GetNumberOfPoints() == 0)
   {
@@ -635,6 +673,66 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+template <typename TImage, typename TTransform>
+typename TImage::RegionType
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  ComputeMappedVirtualRegion(const TImage * image, const TTransform * transform) const
+{
+  using RegionType = typename TImage::RegionType;
+  using IndexType = typename TImage::IndexType;
+  using ContinuousIndexType = ContinuousIndex<double, TImage::ImageDimension>;
+
+  const VirtualRegionType & virtualRegion = this->GetVirtualRegion();
+  if (virtualRegion.GetNumberOfPixels() == 0)
+  {
+    return RegionType();
+  }
+
+  // Bounding box of the mapped corners of the virtual region.
+  ContinuousIndexType lower;
+  ContinuousIndexType upper;
+  lower.Fill(NumericTraits<double>::max());
+  upper.Fill(NumericTraits<double>::NonpositiveMin());
+  for (unsigned int corner = 0; corner < (1u << VirtualImageDimension); ++corner)
+  {
+    VirtualIndexType virtualIndex = virtualRegion.GetIndex();
+    for (unsigned int d = 0; d < VirtualImageDimension; ++d)
+    {
+      if (corner & (1u << d))
+      {
+        virtualIndex[d] += static_cast<IndexValueType>(virtualRegion.GetSize(d)) - 1;
+      }
+    }
+    VirtualPointType virtualPoint;
+    this->TransformVirtualIndexToPhysicalPoint(virtualIndex, virtualPoint);
+    const ContinuousIndexType index =
+      image->template TransformPhysicalPointToContinuousIndex<double>(transform->TransformPoint(virtualPoint));
+    for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+    {
+      lower[d] = std::min(lower[d], index[d]);
+      upper[d] = std::max(upper[d], index[d]);
+    }
+  }
+
+  // Padded by one pixel for the linear interpolation of the gradients.
+  IndexType start;
+  IndexType end;
+  for (unsigned int d = 0; d < TImage::ImageDimension; ++d)
+  {
+    start[d] = static_cast<IndexValueType>(std::floor(lower[d])) - 1;
+    end[d] = static_cast<IndexValueType>(std::ceil(upper[d])) + 1;
+  }
+  RegionType region;
+  region.SetIndex(start);
+  region.SetUpperIndex(end);
+  return region;
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -657,6 +755,22 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   }
 }
 
+template <typename TFixedImage,
+          typename TMovingImage,
+          typename TVirtualImage,
+          typename TInternalComputationValueType,
+          typename TMetricTraits>
+auto
+ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputationValueType, TMetricTraits>::
+  GetSparseJacobianMovingTransform() const -> const MovingBSplineTransformType *
+{
+  if (!this->m_UseSparseJacobian || this->m_MovingTransform.IsNull())
+  {
+    return nullptr;
+  }
+  return dynamic_cast<const MovingBSplineTransformType *>(this->m_MovingTransform.GetPointer());
+}
+
 template <typename TFixedImage,
           typename TMovingImage,
           typename TVirtualImage,
@@ -672,8 +786,11 @@ ImageToImageMetricv4<TFixedImage, TMovingImage, TVirtualImage, TInternalComputat
   os << indent << "ImageToImageMetricv4: " << std::endl
      << indent << "GetUseFixedImageGradientFilter: " << this->GetUseFixedImageGradientFilter() << std::endl
      << indent << "GetUseMovingImageGradientFilter: " << this->GetUseMovingImageGradientFilter() << std::endl
+     << indent << "UseFixedImageGradientCache: " << this->GetUseFixedImageGradientCache() << std::endl
+     << indent << "UseMovingImageGradientCache: " << this->GetUseMovingImageGradientCache() << std::endl
      << indent << "UseFloatingPointCorrection: " << this->GetUseFloatingPointCorrection() << std::endl
-     << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl;
+     << indent << "FloatingPointCorrectionResolution: " << this->GetFloatingPointCorrectionResolution() << std::endl
+     << indent << "UseSparseJacobian: " << this->GetUseSparseJacobian() << std::endl;
 
   itkPrintSelfObjectMacro(FixedImage);
   itkPrintSelfObjectMacro(MovingImage);
@@ -89,6 +89,12 @@ public:
   using CompensatedDerivativeValueType = CompensatedSummation<DerivativeValueType>;
   using CompensatedDerivativeType = std::vector<CompensatedDerivativeValueType>;
 
+  /** Types of the sparse Jacobian of a cubic BSpline moving transform. */
+  using MovingBSplineTransformType = typename ImageToImageMetricv4Type::MovingBSplineTransformType;
+  using SparseJacobianWeightsType = typename MovingBSplineTransformType::WeightsType;
+  using SparseJacobianIndicesType = typename MovingBSplineTransformType::ParameterIndexArrayType;
+  static constexpr unsigned int SparseJacobianNumberOfWeights = MovingBSplineTransformType::NumberOfWeights;
+
   /** Access the GetValueAndDerivative() accesor in image metric base. */
   virtual bool
   GetComputeDerivative() const;
@@ -168,6 +174,51 @@ protected:
   virtual void
   StorePointDerivativeResult(const VirtualIndexType & virtualIndex, const ThreadIdType threadId);
 
+  /** Returns whether ProcessPoint supports the sparse Jacobian of a cubic
+   * BSpline moving transform. When it does, and the moving transform is such
+   * a transform, GetSparseJacobianMovingTransform() is not null, the dense
+   * Jacobian is not allocated, and ProcessPoint computes the sparse Jacobian
+   * with ComputeSparseJacobian() and returns in \c localDerivativeReturn the
+   * derivatives with respect to the parameters with a non-zero Jacobian only:
+   * the derivative with respect to the parameter
+   * GetSparseJacobianParameterIndex(threadId, k, d) at the index
+   * d * SparseJacobianNumberOfWeights + k. False by default. */
+  virtual bool
+  GetSupportsSparseJacobian() const
+  {
+    return false;
+  }
+
+  /** Get the moving transform whose sparse Jacobian is used by ProcessPoint,
+   * or nullptr when the dense Jacobian is used.
+   * This will only be set once threading has been started. */
+  const MovingBSplineTransformType *
+  GetSparseJacobianMovingTransform() const
+  {
+    return this->m_SparseJacobianMovingTransform;
+  }
+
+  /** Compute the sparse Jacobian of the moving transform at the virtual point,
+   * in the per-thread MovingTransformSparseJacobianWeights and
+   * MovingTransformSparseJacobianIndices. */
+  void
+  ComputeSparseJacobian(const VirtualPointType & virtualPoint, const ThreadIdType threadId) const
+  {
+    this->m_SparseJacobianMovingTransform->ComputeSparseJacobianWithRespectToParameters(
+      virtualPoint,
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformSparseJacobianWeights,
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformSparseJacobianIndices);
+  }
+
+  /** Get the index of the parameter of the d-th dimension of the k-th
+   * coefficient of the last sparse Jacobian computed by the thread. */
+  NumberOfParametersType
+  GetSparseJacobianParameterIndex(const ThreadIdType threadId, unsigned int k, unsigned int d) const
+  {
+    return this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformSparseJacobianIndices[k] +
+           d * this->m_CachedNumberOfParametersPerDimension;
+  }
+
   struct GetValueAndDerivativePerThreadStruct
   {
     /** Intermediary threaded metric value storage. */
@@ -184,6 +235,10 @@ protected:
      * classes for efficiency. */
     JacobianType MovingTransformJacobian;
     JacobianType MovingTransformJacobianPositional;
+    /** Pre-allocated sparse transform jacobian objects, used instead of
+     * MovingTransformJacobian with a cubic BSpline moving transform. */
+    SparseJacobianWeightsType MovingTransformSparseJacobianWeights;
+    SparseJacobianIndicesType MovingTransformSparseJacobianIndices;
   };
   itkPadStruct(ITK_CACHE_LINE_ALIGNMENT,
                GetValueAndDerivativePerThreadStruct,
@@ -197,6 +252,10 @@ protected:
    *  These will only be set once threading has been started. */
   mutable NumberOfParametersType m_CachedNumberOfParameters;
   mutable NumberOfParametersType m_CachedNumberOfLocalParameters;
+  mutable NumberOfParametersType m_CachedNumberOfParametersPerDimension{ 0 };
+
+  /** Moving transform whose sparse Jacobian is used, when not null. */
+  const MovingBSplineTransformType * m_SparseJacobianMovingTransform{ nullptr };
 };
 
 } // end namespace itk
@@ -50,6 +50,18 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
   this->m_CachedNumberOfParameters = this->m_Associate->GetNumberOfParameters();
   this->m_CachedNumberOfLocalParameters = this->m_Associate->GetNumberOfLocalParameters();
 
+  /* Use the sparse Jacobian of the moving transform when supported */
+  this->m_SparseJacobianMovingTransform = nullptr;
+  if (this->m_Associate->GetComputeDerivative() && this->GetSupportsSparseJacobian())
+  {
+    this->m_SparseJacobianMovingTransform = this->m_Associate->GetSparseJacobianMovingTransform();
+  }
+  if (this->m_SparseJacobianMovingTransform != nullptr)
+  {
+    this->m_CachedNumberOfParametersPerDimension =
+      this->m_SparseJacobianMovingTransform->GetNumberOfParametersPerDimension();
+  }
+
   /* Per-thread results */
   const ThreadIdType numWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
   delete[] m_GetValueAndDerivativePerThreadVariables;
@@ -61,10 +73,20 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner,
     {
       /* Allocate intermediary per-thread storage used to get results from
        * derived classes */
-      this->m_GetValueAndDerivativePerThreadVariables[i].LocalDerivatives.SetSize(
-        this->m_CachedNumberOfLocalParameters);
-      this->m_GetValueAndDerivativePerThreadVariables[i].MovingTransformJacobian.SetSize(
-        this->m_Associate->VirtualImageDimension, this->m_CachedNumberOfLocalParameters);
+      if (this->m_SparseJacobianMovingTransform != nullptr)
+      {
+        /* Only the derivatives with respect to the parameters with a
+         * non-zero sparse Jacobian are computed for each point. */
+        this->m_GetValueAndDerivativePerThreadVariables[i].LocalDerivatives.SetSize(
+          ImageToImageMetricv4Type::MovingImageDimension * SparseJacobianNumberOfWeights);
+      }
+      else
+      {
+        this->m_GetValueAndDerivativePerThreadVariables[i].LocalDerivatives.SetSize(
+          this->m_CachedNumberOfLocalParameters);
+        this->m_GetValueAndDerivativePerThreadVariables[i].MovingTransformJacobian.SetSize(
+          this->m_Associate->VirtualImageDimension, this->m_CachedNumberOfLocalParameters);
+      }
       // Not pre-allocated since it may not be used
       // this->m_GetValueAndDerivativePerThreadVariables[i].MovingTransformJacobianPositional
       if (this->m_Associate->m_MovingTransform->GetTransformCategory() ==
@@ -289,10 +311,12 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
       MovingTransformType::TransformCategoryEnum::DisplacementField)
   {
     /* Global support */
+    const NumberOfParametersType numberOfLocalDerivatives =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives.Size();
     if (this->m_Associate->GetUseFloatingPointCorrection())
     {
       DerivativeValueType correctionResolution = this->m_Associate->GetFloatingPointCorrectionResolution();
-      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+      for (NumberOfParametersType p = 0; p < numberOfLocalDerivatives; ++p)
       {
         auto test = static_cast<intmax_t>(
           this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p] * correctionResolution);
@@ -300,10 +324,27 @@ ImageToImageMetricv4GetValueAndDerivativeThreaderBase<TDomainPartitioner, TImage
           static_cast<DerivativeValueType>(test / correctionResolution);
       }
     }
-    for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+    if (this->m_SparseJacobianMovingTransform != nullptr)
+    {
+      /* Only the parameters with a non-zero sparse Jacobian are updated */
+      NumberOfParametersType p = 0;
+      for (unsigned int d = 0; d < ImageToImageMetricv4Type::MovingImageDimension; ++d)
+      {
+        for (unsigned int k = 0; k < SparseJacobianNumberOfWeights; ++k, ++p)
+        {
+          this->m_GetValueAndDerivativePerThreadVariables[threadId]
+            .CompensatedDerivatives[this->GetSparseJacobianParameterIndex(threadId, k, d)] +=
+            this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p];
+        }
+      }
+    }
+    else
     {
-      this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[p] +=
-        this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p];
+      for (NumberOfParametersType p = 0; p < this->m_CachedNumberOfParameters; ++p)
+      {
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives[p] +=
+          this->m_GetValueAndDerivativePerThreadVariables[threadId].LocalDerivatives[p];
+      }
     }
   }
   else
@@ -61,6 +61,19 @@ namespace itk
  * One the PDF's have been constructed, the mutual information
  * is obtained by doubling summing over the discrete PDF values.
  *
+ * With a cubic BSpline moving transform and UseSparseJacobian on, the
+ * derivatives of the joint PDF with respect to all the parameters are not
+ * computed: the samples are stored by each thread, and their contributions
+ * to the derivative are computed with the sparse Jacobian once the joint
+ * PDF is known.
+ *
+ * With other global transforms, each work unit accumulates the derivatives
+ * of the joint PDF in its own buffer, and the buffers are summed in parallel
+ * after the threaded execution. When these buffers would use more than
+ * MaximumThreaderJointPDFDerivativesSize elements, the work units instead
+ * share the derivatives of the joint PDF through small buffers that are
+ * added under a lock.
+ *
  * \warning Local-support transforms are not yet supported. If used,
  * an exception is thrown during Initialize().
  *
@@ -363,6 +376,17 @@ protected:
   std::mutex                                m_JointPDFDerivativesLock;
   typename JointPDFDerivativesType::Pointer m_JointPDFDerivatives;
 
+  /** Maximum number of elements of the joint PDF derivatives of the work
+   * units other than the first one, which accumulates in
+   * m_JointPDFDerivatives. */
+  static constexpr SizeValueType MaximumThreaderJointPDFDerivativesSize = 1 << 24;
+
+  /** The joint PDF derivatives of each work unit, for global transforms,
+   * when m_UseThreaderJointPDFDerivatives is true. The first one is
+   * m_JointPDFDerivatives. */
+  std::vector<typename JointPDFDerivativesType::Pointer> m_ThreaderJointPDFDerivatives;
+  bool                                                   m_UseThreaderJointPDFDerivatives{ false };
+
   PDFValueType m_JointPDFSum;
 
   /** Store the per-point local derivative result by parzen window bin.
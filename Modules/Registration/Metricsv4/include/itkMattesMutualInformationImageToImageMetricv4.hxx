@@ -283,7 +283,8 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
                                             TInternalComputationValueType,
                                             TMetricTraits>::FinalizeThread(const ThreadIdType threadId)
 {
-  if (this->GetComputeDerivative() && (!this->HasLocalSupport()))
+  if (this->GetComputeDerivative() && (!this->HasLocalSupport()) &&
+      this->GetSparseJacobianMovingTransform() == nullptr && !this->m_UseThreaderJointPDFDerivatives)
   {
     this->m_ThreaderDerivativeManager[threadId].BlockAndReduce();
   }
@@ -360,6 +361,9 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
   const PDFValueType            nFactor = 1.0 / (this->m_MovingImageBinSize * this->GetNumberOfValidPoints());
 
   auto const temp_num_histogram_bins = this->m_NumberOfHistogramBins;
+  // With the sparse Jacobian, the pRatio is collected like in the local-support case,
+  // and applied to the samples of each thread by the threader.
+  const bool useJointPDFDerivatives = !this->HasLocalSupport() && this->GetSparseJacobianMovingTransform() == nullptr;
   /**
    * Compute the metric by double summation over histogram.
    */
@@ -391,7 +395,7 @@ MattesMutualInformationImageToImageMetricv4<TFixedImage,
 
           if (this->GetComputeDerivative())
           {
-            if (!this->HasLocalSupport())
+            if (useJointPDFDerivatives)
             {
               // Collect global derivative contributions
               JointPDFValueType const * derivPtr = this->m_JointPDFDerivatives->GetBufferPointer() +
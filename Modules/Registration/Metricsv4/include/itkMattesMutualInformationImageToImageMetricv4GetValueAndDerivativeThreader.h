@@ -21,6 +21,7 @@
 #include "itkImageToImageMetricv4GetValueAndDerivativeThreader.h"
 
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -98,6 +99,13 @@ protected:
   void
   AfterThreadedExecution() override;
 
+  /** The sparse Jacobian of a BSpline moving transform is supported. */
+  bool
+  GetSupportsSparseJacobian() const override
+  {
+    return true;
+  }
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -121,10 +129,31 @@ protected:
                                              const PDFValueType &            cubicBSplineDerivativeValue,
                                              DerivativeValueType *           localSupportDerivativeResultPtr) const;
 
+  /** Compute the derivative from the samples of each thread, with the sparse
+   * Jacobian of the moving transform, once the pRatio of the joint PDF bins
+   * is known. */
+  virtual void
+  ComputeSparseJacobianDerivative();
+
 private:
   /** Internal pointer to the Mattes metric object in use by this threader.
    *  This will avoid costly dynamic casting in tight loops. */
   TMattesMutualInformationMetric * m_MattesAssociate;
+
+  /** A sample whose contribution to the derivative is computed with the
+   * sparse Jacobian, once the joint PDF is known. This avoids the joint PDF
+   * derivatives, of the size of the number of parameters times the number
+   * of bins of the joint PDF. */
+  struct SparseJacobianSample
+  {
+    VirtualPointType        VirtualPoint;
+    MovingImageGradientType MovingImageGradient;
+    OffsetValueType         JointPDFIndex1D;
+    PDFValueType            CubicBSplineDerivativeValues[4];
+  };
+
+  /** The samples of each thread, used with the sparse Jacobian. */
+  mutable std::vector<std::vector<SparseJacobianSample>> m_SparseJacobianSamples;
 };
 
 } // end namespace itk
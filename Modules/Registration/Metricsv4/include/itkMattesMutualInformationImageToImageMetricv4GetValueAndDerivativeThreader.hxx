@@ -165,7 +165,23 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       this->m_MattesAssociate->m_LocalDerivativeByParzenBin[n].Fill(NumericTraits<DerivativeValueType>::ZeroValue());
     }
   }
-  if (this->m_MattesAssociate->GetComputeDerivative() && !this->m_MattesAssociate->HasLocalSupport())
+  if (this->m_MattesAssociate->GetComputeDerivative() && this->GetSparseJacobianMovingTransform() != nullptr)
+  {
+    // The pRatio is applied to the samples of each thread once the joint PDF is known.
+    this->m_MattesAssociate->m_PRatioArray.assign(
+      this->m_MattesAssociate->m_NumberOfHistogramBins * this->m_MattesAssociate->m_NumberOfHistogramBins, 0.0);
+    // Don't need these with the sparse Jacobian
+    this->m_MattesAssociate->m_JointPdfIndex1DArray.clear();
+    this->m_MattesAssociate->m_LocalDerivativeByParzenBin.clear();
+    this->m_MattesAssociate->m_JointPDFDerivatives = nullptr;
+
+    this->m_SparseJacobianSamples.resize(localNumberOfWorkUnitsUsed);
+    for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+    {
+      this->m_SparseJacobianSamples[workUnitID].clear();
+    }
+  }
+  else if (this->m_MattesAssociate->GetComputeDerivative() && !this->m_MattesAssociate->HasLocalSupport())
   {
     // Don't need this with global transforms
     this->m_MattesAssociate->m_PRatioArray.clear();
@@ -205,25 +221,59 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
       // Initialize to zero for accumulation
       this->m_MattesAssociate->m_JointPDFDerivatives->FillBuffer(0.0F);
     }
-    if ((this->m_MattesAssociate->m_ThreaderDerivativeManager.size() != localNumberOfWorkUnitsUsed))
+
+    // Each work unit accumulates in its own joint PDF derivatives, without
+    // any lock, unless they use too much memory.
+    this->m_MattesAssociate->m_UseThreaderJointPDFDerivatives =
+      (localNumberOfWorkUnitsUsed - 1) * jointPDFDerivativesRegion.GetNumberOfPixels() <=
+      TMattesMutualInformationMetric::MaximumThreaderJointPDFDerivativesSize;
+    if (this->m_MattesAssociate->m_UseThreaderJointPDFDerivatives)
     {
-      this->m_MattesAssociate->m_ThreaderDerivativeManager.resize(localNumberOfWorkUnitsUsed);
+      this->m_MattesAssociate->m_ThreaderDerivativeManager.clear();
+      this->m_MattesAssociate->m_ThreaderJointPDFDerivatives.resize(localNumberOfWorkUnitsUsed);
+      this->m_MattesAssociate->m_ThreaderJointPDFDerivatives[0] = this->m_MattesAssociate->m_JointPDFDerivatives;
+      this->GetMultiThreader()->ParallelizeArray(
+        1,
+        localNumberOfWorkUnitsUsed,
+        [this, &jointPDFDerivativesRegion](SizeValueType workUnitID) {
+          typename JointPDFDerivativesType::Pointer & jointPDFDerivatives =
+            this->m_MattesAssociate->m_ThreaderJointPDFDerivatives[workUnitID];
+          if (jointPDFDerivatives.IsNull() || (jointPDFDerivatives->GetBufferedRegion() != jointPDFDerivativesRegion))
+          {
+            jointPDFDerivatives = JointPDFDerivativesType::New();
+            jointPDFDerivatives->SetRegions(jointPDFDerivativesRegion);
+            jointPDFDerivatives->Allocate(true);
+          }
+          else
+          {
+            jointPDFDerivatives->FillBuffer(0.0F);
+          }
+        },
+        nullptr);
     }
-    for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+    else
     {
-      this->m_MattesAssociate->m_ThreaderDerivativeManager[workUnitID].Initialize(
-        // A heuristic that assumues memory for 2x size of
-        // m_JointPDFDerivati efficient and easy to make, so
-        // split it accross all the threads.  A work unit of at least 400 is needed
-        // when the thread size approaches the number of histograms so that the
-        // there is enough work to be done between thread lockings.
-        std::max<size_t>(500,
-                         this->m_MattesAssociate->m_NumberOfHistogramBins *
-                           this->m_MattesAssociate->m_NumberOfHistogramBins / localNumberOfWorkUnitsUsed),
-        this->GetCachedNumberOfLocalParameters(),
-        // Need address of the lock
-        &this->m_MattesAssociate->m_JointPDFDerivativesLock,
-        this->m_MattesAssociate->m_JointPDFDerivatives);
+      this->m_MattesAssociate->m_ThreaderJointPDFDerivatives.clear();
+      if ((this->m_MattesAssociate->m_ThreaderDerivativeManager.size() != localNumberOfWorkUnitsUsed))
+      {
+        this->m_MattesAssociate->m_ThreaderDerivativeManager.resize(localNumberOfWorkUnitsUsed);
+      }
+      for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+      {
+        this->m_MattesAssociate->m_ThreaderDerivativeManager[workUnitID].Initialize(
+          // A heuristic that assumues memory for 2x size of
+          // m_JointPDFDerivati efficient and easy to make, so
+          // split it accross all the threads.  A work unit of at least 400 is needed
+          // when the thread size approaches the number of histograms so that the
+          // there is enough work to be done between thread lockings.
+          std::max<size_t>(500,
+                           this->m_MattesAssociate->m_NumberOfHistogramBins *
+                             this->m_MattesAssociate->m_NumberOfHistogramBins / localNumberOfWorkUnitsUsed),
+          this->GetCachedNumberOfLocalParameters(),
+          // Need address of the lock
+          &this->m_MattesAssociate->m_JointPDFDerivativesLock,
+          this->m_MattesAssociate->m_JointPDFDerivatives);
+      }
     }
   }
 }
@@ -327,10 +377,23 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
     }
   }
 
+  // With the sparse Jacobian, store the sample to compute its contribution
+  // to the derivative once the joint PDF is known.
+  SparseJacobianSample * sparseJacobianSample = nullptr;
+  if (doComputeDerivative && this->GetSparseJacobianMovingTransform() != nullptr)
+  {
+    this->m_SparseJacobianSamples[threadId].emplace_back();
+    sparseJacobianSample = &this->m_SparseJacobianSamples[threadId].back();
+    sparseJacobianSample->VirtualPoint = virtualPoint;
+    sparseJacobianSample->MovingImageGradient = movingImageGradient;
+    sparseJacobianSample->JointPDFIndex1D =
+      pdfMovingIndex + (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_NumberOfHistogramBins);
+  }
+
   // Compute the transform Jacobian.
   using JacobianReferenceType = JacobianType &;
   JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
-  if (doComputeDerivative)
+  if (doComputeDerivative && sparseJacobianSample == nullptr)
   {
     JacobianReferenceType jacobianPositional =
       this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobianPositional;
@@ -365,6 +428,10 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
         this->ComputePDFDerivativesLocalSupportTransform(
           jacobian, movingImageGradient, cubicBSplineDerivativeValue, localSupportDerivativeResultPtr);
       }
+      else if (sparseJacobianSample != nullptr)
+      {
+        sparseJacobianSample->CubicBSplineDerivativeValues[movingParzenBin] = cubicBSplineDerivativeValue;
+      }
       else
       {
         // Update bins in the PDF derivatives for the current intensity pair
@@ -372,21 +439,41 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
           (fixedImageParzenWindowIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[2]) +
           (pdfMovingIndex * this->m_MattesAssociate->m_JointPDFDerivatives->GetOffsetTable()[1]);
 
-        PDFValueType * derivativeContributionPtr =
-          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
-        for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
-             ++mu)
+        if (this->m_MattesAssociate->m_UseThreaderJointPDFDerivatives)
         {
-          PDFValueType innerProduct = 0.0;
-          for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+          JointPDFDerivativesValueType * derivativeContributionPtr =
+            this->m_MattesAssociate->m_ThreaderJointPDFDerivatives[threadId]->GetBufferPointer() + ThisIndexOffset;
+          for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
+               ++mu)
           {
-            innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            PDFValueType innerProduct = 0.0;
+            for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+            {
+              innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            }
+
+            *(derivativeContributionPtr) += innerProduct * cubicBSplineDerivativeValue;
+            ++derivativeContributionPtr;
           }
-
-          *(derivativeContributionPtr) = innerProduct * cubicBSplineDerivativeValue;
-          ++derivativeContributionPtr;
         }
-        this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].CheckAndReduceIfNecessary();
+        else
+        {
+          PDFValueType * derivativeContributionPtr =
+            this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].GetNextElementAndAddOffset(ThisIndexOffset);
+          for (NumberOfParametersType mu = 0, maxElement = this->GetCachedNumberOfLocalParameters(); mu < maxElement;
+               ++mu)
+          {
+            PDFValueType innerProduct = 0.0;
+            for (SizeValueType dim = 0, lastDim = this->m_MattesAssociate->MovingImageDimension; dim < lastDim; ++dim)
+            {
+              innerProduct += jacobian[dim][mu] * movingImageGradient[dim];
+            }
+
+            *(derivativeContributionPtr) = innerProduct * cubicBSplineDerivativeValue;
+            ++derivativeContributionPtr;
+          }
+          this->m_MattesAssociate->m_ThreaderDerivativeManager[threadId].CheckAndReduceIfNecessary();
+        }
       }
     }
 
@@ -449,7 +536,8 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
   /* Post-processing that is common the GetValue and GetValueAndDerivative */
   this->m_MattesAssociate->GetValueCommonAfterThreadedExecution();
 
-  if (this->m_MattesAssociate->GetComputeDerivative() && (!this->m_MattesAssociate->HasLocalSupport()))
+  if (this->m_MattesAssociate->GetComputeDerivative() && (!this->m_MattesAssociate->HasLocalSupport()) &&
+      this->GetSparseJacobianMovingTransform() == nullptr)
   {
     // This entire block of code is used to accumulate the per-thread buffers
     // into 1 thread.
@@ -464,18 +552,121 @@ MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
 
     JointPDFDerivativesValueType * const accumulatorPdfDPtrStart =
       this->m_MattesAssociate->m_JointPDFDerivatives->GetBufferPointer();
-    JointPDFDerivativesValueType *             accumulatorPdfDPtr = accumulatorPdfDPtrStart;
-    JointPDFDerivativesValueType const * const tempThreadPdfDPtrEnd =
-      accumulatorPdfDPtrStart + histogramTotalElementsSize;
-    while (accumulatorPdfDPtr < tempThreadPdfDPtrEnd)
+    if (this->m_MattesAssociate->m_UseThreaderJointPDFDerivatives)
+    {
+      // Sum the joint PDF derivatives of the work units into the first one,
+      // by blocks of elements processed in parallel.
+      constexpr SizeValueType blockSize = 4096;
+      this->GetMultiThreader()->ParallelizeArray(
+        0,
+        (histogramTotalElementsSize + blockSize - 1) / blockSize,
+        [this, accumulatorPdfDPtrStart, histogramTotalElementsSize, localNumberOfWorkUnitsUsed, nFactor](
+          SizeValueType block) {
+          JointPDFDerivativesValueType * const accumulatorPdfDPtrBegin = accumulatorPdfDPtrStart + block * blockSize;
+          JointPDFDerivativesValueType * const accumulatorPdfDPtrEnd =
+            accumulatorPdfDPtrStart + std::min(histogramTotalElementsSize, (block + 1) * blockSize);
+          for (ThreadIdType workUnitID = 1; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+          {
+            const JointPDFDerivativesValueType * tempThreadPdfDPtr =
+              this->m_MattesAssociate->m_ThreaderJointPDFDerivatives[workUnitID]->GetBufferPointer() +
+              (accumulatorPdfDPtrBegin - accumulatorPdfDPtrStart);
+            for (JointPDFDerivativesValueType * accumulatorPdfDPtr = accumulatorPdfDPtrBegin;
+                 accumulatorPdfDPtr < accumulatorPdfDPtrEnd;
+                 ++accumulatorPdfDPtr)
+            {
+              *accumulatorPdfDPtr += *(tempThreadPdfDPtr++);
+            }
+          }
+          for (JointPDFDerivativesValueType * accumulatorPdfDPtr = accumulatorPdfDPtrBegin;
+               accumulatorPdfDPtr < accumulatorPdfDPtrEnd;
+               ++accumulatorPdfDPtr)
+          {
+            *accumulatorPdfDPtr *= nFactor;
+          }
+        },
+        nullptr);
+    }
+    else
     {
-      *(accumulatorPdfDPtr++) *= nFactor;
+      JointPDFDerivativesValueType *             accumulatorPdfDPtr = accumulatorPdfDPtrStart;
+      JointPDFDerivativesValueType const * const tempThreadPdfDPtrEnd =
+        accumulatorPdfDPtrStart + histogramTotalElementsSize;
+      while (accumulatorPdfDPtr < tempThreadPdfDPtrEnd)
+      {
+        *(accumulatorPdfDPtr++) *= nFactor;
+      }
     }
   }
 
   // Collect and compute results.
   // Value and derivative are stored in member vars.
   this->m_MattesAssociate->ComputeResults();
+
+  if (this->m_MattesAssociate->GetComputeDerivative() && this->GetSparseJacobianMovingTransform() != nullptr)
+  {
+    this->ComputeSparseJacobianDerivative();
+  }
+}
+
+template <typename TDomainPartitioner, typename TImageToImageMetric, typename TMattesMutualInformationMetric>
+void
+MattesMutualInformationImageToImageMetricv4GetValueAndDerivativeThreader<
+  TDomainPartitioner,
+  TImageToImageMetric,
+  TMattesMutualInformationMetric>::ComputeSparseJacobianDerivative()
+{
+  const ThreadIdType localNumberOfWorkUnitsUsed = this->GetNumberOfWorkUnitsUsed();
+
+  // Each work unit accumulates the contributions of its own samples, only
+  // for the parameters with a non-zero Jacobian.
+  this->GetMultiThreader()->ParallelizeArray(
+    0,
+    localNumberOfWorkUnitsUsed,
+    [this](SizeValueType workUnitID) {
+      const auto   threadId = static_cast<ThreadIdType>(workUnitID);
+      auto &       derivatives = this->m_GetValueAndDerivativePerThreadVariables[threadId].CompensatedDerivatives;
+      const auto & weights =
+        this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformSparseJacobianWeights;
+      for (const SparseJacobianSample & sample : this->m_SparseJacobianSamples[threadId])
+      {
+        // The pRatio array is scaled by the normalization factor of the derivative.
+        PDFValueType pRatioDerivative = 0.0;
+        for (SizeValueType bin = 0; bin < 4; ++bin)
+        {
+          pRatioDerivative += sample.CubicBSplineDerivativeValues[bin] *
+                              this->m_MattesAssociate->m_PRatioArray[sample.JointPDFIndex1D + bin];
+        }
+        if (pRatioDerivative == 0.0)
+        {
+          continue;
+        }
+
+        this->ComputeSparseJacobian(sample.VirtualPoint, threadId);
+        for (unsigned int dim = 0; dim < this->m_MattesAssociate->MovingImageDimension; ++dim)
+        {
+          const PDFValueType gradientDerivative = sample.MovingImageGradient[dim] * pRatioDerivative;
+          for (unsigned int k = 0; k < Superclass::SparseJacobianNumberOfWeights; ++k)
+          {
+            derivatives[this->GetSparseJacobianParameterIndex(threadId, k, dim)] += weights[k] * gradientDerivative;
+          }
+        }
+      }
+    },
+    nullptr);
+
+  // Note: as in the local-support case, the contributions are subtracted to
+  // minimize the metric.
+  for (NumberOfParametersType p = 0, numberOfParameters = this->GetCachedNumberOfParameters(); p < numberOfParameters;
+       ++p)
+  {
+    typename Superclass::CompensatedDerivativeValueType sum;
+    sum.ResetToZero();
+    for (ThreadIdType workUnitID = 0; workUnitID < localNumberOfWorkUnitsUsed; ++workUnitID)
+    {
+      sum += this->m_GetValueAndDerivativePerThreadVariables[workUnitID].CompensatedDerivatives[p].GetSum();
+    }
+    (*(this->m_MattesAssociate->m_DerivativeResult))[p] -= sum.GetSum();
+  }
 }
 
 } // end namespace itk
@@ -67,6 +67,13 @@ public:
 protected:
   MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader() = default;
 
+  /** The sparse Jacobian of a BSpline moving transform is supported. */
+  bool
+  GetSupportsSparseJacobian() const override
+  {
+    return true;
+  }
+
   /** This function computes the local voxel-wise contribution of
    *  the metric to the global integral of the metric/derivative.
    */
@@ -56,6 +56,32 @@ MeanSquaresImageToImageMetricv4GetValueAndDerivativeThreader<
     return true;
   }
 
+  if (this->GetSparseJacobianMovingTransform() != nullptr)
+  {
+    /* Only the derivatives with respect to the parameters with a non-zero
+     * Jacobian, the weight of their coefficient. */
+    this->ComputeSparseJacobian(virtualPoint, threadId);
+    const auto & weights =
+      this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformSparseJacobianWeights;
+    unsigned int par = 0;
+    for (SizeValueType dim = 0; dim < ImageToImageMetricv4Type::MovingImageDimension; ++dim)
+    {
+      for (unsigned int k = 0; k < Superclass::SparseJacobianNumberOfWeights; ++k, ++par)
+      {
+        localDerivativeReturn[par] = NumericTraits<DerivativeValueType>::ZeroValue();
+        for (unsigned int nc = 0; nc < nComponents; ++nc)
+        {
+          MeasureType diffValue = DefaultConvertPixelTraits<FixedImagePixelType>::GetNthComponent(nc, diff);
+          localDerivativeReturn[par] +=
+            2.0 * diffValue * weights[k] *
+            DefaultConvertPixelTraits<MovingImageGradientType>::GetNthComponent(
+              ImageToImageMetricv4Type::FixedImageDimension * nc + dim, movingImageGradient);
+        }
+      }
+    }
+    return true;
+  }
+
   /* Use a pre-allocated jacobian object for efficiency */
   using JacobianReferenceType = typename TImageToImageMetric::JacobianType &;
   JacobianReferenceType jacobian = this->m_GetValueAndDerivativePerThreadVariables[threadId].MovingTransformJacobian;
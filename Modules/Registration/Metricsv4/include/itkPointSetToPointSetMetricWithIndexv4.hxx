@@ -21,6 +21,8 @@
 #include "itkIdentityTransform.h"
 #include "itkCompensatedSummation.h"
 
+#include <vector>
+
 namespace itk
 {
 
@@ -507,20 +509,34 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
     typename MovingTransformType::InverseTransformBasePointer inverseTransform =
       this->m_MovingTransform->GetInverseTransform();
 
-    typename MovingPointsContainer::ConstIterator It = this->m_MovingPointSet->GetPoints()->Begin();
-    while (It != this->m_MovingPointSet->GetPoints()->End())
+    const MovingPointsContainer * movingPoints = this->m_MovingPointSet->GetPoints();
+    if (this->m_CalculateValueAndDerivativeInTangentSpace)
     {
-      if (this->m_CalculateValueAndDerivativeInTangentSpace)
+      // txf all the points into virtual space with a single call
+      using InverseTransformBaseType = typename MovingTransformType::InverseTransformBaseType;
+      std::vector<typename InverseTransformBaseType::InputPointType>  inputPoints;
+      std::vector<typename InverseTransformBaseType::OutputPointType> outputPoints(movingPoints->Size());
+      inputPoints.reserve(movingPoints->Size());
+      for (typename MovingPointsContainer::ConstIterator It = movingPoints->Begin(); It != movingPoints->End(); ++It)
+      {
+        inputPoints.push_back(It.Value());
+      }
+      inverseTransform->TransformPoints(inputPoints.data(), outputPoints.data(), inputPoints.size());
+
+      auto outputPoint = outputPoints.cbegin();
+      for (typename MovingPointsContainer::ConstIterator It = movingPoints->Begin(); It != movingPoints->End(); ++It)
       {
-        PointType point = inverseTransform->TransformPoint(It.Value());
+        const PointType point(*outputPoint++);
         this->m_MovingTransformedPointSet->SetPoint(It.Index(), point);
       }
-      else
+    }
+    else
+    {
+      // evaluation is performed in moving space, so just copy
+      for (typename MovingPointsContainer::ConstIterator It = movingPoints->Begin(); It != movingPoints->End(); ++It)
       {
-        // evaluation is performed in moving space, so just copy
         this->m_MovingTransformedPointSet->SetPoint(It.Index(), It.Value());
       }
-      ++It;
     }
     this->m_MovingTransformedPointSetTime = this->GetMTime();
     if (!this->m_CalculateValueAndDerivativeInTangentSpace)
@@ -555,26 +571,41 @@ PointSetToPointSetMetricWithIndexv4<TFixedPointSet, TMovingPointSet, TInternalCo
     using InverseTransformBasePointer = typename FixedTransformType::InverseTransformBasePointer;
     InverseTransformBasePointer inverseTransform = this->m_FixedTransform->GetInverseTransform();
 
-    typename FixedPointsContainer::ConstIterator It = this->m_FixedPointSet->GetPoints()->Begin();
-    while (It != this->m_FixedPointSet->GetPoints()->End())
+    // The points are transformed with a single call to each transform.
+    const FixedPointsContainer * fixedPoints = this->m_FixedPointSet->GetPoints();
+    std::vector<typename FixedTransformType::OutputPointType> inputPoints;
+    std::vector<typename FixedTransformType::InputPointType>  virtualPoints(fixedPoints->Size());
+    inputPoints.reserve(fixedPoints->Size());
+    for (typename FixedPointsContainer::ConstIterator It = fixedPoints->Begin(); It != fixedPoints->End(); ++It)
+    {
+      inputPoints.push_back(It.Value());
+    }
+
+    // txf into virtual space
+    inverseTransform->TransformPoints(inputPoints.data(), virtualPoints.data(), inputPoints.size());
+
+    std::vector<typename MovingTransformType::OutputPointType> movingPoints;
+    if (!this->m_CalculateValueAndDerivativeInTangentSpace)
+    {
+      // txf into moving space
+      movingPoints.resize(virtualPoints.size());
+      this->m_MovingTransform->TransformPoints(virtualPoints.data(), movingPoints.data(), virtualPoints.size());
+    }
+
+    SizeValueType i = 0;
+    for (typename FixedPointsContainer::ConstIterator It = fixedPoints->Begin(); It != fixedPoints->End(); ++It, ++i)
     {
+      const PointType virtualPoint(virtualPoints[i]);
+      this->m_VirtualTransformedPointSet->SetPoint(It.Index(), virtualPoint);
       if (this->m_CalculateValueAndDerivativeInTangentSpace)
       {
-        // txf into virtual space
-        PointType point = inverseTransform->TransformPoint(It.Value());
-        this->m_VirtualTransformedPointSet->SetPoint(It.Index(), point);
-        this->m_FixedTransformedPointSet->SetPoint(It.Index(), point);
+        this->m_FixedTransformedPointSet->SetPoint(It.Index(), virtualPoint);
       }
       else
       {
-        // txf into virtual space
-        PointType point = inverseTransform->TransformPoint(It.Value());
-        this->m_VirtualTransformedPointSet->SetPoint(It.Index(), point);
-        // txf into moving space
-        point = this->m_MovingTransform->TransformPoint(point);
-        this->m_FixedTransformedPointSet->SetPoint(It.Index(), point);
+        const PointType movingPoint(movingPoints[i]);
+        this->m_FixedTransformedPointSet->SetPoint(It.Index(), movingPoint);
       }
-      ++It;
     }
     this->m_FixedTransformedPointSetTime = std::max(this->GetMTime(), this->m_FixedTransform->GetMTime());
     if (!this->m_CalculateValueAndDerivativeInTangentSpace)
@@ -0,0 +1,200 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkMeanSquaresImageToImageMetricv4.h"
+#include "itkCorrelationImageToImageMetricv4.h"
+#include "itkANTSNeighborhoodCorrelationImageToImageMetricv4.h"
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkBSplineTransform.h"
+#include "itkIdentityTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkTestingMacros.h"
+
+/* Verify that the metrics compute the same value and derivative with the
+ * sparse Jacobian of a BSpline moving transform as with its dense Jacobian,
+ * with the dense and the sparse threaders. */
+
+namespace
+{
+constexpr unsigned int ImageDimension = 2;
+using ImageType = itk::Image<double, ImageDimension>;
+using BSplineTransformType = itk::BSplineTransform<double, ImageDimension, 3>;
+using IdentityTransformType = itk::IdentityTransform<double, ImageDimension>;
+
+ImageType::Pointer
+CreateBlobImage(double centerX, double centerY)
+{
+  ImageType::SizeType size;
+  size.Fill(40);
+
+  auto image = ImageType::New();
+  image->SetRegions(size);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double dx = it.GetIndex()[0] - centerX;
+    const double dy = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(dx * dx + dy * dy) / 60.0) + 0.05 * dx * dy);
+  }
+  return image;
+}
+
+template <typename TMetric>
+int
+TestSparseJacobian(TMetric * metric, const char * name, bool useSampledPointSet)
+{
+  std::cout << name << (useSampledPointSet ? " with a sampled point set" : "") << std::endl;
+
+  const ImageType::Pointer fixedImage = CreateBlobImage(19.0, 20.0);
+  const ImageType::Pointer movingImage = CreateBlobImage(21.5, 18.0);
+
+  auto                               movingTransform = BSplineTransformType::New();
+  BSplineTransformType::MeshSizeType meshSize;
+  meshSize.Fill(4);
+  BSplineTransformType::PhysicalDimensionsType dimensions;
+  dimensions.Fill(39.0);
+  movingTransform->SetTransformDomainOrigin(fixedImage->GetOrigin());
+  movingTransform->SetTransformDomainPhysicalDimensions(dimensions);
+  movingTransform->SetTransformDomainDirection(fixedImage->GetDirection());
+  movingTransform->SetTransformDomainMeshSize(meshSize);
+
+  BSplineTransformType::ParametersType parameters(movingTransform->GetNumberOfParameters());
+  for (unsigned int p = 0; p < parameters.Size(); ++p)
+  {
+    parameters[p] = 0.7 * std::sin(0.37 * p);
+  }
+  movingTransform->SetParameters(parameters);
+
+  metric->SetFixedImage(fixedImage);
+  metric->SetMovingImage(movingImage);
+  metric->SetFixedTransform(IdentityTransformType::New());
+  metric->SetMovingTransform(movingTransform);
+
+  if (useSampledPointSet)
+  {
+    using PointSetType = typename TMetric::FixedSampledPointSetType;
+    auto                                         pointSet = PointSetType::New();
+    unsigned int                                 pointId = 0;
+    itk::ImageRegionIteratorWithIndex<ImageType> it(fixedImage, fixedImage->GetLargestPossibleRegion());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      if ((it.GetIndex()[0] + 3 * it.GetIndex()[1]) % 5 == 0)
+      {
+        typename PointSetType::PointType point;
+        fixedImage->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+        pointSet->SetPoint(pointId++, point);
+      }
+    }
+    metric->SetFixedSampledPointSet(pointSet);
+    metric->SetUseSampledPointSet(true);
+  }
+
+  typename TMetric::MeasureType    denseValue, sparseValue;
+  typename TMetric::DerivativeType denseDerivative, sparseDerivative;
+
+  metric->SetUseSparseJacobian(false);
+  ITK_TRY_EXPECT_NO_EXCEPTION(metric->Initialize());
+  ITK_TRY_EXPECT_NO_EXCEPTION(metric->GetValueAndDerivative(denseValue, denseDerivative));
+
+  metric->SetUseSparseJacobian(true);
+  ITK_TRY_EXPECT_NO_EXCEPTION(metric->Initialize());
+  ITK_TRY_EXPECT_NO_EXCEPTION(metric->GetValueAndDerivative(sparseValue, sparseDerivative));
+
+  if (metric->GetSparseJacobianMovingTransform() != movingTransform.GetPointer())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Error in GetSparseJacobianMovingTransform()" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The derivative is expected to be non-trivial
+  const double derivativeMagnitude = denseDerivative.inf_norm();
+  if (!(derivativeMagnitude > 0.0) || sparseDerivative.Size() != denseDerivative.Size())
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "Unexpected dense derivative: " << denseDerivative << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const double tolerance = 1e-10;
+  if (std::abs(sparseValue - denseValue) > tolerance * std::abs(denseValue) ||
+      (sparseDerivative - denseDerivative).inf_norm() > tolerance * derivativeMagnitude)
+  {
+    std::cerr << "Test failed!" << std::endl;
+    std::cerr << "The sparse Jacobian does not give the same results as the dense one." << std::endl;
+    std::cerr << "Dense value: " << denseValue << ", sparse value: " << sparseValue << std::endl;
+    std::cerr << "Dense derivative: " << denseDerivative << std::endl;
+    std::cerr << "Sparse derivative: " << sparseDerivative << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
+
+template <typename TMetric>
+int
+TestSparseJacobianWithMetric(const char * name)
+{
+  int result = EXIT_SUCCESS;
+  for (const bool useSampledPointSet : { false, true })
+  {
+    auto metric = TMetric::New();
+    if (TestSparseJacobian(metric.GetPointer(), name, useSampledPointSet) == EXIT_FAILURE)
+    {
+      result = EXIT_FAILURE;
+    }
+  }
+  return result;
+}
+} // namespace
+
+int
+itkImageToImageMetricv4SparseJacobianTest(int, char *[])
+{
+  using MeanSquaresMetricType = itk::MeanSquaresImageToImageMetricv4<ImageType, ImageType>;
+  using CorrelationMetricType = itk::CorrelationImageToImageMetricv4<ImageType, ImageType>;
+  using ANTSNeighborhoodCorrelationMetricType =
+    itk::ANTSNeighborhoodCorrelationImageToImageMetricv4<ImageType, ImageType>;
+  using MattesMutualInformationMetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+  auto metric = MeanSquaresMetricType::New();
+  ITK_TEST_SET_GET_BOOLEAN(metric, UseSparseJacobian, true);
+
+  int result = EXIT_SUCCESS;
+  if (TestSparseJacobianWithMetric<MeanSquaresMetricType>("MeanSquares") == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+  if (TestSparseJacobianWithMetric<CorrelationMetricType>("Correlation") == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+  if (TestSparseJacobianWithMetric<ANTSNeighborhoodCorrelationMetricType>("ANTSNeighborhoodCorrelation") ==
+      EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+  if (TestSparseJacobianWithMetric<MattesMutualInformationMetricType>("MattesMutualInformation") == EXIT_FAILURE)
+  {
+    result = EXIT_FAILURE;
+  }
+
+  std::cout << "Test finished." << std::endl;
+  return result;
+}
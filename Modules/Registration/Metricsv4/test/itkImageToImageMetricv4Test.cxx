@@ -237,6 +237,12 @@ ImageToImageMetricv4TestComputeIdentityTruthValues(const ImageToImageMetricv4Tes
         metric->GetFixedImageGradientImage();
       fixedImageDerivative = fixedGradientImage->GetPixel(itFixed.GetIndex());
     }
+    else if (metric->GetUseFixedImageGradientCache())
+    {
+      ImageToImageMetricv4TestMetricType::FixedImagePointType point;
+      fixedImage->TransformIndexToPhysicalPoint(itFixed.GetIndex(), point);
+      fixedImageDerivative = metric->GetFixedImageGradientCache()->Evaluate(point);
+    }
     else
     {
       using FixedGradientCalculatorPointer =
@@ -254,6 +260,12 @@ ImageToImageMetricv4TestComputeIdentityTruthValues(const ImageToImageMetricv4Tes
         metric->GetMovingImageGradientImage();
       movingImageDerivative = movingGradientImage->GetPixel(itMoving.GetIndex());
     }
+    else if (metric->GetUseMovingImageGradientCache())
+    {
+      ImageToImageMetricv4TestMetricType::FixedImagePointType point;
+      movingImage->TransformIndexToPhysicalPoint(itMoving.GetIndex(), point);
+      movingImageDerivative = metric->GetMovingImageGradientCache()->Evaluate(point);
+    }
     else
     {
       using MovingGradientCalculatorPointer =
@@ -526,6 +538,24 @@ itkImageToImageMetricv4Test(int, char ** const)
     } // loop through permutations
   }   // loop thru # of threads
 
+  // Test the caches of the gradients of the gradient calculators.
+  metric->SetUseFixedImageGradientFilter(false);
+  metric->SetUseMovingImageGradientFilter(false);
+  metric->UseFixedImageGradientCacheOn();
+  metric->UseMovingImageGradientCacheOn();
+  std::cout << "* Testing with gradient caches..." << std::endl;
+  ImageToImageMetricv4TestComputeIdentityTruthValues(metric, fixedImage, movingImage, truthValue, truthDerivative);
+  if (ImageToImageMetricv4TestRunSingleTest(metric, truthValue, truthDerivative, imageSize * imageSize, false) !=
+        EXIT_SUCCESS ||
+      metric->GetFixedImageGradientCache()->GetNumberOfCachedBlocks() == 0 ||
+      metric->GetMovingImageGradientCache()->GetNumberOfCachedBlocks() == 0)
+  {
+    std::cerr << "Failed testing with gradient caches." << std::endl;
+    return EXIT_FAILURE;
+  }
+  metric->UseFixedImageGradientCacheOff();
+  metric->UseMovingImageGradientCacheOff();
+
 
   // Test that non-overlapping images will generate a warning
   // and return max value for metric value.
@@ -0,0 +1,146 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#include "itkMattesMutualInformationImageToImageMetricv4.h"
+#include "itkAffineTransform.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkMultiThreaderBase.h"
+#include "itkTimeProbe.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Report the number of evaluations of the metric and its derivative per
+ * second with an affine transform, for increasing numbers of threads, and
+ * check that the results do not depend on the number of threads.
+ */
+
+int
+itkMattesMutualInformationImageToImageMetricv4SpeedTest(int argc, char * argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "usage: " << itkNameOfTestExecutableMacro(argv) << ": image-dimension number-of-reps" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const int imageSize = std::stoi(argv[1]);
+  const int numberOfReps = std::stoi(argv[2]);
+
+  std::cout << "image dim: " << imageSize << ", reps: " << numberOfReps << std::endl;
+
+  constexpr unsigned int imageDimensionality = 3;
+  using ImageType = itk::Image<double, imageDimensionality>;
+
+  ImageType::SizeType size;
+  size.Fill(imageSize);
+
+  /* Create simple test images. */
+  auto fixedImage = ImageType::New();
+  fixedImage->SetRegions(size);
+  fixedImage->Allocate();
+
+  auto movingImage = ImageType::New();
+  movingImage->SetRegions(size);
+  movingImage->Allocate();
+
+  /* Fill images */
+  const double center = 0.5 * imageSize;
+  const double radius = 0.3 * imageSize;
+
+  itk::ImageRegionIteratorWithIndex<ImageType> itFixed(fixedImage, fixedImage->GetLargestPossibleRegion());
+  itk::ImageRegionIteratorWithIndex<ImageType> itMoving(movingImage, movingImage->GetLargestPossibleRegion());
+  for (itFixed.GoToBegin(), itMoving.GoToBegin(); !itFixed.IsAtEnd(); ++itFixed, ++itMoving)
+  {
+    double fixedDistance = 0.0;
+    double movingDistance = 0.0;
+    for (unsigned int d = 0; d < imageDimensionality; ++d)
+    {
+      const double fixedOffset = itFixed.GetIndex()[d] - center;
+      const double movingOffset = itMoving.GetIndex()[d] - center - 1.5;
+      fixedDistance += fixedOffset * fixedOffset;
+      movingDistance += movingOffset * movingOffset;
+    }
+    itFixed.Set(100.0 * std::exp(-fixedDistance / (radius * radius)));
+    itMoving.Set(200.0 - 80.0 * std::exp(-movingDistance / (radius * radius)));
+  }
+
+  /* Transforms */
+  using TransformType = itk::AffineTransform<double, imageDimensionality>;
+
+  auto fixedTransform = TransformType::New();
+  auto movingTransform = TransformType::New();
+  fixedTransform->SetIdentity();
+  movingTransform->SetIdentity();
+
+  /* The metric */
+  using MetricType = itk::MattesMutualInformationImageToImageMetricv4<ImageType, ImageType>;
+
+  MetricType::MeasureType    referenceValue = 0.0;
+  MetricType::DerivativeType referenceDerivative;
+
+  // The threaders of the metric split their work according to the global
+  // default number of threads when they are created.
+  const itk::ThreadIdType defaultNumberOfThreads = itk::MultiThreaderBase::GetGlobalDefaultNumberOfThreads();
+  const itk::ThreadIdType maximumNumberOfThreads = std::max<itk::ThreadIdType>(4, defaultNumberOfThreads);
+  for (itk::ThreadIdType numberOfThreads = 1; numberOfThreads <= maximumNumberOfThreads; numberOfThreads *= 2)
+  {
+    itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(numberOfThreads);
+    auto metric = MetricType::New();
+    metric->SetNumberOfHistogramBins(50);
+    metric->SetFixedImage(fixedImage);
+    metric->SetMovingImage(movingImage);
+    metric->SetFixedTransform(fixedTransform);
+    metric->SetMovingTransform(movingTransform);
+    metric->SetUseMovingImageGradientFilter(false);
+    metric->SetUseFixedImageGradientFilter(false);
+
+    ITK_TRY_EXPECT_NO_EXCEPTION(metric->Initialize());
+
+    MetricType::MeasureType    value;
+    MetricType::DerivativeType derivative;
+
+    itk::TimeProbe timeProbe;
+    for (int r = 0; r < numberOfReps; ++r)
+    {
+      timeProbe.Start();
+      metric->GetValueAndDerivative(value, derivative);
+      timeProbe.Stop();
+    }
+
+    std::cout << "threads: " << numberOfThreads << ", work units: " << metric->GetNumberOfWorkUnitsUsed()
+              << ", evaluations/s: " << timeProbe.GetNumberOfStops() / timeProbe.GetTotal() << std::endl;
+
+    if (numberOfThreads == 1)
+    {
+      referenceValue = value;
+      referenceDerivative = derivative;
+    }
+    else if (std::abs(value - referenceValue) > 1e-10 * std::abs(referenceValue) ||
+             (derivative - referenceDerivative).inf_norm() > 1e-8 * referenceDerivative.inf_norm())
+    {
+      std::cerr << "Test failed!" << std::endl;
+      std::cerr << "The results depend on the number of threads." << std::endl;
+      std::cerr << "Value with 1 thread: " << referenceValue << ", with " << numberOfThreads << " threads: " << value
+                << std::endl;
+      std::cerr << "Derivative with 1 thread: " << referenceDerivative << ", with " << numberOfThreads
+                << " threads: " << derivative << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  itk::MultiThreaderBase::SetGlobalDefaultNumberOfThreads(defaultNumberOfThreads);
+
+  return EXIT_SUCCESS;
+}
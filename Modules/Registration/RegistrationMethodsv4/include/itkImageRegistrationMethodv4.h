@@ -26,6 +26,7 @@
 #include "itkObjectToObjectMultiMetricv4.h"
 #include "itkObjectToObjectOptimizerBase.h"
 #include "itkImageToImageMetricv4.h"
+#include "itkImageRegistrationPyramidCache.h"
 #include "itkPointSetToPointSetMetricWithIndexv4.h"
 #include "itkShrinkImageFilter.h"
 #include "itkIdentityTransform.h"
@@ -102,6 +103,13 @@ extern ITKRegistrationMethodsv4_EXPORT std::ostream &
  * given stage so typical use will be to assign the base adaptor class to
  * level 0 of all stages but we leave that open to the user.
  *
+ * Pyramid cache:  The smoothed fixed and moving images and the shrunk
+ * virtual domain images of each level can be cached in an
+ * ImageRegistrationPyramidCache.  Setting the same cache on the
+ * registration methods of the stages of a multi-stage registration
+ * computes these images only once for all the stages that use the same
+ * images, sigmas and shrink factors.
+ *
  * Output: The output is the updated transform.
  *
  * \author Nick Tustison
@@ -197,6 +205,10 @@ public:
   using ShrinkFactorsArrayType = Array<SizeValueType>;
 
   using SmoothingSigmasArrayType = Array<RealType>;
+
+  /** Type of the cache of the smoothed and shrunk images of the levels. */
+  using PyramidCacheType = ImageRegistrationPyramidCache<FixedImageType, MovingImageType, VirtualImageType>;
+  using PyramidCachePointer = typename PyramidCacheType::Pointer;
   using MetricSamplingPercentageArrayType = Array<RealType>;
 
   /** Transform adaptor type alias */
@@ -433,6 +445,16 @@ public:
   itkGetConstMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits, bool);
   itkBooleanMacro(SmoothingSigmasAreSpecifiedInPhysicalUnits);
 
+  /**
+   * Set/Get the cache of the smoothed fixed and moving images and of the
+   * shrunk virtual domain images of the levels.  The same cache can be set
+   * on the registration methods of several stages, which then share the
+   * images they have in common.  No cache is used by default, and the images
+   * of each level are computed when the level is initialized.
+   */
+  itkSetObjectMacro(PyramidCache, PyramidCacheType);
+  itkGetModifiableObjectMacro(PyramidCache, PyramidCacheType);
+
   /** Make a DataObject of the correct type to be used as the specified output. */
   using DataObjectPointerArraySizeType = ProcessObject::DataObjectPointerArraySizeType;
   using Superclass::MakeOutput;
@@ -560,6 +582,7 @@ protected:
   std::vector<ShrinkFactorsPerDimensionContainerType> m_ShrinkFactorsPerLevel;
   SmoothingSigmasArrayType                            m_SmoothingSigmasPerLevel;
   bool                                                m_SmoothingSigmasAreSpecifiedInPhysicalUnits;
+  PyramidCachePointer                                 m_PyramidCache;
 
   bool m_ReseedIterator;
   int  m_RandomSeed;
@@ -472,7 +472,12 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
   //   2. smooth the fixed and moving images.
 
   typename VirtualImageType::Pointer currentLevelVirtualDomainImage = nullptr;
-  if (this->m_VirtualDomainImage.IsNotNull())
+  if (this->m_VirtualDomainImage.IsNotNull() && this->m_PyramidCache.IsNotNull())
+  {
+    currentLevelVirtualDomainImage = this->m_PyramidCache->GetShrunkVirtualDomainImage(
+      this->m_VirtualDomainImage, this->m_ShrinkFactorsPerLevel[level]);
+  }
+  else if (this->m_VirtualDomainImage.IsNotNull())
   {
     auto shrinkFilter = ShrinkFilterType::New();
     shrinkFilter->SetShrinkFactors(this->m_ShrinkFactorsPerLevel[level]);
@@ -621,8 +626,6 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
       if (this->m_SmoothingSigmasPerLevel[level] > 0)
       {
         using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
-        typename FixedImageSmoothingFilterType::Pointer fixedImageSmoothingFilter =
-          FixedImageSmoothingFilterType::New();
         typename FixedImageSmoothingFilterType::SigmaArrayType fixedImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -634,16 +637,24 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             fixedImageSigmaArray[i] *= fixedSpacing[i];
           }
         }
-        fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
-        fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
-
-        this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
-        fixedImageSmoothingFilter->Update();
-        fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        if (this->m_PyramidCache.IsNotNull())
+        {
+          this->m_FixedSmoothImages[n] =
+            this->m_PyramidCache->GetSmoothedFixedImage(this->GetFixedImage(n), fixedImageSigmaArray);
+        }
+        else
+        {
+          typename FixedImageSmoothingFilterType::Pointer fixedImageSmoothingFilter =
+            FixedImageSmoothingFilterType::New();
+          fixedImageSmoothingFilter->SetSigmaArray(fixedImageSigmaArray);
+          fixedImageSmoothingFilter->SetInput(this->GetFixedImage(n));
+
+          this->m_FixedSmoothImages[n] = fixedImageSmoothingFilter->GetOutput();
+          fixedImageSmoothingFilter->Update();
+          fixedImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        }
 
         using MovingImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<MovingImageType, MovingImageType>;
-        typename MovingImageSmoothingFilterType::Pointer movingImageSmoothingFilter =
-          MovingImageSmoothingFilterType::New();
         typename MovingImageSmoothingFilterType::SigmaArrayType movingImageSigmaArray(
           this->m_SmoothingSigmasPerLevel[level]);
 
@@ -655,12 +666,22 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
             movingImageSigmaArray[i] *= movingSpacing[i];
           }
         }
-        movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
-        movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
-
-        this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
-        movingImageSmoothingFilter->Update();
-        movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        if (this->m_PyramidCache.IsNotNull())
+        {
+          this->m_MovingSmoothImages[n] =
+            this->m_PyramidCache->GetSmoothedMovingImage(this->GetMovingImage(n), movingImageSigmaArray);
+        }
+        else
+        {
+          typename MovingImageSmoothingFilterType::Pointer movingImageSmoothingFilter =
+            MovingImageSmoothingFilterType::New();
+          movingImageSmoothingFilter->SetSigmaArray(movingImageSigmaArray);
+          movingImageSmoothingFilter->SetInput(this->GetMovingImage(n));
+
+          this->m_MovingSmoothImages[n] = movingImageSmoothingFilter->GetOutput();
+          movingImageSmoothingFilter->Update();
+          movingImageSmoothingFilter->GetOutput()->DisconnectPipeline();
+        }
       }
       else
       {
@@ -1187,6 +1208,8 @@ ImageRegistrationMethodv4<TFixedImage, TMovingImage, TTransform, TVirtualImage,
     os << indent2 << "Smoothing sigmas are specified in voxel units." << std::endl;
   }
 
+  itkPrintSelfObjectMacro(PyramidCache);
+
   if (this->m_OptimizerWeights.Size() > 0)
   {
     os << indent << "Optimizers weights: " << this->m_OptimizerWeights << std::endl;
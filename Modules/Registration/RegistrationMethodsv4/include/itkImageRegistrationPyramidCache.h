@@ -0,0 +1,166 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_h
+#define itkImageRegistrationPyramidCache_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkShrinkImageFilter.h"
+#include "itkSmoothingRecursiveGaussianImageFilter.h"
+
+#include <mutex>
+#include <vector>
+
+namespace itk
+{
+/** \class ImageRegistrationPyramidCache
+ * \brief Cache of the smoothed images and shrunk virtual domain images of
+ * multi-resolution registrations.
+ *
+ * At each level, ImageRegistrationMethodv4 smooths the fixed and moving
+ * images with a SmoothingRecursiveGaussianImageFilter and shrinks the
+ * virtual domain image with a ShrinkImageFilter. Multi-stage registrations,
+ * e.g. rigid, then affine, then SyN, usually use the same images, sigmas and
+ * shrink factors in all their stages, and therefore recompute the same
+ * images at each stage. Setting the same cache on the registration methods
+ * of all the stages computes each of these images only once.
+ *
+ * The smoothed images are cached by input image, modified time of the input
+ * image, and sigmas (in physical units). The shrunk virtual domain images are
+ * cached by domain (largest possible region, origin, spacing and direction)
+ * and shrink factors, since only the domain of the virtual domain image is
+ * used. The smoothed images are
+ * computed by the multi-threaded filters, and the cache can be used from
+ * several threads. The cached images are kept until ClearCache() is called,
+ * or the cache is deleted.
+ *
+ * The cached images are shared by all the registration methods using the
+ * cache, and must not be modified.
+ *
+ * \sa ImageRegistrationMethodv4
+ *
+ * \ingroup ITKRegistrationMethodsv4
+ */
+template <typename TFixedImage, typename TMovingImage = TFixedImage, typename TVirtualImage = TFixedImage>
+class ITK_TEMPLATE_EXPORT ImageRegistrationPyramidCache : public Object
+{
+public:
+  ITK_DISALLOW_COPY_AND_MOVE(ImageRegistrationPyramidCache);
+
+  /** Standard class type aliases. */
+  using Self = ImageRegistrationPyramidCache;
+  using Superclass = Object;
+  using Pointer = SmartPointer<Self>;
+  using ConstPointer = SmartPointer<const Self>;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageRegistrationPyramidCache, Object);
+
+  /** ImageDimension constants */
+  static constexpr unsigned int ImageDimension = TFixedImage::ImageDimension;
+
+  /** Image type alias. */
+  using FixedImageType = TFixedImage;
+  using MovingImageType = TMovingImage;
+  using VirtualImageType = TVirtualImage;
+
+  /** Types of the filters computing the cached images. */
+  using FixedImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<FixedImageType, FixedImageType>;
+  using MovingImageSmoothingFilterType = SmoothingRecursiveGaussianImageFilter<MovingImageType, MovingImageType>;
+  using ShrinkFilterType = ShrinkImageFilter<VirtualImageType, VirtualImageType>;
+
+  using FixedSigmaArrayType = typename FixedImageSmoothingFilterType::SigmaArrayType;
+  using MovingSigmaArrayType = typename MovingImageSmoothingFilterType::SigmaArrayType;
+  using ShrinkFactorsType = typename ShrinkFilterType::ShrinkFactorsType;
+
+  /** Get the fixed image smoothed with the sigmas, in physical units.
+   * The image itself is returned when all the sigmas are zero. */
+  const FixedImageType *
+  GetSmoothedFixedImage(const FixedImageType * image, const FixedSigmaArrayType & sigmas);
+
+  /** Get the moving image smoothed with the sigmas, in physical units.
+   * The image itself is returned when all the sigmas are zero. */
+  const MovingImageType *
+  GetSmoothedMovingImage(const MovingImageType * image, const MovingSigmaArrayType & sigmas);
+
+  /** Get the virtual domain image shrunk by the shrink factors. */
+  VirtualImageType *
+  GetShrunkVirtualDomainImage(const VirtualImageType * image, const ShrinkFactorsType & shrinkFactors);
+
+  /** Remove all the cached images. */
+  void
+  ClearCache();
+
+  /** Get the number of cached images. */
+  SizeValueType
+  GetNumberOfCachedImages() const;
+
+protected:
+  ImageRegistrationPyramidCache() = default;
+  ~ImageRegistrationPyramidCache() override = default;
+
+  void
+  PrintSelf(std::ostream & os, Indent indent) const override;
+
+private:
+  /** A cached image, computed from an input image and parameters. */
+  template <typename TImage, typename TParameters>
+  struct Entry
+  {
+    typename TImage::ConstPointer Input;
+    ModifiedTimeType              InputTime;
+    TParameters                   Parameters;
+    typename TImage::Pointer      Output;
+  };
+
+  template <typename TImage, typename TParameters>
+  using EntriesType = std::vector<Entry<TImage, TParameters>>;
+
+  /** Removes the images computed from a previous version of the image.
+   * Called with m_Mutex locked. */
+  template <typename TImage, typename TParameters>
+  static void
+  RemoveOutOfDateEntries(EntriesType<TImage, TParameters> & entries, const TImage * image);
+
+  /** Finds the image cached for an input for which isSameInput is true and
+   * for the parameters, or computes it from the image and caches it. Called
+   * with m_Mutex locked. */
+  template <typename TImage, typename TParameters, typename TPredicate, typename TFunction>
+  static TImage *
+  FindOrCompute(EntriesType<TImage, TParameters> & entries,
+                const TImage *                     image,
+                const TParameters &                parameters,
+                TPredicate                         isSameInput,
+                TFunction                          compute);
+
+  EntriesType<FixedImageType, FixedSigmaArrayType>   m_SmoothedFixedImages;
+  EntriesType<MovingImageType, MovingSigmaArrayType> m_SmoothedMovingImages;
+  EntriesType<VirtualImageType, ShrinkFactorsType>   m_ShrunkVirtualDomainImages;
+
+  mutable std::mutex m_Mutex;
+};
+} // end namespace itk
+
+#ifndef ITK_MANUAL_INSTANTIATION
+#  include "itkImageRegistrationPyramidCache.hxx"
+#endif
+
+#endif
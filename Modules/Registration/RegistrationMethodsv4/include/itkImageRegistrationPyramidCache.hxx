@@ -0,0 +1,196 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+#ifndef itkImageRegistrationPyramidCache_hxx
+#define itkImageRegistrationPyramidCache_hxx
+
+#include <algorithm>
+
+namespace itk
+{
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetSmoothedFixedImage(
+  const FixedImageType *      image,
+  const FixedSigmaArrayType & sigmas) -> const FixedImageType *
+{
+  if (image == nullptr)
+  {
+    itkExceptionMacro("The fixed image is not present.");
+  }
+  if (std::all_of(sigmas.Begin(), sigmas.End(), [](double sigma) { return sigma == 0.0; }))
+  {
+    return image;
+  }
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  RemoveOutOfDateEntries(m_SmoothedFixedImages, image);
+  const auto isSameImage = [image](const FixedImageType * input) { return input == image; };
+  return FindOrCompute(m_SmoothedFixedImages, image, sigmas, isSameImage, [&sigmas](const FixedImageType * input) {
+    auto filter = FixedImageSmoothingFilterType::New();
+    filter->SetSigmaArray(sigmas);
+    filter->SetInput(input);
+    filter->Update();
+    typename FixedImageType::Pointer output = filter->GetOutput();
+    output->DisconnectPipeline();
+    return output;
+  });
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetSmoothedMovingImage(
+  const MovingImageType *      image,
+  const MovingSigmaArrayType & sigmas) -> const MovingImageType *
+{
+  if (image == nullptr)
+  {
+    itkExceptionMacro("The moving image is not present.");
+  }
+  if (std::all_of(sigmas.Begin(), sigmas.End(), [](double sigma) { return sigma == 0.0; }))
+  {
+    return image;
+  }
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  RemoveOutOfDateEntries(m_SmoothedMovingImages, image);
+  const auto isSameImage = [image](const MovingImageType * input) { return input == image; };
+  return FindOrCompute(m_SmoothedMovingImages, image, sigmas, isSameImage, [&sigmas](const MovingImageType * input) {
+    auto filter = MovingImageSmoothingFilterType::New();
+    filter->SetSigmaArray(sigmas);
+    filter->SetInput(input);
+    filter->Update();
+    typename MovingImageType::Pointer output = filter->GetOutput();
+    output->DisconnectPipeline();
+    return output;
+  });
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+auto
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetShrunkVirtualDomainImage(
+  const VirtualImageType *  image,
+  const ShrinkFactorsType & shrinkFactors) -> VirtualImageType *
+{
+  if (image == nullptr)
+  {
+    itkExceptionMacro("The virtual domain image is not present.");
+  }
+
+  // Only the domain of the virtual domain image is used, so that the images
+  // are cached by domain, with an image holding that domain without pixels.
+  auto domain = VirtualImageType::New();
+  domain->CopyInformation(image);
+  domain->SetRegions(image->GetLargestPossibleRegion());
+  const auto isSameDomain = [image](const VirtualImageType * input) {
+    return input->GetLargestPossibleRegion() == image->GetLargestPossibleRegion() &&
+           input->GetOrigin() == image->GetOrigin() && input->GetSpacing() == image->GetSpacing() &&
+           input->GetDirection() == image->GetDirection();
+  };
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return FindOrCompute(
+    m_ShrunkVirtualDomainImages, domain.GetPointer(), shrinkFactors, isSameDomain, [&](const VirtualImageType *) {
+      auto filter = ShrinkFilterType::New();
+      filter->SetShrinkFactors(shrinkFactors);
+      filter->SetInput(image);
+      filter->Update();
+      typename VirtualImageType::Pointer output = filter->GetOutput();
+      output->DisconnectPipeline();
+      return output;
+    });
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+template <typename TImage, typename TParameters>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::RemoveOutOfDateEntries(
+  EntriesType<TImage, TParameters> & entries,
+  const TImage *                     image)
+{
+  const ModifiedTimeType inputTime = image->GetMTime();
+  entries.erase(std::remove_if(entries.begin(),
+                               entries.end(),
+                               [image, inputTime](const Entry<TImage, TParameters> & entry) {
+                                 return entry.Input == image && entry.InputTime != inputTime;
+                               }),
+                entries.end());
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+template <typename TImage, typename TParameters, typename TPredicate, typename TFunction>
+TImage *
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::FindOrCompute(
+  EntriesType<TImage, TParameters> & entries,
+  const TImage *                     image,
+  const TParameters &                parameters,
+  TPredicate                         isSameInput,
+  TFunction                          compute)
+{
+  for (const auto & entry : entries)
+  {
+    if (isSameInput(entry.Input.GetPointer()) && entry.Parameters == parameters)
+    {
+      return entry.Output;
+    }
+  }
+
+  Entry<TImage, TParameters> entry;
+  entry.Input = image;
+  entry.InputTime = image->GetMTime();
+  entry.Parameters = parameters;
+  entry.Output = compute(image);
+  entries.push_back(entry);
+  return entry.Output;
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::ClearCache()
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  m_SmoothedFixedImages.clear();
+  m_SmoothedMovingImages.clear();
+  m_ShrunkVirtualDomainImages.clear();
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+SizeValueType
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::GetNumberOfCachedImages() const
+{
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  return static_cast<SizeValueType>(m_SmoothedFixedImages.size() + m_SmoothedMovingImages.size() +
+                                    m_ShrunkVirtualDomainImages.size());
+}
+
+template <typename TFixedImage, typename TMovingImage, typename TVirtualImage>
+void
+ImageRegistrationPyramidCache<TFixedImage, TMovingImage, TVirtualImage>::PrintSelf(std::ostream & os,
+                                                                                    Indent         indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  const std::lock_guard<std::mutex> lock(m_Mutex);
+  os << indent << "Number of smoothed fixed images: " << m_SmoothedFixedImages.size() << std::endl;
+  os << indent << "Number of smoothed moving images: " << m_SmoothedMovingImages.size() << std::endl;
+  os << indent << "Number of shrunk virtual domain images: " << m_ShrunkVirtualDomainImages.size() << std::endl;
+}
+
+} // end namespace itk
+
+#endif
@@ -0,0 +1,182 @@
+/*=========================================================================
+ *
+ *  Copyright NumFOCUS
+ *
+ *  Licensed under the Apache License, Version 2.0 (the "License");
+ *  you may not use this file except in compliance with the License.
+ *  You may obtain a copy of the License at
+ *
+ *         http://www.apache.org/licenses/LICENSE-2.0.txt
+ *
+ *  Unless required by applicable law or agreed to in writing, software
+ *  distributed under the License is distributed on an "AS IS" BASIS,
+ *  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ *  See the License for the specific language governing permissions and
+ *  limitations under the License.
+ *
+ *=========================================================================*/
+
+#include "itkImageRegistrationMethodv4.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkAffineTransform.h"
+#include "itkTranslationTransform.h"
+#include "itkTestingMacros.h"
+
+/*
+ * Test sharing an ImageRegistrationPyramidCache between the stages of a
+ * translation, then affine, registration: the smoothed and shrunk images are
+ * computed once for both stages, and the registration results are the same
+ * as without the cache.
+ */
+namespace
+{
+using PyramidCacheTestImageType = itk::Image<double, 2>;
+
+PyramidCacheTestImageType::Pointer
+PyramidCacheTestCreateImage(double centerX, double centerY)
+{
+  auto                                 image = PyramidCacheTestImageType::New();
+  PyramidCacheTestImageType::SizeType  size = { { 64, 64 } };
+  PyramidCacheTestImageType::IndexType start = { { 0, 0 } };
+  image->SetRegions(PyramidCacheTestImageType::RegionType(start, size));
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<PyramidCacheTestImageType> it(image, image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double x = it.GetIndex()[0] - centerX;
+    const double y = it.GetIndex()[1] - centerY;
+    it.Set(100.0 * std::exp(-(x * x + 2.0 * y * y) / 200.0));
+  }
+  return image;
+}
+
+template <typename TTransform>
+using PyramidCacheTestRegistrationType =
+  itk::ImageRegistrationMethodv4<PyramidCacheTestImageType, PyramidCacheTestImageType, TTransform>;
+
+template <typename TTransform>
+typename PyramidCacheTestRegistrationType<TTransform>::Pointer
+PyramidCacheTestCreateStage(const PyramidCacheTestImageType *                                         fixedImage,
+                            const PyramidCacheTestImageType *                                         movingImage,
+                            typename PyramidCacheTestRegistrationType<TTransform>::PyramidCacheType * cache)
+{
+  using RegistrationType = PyramidCacheTestRegistrationType<TTransform>;
+  auto registration = RegistrationType::New();
+  registration->SetFixedImage(fixedImage);
+  registration->SetMovingImage(movingImage);
+  registration->SetPyramidCache(cache);
+  registration->SetNumberOfLevels(2);
+
+  typename RegistrationType::ShrinkFactorsArrayType shrinkFactorsPerLevel(2);
+  shrinkFactorsPerLevel[0] = 2;
+  shrinkFactorsPerLevel[1] = 1;
+  registration->SetShrinkFactorsPerLevel(shrinkFactorsPerLevel);
+
+  typename RegistrationType::SmoothingSigmasArrayType smoothingSigmasPerLevel(2);
+  smoothingSigmasPerLevel[0] = 2;
+  smoothingSigmasPerLevel[1] = 0;
+  registration->SetSmoothingSigmasPerLevel(smoothingSigmasPerLevel);
+
+  auto * optimizer = dynamic_cast<itk::GradientDescentOptimizerv4 *>(registration->GetModifiableOptimizer());
+  if (!optimizer)
+  {
+    itkGenericExceptionMacro("Error dynamic_cast failed");
+  }
+  optimizer->SetNumberOfIterations(10);
+  return registration;
+}
+
+template <typename TTransform>
+bool
+PyramidCacheTestCompareParameters(const TTransform * transform, const TTransform * expectedTransform)
+{
+  const typename TTransform::ParametersType & parameters = transform->GetParameters();
+  const typename TTransform::ParametersType & expectedParameters = expectedTransform->GetParameters();
+  for (unsigned int i = 0; i < parameters.Size(); ++i)
+  {
+    if (itk::Math::abs(parameters[i] - expectedParameters[i]) > 1e-10)
+    {
+      std::cerr << "Parameters with cache " << parameters << " differ from the parameters without cache "
+                << expectedParameters << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+} // namespace
+
+int
+itkImageRegistrationPyramidCacheTest(int, char *[])
+{
+  using ImageType = PyramidCacheTestImageType;
+  using TranslationTransformType = itk::TranslationTransform<double, 2>;
+  using AffineTransformType = itk::AffineTransform<double, 2>;
+  using TranslationRegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, TranslationTransformType>;
+  using AffineRegistrationType = itk::ImageRegistrationMethodv4<ImageType, ImageType, AffineTransformType>;
+  using PyramidCacheType = TranslationRegistrationType::PyramidCacheType;
+
+  ImageType::Pointer fixedImage = PyramidCacheTestCreateImage(32.0, 32.0);
+  ImageType::Pointer movingImage = PyramidCacheTestCreateImage(35.0, 30.0);
+
+  auto cache = PyramidCacheType::New();
+  ITK_EXERCISE_BASIC_OBJECT_METHODS(cache, ImageRegistrationPyramidCache, Object);
+
+  // Run the two stages with and without the cache.
+  TranslationRegistrationType::Pointer translationStages[2];
+  AffineRegistrationType::Pointer      affineStages[2];
+  for (unsigned int withCache = 0; withCache < 2; ++withCache)
+  {
+    PyramidCacheType * stageCache = withCache ? cache.GetPointer() : nullptr;
+    translationStages[withCache] =
+      PyramidCacheTestCreateStage<TranslationTransformType>(fixedImage, movingImage, stageCache);
+    ITK_TRY_EXPECT_NO_EXCEPTION(translationStages[withCache]->Update());
+    if (withCache)
+    {
+      // The smoothed fixed and moving images of the first level, and the
+      // virtual domain images of both levels.
+      ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 4u);
+    }
+
+    affineStages[withCache] = PyramidCacheTestCreateStage<AffineTransformType>(fixedImage, movingImage, stageCache);
+    affineStages[withCache]->SetMovingInitialTransform(translationStages[withCache]->GetTransform());
+    ITK_TRY_EXPECT_NO_EXCEPTION(affineStages[withCache]->Update());
+    if (withCache)
+    {
+      // The second stage uses the images cached by the first one.
+      ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 4u);
+    }
+  }
+  ITK_TEST_SET_GET_VALUE(cache.GetPointer(), translationStages[1]->GetPyramidCache());
+
+  if (!PyramidCacheTestCompareParameters(translationStages[1]->GetTransform(), translationStages[0]->GetTransform()) ||
+      !PyramidCacheTestCompareParameters(affineStages[1]->GetTransform(), affineStages[0]->GetTransform()))
+  {
+    std::cerr << "Test failed!" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The cached images are found by input image and sigmas.
+  PyramidCacheType::FixedSigmaArrayType sigmas(2.0);
+  ImageType::ConstPointer               smoothedImage = cache->GetSmoothedFixedImage(fixedImage, sigmas);
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 4u);
+  sigmas.Fill(0.0);
+  ITK_TEST_EXPECT_EQUAL(cache->GetSmoothedFixedImage(fixedImage, sigmas), fixedImage.GetPointer());
+  sigmas.Fill(1.0);
+  ITK_TEST_EXPECT_TRUE(cache->GetSmoothedFixedImage(fixedImage, sigmas) != smoothedImage.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 5u);
+
+  // The images cached for a previous version of an input image are replaced.
+  fixedImage->Modified();
+  sigmas.Fill(2.0);
+  ITK_TEST_EXPECT_TRUE(cache->GetSmoothedFixedImage(fixedImage, sigmas) != smoothedImage.GetPointer());
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 4u);
+
+  ITK_TRY_EXPECT_EXCEPTION(cache->GetSmoothedMovingImage(nullptr, sigmas));
+
+  cache->ClearCache();
+  ITK_TEST_EXPECT_EQUAL(cache->GetNumberOfCachedImages(), 0u);
+
+  std::cout << "Test finished." << std::endl;
+  return EXIT_SUCCESS;
+}
@@ -43,9 +43,28 @@ namespace itk
  *
  * After the filter is executed, ObjectCount holds the number of connected components.
  *
- * \sa ImageToImageFilter
+ * All the steps are parallel: the runs are extracted and labeled by lines,
+ * the equivalences between the labels are resolved in a lock-free union-find
+ * with path compression, and the consecutive labels are computed by chunks
+ * of labels. The labeling does not depend on the number of threads.
+ *
+ * The filter can label an image too large to fit in memory, when its
+ * output is streamed, for example by a StreamingImageFilter or an
+ * ImageFileWriter. With NumberOfStreamDivisions greater than one, the
+ * input is divided into slabs along its slowest dimension. The first time
+ * some output is requested, the slabs are labeled one after the other, and
+ * the labels of the objects that cross the boundaries between the slabs are
+ * merged in a table of equivalences. Each requested region is then
+ * generated by labeling its slabs again, and mapping their labels through
+ * the table. The memory used is bounded by the size of the slabs and of
+ * the table, and the output is the same as without streaming.
+ *
+ * To get a LabelMap instead of a label image, use BinaryImageToLabelMapFilter,
+ * which shares this implementation and builds the label objects directly
+ * from the runs.
+ *
+ * \sa ImageToImageFilter, BinaryImageToLabelMapFilter
  *
- * \ingroup SingleThreaded
  * \ingroup ITKConnectedComponents
  *
  * \sphinx
@@ -152,6 +171,14 @@ public:
   itkSetMacro(BackgroundValue, OutputImagePixelType);
   itkGetConstMacro(BackgroundValue, OutputImagePixelType);
 
+  /** Set/Get the number of slabs in which the input is divided, to label it
+   * piece by piece. The upstream pipeline is executed once per slab, to
+   * compute the equivalences between the labels of the slabs, and once more
+   * for each requested region. The requested regions are enlarged to whole
+   * slabs. The default is 1, which labels the whole image at once. */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
 protected:
   ConnectedComponentImageFilter();
 
@@ -197,10 +224,49 @@ protected:
   using WorkUnitData = typename ScanlineFunctions::WorkUnitData;
 
 private:
+  /** The slabs are labeled separately with unsigned labels, so that a slab
+   * never has too many objects for the output pixel type. */
+  using SlabLabelImageType = Image<LabelType, ImageDimension>;
+  using SlabLabelerType = ConnectedComponentImageFilter<TInputImage, SlabLabelImageType, TMaskImage>;
+
+  /** Sets ObjectCount, after checking that the objects can be labeled with
+   * the output pixel type. */
+  void
+  SetObjectCount(SizeValueType numberOfObjects);
+
+  /** Generates the requested region slab by slab. */
+  void
+  GenerateDataInSlabs();
+
+  /** Labels all the slabs and computes the output label of the objects of
+   * each slab. */
+  void
+  ComputeSlabLabelMap();
+
+  /** Splits the largest possible region in slabs along its slowest
+   * dimension. */
+  std::vector<RegionType>
+  GetSlabs() const;
+
+  /** Updates the input and the mask over the region. */
+  void
+  UpdateInputsOverRegion(const RegionType & region);
+
+  /** Labels the slab, from the buffered input and mask. */
+  SmartPointer<SlabLabelerType>
+  LabelSlab(const RegionType & slab);
+
   OutputPixelType m_BackgroundValue = NumericTraits<OutputPixelType>::ZeroValue();
   LabelType       m_ObjectCount = 0;
+  unsigned int    m_NumberOfStreamDivisions = 1;
 
   typename TInputImage::ConstPointer m_Input;
+
+  /** The offset of the labels of each slab in m_SlabLabelMap, and the output
+   * label of the objects of all the slabs. */
+  std::vector<SizeValueType>   m_SlabLabelOffsets;
+  std::vector<OutputPixelType> m_SlabLabelMap;
+  TimeStamp                    m_SlabLabelMapTime;
 };
 } // end namespace itk
 
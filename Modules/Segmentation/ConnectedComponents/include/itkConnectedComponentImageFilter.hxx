@@ -25,6 +25,10 @@
 #include "itkMaskImageFilter.h"
 #include "itkConnectedComponentAlgorithm.h"
 #include "itkProgressTransformer.h"
+#include "itkProgressReporter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionSplitterSlowDimension.h"
+#include "itkImageAlgorithm.h"
 
 namespace itk
 {
@@ -46,6 +50,12 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateIn
   // call the superclass' implementation of this method
   Superclass::GenerateInputRequestedRegion();
 
+  // When streaming, the input of the requested slabs is enough.
+  if (m_NumberOfStreamDivisions > 1)
+  {
+    return;
+  }
+
   // We need all the input.
   InputImagePointer input = const_cast<InputImageType *>(this->GetInput());
   if (!input)
@@ -65,13 +75,47 @@ template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::EnlargeOutputRequestedRegion(DataObject *)
 {
-  this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+  OutputImageType * output = this->GetOutput();
+  if (m_NumberOfStreamDivisions <= 1)
+  {
+    output->SetRequestedRegion(output->GetLargestPossibleRegion());
+    return;
+  }
+
+  // Only whole slabs can be labeled: enlarge the requested region to the
+  // slabs it intersects, which follow each other.
+  const RegionType requestedRegion = output->GetRequestedRegion();
+  RegionType       region;
+  bool             intersects = false;
+  for (const RegionType & slab : this->GetSlabs())
+  {
+    RegionType intersection = slab;
+    if (intersection.Crop(requestedRegion))
+    {
+      if (!intersects)
+      {
+        region = slab;
+        intersects = true;
+      }
+      region.SetUpperIndex(slab.GetUpperIndex());
+    }
+  }
+  if (intersects)
+  {
+    output->SetRequestedRegion(region);
+  }
 }
 
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateData()
 {
+  if (m_NumberOfStreamDivisions > 1)
+  {
+    this->GenerateDataInSlabs();
+    return;
+  }
+
   this->AllocateOutputs();
   this->SetupLineOffsets(false);
   typename TInputImage::ConstPointer input = this->GetInput();
@@ -135,15 +179,7 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateDa
   SizeValueType numberOfObjects = this->CreateConsecutive(m_BackgroundValue);
   itkAssertOrThrowMacro(numberOfObjects <= this->m_NumberOfLabels,
                         "Number of consecutive labels cannot be greater than the initial number of labels!");
-  // check for overflow exception here
-  if (numberOfObjects > static_cast<SizeValueType>(NumericTraits<OutputPixelType>::max()))
-  {
-    itkExceptionMacro(<< "Number of objects (" << numberOfObjects << ") greater than maximum of output pixel type ("
-                      << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(
-                           NumericTraits<OutputPixelType>::max())
-                      << ").");
-  }
-  m_ObjectCount = numberOfObjects;
+  this->SetObjectCount(numberOfObjects);
 
   ProgressTransformer progress4(0.75f, 1.0f, this);
   multiThreader->template ParallelizeImageRegionRestrictDirection<TOutputImage::ImageDimension>(
@@ -161,6 +197,281 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateDa
   m_Input = nullptr;
 }
 
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::SetObjectCount(SizeValueType numberOfObjects)
+{
+  // check for overflow exception here
+  if (numberOfObjects > static_cast<SizeValueType>(NumericTraits<OutputPixelType>::max()))
+  {
+    itkExceptionMacro(<< "Number of objects (" << numberOfObjects << ") greater than maximum of output pixel type ("
+                      << static_cast<typename NumericTraits<OutputImagePixelType>::PrintType>(
+                           NumericTraits<OutputPixelType>::max())
+                      << ").");
+  }
+  m_ObjectCount = numberOfObjects;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GenerateDataInSlabs()
+{
+  OutputImageType * output = this->GetOutput();
+  const RegionType  requestedRegion = output->GetRequestedRegion();
+
+  // The labels of the slabs only have to be merged again when the pipeline
+  // has been modified, not for each requested region.
+  if (m_SlabLabelMapTime.GetMTime() < output->GetPipelineMTime())
+  {
+    this->ComputeSlabLabelMap();
+    m_SlabLabelMapTime.Modified();
+    this->UpdateInputsOverRegion(requestedRegion);
+  }
+
+  this->AllocateOutputs();
+
+  const std::vector<RegionType> slabs = this->GetSlabs();
+  ProgressReporter              progress(this, 0, slabs.size(), 100, 0.5f, 0.5f);
+  for (unsigned int slabNumber = 0; slabNumber < slabs.size(); ++slabNumber)
+  {
+    if (requestedRegion.IsInside(slabs[slabNumber]))
+    {
+      const auto                 labeler = this->LabelSlab(slabs[slabNumber]);
+      const SlabLabelImageType * labels = labeler->GetOutput();
+      const OutputPixelType *    labelMap = m_SlabLabelMap.data() + m_SlabLabelOffsets[slabNumber];
+      const OutputPixelType      background = m_BackgroundValue;
+
+      this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+        slabs[slabNumber],
+        [output, labels, labelMap, background](const RegionType & region) {
+          ImageScanlineConstIterator<SlabLabelImageType> lit(labels, region);
+          ImageScanlineIterator<OutputImageType>         oit(output, region);
+          while (!oit.IsAtEnd())
+          {
+            while (!oit.IsAtEndOfLine())
+            {
+              const LabelType label = lit.Get();
+              oit.Set(label == 0 ? background : labelMap[label]);
+              ++lit;
+              ++oit;
+            }
+            lit.NextLine();
+            oit.NextLine();
+          }
+        },
+        nullptr);
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::ComputeSlabLabelMap()
+{
+  const std::vector<RegionType> slabs = this->GetSlabs();
+  const RegionType &            largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+
+  // the dimension along which the slabs follow each other
+  unsigned int slabDimension = ImageDimension - 1;
+  for (unsigned int i = 0; i < ImageDimension; ++i)
+  {
+    if (slabs[0].GetSize(i) != largestRegion.GetSize(i))
+    {
+      slabDimension = i;
+    }
+  }
+
+  // offsets from the first plane of a slab to the neighbors in the last plane
+  // of the previous slab
+  std::vector<OffsetType> planeOffsets;
+  for (unsigned int n = 0; n < Math::UnsignedPower(3, ImageDimension); ++n)
+  {
+    OffsetType    offset;
+    unsigned int  digits = n;
+    SizeValueType distance = 0;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      offset[i] = static_cast<OffsetValueType>(digits % 3) - 1;
+      distance += itk::Math::abs(offset[i]);
+      digits /= 3;
+    }
+    if (offset[slabDimension] == -1 && (this->m_FullyConnected || distance == 1))
+    {
+      planeOffsets.push_back(offset);
+    }
+  }
+
+  // The objects of the slabs are the sets of a union-find, where the root of
+  // a set is its smallest label. The labels of the slabs follow each other
+  // in raster order, so that the roots are in the same order as the objects
+  // of the whole image.
+  std::vector<SizeValueType> unionFind(1, 0);
+  const auto                 findRoot = [&unionFind](SizeValueType label) {
+    while (unionFind[label] != label)
+    {
+      unionFind[label] = unionFind[unionFind[label]];
+      label = unionFind[label];
+    }
+    return label;
+  };
+
+  m_SlabLabelOffsets.clear();
+  typename SlabLabelImageType::Pointer previousPlane;
+  ProgressReporter                     progress(this, 0, slabs.size(), 100, 0.0f, 0.5f);
+  for (const RegionType & slab : slabs)
+  {
+    this->UpdateInputsOverRegion(slab);
+    const auto                 labeler = this->LabelSlab(slab);
+    const SlabLabelImageType * labels = labeler->GetOutput();
+
+    const SizeValueType offset = unionFind.size() - 1;
+    m_SlabLabelOffsets.push_back(offset);
+    for (SizeValueType label = 1; label <= labeler->GetObjectCount(); ++label)
+    {
+      unionFind.push_back(offset + label);
+    }
+
+    // merge the objects across the boundary with the previous slab
+    if (previousPlane)
+    {
+      RegionType firstPlane = slab;
+      firstPlane.SetSize(slabDimension, 1);
+      for (ImageRegionConstIteratorWithIndex<SlabLabelImageType> it(labels, firstPlane); !it.IsAtEnd(); ++it)
+      {
+        if (it.Get() != 0)
+        {
+          for (const OffsetType & planeOffset : planeOffsets)
+          {
+            const IndexType neighbor = it.GetIndex() + planeOffset;
+            if (previousPlane->GetBufferedRegion().IsInside(neighbor) && previousPlane->GetPixel(neighbor) != 0)
+            {
+              SizeValueType root1 = findRoot(previousPlane->GetPixel(neighbor));
+              SizeValueType root2 = findRoot(offset + it.Get());
+              if (root1 > root2)
+              {
+                std::swap(root1, root2);
+              }
+              unionFind[root2] = root1;
+            }
+          }
+        }
+      }
+    }
+
+    // keep the labels of the last plane for the next slab
+    RegionType lastPlane = slab;
+    lastPlane.SetIndex(slabDimension, slab.GetUpperIndex()[slabDimension]);
+    lastPlane.SetSize(slabDimension, 1);
+    previousPlane = SlabLabelImageType::New();
+    previousPlane->SetRegions(lastPlane);
+    previousPlane->Allocate();
+    ImageRegionConstIterator<SlabLabelImageType> it(labels, lastPlane);
+    for (ImageRegionIterator<SlabLabelImageType> pit(previousPlane, lastPlane); !pit.IsAtEnd(); ++pit, ++it)
+    {
+      pit.Set(it.Get() == 0 ? 0 : offset + it.Get());
+    }
+    progress.CompletedPixel();
+  }
+
+  // consecutive labels in the order of the roots, as in CreateConsecutive()
+  m_SlabLabelMap.resize(unionFind.size());
+  m_SlabLabelMap[0] = m_BackgroundValue;
+  OutputPixelType consecutiveLabel = 0;
+  SizeValueType   numberOfObjects = 0;
+  for (SizeValueType label = 1; label < unionFind.size(); ++label)
+  {
+    const SizeValueType root = findRoot(label);
+    if (root == label)
+    {
+      if (consecutiveLabel == m_BackgroundValue)
+      {
+        ++consecutiveLabel;
+      }
+      m_SlabLabelMap[label] = consecutiveLabel;
+      ++consecutiveLabel;
+      ++numberOfObjects;
+    }
+    else
+    {
+      m_SlabLabelMap[label] = m_SlabLabelMap[root];
+    }
+  }
+  this->SetObjectCount(numberOfObjects);
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::GetSlabs() const -> std::vector<RegionType>
+{
+  const RegionType & largestRegion = this->GetOutput()->GetLargestPossibleRegion();
+
+  auto                    splitter = ImageRegionSplitterSlowDimension::New();
+  const unsigned int      numberOfSlabs = splitter->GetNumberOfSplits(largestRegion, m_NumberOfStreamDivisions);
+  std::vector<RegionType> slabs(numberOfSlabs, largestRegion);
+  for (unsigned int i = 0; i < numberOfSlabs; ++i)
+  {
+    splitter->GetSplit(i, numberOfSlabs, slabs[i]);
+  }
+  return slabs;
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+void
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::UpdateInputsOverRegion(const RegionType & region)
+{
+  // As in StreamingImageFilter, execute the upstream pipeline for the region.
+  auto * input = const_cast<InputImageType *>(this->GetInput());
+  input->SetRequestedRegion(region);
+  input->PropagateRequestedRegion();
+  input->UpdateOutputData();
+
+  auto * mask = const_cast<MaskImageType *>(this->GetMaskImage());
+  if (mask)
+  {
+    mask->SetRequestedRegion(region);
+    mask->PropagateRequestedRegion();
+    mask->UpdateOutputData();
+  }
+}
+
+template <typename TInputImage, typename TOutputImage, typename TMaskImage>
+auto
+ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::LabelSlab(const RegionType & slab)
+  -> SmartPointer<SlabLabelerType>
+{
+  // Images without source, so that the labeler does not update the pipeline
+  // over the largest region. They share the buffers of the inputs when they
+  // are buffered over the slab only.
+  const auto wrap = [&slab](auto * image) {
+    using ImageType = std::remove_const_t<std::remove_pointer_t<decltype(image)>>;
+    auto slabImage = ImageType::New();
+    slabImage->CopyInformation(image);
+    slabImage->SetRegions(slab);
+    if (image->GetBufferedRegion() == slab)
+    {
+      slabImage->SetPixelContainer(const_cast<typename ImageType::PixelContainer *>(image->GetPixelContainer()));
+    }
+    else
+    {
+      slabImage->Allocate();
+      ImageAlgorithm::Copy(image, slabImage.GetPointer(), slab, slab);
+    }
+    return slabImage;
+  };
+
+  auto labeler = SlabLabelerType::New();
+  labeler->SetInput(wrap(this->GetInput()));
+  if (this->GetMaskImage())
+  {
+    labeler->SetMaskImage(wrap(this->GetMaskImage()));
+  }
+  labeler->SetFullyConnected(this->m_FullyConnected);
+  labeler->SetNumberOfWorkUnits(this->GetNumberOfWorkUnits());
+  labeler->Update();
+  return labeler;
+}
+
 template <typename TInputImage, typename TOutputImage, typename TMaskImage>
 void
 ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::DynamicThreadedGenerateData(
@@ -267,6 +578,7 @@ ConnectedComponentImageFilter<TInputImage, TOutputImage, TMaskImage>::PrintSelf(
   Superclass::PrintSelf(os, indent);
 
   os << indent << "ObjectCount: " << m_ObjectCount << std::endl;
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
 }
 } // end namespace itk
 
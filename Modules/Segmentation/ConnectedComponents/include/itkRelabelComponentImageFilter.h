@@ -20,8 +20,9 @@
 
 #include "itkInPlaceImageFilter.h"
 #include "itkImage.h"
-#include <vector>
+#include <map>
 #include <mutex>
+#include <vector>
 
 namespace itk
 {
@@ -68,6 +69,13 @@ namespace itk
  * controlled via methods in the superclass,
  * InPlaceImageFilter::InPlaceOn() and InPlaceImageFilter::InPlaceOff().
  *
+ * The filter can relabel an image too large to fit in memory, when its
+ * output is streamed. With NumberOfStreamDivisions greater than one, the
+ * sizes of the objects are accumulated over slabs of the input, the first
+ * time some output is requested. Each requested region is then relabeled
+ * from its input only. The memory used is bounded by the size of the slabs
+ * and the number of objects.
+ *
  * \sa ConnectedComponentImageFilter, BinaryThresholdImageFilter, ThresholdImageFilter
  *
  * \ingroup SingleThreaded
@@ -177,6 +185,13 @@ public:
   itkGetConstMacro(SortByObjectSize, bool);
   itkBooleanMacro(SortByObjectSize);
 
+  /** Set/Get the number of slabs in which the input is divided, to compute
+   * the sizes of the objects. The upstream pipeline is executed once per
+   * slab, and once more for each requested region. The default is 1, which
+   * requests the whole input at once. */
+  itkSetClampMacro(NumberOfStreamDivisions, unsigned int, 1, NumericTraits<unsigned int>::max());
+  itkGetConstMacro(NumberOfStreamDivisions, unsigned int);
+
   /** Get the size of each object in pixels. This information is only
    * valid after the filter has executed.  Size of the background is
    * not calculated.  Size of object #1 is
@@ -281,17 +296,27 @@ protected:
   };
 
 private:
+  /** Computes the output labels of the input labels from the sizes of the
+   * objects. */
+  void
+  ComputeRelabelMap();
+
   SizeValueType  m_NumberOfObjects{ 0 };
   SizeValueType  m_NumberOfObjectsToPrint{ 10 };
   SizeValueType  m_OriginalNumberOfObjects{ 0 };
   ObjectSizeType m_MinimumObjectSize{ 0 };
   bool           m_SortByObjectSize{ true };
+  unsigned int   m_NumberOfStreamDivisions{ 1 };
 
   std::mutex m_Mutex;
 
   using MapType = std::map<LabelType, RelabelComponentObjectType>;
   MapType m_SizeMap;
 
+  using RelabelMapType = std::map<LabelType, OutputPixelType>;
+  RelabelMapType m_RelabelMap;
+  TimeStamp      m_RelabelMapTime;
+
   ObjectSizeInPixelsContainerType        m_SizeOfObjectsInPixels;
   ObjectSizeInPhysicalUnitsContainerType m_SizeOfObjectsInPhysicalUnits;
 };
@@ -26,6 +26,7 @@
 #include <map>
 #include <utility>
 #include "itkTotalProgressReporter.h"
+#include "itkImageRegionSplitterSlowDimension.h"
 
 namespace itk
 {
@@ -43,6 +44,12 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRe
   // call the superclass' implementation of this method
   Superclass::GenerateInputRequestedRegion();
 
+  // When streaming, the input of the requested region is enough.
+  if (m_NumberOfStreamDivisions > 1)
+  {
+    return;
+  }
+
   // We need all the input.
   InputImagePointer input = const_cast<InputImageType *>(this->GetInput());
   if (input)
@@ -62,8 +69,9 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::ParallelComputeLabels(co
   // walk the input
   ImageScanlineConstIterator<InputImageType> it(this->GetInput(), inputRegionForThread);
 
-  auto                  inputRequestedRegion = this->GetInput()->GetRequestedRegion();
-  TotalProgressReporter report(this, inputRequestedRegion.GetNumberOfPixels(), 100, 0.5f);
+  // the whole input is walked, possibly one slab after the other
+  auto                  largestRegion = this->GetInput()->GetLargestPossibleRegion();
+  TotalProgressReporter report(this, largestRegion.GetNumberOfPixels(), 100, 0.5f);
 
   MapType localSizeMap;
 
@@ -88,7 +96,7 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::ParallelComputeLabels(co
       // increment the iterator
       ++it;
     }
-    report.Completed(inputRequestedRegion.GetSize(0));
+    report.Completed(largestRegion.GetSize(0));
     it.NextLine();
   }
 
@@ -124,28 +132,17 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::ParallelComputeLabels(co
 
 template <typename TInputImage, typename TOutputImage>
 void
-RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
+RelabelComponentImageFilter<TInputImage, TOutputImage>::ComputeRelabelMap()
 {
   using LabelComponentPairType = std::pair<LabelType, RelabelComponentObjectType>;
 
-  // Get the input and the output
-  const TInputImage * input = this->GetInput();
-  TOutputImage *      output = this->GetOutput();
-
   // Calculate the size of pixel
   float physicalPixelSize = 1.0;
   for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
   {
-    physicalPixelSize *= input->GetSpacing()[i];
+    physicalPixelSize *= this->GetInput()->GetSpacing()[i];
   }
 
-  // Walk the entire input image and compute used labels and the number of each label.
-  this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
-    input->GetRequestedRegion(),
-    [this](const RegionType & inputRegion) { this->ParallelComputeLabels(inputRegion); },
-    nullptr);
-
-
   // Construct an array of the label, component information pair to sort
   auto sizeVector = std::vector<LabelComponentPairType>(m_SizeMap.begin(), m_SizeMap.end());
 
@@ -166,8 +163,8 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
 
 
   // A map from the input pixel labels to the output labels
-  using RelabelMapType = std::map<LabelType, OutputPixelType>;
-  RelabelMapType relabelMap;
+  RelabelMapType & relabelMap = m_RelabelMap;
+  relabelMap.clear();
 
   // create a lookup table to map the input label to the output label.
   // cache the object sizes for later access by the user
@@ -220,6 +217,53 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
 
   // After the objects stats are computed add in the background label so the relabelMap can be directly applied.
   relabelMap.insert({ NumericTraits<LabelType>::ZeroValue(), NumericTraits<OutputPixelType>::ZeroValue() });
+}
+
+template <typename TInputImage, typename TOutputImage>
+void
+RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  // Get the input and the output
+  const TInputImage * input = this->GetInput();
+  TOutputImage *      output = this->GetOutput();
+
+  if (m_NumberOfStreamDivisions <= 1)
+  {
+    // Walk the entire input image and compute used labels and the number of each label.
+    this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+      input->GetRequestedRegion(),
+      [this](const RegionType & inputRegion) { this->ParallelComputeLabels(inputRegion); },
+      nullptr);
+    this->ComputeRelabelMap();
+  }
+  else if (m_RelabelMapTime.GetMTime() < output->GetPipelineMTime())
+  {
+    // The sizes of the objects only have to be computed again when the
+    // pipeline has been modified, not for each requested region. As in
+    // StreamingImageFilter, the upstream pipeline is executed for each slab.
+    auto *             streamedInput = const_cast<TInputImage *>(input);
+    const RegionType   requestedRegion = input->GetRequestedRegion();
+    const RegionType   largestRegion = input->GetLargestPossibleRegion();
+    auto               splitter = ImageRegionSplitterSlowDimension::New();
+    const unsigned int numberOfSlabs = splitter->GetNumberOfSplits(largestRegion, m_NumberOfStreamDivisions);
+    for (unsigned int i = 0; i < numberOfSlabs; ++i)
+    {
+      RegionType slab = largestRegion;
+      splitter->GetSplit(i, numberOfSlabs, slab);
+      streamedInput->SetRequestedRegion(slab);
+      streamedInput->PropagateRequestedRegion();
+      streamedInput->UpdateOutputData();
+
+      this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
+        slab, [this](const RegionType & inputRegion) { this->ParallelComputeLabels(inputRegion); }, nullptr);
+    }
+    this->ComputeRelabelMap();
+    m_RelabelMapTime.Modified();
+
+    streamedInput->SetRequestedRegion(requestedRegion);
+    streamedInput->PropagateRequestedRegion();
+    streamedInput->UpdateOutputData();
+  }
 
   // Second pass: walk just the output requested region and relabel
   // the necessary pixels.
@@ -231,14 +275,15 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::GenerateData()
   // In parallel apply the relabling map
   this->GetMultiThreader()->template ParallelizeImageRegion<ImageDimension>(
     output->GetRequestedRegion(),
-    [this, &relabelMap](const RegionType & outputRegionForThread) {
+    [this](const RegionType & outputRegionForThread) {
       auto                  outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
       TotalProgressReporter report(this, outputRequestedRegion.GetNumberOfPixels(), 100, 0.5f);
 
       ImageScanlineIterator<OutputImageType>     oit(this->GetOutput(), outputRegionForThread);
       ImageScanlineConstIterator<InputImageType> it(this->GetInput(), outputRegionForThread);
 
-      auto mapIt = relabelMap.cbegin();
+      const RelabelMapType & relabelMap = m_RelabelMap;
+      auto                   mapIt = relabelMap.cbegin();
 
       while (!oit.IsAtEnd())
       {
@@ -278,6 +323,7 @@ RelabelComponentImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream &
   os << indent << "NumberOfObjectsToPrint: " << m_NumberOfObjectsToPrint << std::endl;
   os << indent << "MinimumObjectSizes: " << m_MinimumObjectSize << std::endl;
   os << indent << "SortByObjectSize: " << m_SortByObjectSize << std::endl;
+  os << indent << "NumberOfStreamDivisions: " << m_NumberOfStreamDivisions << std::endl;
 
   typename ObjectSizeInPixelsContainerType::const_iterator it;
   ObjectSizeInPhysicalUnitsContainerType::const_iterator   fit;
@@ -23,8 +23,11 @@ using itk::print_helper::operator<<;
 #include "itkGTest.h"
 #include "itkImage.h"
 #include "itkConnectedComponentImageFilter.h"
+#include "itkBinaryThresholdImageFilter.h"
+#include "itkStreamingImageFilter.h"
 
 #include <bitset>
+#include <random>
 
 namespace
 {
@@ -50,6 +53,24 @@ CreateTestImageA()
 
   return image;
 }
+
+itk::Image<unsigned char, 3>::Pointer
+CreateRandomImage(double density)
+{
+  using ImageType = itk::Image<unsigned char, 3>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(itk::MakeSize(37u, 23u, 19u)));
+  image->Allocate();
+
+  std::mt19937                generator(42);
+  std::bernoulli_distribution foreground(density);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(foreground(generator) ? 1 : 0);
+  }
+  return image;
+}
 } // namespace
 
 
@@ -84,3 +105,99 @@ TEST(ConnectedComponentImageFilter, checkerboard_3D)
   ++it;
   EXPECT_TRUE(it.IsAtEnd());
 }
+
+
+TEST(ConnectedComponentImageFilter, random_3D_work_units)
+{
+  using ImageType = itk::Image<unsigned char, 3>;
+  using LabelImageType = itk::Image<unsigned int, 3>;
+
+  auto image = CreateRandomImage(0.09);
+
+  for (bool fullyConnected : { false, true })
+  {
+    auto reference = itk::ConnectedComponentImageFilter<ImageType, LabelImageType>::New();
+    reference->SetInput(image);
+    reference->SetFullyConnected(fullyConnected);
+    reference->SetNumberOfWorkUnits(1);
+    reference->Update();
+
+    // the objects are labeled consecutively in raster order
+    unsigned int maximumLabel = 0;
+    for (itk::ImageRegionConstIterator<LabelImageType> it(reference->GetOutput(),
+                                                          reference->GetOutput()->GetBufferedRegion());
+         !it.IsAtEnd();
+         ++it)
+    {
+      EXPECT_LE(it.Get(), maximumLabel + 1);
+      maximumLabel = std::max(maximumLabel, it.Get());
+    }
+    EXPECT_EQ(reference->GetObjectCount(), maximumLabel);
+    EXPECT_GT(maximumLabel, 1u);
+
+    // the labeling does not depend on the number of work units
+    for (itk::ThreadIdType numberOfWorkUnits : { 3, 16 })
+    {
+      auto connected = itk::ConnectedComponentImageFilter<ImageType, LabelImageType>::New();
+      connected->SetInput(image);
+      connected->SetFullyConnected(fullyConnected);
+      connected->SetNumberOfWorkUnits(numberOfWorkUnits);
+      connected->Update();
+
+      EXPECT_EQ(connected->GetObjectCount(), reference->GetObjectCount());
+      itk::ImageRegionConstIterator<LabelImageType> it(connected->GetOutput(),
+                                                       connected->GetOutput()->GetBufferedRegion());
+      itk::ImageRegionConstIterator<LabelImageType> referenceIt(reference->GetOutput(),
+                                                                reference->GetOutput()->GetBufferedRegion());
+      for (; !it.IsAtEnd(); ++it, ++referenceIt)
+      {
+        ASSERT_EQ(it.Get(), referenceIt.Get());
+      }
+    }
+  }
+}
+
+
+TEST(ConnectedComponentImageFilter, streaming_3D)
+{
+  using ImageType = itk::Image<unsigned char, 3>;
+  using LabelImageType = itk::Image<unsigned short, 3>;
+
+  auto image = CreateRandomImage(0.2);
+
+  for (bool fullyConnected : { false, true })
+  {
+    auto reference = itk::ConnectedComponentImageFilter<ImageType, LabelImageType>::New();
+    reference->SetInput(image);
+    reference->SetFullyConnected(fullyConnected);
+    reference->Update();
+
+    // an upstream filter, which is executed for each slab
+    auto threshold = itk::BinaryThresholdImageFilter<ImageType, ImageType>::New();
+    threshold->SetInput(image);
+    threshold->SetLowerThreshold(1);
+
+    auto connected = itk::ConnectedComponentImageFilter<ImageType, LabelImageType>::New();
+    connected->SetInput(threshold->GetOutput());
+    connected->SetFullyConnected(fullyConnected);
+    connected->SetNumberOfStreamDivisions(5);
+    EXPECT_EQ(connected->GetNumberOfStreamDivisions(), 5u);
+
+    // the streamed pieces are not aligned with the slabs
+    auto streamer = itk::StreamingImageFilter<LabelImageType, LabelImageType>::New();
+    streamer->SetInput(connected->GetOutput());
+    streamer->SetNumberOfStreamDivisions(3);
+    streamer->Update();
+
+    EXPECT_LT(threshold->GetOutput()->GetBufferedRegion().GetNumberOfPixels(),
+              image->GetBufferedRegion().GetNumberOfPixels());
+    EXPECT_EQ(connected->GetObjectCount(), reference->GetObjectCount());
+    itk::ImageRegionConstIterator<LabelImageType> it(streamer->GetOutput(), streamer->GetOutput()->GetBufferedRegion());
+    itk::ImageRegionConstIterator<LabelImageType> referenceIt(reference->GetOutput(),
+                                                              reference->GetOutput()->GetBufferedRegion());
+    for (; !it.IsAtEnd(); ++it, ++referenceIt)
+    {
+      ASSERT_EQ(it.Get(), referenceIt.Get());
+    }
+  }
+}
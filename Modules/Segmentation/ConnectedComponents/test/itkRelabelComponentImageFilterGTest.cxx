@@ -23,10 +23,14 @@ using itk::print_helper::operator<<;
 #include "itkGTest.h"
 #include "itkImage.h"
 #include "itkRelabelComponentImageFilter.h"
+#include "itkConnectedComponentImageFilter.h"
+#include "itkStreamingImageFilter.h"
 
 #include "itkSimpleFilterWatcher.h"
 #include "itkRandomImageSource.h"
 
+#include <random>
+
 namespace
 {
 
@@ -173,3 +177,53 @@ TEST(RelabelComponentImageFilter, big_random)
 
   filter->Update();
 }
+
+
+TEST(RelabelComponentImageFilter, streaming)
+{
+  using ImageType = itk::Image<unsigned char, 3>;
+  using LabelImageType = itk::Image<unsigned short, 3>;
+
+  auto image = ImageType::New();
+  image->SetRegions(ImageType::RegionType(itk::MakeSize(31u, 17u, 13u)));
+  image->Allocate();
+
+  std::mt19937                generator(42);
+  std::bernoulli_distribution foreground(0.2);
+  for (itk::ImageRegionIterator<ImageType> it(image, image->GetBufferedRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(foreground(generator) ? 1 : 0);
+  }
+
+  // the labels are streamed too
+  auto connected = itk::ConnectedComponentImageFilter<ImageType, LabelImageType>::New();
+  connected->SetInput(image);
+  connected->SetNumberOfStreamDivisions(4);
+
+  auto reference = itk::RelabelComponentImageFilter<LabelImageType, LabelImageType>::New();
+  reference->SetInput(connected->GetOutput());
+  reference->SetMinimumObjectSize(2);
+  reference->Update();
+
+  auto filter = itk::RelabelComponentImageFilter<LabelImageType, LabelImageType>::New();
+  filter->SetInput(connected->GetOutput());
+  filter->SetMinimumObjectSize(2);
+  filter->SetNumberOfStreamDivisions(4);
+  EXPECT_EQ(filter->GetNumberOfStreamDivisions(), 4u);
+
+  auto streamer = itk::StreamingImageFilter<LabelImageType, LabelImageType>::New();
+  streamer->SetInput(filter->GetOutput());
+  streamer->SetNumberOfStreamDivisions(3);
+  streamer->Update();
+
+  EXPECT_EQ(filter->GetNumberOfObjects(), reference->GetNumberOfObjects());
+  EXPECT_EQ(filter->GetOriginalNumberOfObjects(), reference->GetOriginalNumberOfObjects());
+  EXPECT_EQ(filter->GetSizeOfObjectsInPixels(), reference->GetSizeOfObjectsInPixels());
+  itk::ImageRegionConstIterator<LabelImageType> it(streamer->GetOutput(), streamer->GetOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<LabelImageType> referenceIt(reference->GetOutput(),
+                                                            reference->GetOutput()->GetBufferedRegion());
+  for (; !it.IsAtEnd(); ++it, ++referenceIt)
+  {
+    ASSERT_EQ(it.Get(), referenceIt.Get());
+  }
+}